@@ -30,6 +30,58 @@
 
 #define NUM_ALLOC 100
 
+#ifdef CONFIG_MM_SEGREGATED_FIT
+#define HEAP_ALLOCATOR_NAME "segregated fit"
+#else
+#define HEAP_ALLOCATOR_NAME "sorted free lists"
+#endif
+
+static uint32_t elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+/* Allocate and release NUM_ALLOC memory segments of a given size once,
+ * timing each call, and report the longest malloc() and free().
+ */
+static int measure_worst_latency(int size, char *data[], uint32_t *worst_malloc, uint32_t *worst_free)
+{
+	struct timespec ts1, ts2;
+	uint32_t elapsed;
+	int i;
+
+	*worst_malloc = 0;
+	*worst_free = 0;
+
+	for (i = 0; i < NUM_ALLOC; ++i) {
+		clock_gettime(CLOCK_REALTIME, &ts1);
+		data[i] = (char *)malloc(size);
+		clock_gettime(CLOCK_REALTIME, &ts2);
+		if (data[i] == NULL) {
+			while (--i >= 0) {
+				free(data[i]);
+			}
+			return -1;
+		}
+		elapsed = elapsed_usec(&ts1, &ts2);
+		if (elapsed > *worst_malloc) {
+			*worst_malloc = elapsed;
+		}
+	}
+
+	for (i = 0; i < NUM_ALLOC; ++i) {
+		clock_gettime(CLOCK_REALTIME, &ts1);
+		free(data[i]);
+		clock_gettime(CLOCK_REALTIME, &ts2);
+		elapsed = elapsed_usec(&ts1, &ts2);
+		if (elapsed > *worst_free) {
+			*worst_free = elapsed;
+		}
+	}
+
+	return 0;
+}
+
 static int heap_performance_test(int argc, char *argv[])
 {
 	struct timespec ts1, ts2;
@@ -40,6 +92,10 @@ static int heap_performance_test(int argc, char *argv[])
 	int test_repeat = 11;
 	uint32_t elapsed = 0;
 	uint32_t total_elapsed = 0;
+	uint32_t worst_malloc;
+	uint32_t worst_free;
+	uint32_t total_worst_malloc = 0;
+	uint32_t total_worst_free = 0;
 	int sizes[11] = {16, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192};
 	int interval = 1;
 
@@ -64,7 +120,8 @@ static int heap_performance_test(int argc, char *argv[])
 		printf("At this time, %s will be performed with default values.\n\n", argv[1]);
 	}
 
-	printf("\nTest with interval %d, repetition %d.\n", interval, repeat);
+	printf("\nHeap allocator : %s\n", HEAP_ALLOCATOR_NAME);
+	printf("Test with interval %d, repetition %d.\n", interval, repeat);
 	printf("Elapsed time doing a cycle of malloc() and free() %u times:\n", NUM_ALLOC * repeat);
 
 	for (k = 0; k < test_repeat; ++k) {
@@ -94,16 +151,28 @@ static int heap_performance_test(int argc, char *argv[])
 			return 0;
 		}
 
+		if (measure_worst_latency(size, data, &worst_malloc, &worst_free) < 0) {
+			printf("With size %d, Test failed due to malloc failure.\n", size);
+			return 0;
+		}
+
 		if (k > 0) {
 			elapsed = ((ts2.tv_sec - ts1.tv_sec) * 1000 + (ts2.tv_nsec - ts1.tv_nsec) / 1000000);
 			total_elapsed += elapsed;
-			printf("Size %u bytes	: %u mseconds.\n", size, elapsed);
+			printf("Size %u bytes	: %u mseconds (worst malloc %u usec, worst free %u usec).\n", size, elapsed, worst_malloc, worst_free);
+			if (worst_malloc > total_worst_malloc) {
+				total_worst_malloc = worst_malloc;
+			}
+			if (worst_free > total_worst_free) {
+				total_worst_free = worst_free;
+			}
 		}
 
 		sleep(interval);
 	}
 
 	printf("Total elapsed time : %u mseconds\n", total_elapsed);
+	printf("Worst-case latency : malloc %u usec, free %u usec\n", total_worst_malloc, total_worst_free);
 
 	return 0;
 }
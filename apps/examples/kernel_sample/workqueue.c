@@ -90,10 +90,10 @@ int workqueue_test(void)
 	struct work_s *test_wq3;
 	struct work_s *test_wq4;
 
-	test_wq1 = (struct work_s *)malloc(sizeof(struct work_s));
-	test_wq2 = (struct work_s *)malloc(sizeof(struct work_s));
-	test_wq3 = (struct work_s *)malloc(sizeof(struct work_s));
-	test_wq4 = (struct work_s *)malloc(sizeof(struct work_s));
+	test_wq1 = (struct work_s *)zalloc(sizeof(struct work_s));
+	test_wq2 = (struct work_s *)zalloc(sizeof(struct work_s));
+	test_wq3 = (struct work_s *)zalloc(sizeof(struct work_s));
+	test_wq4 = (struct work_s *)zalloc(sizeof(struct work_s));
 
 	start_time = clock();
 
@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file mem_benchmark_main.c
+/// @brief Throughput benchmark of memcpy(), memmove(), memset() and memcmp()
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_MEM_BENCHMARK_TOTAL
+#define CONFIG_EXAMPLES_MEM_BENCHMARK_TOTAL 4194304
+#endif
+
+#define MEMBENCH_MINSIZE    4
+#define MEMBENCH_MAXSIZE    (64 * 1024)
+
+/* Misaligned runs use these offsets from word aligned buffers */
+
+#define MEMBENCH_SRCOFFSET  1
+#define MEMBENCH_DSTOFFSET  3
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct membench_s {
+	const char *name;
+	void (*run)(uint8_t *dst, const uint8_t *src, size_t size);
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static volatile int g_result;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void run_memcpy(uint8_t *dst, const uint8_t *src, size_t size)
+{
+	memcpy(dst, src, size);
+}
+
+static void run_memmove(uint8_t *dst, const uint8_t *src, size_t size)
+{
+	/* Overlapping, with dst above src, so the copy runs backwards */
+
+	memmove(dst + 4, dst, size - 4);
+}
+
+static void run_memset(uint8_t *dst, const uint8_t *src, size_t size)
+{
+	memset(dst, 0x5a, size);
+}
+
+static void run_memcmp(uint8_t *dst, const uint8_t *src, size_t size)
+{
+	/* The areas are equal, so every byte is compared */
+
+	g_result += memcmp(dst, src, size);
+}
+
+static const struct membench_s g_benches[] = {
+	{"memcpy", run_memcpy},
+	{"memmove", run_memmove},
+	{"memset", run_memset},
+	{"memcmp", run_memcmp},
+};
+
+static uint32_t elapsed_us(struct timespec *start, struct timespec *end)
+{
+	return (uint32_t)(end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void membench_run(const struct membench_s *bench, uint8_t *dst, const uint8_t *src, size_t size, uint32_t total, const char *align)
+{
+	struct timespec start;
+	struct timespec end;
+	uint32_t loops;
+	uint32_t i;
+	uint32_t us;
+
+	loops = total / size;
+	if (loops == 0) {
+		loops = 1;
+	}
+
+	/* memcmp must see equal areas */
+
+	memcpy(dst, src, size);
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < loops; i++) {
+		bench->run(dst, src, size);
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	us = elapsed_us(&start, &end);
+	if (us == 0) {
+		printf(" %-8s %6u %-10s %10s\n", bench->name, (unsigned int)size, align, "-");
+	} else {
+		printf(" %-8s %6u %-10s %10u\n", bench->name, (unsigned int)size, align, (unsigned int)((uint64_t)loops * size * 1000000 / 1024 / us));
+	}
+}
+
+/****************************************************************************
+ * mem_benchmark_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int mem_benchmark_main(int argc, char *argv[])
+#endif
+{
+	uint32_t total = CONFIG_EXAMPLES_MEM_BENCHMARK_TOTAL;
+	uint32_t *srcbuf;
+	uint32_t *dstbuf;
+	uint8_t *src;
+	uint8_t *dst;
+	size_t size;
+	int i;
+
+	if (argc > 1) {
+		total = strtoul(argv[1], NULL, 0);
+	}
+
+	/* Allocate as words to get aligned buffers, with room for the offsets */
+
+	srcbuf = (uint32_t *)malloc(MEMBENCH_MAXSIZE + 2 * sizeof(uint32_t));
+	dstbuf = (uint32_t *)malloc(MEMBENCH_MAXSIZE + 2 * sizeof(uint32_t));
+	if (srcbuf == NULL || dstbuf == NULL) {
+		printf("Failed to allocate buffers\n");
+		free(srcbuf);
+		free(dstbuf);
+		return -1;
+	}
+
+	for (i = 0; i < MEMBENCH_MAXSIZE; i++) {
+		((uint8_t *)srcbuf)[i] = (uint8_t)i;
+	}
+
+	printf("Memory function throughput, %u bytes per measurement\n", (unsigned int)total);
+	printf(" %-8s %6s %-10s %10s\n", "FUNC", "SIZE", "ALIGN", "KB/s");
+
+	for (i = 0; i < sizeof(g_benches) / sizeof(g_benches[0]); i++) {
+		for (size = MEMBENCH_MINSIZE; size <= MEMBENCH_MAXSIZE; size *= 4) {
+			membench_run(&g_benches[i], (uint8_t *)dstbuf, (uint8_t *)srcbuf, size, total, "aligned");
+
+			src = (uint8_t *)srcbuf + MEMBENCH_SRCOFFSET;
+			dst = (uint8_t *)dstbuf + MEMBENCH_DSTOFFSET;
+			membench_run(&g_benches[i], dst, src, size, total, "misaligned");
+		}
+	}
+
+	free(srcbuf);
+	free(dstbuf);
+	return 0;
+}
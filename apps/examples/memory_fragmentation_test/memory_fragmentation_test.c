@@ -41,6 +41,12 @@
 /* Seed for random number */
 #define SEED 1
 
+#ifdef CONFIG_MM_SEGREGATED_FIT
+#define HEAP_ALLOCATOR_NAME "segregated fit"
+#else
+#define HEAP_ALLOCATOR_NAME "sorted free lists"
+#endif
+
 /* Data structure to store allocated memory segments */
 struct alloc_list {
 	char *data;
@@ -48,6 +54,48 @@ struct alloc_list {
 	struct alloc_list *prev;
 };
 
+/* Worst-case latency of a single malloc()/free() of a data segment in usec */
+static uint32_t g_worst_malloc;
+static uint32_t g_worst_free;
+
+static uint32_t elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static char *timed_malloc(size_t size)
+{
+	struct timespec ts1, ts2;
+	uint32_t elapsed;
+	char *data;
+
+	clock_gettime(CLOCK_REALTIME, &ts1);
+	data = (char *)malloc(size);
+	clock_gettime(CLOCK_REALTIME, &ts2);
+
+	elapsed = elapsed_usec(&ts1, &ts2);
+	if (elapsed > g_worst_malloc) {
+		g_worst_malloc = elapsed;
+	}
+
+	return data;
+}
+
+static void timed_free(char *data)
+{
+	struct timespec ts1, ts2;
+	uint32_t elapsed;
+
+	clock_gettime(CLOCK_REALTIME, &ts1);
+	free(data);
+	clock_gettime(CLOCK_REALTIME, &ts2);
+
+	elapsed = elapsed_usec(&ts1, &ts2);
+	if (elapsed > g_worst_free) {
+		g_worst_free = elapsed;
+	}
+}
+
 static bool memory_allocation(struct alloc_list list[], int numof_size[], int num_alloc[])
 {
 	struct alloc_list *next[MAX_SIZE_EXPONENT];
@@ -97,7 +145,7 @@ static bool memory_allocation(struct alloc_list list[], int numof_size[], int nu
 					
 				item = (struct alloc_list *)malloc(sizeof(struct alloc_list));
 				if (item) {
-					item->data = (char *)malloc((1 << (i + 4) * sizeof(char)));
+					item->data = timed_malloc((1 << (i + 4) * sizeof(char)));
 					/* add a new item at the tail */
 					if (item->data) {
 						item->next = NULL;
@@ -145,7 +193,7 @@ static bool memory_free(int num[], int num_alloc[], struct alloc_list list[])
 				if (temp->next) {
 					temp->next->prev = temp->prev;
 				} 
-				free(temp->data);
+				timed_free(temp->data);
 				free(temp);
 				--num_alloc[i];
 			} else {
@@ -256,6 +304,9 @@ static int memory_fragmentation_test(int argc, char *argv[])
 
 	srand(SEED);
 
+	g_worst_malloc = 0;
+	g_worst_free = 0;
+
 	/* Allocate memory according to 'numof_size' */
 	if (memory_allocation(list, numof_size, num_alloc) == false) {
 		printf("memory_allocation failed!\n");
@@ -320,6 +371,9 @@ static int memory_fragmentation_test(int argc, char *argv[])
 			printf("%d		%d			%d\n", 1 << (i + 4), num_free[i], num_alloc[i]);
 		}
 	}
+	printf("\nWorst-case latency with %s allocator:\n", HEAP_ALLOCATOR_NAME);
+	printf("malloc : %u usec\n", g_worst_malloc);
+	printf("free   : %u usec\n", g_worst_free);
 	printf("\nPlease, use 'heapinfo' to see how the heap memory is fragmented in detail.\n");
 
 	return 0;
@@ -0,0 +1,259 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * apps/examples/messaging_sample/messaging_benchmark.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_sample_internal.h"
+
+#define BENCH_PORT "bench_port"
+#define BENCH_IDLE_PORT "bench_idle"
+
+/* The number of multicast receivers and the payload size of each message */
+#define BENCH_NRECV 3
+#define BENCH_MSGSIZE 256
+
+/* Ports registered (but never used) only to show that the send cost does
+ * not depend on the number of ports.
+ */
+#define BENCH_NIDLE_PORTS 32
+
+#define MSG_PRIO 10
+#define TASK_PRIO 100
+#define STACKSIZE 2048
+#define BENCH_TIMEOUT_MS 10000
+#define BENCH_POLL_MS 10
+
+extern int fail_cnt;
+
+static int g_bench_count;
+static volatile int g_bench_received[BENCH_NRECV];
+static volatile int g_bench_ready;
+
+static uint32_t elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void bench_recv_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
+{
+	(*(volatile int *)cb_data)++;
+}
+
+static void bench_idle_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
+{
+}
+
+static int bench_receiver(int argc, FAR char *argv[])
+{
+	int ret;
+	int idx;
+	int waited;
+	msg_callback_info_t cb_info;
+	msg_recv_buf_t data;
+
+	idx = atoi(argv[1]);
+
+	data.buf = (char *)malloc(BENCH_MSGSIZE);
+	if (data.buf == NULL) {
+		fail_cnt++;
+		printf("Fail to run benchmark receiver : out of memory.\n");
+		return ERROR;
+	}
+	data.buflen = BENCH_MSGSIZE;
+
+	cb_info.cb_func = bench_recv_callback;
+	cb_info.cb_data = (void *)&g_bench_received[idx];
+
+	ret = messaging_recv_nonblock(BENCH_PORT, &data, &cb_info);
+	if (ret != OK) {
+		fail_cnt++;
+		printf("Fail to register benchmark receiver %d.\n", idx);
+		free(data.buf);
+		return ERROR;
+	}
+	g_bench_ready++;
+
+	/* Messages are received through the callback; stay alive until all arrived. */
+	for (waited = 0; g_bench_received[idx] < g_bench_count && waited < BENCH_TIMEOUT_MS; waited += BENCH_POLL_MS) {
+		usleep(BENCH_POLL_MS * 1000);
+	}
+
+	(void)messaging_cleanup(BENCH_PORT);
+	free(data.buf);
+	return OK;
+}
+
+static int bench_register_idle_ports(char *buf)
+{
+	int idx;
+	char port_name[32];
+	msg_callback_info_t cb_info;
+	static msg_recv_buf_t data;
+
+	data.buf = buf;
+	data.buflen = BENCH_MSGSIZE;
+	cb_info.cb_func = bench_idle_callback;
+	cb_info.cb_data = NULL;
+
+	for (idx = 0; idx < BENCH_NIDLE_PORTS; idx++) {
+		snprintf(port_name, sizeof(port_name), "%s%d_", BENCH_IDLE_PORT, idx);
+		if (messaging_recv_nonblock(port_name, &data, &cb_info) != OK) {
+			return idx;
+		}
+	}
+
+	return idx;
+}
+
+static void bench_cleanup_idle_ports(int nports)
+{
+	int idx;
+	char port_name[32];
+
+	for (idx = 0; idx < nports; idx++) {
+		snprintf(port_name, sizeof(port_name), "%s%d_", BENCH_IDLE_PORT, idx);
+		(void)messaging_cleanup(port_name);
+	}
+}
+
+/****************************************************************************
+ * Name : messaging_benchmark
+ *
+ * Description :
+ *  Multicast count messages of BENCH_MSGSIZE bytes to BENCH_NRECV receivers
+ *  while BENCH_NIDLE_PORTS other ports are registered, and report the
+ *  throughput seen by the sender and by the receivers.
+ ****************************************************************************/
+void messaging_benchmark(int count)
+{
+	int ret;
+	int idx;
+	int sent;
+	int received;
+	int waited;
+	int nidle;
+	char *payload;
+	char *idle_buf;
+	char idx_str[BENCH_NRECV][4];
+	FAR char *recv_argv[2];
+	msg_send_data_t data;
+	struct timespec start;
+	struct timespec sent_time;
+	struct timespec end;
+	uint32_t send_usec;
+	uint32_t total_usec;
+
+	printf("\n--- Start the Messaging benchmark. ---\n");
+
+	payload = (char *)malloc(BENCH_MSGSIZE);
+	idle_buf = (char *)malloc(BENCH_MSGSIZE);
+	if (payload == NULL || idle_buf == NULL) {
+		fail_cnt++;
+		printf("Fail to run benchmark : out of memory.\n");
+		goto errout;
+	}
+	memset(payload, 'M', BENCH_MSGSIZE);
+
+	nidle = bench_register_idle_ports(idle_buf);
+
+	g_bench_count = count;
+	g_bench_ready = 0;
+	for (idx = 0; idx < BENCH_NRECV; idx++) {
+		g_bench_received[idx] = 0;
+		snprintf(idx_str[idx], sizeof(idx_str[idx]), "%d", idx);
+		recv_argv[0] = idx_str[idx];
+		recv_argv[1] = NULL;
+		ret = task_create("bench_recv", TASK_PRIO, STACKSIZE, bench_receiver, recv_argv);
+		if (ret < 0) {
+			fail_cnt++;
+			printf("Fail to create benchmark receiver.\n");
+			goto errout_with_idle;
+		}
+	}
+
+	for (waited = 0; g_bench_ready < BENCH_NRECV && waited < BENCH_TIMEOUT_MS; waited += BENCH_POLL_MS) {
+		usleep(BENCH_POLL_MS * 1000);
+	}
+
+	data.msg = payload;
+	data.msglen = BENCH_MSGSIZE;
+	data.priority = MSG_PRIO;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (sent = 0; sent < count; sent++) {
+		if (messaging_multicast(BENCH_PORT, &data) != BENCH_NRECV) {
+			fail_cnt++;
+			printf("Fail to send benchmark multicast %d.\n", sent);
+			break;
+		}
+	}
+	clock_gettime(CLOCK_REALTIME, &sent_time);
+
+	/* Wait until the receivers have consumed everything that was sent. */
+	do {
+		received = 0;
+		for (idx = 0; idx < BENCH_NRECV; idx++) {
+			received += g_bench_received[idx];
+		}
+		if (received >= sent * BENCH_NRECV) {
+			break;
+		}
+		usleep(BENCH_POLL_MS * 1000);
+		waited += BENCH_POLL_MS;
+	} while (waited < BENCH_TIMEOUT_MS);
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	send_usec = elapsed_usec(&start, &sent_time);
+	total_usec = elapsed_usec(&start, &end);
+	if (send_usec == 0) {
+		send_usec = 1;
+	}
+	if (total_usec == 0) {
+		total_usec = 1;
+	}
+
+	printf("- %d multicasts of %d bytes to %d receivers, %d idle ports\n", sent, BENCH_MSGSIZE, BENCH_NRECV, nidle);
+	printf("- send : %u usec (%u usec per multicast)\n", send_usec, sent ? send_usec / sent : 0);
+	printf("- delivered : %d / %d messages in %u usec, %u messages/sec, %u KB/sec\n", received, sent * BENCH_NRECV, total_usec, (uint32_t)((uint64_t)received * 1000000 / total_usec), (uint32_t)((uint64_t)received * BENCH_MSGSIZE * 1000000 / total_usec / 1024));
+	if (received < sent * BENCH_NRECV) {
+		fail_cnt++;
+		printf("Fail to deliver all benchmark messages.\n");
+	}
+
+	/* Let the receivers notice the end and clean up their ports. */
+	sleep(1);
+
+errout_with_idle:
+	bench_cleanup_idle_ports(nidle);
+errout:
+	free(payload);
+	free(idle_buf);
+}
@@ -63,6 +63,7 @@
 
 #define EXEC_NORMAL   0
 #define EXEC_INFINITE 1
+#define EXEC_BENCHMARK 2
 
 static volatile bool inf_flag;
 static volatile bool is_running;
@@ -132,13 +133,14 @@ int messaging_main(int argc, char *argv[])
 	int option;
 	char *cmd_arg = NULL;
 	char *cnt_arg = NULL;
+	char *bench_arg = NULL;
 	int execution_type = EXEC_NORMAL;
 
 	if (argc >= 4 || argc == 2) {
 		goto usage;
 	}
 
-	while ((option = getopt(argc, argv, "r:n:")) != ERROR) {
+	while ((option = getopt(argc, argv, "r:n:b:")) != ERROR) {
 		switch (option) {
 		case 'r':
 			execution_type = EXEC_INFINITE;
@@ -148,6 +150,10 @@ int messaging_main(int argc, char *argv[])
 			execution_type = EXEC_NORMAL;
 			cnt_arg = optarg;
 			break;
+		case 'b':
+			execution_type = EXEC_BENCHMARK;
+			bench_arg = optarg;
+			break;
 		case '?':
 		default:
 			goto usage;
@@ -172,6 +178,21 @@ int messaging_main(int argc, char *argv[])
 			goto usage;
 		}
 
+	} else if (execution_type == EXEC_BENCHMARK) {
+		if (is_running) {
+			goto already_running;
+		}
+
+		repetition_num = atoi(bench_arg);
+		if (repetition_num <= 0) {
+			goto usage;
+		}
+
+		is_running = true;
+		fail_cnt = 0;
+		messaging_benchmark(repetition_num);
+		printf("\n=== Messaging Benchmark is finished. fail : %d\n", fail_cnt);
+		is_running = false;
 	} else {
 		if (is_running) {
 			goto already_running;
@@ -196,6 +217,7 @@ usage:
 	printf(" -r start : Execute messaging sample infinitely until stop cmd.\n");
 	printf("    stop  : Stop the messaging sample infinite execution.\n");
 	printf(" -n COUNT : Execute messaging sample COUNT-iterations.\n");
+	printf(" -b COUNT : Measure multicast throughput with COUNT messages.\n");
 	return -1;
 already_running:
 	printf("There is already running Messaging Sample.\n");
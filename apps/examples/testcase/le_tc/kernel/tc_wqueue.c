@@ -26,7 +26,11 @@
 #include <tinyara/config.h>
 #include <tinyara/clock.h>
 #include <tinyara/wqueue.h>
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include <sys/types.h>
 #include "tc_internal.h"
 
@@ -35,12 +39,21 @@
 **************************************************************************/
 #ifdef CONFIG_SCHED_WORKQUEUE
 
+#define WQ_STRESS_NWORKS    64
+#define WQ_STRESS_ROUNDS    100
+#define WQ_STRESS_LONGDELAY 1000
+
 /**************************************************************************
 * Private Variables
 **************************************************************************/
 
 static clock_t start_time;
 
+static struct work_s stress_work[WQ_STRESS_NWORKS];
+static clock_t stress_due[WQ_STRESS_NWORKS];
+static volatile int stress_runs;
+static volatile int stress_early;
+
 /**************************************************************************
 * Private Functions
 **************************************************************************/
@@ -64,10 +77,81 @@ static void wq_test3(void *arg)
 	cur_time = clock();
 	printf("workqueue_test 3 : test 3 requested delay is (%u) ticks, executed delay is (%llu) ticks.\n", (uint32_t)arg, (uint64_t)cur_time - (uint64_t)start_time);
 }
+static void wq_stress(void *arg)
+{
+	int i = (int)arg;
+
+	if ((int32_t)(clock() - stress_due[i]) < 0) {
+		stress_early++;
+	}
+	stress_runs++;
+}
+
 /**************************************************************************
 * Public Functions
 **************************************************************************/
 #if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
+static void tc_wqueue_work_queue_stress(void)
+{
+	int result;
+	int round;
+	int i;
+	clock_t delay;
+	clock_t elapsed;
+
+	memset(stress_work, 0, sizeof(stress_work));
+	stress_runs = 0;
+	stress_early = 0;
+
+	/* Keep many delayed works pending and requeue them repeatedly */
+
+	for (i = 0; i < WQ_STRESS_NWORKS; i++) {
+		result = work_queue(HPWORK, &stress_work[i], wq_stress, (void *)i, WQ_STRESS_LONGDELAY + i);
+		TC_ASSERT_EQ("work_queue", result, OK);
+	}
+
+	result = work_queue(HPWORK, &stress_work[0], wq_stress, (void *)0, WQ_STRESS_LONGDELAY);
+	TC_ASSERT_EQ("work_queue", result, -EALREADY);
+
+	start_time = clock();
+	for (round = 0; round < WQ_STRESS_ROUNDS; round++) {
+		for (i = 0; i < WQ_STRESS_NWORKS; i++) {
+			result = work_cancel(HPWORK, &stress_work[i]);
+			TC_ASSERT_EQ("work_cancel", result, OK);
+			result = work_queue(HPWORK, &stress_work[i], wq_stress, (void *)i, WQ_STRESS_LONGDELAY + (round * 7 + i) % 97);
+			TC_ASSERT_EQ("work_queue", result, OK);
+		}
+	}
+	elapsed = clock() - start_time;
+	printf("workqueue_stress: %d cancel/queue pairs with %d pending works took %llu ticks\n",
+		   WQ_STRESS_ROUNDS * WQ_STRESS_NWORKS, WQ_STRESS_NWORKS, (uint64_t)elapsed);
+
+	/* Then let all of them run with spread short delays */
+
+	for (i = 0; i < WQ_STRESS_NWORKS; i++) {
+		result = work_cancel(HPWORK, &stress_work[i]);
+		TC_ASSERT_EQ("work_cancel", result, OK);
+	}
+	TC_ASSERT_EQ("work_cancel", stress_runs, 0);
+
+	for (i = 0; i < WQ_STRESS_NWORKS; i++) {
+		delay = 1 + (i * 13) % WQ_STRESS_NWORKS;
+		stress_due[i] = clock() + delay;
+		result = work_queue(HPWORK, &stress_work[i], wq_stress, (void *)i, delay);
+		TC_ASSERT_EQ("work_queue", result, OK);
+	}
+
+	usleep((WQ_STRESS_NWORKS + 10) * USEC_PER_TICK);
+
+	TC_ASSERT_EQ("work_queue", stress_runs, WQ_STRESS_NWORKS);
+	TC_ASSERT_EQ("work_queue", stress_early, 0);
+	for (i = 0; i < WQ_STRESS_NWORKS; i++) {
+		TC_ASSERT_EQ("work_available", work_available(&stress_work[i]), true);
+	}
+
+	TC_SUCCESS_RESULT();
+}
+
 static void tc_wqueue_work_queue_cancel(void)
 {
 	int result;
@@ -75,9 +159,9 @@ static void tc_wqueue_work_queue_cancel(void)
 	struct work_s *test_work2;
 	struct work_s *test_work3;
 
-	test_work1 = (struct work_s *)malloc(sizeof(struct work_s));
-	test_work2 = (struct work_s *)malloc(sizeof(struct work_s));
-	test_work3 = (struct work_s *)malloc(sizeof(struct work_s));
+	test_work1 = (struct work_s *)zalloc(sizeof(struct work_s));
+	test_work2 = (struct work_s *)zalloc(sizeof(struct work_s));
+	test_work3 = (struct work_s *)zalloc(sizeof(struct work_s));
 
 	start_time = clock();
 
@@ -115,6 +199,7 @@ int wqueue_main(void)
 {
 #if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
 	tc_wqueue_work_queue_cancel();
+	tc_wqueue_work_queue_stress();
 #endif
 	return 0;
 }
@@ -48,6 +48,7 @@
  *  Global Variables
  ****************************************************************************/
 static db_cursor_t *g_cursor;
+static char g_batch_query[DATA_SET_NUM][QUERY_LENGTH];
 
 const static char *g_attribute_set[] = {"id", "date", "fruit", "value", "weight"};
 
@@ -145,7 +146,7 @@ static void utc_arastorage_db_deinit_p(void)
 * @testcase         utc_arastorage_db_exec_p
 * @brief            Excute database operations
 * @scenario         Create relation, attributes, index and insert data
-* @apicovered       db_exec
+* @apicovered       db_exec, db_insert_batch
 * @precondition     none
 * @postcondition    none
 */
@@ -153,6 +154,7 @@ static void utc_arastorage_db_exec_p(void)
 {
 	db_result_t res;
 	char query[QUERY_LENGTH];
+	char *batch[DATA_SET_NUM];
 	int i;
 
 	/* cleanup called for cleaning all undeleted resources */
@@ -248,6 +250,14 @@ static void utc_arastorage_db_exec_p(void)
 		TC_ASSERT_EQ("db_exec", DB_SUCCESS(res), true);
 	}
 
+	/* Insert one more data set as a single batch */
+	for (i = 0; i < DATA_SET_NUM; i++) {
+		snprintf(g_batch_query[i], QUERY_LENGTH, "INSERT (%d, %ld) INTO %s;", DATA_SET_NUM * 10 + i, rand()%10000, RELATION_NAME2);
+		batch[i] = g_batch_query[i];
+	}
+	res = db_insert_batch(batch, DATA_SET_NUM);
+	TC_ASSERT_EQ("db_insert_batch", DB_SUCCESS(res), true);
+
 #ifdef CONFIG_ARCH_FLOAT_H
 	memset(query, 0, QUERY_LENGTH);
 	snprintf(query, QUERY_LENGTH, "CREATE ATTRIBUTE %s DOMAIN double IN %s;", g_attribute_set[4], RELATION_NAME1);
@@ -318,7 +328,7 @@ static void utc_arastorage_db_exec_p(void)
 * @testcase         utc_arastorage_db_exec_n
 * @brief            Excute database operations with invalid argument
 * @scenario         Create exiting relation, attribute and excute db with NULL value
-* @apicovered       db_exec
+* @apicovered       db_exec, db_insert_batch
 * @precondition     none
 * @postcondition    none
 */
@@ -328,6 +338,7 @@ static void utc_arastorage_db_exec_n(void)
 	char query[QUERY_LENGTH];
 	char *name = "BAD_RELATION";
 	char *attr_name = "attr";
+	char *batch[1];
 	/* Try to create existing relation */
 	memset(query, 0, QUERY_LENGTH);
 	snprintf(query, QUERY_LENGTH, "CREATE RELATION %s;", RELATION_NAME1);
@@ -368,6 +379,14 @@ static void utc_arastorage_db_exec_n(void)
 	res = db_exec(query);
 	TC_ASSERT_EQ("db_exec", DB_ERROR(res), true);
 
+	/* Batch with NULL value and with a query other than INSERT */
+	res = db_insert_batch(NULL, 1);
+	TC_ASSERT_EQ("db_insert_batch", DB_ERROR(res), true);
+
+	batch[0] = query;
+	res = db_insert_batch(batch, 1);
+	TC_ASSERT_EQ("db_insert_batch", DB_ERROR(res), true);
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -375,13 +394,17 @@ static void utc_arastorage_db_exec_n(void)
 * @testcase         utc_arastorage_db_query_p
 * @brief            Query a database
 * @scenario         Select data and get returned cursor
-* @apicovered       db_query
+* @apicovered       db_query, db_query_stream, cursor_fetch_next, db_get_cache_stats
 * @precondition     utc_arastorage_db_exec_p should be passed
 * @postcondition    none
 */
 static void utc_arastorage_db_query_p(void)
 {
 	db_result_t res;
+	int count;
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	db_cache_stats_t stats;
+#endif
 	char query[QUERY_LENGTH];
 
 	/* Select over bplus-tree index */
@@ -422,6 +445,74 @@ static void utc_arastorage_db_query_p(void)
 	snprintf(query, QUERY_LENGTH, "SELECT MIN(id) FROM %s;", RELATION_NAME2);
 	check_query_result(query);
 
+	/* Select over both inline and bplus-tree index, stopped by LIMIT.
+	 * Rows with id 501 to DATA_SET_NUM * DATA_SET_MULTIPLIER - 1 match,
+	 * far more than the limit. */
+	snprintf(query, QUERY_LENGTH, "SELECT id, value FROM %s WHERE id > 10 AND value < 500 LIMIT 5;", RELATION_NAME1);
+	g_cursor = db_query(query);
+	TC_ASSERT_NEQ("db_query", g_cursor, NULL);
+	TC_ASSERT_EQ_CLEANUP("cursor_get_count", cursor_get_count(g_cursor), 5, db_cursor_free(g_cursor));
+
+	if (DB_SUCCESS(cursor_move_first(g_cursor))) {
+		do {
+			TC_ASSERT_GT_CLEANUP("cursor_get_int_value", cursor_get_int_value(g_cursor, 0), 500, db_cursor_free(g_cursor));
+			TC_ASSERT_LT_CLEANUP("cursor_get_int_value", cursor_get_int_value(g_cursor, 1), 500, db_cursor_free(g_cursor));
+		} while (DB_SUCCESS(cursor_move_next(g_cursor)));
+	}
+
+	res = db_cursor_free(g_cursor);
+	TC_ASSERT_EQ("db_cursor_free", DB_SUCCESS(res), true);
+	g_cursor = NULL;
+
+	/* Stream the rows without materializing a result relation */
+	snprintf(query, QUERY_LENGTH, "SELECT id, value FROM %s WHERE value < 990;", RELATION_NAME1);
+	g_cursor = db_query_stream(query);
+	TC_ASSERT_NEQ("db_query_stream", g_cursor, NULL);
+
+	count = 0;
+	while ((res = cursor_fetch_next(g_cursor)) == DB_OK) {
+		count++;
+	}
+	TC_ASSERT_EQ_CLEANUP("cursor_fetch_next", res, DB_FINISHED, db_cursor_free(g_cursor));
+	TC_ASSERT_EQ_CLEANUP("cursor_get_count", cursor_get_count(g_cursor), count, db_cursor_free(g_cursor));
+
+	res = db_cursor_free(g_cursor);
+	TC_ASSERT_EQ("db_cursor_free", DB_SUCCESS(res), true);
+	g_cursor = NULL;
+
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	/* The bplus-tree index on value was written through the page cache.
+	 * Every row found over it must read back as inserted, including the
+	 * pages which were evicted and written back meanwhile. */
+	snprintf(query, QUERY_LENGTH, "SELECT id, value FROM %s WHERE value < 990;", RELATION_NAME1);
+	g_cursor = db_query(query);
+	TC_ASSERT_NEQ("db_query", g_cursor, NULL);
+
+	count = 0;
+	if (DB_SUCCESS(cursor_move_first(g_cursor))) {
+		do {
+			TC_ASSERT_EQ_CLEANUP("cursor_get_int_value", cursor_get_int_value(g_cursor, 1), 1000 - cursor_get_int_value(g_cursor, 0), db_cursor_free(g_cursor));
+			count++;
+		} while (DB_SUCCESS(cursor_move_next(g_cursor)));
+	}
+	/* Rows with id 11 to DATA_SET_NUM * DATA_SET_MULTIPLIER - 1 match */
+	TC_ASSERT_EQ_CLEANUP("cursor_get_count", count, DATA_SET_NUM * DATA_SET_MULTIPLIER - 11, db_cursor_free(g_cursor));
+
+	res = db_cursor_free(g_cursor);
+	TC_ASSERT_EQ("db_cursor_free", DB_SUCCESS(res), true);
+	g_cursor = NULL;
+
+	/* The queries above read the tuples through the page cache */
+	res = db_get_cache_stats(&stats);
+	TC_ASSERT_EQ("db_get_cache_stats", DB_SUCCESS(res), true);
+	TC_ASSERT_GT("db_get_cache_stats", stats.hits + stats.misses, 0);
+	/* More pages were loaded than the cache holds, so pages were evicted */
+	TC_ASSERT_GT("db_get_cache_stats", stats.misses + stats.prefetches, CONFIG_ARASTORAGE_PAGE_CACHE_PAGES);
+
+	res = db_get_cache_stats(NULL);
+	TC_ASSERT_EQ("db_get_cache_stats", DB_ERROR(res), true);
+#endif
+
 	/* Remove operation */
 	snprintf(query, QUERY_LENGTH, "REMOVE FROM %s WHERE date > 2000 AND date < 8000;", RELATION_NAME2);
 	check_query_result(query);
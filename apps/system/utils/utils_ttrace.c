@@ -43,6 +43,7 @@ static const struct tag_list ttrace_tags[] = {
 	{"lock",    "Lock",          TTRACE_TAG_LOCK},
 	{"task",    "TASK",          TTRACE_TAG_TASK},
 	{"ipc",     "IPC",           TTRACE_TAG_IPC},
+	{"irq",     "Interrupts",    TTRACE_TAG_IRQ},
 };
 
 int param = 0;
@@ -255,6 +256,68 @@ static int read_tracebuffer(FILE *file, int bufsize)
 	return TTRACE_VALID;
 }
 
+#ifdef CONFIG_TTRACE_EVENTS
+static void print_event(struct ttrace_event_s *ev)
+{
+	printf("[%06d:%06d] %03d: ", ev->sec, ev->usec, ev->pid);
+
+	switch (ev->type) {
+	case TTRACE_EVENT_SCHED:
+		printf("s|prev_comm=%d prev_pid=%d prev_prio=%u prev_state=%u ==> next_comm=%d next_pid=%d next_prio=%u\r\n",
+			   ev->pid, ev->pid, ev->aux, ev->arg & 0xff,
+			   (int16_t)(ev->arg >> 16), (int16_t)(ev->arg >> 16), (ev->arg >> 8) & 0xff);
+		break;
+	case TTRACE_EVENT_SEM_WAIT:
+		printf("w|%08x\r\n", ev->arg);
+		break;
+	case TTRACE_EVENT_SEM_WAKE:
+		printf("r|%08x\r\n", ev->arg);
+		break;
+	case TTRACE_EVENT_SEM_POST:
+		printf("p|%08x\r\n", ev->arg);
+		break;
+	case TTRACE_EVENT_IRQ_ENTER:
+		printf("i|%u\r\n", ev->arg);
+		break;
+	case TTRACE_EVENT_IRQ_LEAVE:
+		printf("x|%u\r\n", ev->arg);
+		break;
+	case TTRACE_EVENT_BEGIN:
+		printf("b|%s\r\n", (char *)ev->arg);
+		break;
+	case TTRACE_EVENT_BEGIN_UID:
+		printf("b|%u\r\n", ev->arg);
+		break;
+	case TTRACE_EVENT_END:
+		printf("e|0\r\n");
+		break;
+	default:
+		printf("?|%u %u\r\n", ev->type, ev->arg);
+		break;
+	}
+}
+
+static int read_events(FILE *file, int nevents)
+{
+	struct ttrace_evread_s rd;
+	int i;
+
+	rd.events = (struct ttrace_event_s *)alloc_tracebuffer(nevents * sizeof(struct ttrace_event_s));
+	if (rd.events == NULL) {
+		return TTRACE_INVALID;
+	}
+	rd.nevents = nevents;
+
+	nevents = run_cmd(file, TTRACE_READ_EVENTS, (int)&rd);
+	for (i = 0; i < nevents; i++) {
+		print_event(&rd.events[i]);
+	}
+
+	free_tracebuffer((char *)rd.events);
+	return nevents < 0 ? TTRACE_INVALID : TTRACE_VALID;
+}
+#endif
+
 void wait_ttrace_dump()
 {
 	int i = 0;
@@ -271,6 +334,9 @@ static int send_cmds(FILE *file, int cmd)
 {
 	int ret = 0;
 	int bufsize = 0;
+#ifdef CONFIG_TTRACE_EVENTS
+	int nevents;
+#endif
 
 	if (cmd == TTRACE_START) {
 		ret = run_cmd(file, TTRACE_SELECTED_TAG, selected_tags);
@@ -281,10 +347,19 @@ static int send_cmds(FILE *file, int cmd)
 		bufsize = run_cmd(file, TTRACE_USED_BUFSIZE, param);
 	} else if (cmd == TTRACE_PRINT) {
 		bufsize = run_cmd(file, TTRACE_USED_BUFSIZE, param);
+		if (bufsize > 0) {
+			ret = read_tracebuffer(file, bufsize);
+		}
+#ifdef CONFIG_TTRACE_EVENTS
+		nevents = run_cmd(file, TTRACE_USED_EVENTS, 0);
+		if (nevents > 0 && ret == TTRACE_VALID) {
+			ret = read_events(file, nevents);
+		}
+		bufsize += nevents;
+#endif
 		if (bufsize <= 0) {
 			return TTRACE_NODATA;
 		}
-		ret = read_tracebuffer(file, bufsize);
 		return ret;
 	}
 
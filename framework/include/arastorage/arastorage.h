@@ -180,6 +180,18 @@ typedef uint32_t tuple_id_t;
 
 typedef uint8_t attribute_id_t;
 
+/**
+ * @brief Statistics of the page cache shared by the database files
+ */
+struct db_cache_stats_s {
+	unsigned long hits;			/* Reads served from the cache */
+	unsigned long misses;		/* Reads which loaded a page from storage */
+	unsigned long prefetches;	/* Pages read ahead for sequential reads */
+	unsigned long writebacks;	/* Dirty pages written back to storage */
+};
+
+typedef struct db_cache_stats_s db_cache_stats_t;
+
 /****************************************************************************
 * Public Variables
 ****************************************************************************/
@@ -222,6 +234,21 @@ db_result_t db_deinit(void);
 */
 db_result_t db_exec(char *format);
 
+/**
+* @brief insert many tuples into one relation as a single batch
+*
+* @details @b #include <arastorage/arastorage.h>
+* All queries must be INSERT queries into the same relation. Either every
+* tuple is inserted or none is. With CONFIG_ARASTORAGE_ENABLE_WAL, the batch
+* is committed to the write-ahead log with one sync and applied to the
+* relation and its indexes later.
+* @param[in] queries array of INSERT query sentences
+* @param[in] count number of queries in the array
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_insert_batch(char **queries, int count);
+
 /**
 * @brief process query of arastorage
 *
@@ -232,6 +259,20 @@ db_result_t db_exec(char *format);
 */
 db_cursor_t *db_query(char *format);
 
+/**
+* @brief open a streaming cursor over the result of a SELECT query
+*
+* @details @b #include <arastorage/arastorage.h>
+* Unlike db_query, no tuple is read until the cursor is advanced, the result
+* is not limited by DB_TUPLE_LIMIT and no result relation is written.
+* The cursor is forward-only: use cursor_fetch_next, cursor_move_first or
+* cursor_move_next to advance it, and db_cursor_free to close it.
+* @param[in] format query sentence
+* @return On success, a pointer to db_cursor_t is returned. On failure, a NULL is returned.
+* @since TizenRT v3.1
+*/
+db_cursor_t *db_query_stream(char *format);
+
 /**
 * @brief free allocated cursor data, it should be called before application terminated
 *
@@ -242,6 +283,18 @@ db_cursor_t *db_query(char *format);
 */
 db_result_t db_cursor_free(db_cursor_t *cursor);
 
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+/**
+* @brief get hit, miss, prefetch and write-back counters of the page cache
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[out] stats a pointer to the statistics to fill
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_get_cache_stats(db_cache_stats_t *stats);
+#endif
+
 /**
 * @brief get string corresponding to each result value of API
 *
@@ -334,6 +387,17 @@ db_result_t cursor_move_prev(db_cursor_t *cursor);
 */
 db_result_t cursor_move_to(db_cursor_t *cursor, tuple_id_t row_id);
 
+/**
+* @brief read the next row of a streaming cursor
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] cursor a pointer to cursor returned by db_query_stream
+* @return DB_OK if the cursor points to a new row, DB_FINISHED if there are no more rows.
+*         On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t cursor_fetch_next(db_cursor_t *cursor);
+
 /**
 * @brief check whether current position of cursor is first row
 *
@@ -368,6 +432,7 @@ cursor_row_t cursor_get_row(db_cursor_t *cursor);
 * @brief get the number of rows of cursor
 *
 * @details @b #include <arastorage/arastorage.h>
+* For a streaming cursor, this is the number of rows read so far.
 * @param[in] cursor a pointer to cursor
 * @return On success, the number of rows is returned. On failure, INVALID_CURSOR_VALUE is returned.
 * @since TizenRT v1.0
@@ -210,6 +210,18 @@ public:
 	 */
 	player_result_t setObserver(std::shared_ptr<MediaPlayerObserverInterface>);
 
+	/**
+	 * @brief Set the stream information of MediaPlayer
+	 * @details @b #include <media/MediaPlayer.h>
+	 * This function is a synchronous API
+	 * It should be called before prepare. With the audio mixer, a player of
+	 * STREAM_TYPE_NOTIFY or STREAM_TYPE_EMERGENCY ducks the other players.
+	 * @param[in] stream_info shared_ptr of stream_info_t
+	 * @return The result of the setStreamInfo operation
+	 * @since TizenRT v3.1
+	 */
+	player_result_t setStreamInfo(std::shared_ptr<stream_info_t> stream_info);
+
 	/**
 	 * @brief MediaPlayer operator==
 	 * @details @b #include <media/MediaPlayer.h>
@@ -134,6 +134,15 @@ public:
 	 * @since TizenRT v2.0
 	 */
 	virtual void onAsyncPrepared(MediaPlayer &mediaPlayer, player_error_t error) {}
+	/**
+	 * @brief informs the user of an XRUN during playback, which the player recovered from
+	 * @details @b #include <media/MediaPlayerObserverInterface.h>
+	 * underrunCount counts how many times the PCM queued for output ran dry,
+	 * xrunCount counts how many times the output device reported XRUN.
+	 * Both are accumulated since the player was prepared.
+	 * @since TizenRT v3.1
+	 */
+	virtual void onPlaybackXrun(MediaPlayer &mediaPlayer, unsigned int underrunCount, unsigned int xrunCount) {}
 };
 } // namespace media
 
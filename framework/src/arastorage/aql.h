@@ -193,6 +193,7 @@ enum token_e {
 
 	ATTRIBUTE,
 	BPLUSTREE,					/* 48 */
+	LIMIT,
 
 	INTEGER_VALUE = 251,
 	FLOAT_VALUE = 252,
@@ -244,6 +245,7 @@ struct aql_adt_s {
 	uint8_t value_count;
 	uint32_t optype;
 	uint8_t flags;
+	tuple_id_t tuple_limit;
 	void *lvm_instance;
 };
 typedef struct aql_adt_s aql_adt_t;
@@ -255,6 +257,8 @@ int lexer_start(lexer_t *, char *, token_t *, value_t *);
 int lexer_next(lexer_t *);
 void lexer_rewind(lexer_t *);
 
+db_result_t aql_init_handle(db_handle_t **handle);
+db_result_t aql_deinit_handle(db_handle_t **handle);
 void aql_clear(aql_adt_t *adt);
 void aql_add_relation(aql_adt_t *adt, char *rel);
 aql_status_t aql_parse(aql_adt_t *adt, char *query_string);
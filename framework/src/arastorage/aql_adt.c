@@ -85,6 +85,7 @@ void aql_clear(aql_adt_t *adt)
 	adt->attribute_count = 0;
 	adt->value_count = 0;
 	adt->flags = 0;
+	adt->tuple_limit = 0;
 	memset(adt->aggregators, 0, sizeof(adt->aggregators));
 }
 
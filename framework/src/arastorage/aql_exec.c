@@ -68,6 +68,8 @@
 #include "relation.h"
 #include "result.h"
 #include "aql.h"
+#include "query_planner.h"
+#include "wal.h"
 
 /****************************************************************************
 * Private Functions
@@ -98,9 +100,14 @@ db_result_t aql_deinit_handle(db_handle_t **handle)
 		}
 	}
 	if ((*handle)->result_rel != NULL) {
-		res = relation_release((*handle)->result_rel);
-		if (DB_ERROR(res)) {
-			return res;
+		if (((*handle)->flags & DB_HANDLE_FLAG_STREAM) && (*handle)->result_rel->dir == DB_MEMORY) {
+			relation_destroy_transient((*handle)->result_rel);
+			(*handle)->result_rel = NULL;
+		} else {
+			res = relation_release((*handle)->result_rel);
+			if (DB_ERROR(res)) {
+				return res;
+			}
 		}
 	}
 	if ((*handle)->tuple != NULL) {
@@ -115,6 +122,7 @@ db_result_t aql_deinit_handle(db_handle_t **handle)
 		free((*handle)->attr_map);
 		(*handle)->attr_map = NULL;
 	}
+	planner_release(*handle);
 	free(*handle);
 	*handle = NULL;
 	DB_LOG_D("deinit handle!\n");
@@ -167,6 +175,13 @@ db_result_t db_exec(char *format)
 		return DB_ARGUMENT_ERROR;
 	}
 
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+	/* Batched inserts must reach the relations before they are changed. */
+	if (DB_ERROR(wal_checkpoint())) {
+		DB_LOG_E("DB : WAL checkpoint failed\n");
+	}
+#endif
+
 	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(&adt));
 	if (optype != AQL_TYPE_CREATE_RELATION) {
 		rel = aql_get_relation(&adt);
@@ -257,6 +272,11 @@ db_cursor_t *db_query(char *format)
 		DB_LOG_E("DB : AQL OP TYPE Error \n");
 		return NULL;
 	}
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+	if (DB_ERROR(wal_checkpoint())) {
+		DB_LOG_E("DB : WAL checkpoint failed\n");
+	}
+#endif
 #ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
 	if (DB_SUCCESS(storage_flush_insert_buffer())) {
 		DB_LOG_D("DB : flush insert buffer!!\n");
@@ -317,3 +337,165 @@ errout:
 
 	return NULL;
 }
+
+db_cursor_t *db_query_stream(char *format)
+{
+	aql_adt_t adt;
+	relation_t *rel;
+	db_handle_t *handler;
+	db_cursor_t *cursor;
+
+	handler = NULL;
+
+	if (DB_ERROR(aql_get_parse_result(format, &adt))) {
+		DB_LOG_E("DB : Parsing Error in db_query_stream\n");
+		return NULL;
+	}
+	if (AQL_GET_EXEC_TYPE(AQL_GET_TYPE(&adt)) != AQL_TYPE_SELECT) {
+		DB_LOG_E("DB : Only SELECT can be streamed\n");
+		goto errout_parse;
+	}
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+	if (DB_ERROR(wal_checkpoint())) {
+		DB_LOG_E("DB : WAL checkpoint failed\n");
+	}
+#endif
+#ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
+	if (DB_SUCCESS(storage_flush_insert_buffer())) {
+		DB_LOG_D("DB : flush insert buffer!!\n");
+	}
+#endif
+
+	rel = aql_get_relation(&adt);
+	if (rel == NULL) {
+		goto errout_parse;
+	}
+
+	if (DB_ERROR(aql_init_handle(&handler))) {
+		DB_LOG_E("DB: Init handle failed\n");
+		relation_release(rel);
+		goto errout_parse;
+	}
+	handler->flags |= DB_HANDLE_FLAG_STREAM;
+
+	/* The handle now owns the relation and releases it on deinit. */
+	if (DB_ERROR(relation_select(&handler, rel, &adt))) {
+		DB_LOG_E("DB: Failed relation_select\n");
+		goto errout;
+	}
+
+	/* No tuple is read until the caller fetches the first row. */
+	cursor = cursor_stream_open(handler);
+	if (cursor == NULL) {
+		DB_LOG_E("DB: Failed to open a streaming cursor\n");
+		goto errout;
+	}
+
+	return cursor;
+
+errout:
+	aql_deinit_handle(&handler);
+
+	return NULL;
+
+errout_parse:
+	if (adt.lvm_instance != NULL) {
+		free(adt.lvm_instance);
+	}
+
+	return NULL;
+}
+
+db_result_t db_insert_batch(char **queries, int count)
+{
+	aql_adt_t adt;
+	relation_t *rel;
+	relation_t *query_rel;
+	unsigned char *rows;
+	db_result_t res;
+	int i;
+
+	if (queries == NULL || count <= 0 || count > DB_TUPLE_LIMIT) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	rel = NULL;
+	rows = NULL;
+	res = DB_OK;
+	adt.lvm_instance = NULL;
+
+	/* Convert every tuple first, so that a bad query inserts nothing.
+	   Only a rejected query leaves a condition in adt.lvm_instance. */
+	for (i = 0; i < count; i++) {
+		if (DB_ERROR(aql_get_parse_result(queries[i], &adt))) {
+			DB_LOG_E("DB : Parsing Error in db_insert_batch : %d\n", i);
+			res = DB_PARSING_ERROR;
+			goto errout;
+		}
+		if (AQL_GET_EXEC_TYPE(AQL_GET_TYPE(&adt)) != AQL_TYPE_INSERT) {
+			DB_LOG_E("DB : Only INSERT can be batched\n");
+			res = DB_ARGUMENT_ERROR;
+			goto errout;
+		}
+
+		query_rel = aql_get_relation(&adt);
+		if (query_rel == NULL) {
+			res = DB_RELATIONAL_ERROR;
+			goto errout;
+		}
+		if (rel == NULL) {
+			rel = query_rel;
+			rows = (unsigned char *)malloc(rel->row_length * count);
+			if (rows == NULL) {
+				res = DB_ALLOCATION_ERROR;
+				goto errout;
+			}
+		} else {
+			relation_release(query_rel);
+			if (query_rel != rel) {
+				DB_LOG_E("DB : A batch must insert into one relation\n");
+				res = DB_ARGUMENT_ERROR;
+				goto errout;
+			}
+		}
+
+		res = relation_build_row(rel, adt.values, rows + i * rel->row_length);
+		if (DB_ERROR(res)) {
+			goto errout;
+		}
+	}
+
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+	if (relation_cardinality(rel) + wal_pending_rows(rel) + count > DB_TUPLE_LIMIT) {
+		res = DB_LIMIT_ERROR;
+		goto errout;
+	}
+	res = wal_append(rel, rows, (uint16_t)count);
+#else
+	if (relation_cardinality(rel) + count > DB_TUPLE_LIMIT) {
+		res = DB_LIMIT_ERROR;
+		goto errout;
+	}
+	for (i = 0; i < count; i++) {
+		res = relation_insert_row(rel, rows + i * rel->row_length);
+		if (DB_ERROR(res)) {
+			break;
+		}
+	}
+#endif
+	if (DB_SUCCESS(res)) {
+		res = DB_OK;
+	}
+
+errout:
+	if (adt.lvm_instance != NULL) {
+		free(adt.lvm_instance);
+	}
+	if (rows != NULL) {
+		free(rows);
+	}
+	if (rel != NULL) {
+		relation_release(rel);
+	}
+	return res;
+}
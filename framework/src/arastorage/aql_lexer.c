@@ -117,8 +117,9 @@ static const struct keyword keywords[] = {
 	{"WHERE", WHERE},			/* 34 */
 	{"COUNT", COUNT},
 	{"INDEX", INDEX},
+	{"LIMIT", LIMIT},
 
-	{"INSERT", INSERT},			/* 37 */
+	{"INSERT", INSERT},			/* 38 */
 	{"SELECT", SELECT},
 	{"REMOVE", REMOVE},
 	{"CREATE", CREATE},
@@ -128,16 +129,16 @@ static const struct keyword keywords[] = {
 	{"INLINE", INLINE},
 	{"REMAIN", REMAIN},
 
-	{"PROJECT", PROJECT},		/* 46 */
+	{"PROJECT", PROJECT},		/* 47 */
 
-	{"RELATION", RELATION},		/* 47 */
+	{"RELATION", RELATION},		/* 48 */
 
-	{"ATTRIBUTE", ATTRIBUTE},	/* 48 */
+	{"ATTRIBUTE", ATTRIBUTE},	/* 49 */
 	{"BPLUSTREE", BPLUSTREE}
 };
 
 /* Provides a pointer to the first keyword of a specific length. */
-static const int8_t skip_hint[] = { 0, 13, 21, 28, 34, 37, 46, 47, 48 };
+static const int8_t skip_hint[] = { 0, 13, 21, 28, 34, 38, 47, 48, 49 };
 
 static char separators[] = "#.;,() \t\n";
 
@@ -517,12 +517,25 @@ PARSER(select)
 			AQL_SET_CONDITION(adt, NULL);
 			RETURN(SYNTAX_ERROR);
 		}
-	} else {
+		NEXT;
+	} else if (TOKEN != LIMIT) {
 		REWIND;
 		RETURN(STATUS_OK);
 	}
 
-	CONSUME(END);
+	if (TOKEN == LIMIT) {
+		/* Stop the selection once this many tuples have been found. */
+		CONSUME(INTEGER_VALUE);
+		if (*(long *)lexer->value <= 0) {
+			RETURN(SYNTAX_ERROR);
+		}
+		adt->tuple_limit = (tuple_id_t)*(long *)lexer->value;
+		NEXT;
+	}
+
+	if (TOKEN != END) {
+		RETURN(SYNTAX_ERROR);
+	}
 
 	return STATUS_OK;
 }
@@ -65,6 +65,8 @@
 #include "db_debug.h"
 #include "result.h"
 #include "aql.h"
+#include "storage_cache.h"
+#include "wal.h"
 #include <arastorage/arastorage.h>
 
 /****************************************************************************
@@ -86,17 +88,36 @@ db_result_t db_init(void)
 	if (res != DB_OK) {
 		return res;
 	}
+#endif
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	res = storage_cache_init();
+	if (res != DB_OK) {
+		return res;
+	}
+#endif
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+	/* Recover the batches committed before the last shutdown or power loss. */
+	res = wal_checkpoint();
+	if (res != DB_OK) {
+		return res;
+	}
 #endif
 	return res;
 }
 
 db_result_t db_deinit()
 {
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+	wal_checkpoint();
+#endif
 #ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
 	storage_write_buffer_deinit();
 #endif
 	relation_deinit();
 	index_deinit();
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	storage_cache_deinit();
+#endif
 	return DB_OK;
 }
 
@@ -169,6 +190,17 @@ db_result_t db_cursor_free(db_cursor_t *cursor)
 	return cursor_deinit(cursor);
 }
 
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+db_result_t db_get_cache_stats(db_cache_stats_t *stats)
+{
+	if (stats == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	storage_cache_get_stats(stats);
+	return DB_OK;
+}
+#endif
+
 
 /* Print tuple value */
 db_result_t db_print_tuple(db_cursor_t *cursor)
@@ -28,14 +28,54 @@
 #include "db_debug.h"
 #include "storage.h"
 #include "relation.h"
+#include "aql.h"
 
 /****************************************************************************
 * Public Functions
 ****************************************************************************/
 
+/* Read the next row of a streaming cursor. */
+db_result_t cursor_fetch_next(db_cursor_t *cursor)
+{
+	db_result_t res;
+
+	if (cursor == NULL || cursor->stream == NULL) {
+		return DB_CURSOR_ERROR;
+	}
+
+	while (db_processing_status(cursor->stream)) {
+		res = relation_process(&cursor->stream, cursor);
+		if (DB_ERROR(res)) {
+			DB_LOG_E("DB: Failed to process tuples : %d\n", res);
+			cursor->stream->flags &= ~DB_HANDLE_FLAG_PROCESSING;
+			return res;
+		}
+		if (res == DB_GOT_ROW) {
+			return DB_OK;
+		}
+		if (res == DB_FINISHED) {
+			break;
+		}
+	}
+
+	cursor->stream->flags &= ~DB_HANDLE_FLAG_PROCESSING;
+	return DB_FINISHED;
+}
+
 /* Update current cursor id and storage id. */
 db_result_t cursor_move_to(db_cursor_t *cursor, tuple_id_t row_id)
 {
+	if (cursor != NULL && cursor->stream != NULL) {
+		/* A streaming cursor can only stay or step forward by one row. */
+		if (row_id == cursor->current_cursor_row) {
+			return IS_INVALID_CURSOR_ROW(cursor) ? DB_CURSOR_ERROR : DB_OK;
+		}
+		if (row_id == cursor->current_cursor_row + 1 && cursor_fetch_next(cursor) == DB_OK) {
+			return DB_OK;
+		}
+		return DB_CURSOR_ERROR;
+	}
+
 	if (IS_EMPTY_CURSOR(cursor)) {
 		DB_LOG_E("Empty Cursor\n");
 		return DB_CURSOR_ERROR;
@@ -124,6 +164,9 @@ bool cursor_is_first_row(db_cursor_t *cursor)
 	if (cursor->current_cursor_row != 0) {
 		return false;
 	}
+	if (cursor->stream != NULL) {
+		return true;
+	}
 	//check whether pointing storage row id is true
 	for (i = 0; i < cursor->total_rows; i++) {
 		index = GET_INDEX(i);
@@ -149,6 +192,10 @@ bool cursor_is_last_row(db_cursor_t *cursor)
 	if (cursor->current_cursor_row != cursor->cursor_rows - 1) {
 		return false;
 	}
+	if (cursor->stream != NULL) {
+		/* The last row is only known once the stream has ended. */
+		return !db_processing_status(cursor->stream);
+	}
 	//check whether pointing storage row id is true
 	int i, index, pos;
 
@@ -272,6 +319,9 @@ db_result_t cursor_get_value_storage(attribute_value_t *value, db_cursor_t *curs
 		/* If the type of value is aggregate value, we don't need to read storage.
 		 Because aggregate result is already calculated and stored in buffer. */
 		buf += cursor->attr_map[col].offset;
+	} else if (cursor->stream != NULL) {
+		/* A streaming cursor keeps its current row in memory. */
+		memcpy(buf, cursor->stream_row + cursor->attr_map[col].offset, attr.element_size);
 	} else {
 		/* Otherwise, Read tuple value from storage. */
 		offset = cursor->current_storage_row * cursor->storage_row_length + cursor->attr_map[col].offset;
@@ -441,6 +491,46 @@ db_result_t cursor_init(db_cursor_t **cursor, relation_t *rel)
 	return DB_OK;
 }
 
+db_cursor_t *cursor_stream_open(db_handle_t *handle)
+{
+	db_cursor_t *cursor;
+
+	cursor = (db_cursor_t *)malloc(sizeof(db_cursor_t));
+	if (cursor == NULL) {
+		return NULL;
+	}
+	memset(cursor, 0, sizeof(db_cursor_t));
+	cursor_clean_data(cursor);
+
+	cursor->stream_row = (unsigned char *)malloc(handle->rel->row_length + 1);
+	if (cursor->stream_row == NULL) {
+		free(cursor);
+		return NULL;
+	}
+
+	if (DB_ERROR(cursor_data_set(cursor, handle->attr_map, handle->result_rel->attribute_count))) {
+		free(cursor->stream_row);
+		free(cursor);
+		return NULL;
+	}
+
+	cursor->stream = handle;
+	cursor->total_rows = handle->rel->cardinality;
+	cursor->storage_row_length = handle->rel->row_length;
+	memcpy(cursor->name, handle->rel->tuple_filename, sizeof(handle->rel->tuple_filename));
+	memcpy(cursor->rel_name, handle->rel->name, sizeof(handle->rel->name));
+
+	return cursor;
+}
+
+/* Make a row produced by the selection the current row of a streaming cursor. */
+void cursor_stream_set_row(db_cursor_t *cursor, tuple_id_t tuple_id, unsigned char *row)
+{
+	memcpy(cursor->stream_row, row, cursor->storage_row_length);
+	cursor->current_storage_row = tuple_id;
+	cursor->current_cursor_row = cursor->cursor_rows++;
+}
+
 db_result_t cursor_deinit(db_cursor_t *cursor)
 {
 	if (cursor == NULL) {
@@ -450,6 +540,10 @@ db_result_t cursor_deinit(db_cursor_t *cursor)
 		free(cursor->row_arr);
 		cursor->row_arr = NULL;
 	}
+	if (cursor->stream != NULL) {
+		aql_deinit_handle(&cursor->stream);
+		free(cursor->stream_row);
+	}
 	free(cursor);
 	return DB_OK;
 }
@@ -189,6 +189,11 @@
 #define REMOVE_RELATION "db-rem"
 #endif							/* REMOVE_RELATION */
 
+/* The name of the write-ahead log file of batched inserts. */
+#ifndef DB_WAL_FILENAME
+#define DB_WAL_FILENAME "db-wal"
+#endif							/* DB_WAL_FILENAME */
+
 #define INDEX_NAME_SUFFIX ".idx"
 
 #define INDEX_NAME_LENGTH (RELATION_NAME_LENGTH + sizeof(INDEX_NAME_SUFFIX) - 1)
@@ -216,6 +221,28 @@
 #define DB_INDEX_COST                   64
 #endif							/* DB_INDEX_COST */
 
+/* Relative cost of reading one tuple from the tuple file, used by the
+   query planner to compare index plans with a full scan. */
+#ifndef DB_PLAN_ROW_COST
+#define DB_PLAN_ROW_COST                8
+#endif							/* DB_PLAN_ROW_COST */
+
+/* Relative cost of reading one entry from a B+-tree index. */
+#ifndef DB_PLAN_INDEX_ENTRY_COST
+#define DB_PLAN_INDEX_ENTRY_COST        1
+#endif							/* DB_PLAN_INDEX_ENTRY_COST */
+
+/* The planner assumes that a range open at one end, such as "a > 5",
+   selects one in DB_PLAN_OPEN_RANGE_DIVISOR tuples. */
+#ifndef DB_PLAN_OPEN_RANGE_DIVISOR
+#define DB_PLAN_OPEN_RANGE_DIVISOR      3
+#endif							/* DB_PLAN_OPEN_RANGE_DIVISOR */
+
+/* The maximum number of indexes intersected for a single query. */
+#ifndef DB_PLAN_INDEX_LIMIT
+#define DB_PLAN_INDEX_LIMIT             3
+#endif							/* DB_PLAN_INDEX_LIMIT */
+
 /* The maximum number of Maxheap indexes. */
 #ifndef DB_HEAP_INDEX_LIMIT
 #define DB_HEAP_INDEX_LIMIT             1
@@ -230,6 +257,28 @@
 #define DB_TREE_CACHE_LIMIT             10
 #endif
 
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+/* The number of pages in the page cache shared by all database files. */
+#ifndef DB_PAGE_CACHE_PAGES
+#define DB_PAGE_CACHE_PAGES             CONFIG_ARASTORAGE_PAGE_CACHE_PAGES
+#endif							/* DB_PAGE_CACHE_PAGES */
+
+/* The size of a page in the page cache. */
+#ifndef DB_PAGE_SIZE
+#define DB_PAGE_SIZE                    CONFIG_ARASTORAGE_PAGE_SIZE
+#endif							/* DB_PAGE_SIZE */
+
+/* The number of pages read ahead once a file is read sequentially. */
+#ifndef DB_PAGE_PREFETCH
+#define DB_PAGE_PREFETCH                CONFIG_ARASTORAGE_PAGE_PREFETCH
+#endif							/* DB_PAGE_PREFETCH */
+
+/* The maximum number of open files tracked by the page cache. */
+#ifndef DB_PAGE_CACHE_FILES
+#define DB_PAGE_CACHE_FILES             CONFIG_ARASTORAGE_PAGE_CACHE_FILES
+#endif							/* DB_PAGE_CACHE_FILES */
+#endif							/* CONFIG_ARASTORAGE_PAGE_CACHE */
+
 #ifdef DB_WIP
 #undef DB_WIP						/* DB WORK IN PROGRESS */
 #endif
@@ -119,8 +119,9 @@ struct index_api_s {
 	db_result_t(*load)(index_t *);
 	db_result_t(*release)(index_t *);
 	db_result_t(*insert)(index_t *, attribute_value_t *, tuple_id_t);
-	db_result_t(*delete)(index_t *, attribute_value_t *);
+	db_result_t(*delete)(index_t *, attribute_value_t *, tuple_id_t);
 	tuple_id_t(*get_next)(index_iterator_t *, uint8_t);
+	db_result_t(*sync)(index_t *);
 };
 
 typedef struct index_api_s index_api_t;
@@ -140,9 +141,11 @@ db_result_t index_destroy(index_t *);
 db_result_t index_load(relation_t *, attribute_t *);
 db_result_t index_release(index_t *);
 db_result_t index_insert(index_t *, attribute_value_t *, tuple_id_t);
-db_result_t index_delete(index_t *, attribute_value_t *);
+db_result_t index_delete(index_t *, attribute_value_t *, tuple_id_t);
+int index_has_tuple(index_t *, attribute_value_t *, tuple_id_t);
 db_result_t index_get_iterator(index_iterator_t *, index_t *, attribute_value_t *, attribute_value_t *);
 tuple_id_t index_get_next(index_iterator_t *, uint8_t);
+db_result_t index_sync_all(void);
 int index_exists(attribute_t *);
 db_result_t index_deinit(void);
 #endif							/* !INDEX_H */
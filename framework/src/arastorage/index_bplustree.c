@@ -273,15 +273,16 @@ static cache_result_t cache_write_bucket(tree_t *, int, bucket_t *);
 static cache_result_t modify_cache(tree_t *, int, cache_type_t, op_type_t);
 static cache_result_t cache_write_node(tree_t *, int, tree_node_t *);
 static cache_result_t cache_replace_node(tree_t *, int, tree_node_t *);
-static db_result_t delete_item_btree(index_t *index, int value);
+static db_result_t delete_item_btree(index_t *index, int value, int tuple);
 
 static db_result_t create(index_t *);
 static db_result_t destroy(index_t *);
 static db_result_t load(index_t *);
 static db_result_t release(index_t *);
 static db_result_t insert(index_t *, attribute_value_t *, tuple_id_t);
-static db_result_t delete(index_t *, attribute_value_t *);
+static db_result_t delete(index_t *, attribute_value_t *, tuple_id_t);
 static tuple_id_t get_next(index_iterator_t *, uint8_t);
+static db_result_t sync_index(index_t *);
 
 #ifdef DB_WIP
 static db_result_t vacuum(tree_t *, relation_t *);
@@ -302,7 +303,8 @@ index_api_t index_bplustree = {
 	release,
 	insert,
 	delete,
-	get_next
+	get_next,
+	sync_index
 };
 
 /****************************************************************************
@@ -782,14 +784,74 @@ static db_result_t insert(index_t *index, attribute_value_t *key, tuple_id_t val
 	return DB_OK;
 }
 
-static db_result_t delete(index_t *index, attribute_value_t *value)
+/****************************************************************************
+ * Name: sync_index
+ *
+ * Description: Writes the tree structure and the dirty entries of the node
+ *              and bucket caches to flash, and syncs the index files.
+ *              Required before the rows which the index entries refer to
+ *              can be dropped from the write-ahead log.
+ *
+ ****************************************************************************/
+static db_result_t sync_index(index_t *index)
+{
+	tree_t *tree;
+	qnode_t *tmp_node;
+	db_result_t result;
+
+	tree = (tree_t *)index->opaque_data;
+	if (tree == NULL || tree->node_cache == NULL || tree->buck_cache == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+
+	result = DB_OK;
+	if (DB_ERROR(storage_write_to(tree->tree_storage, tree, 0, sizeof(tree_t)))) {
+		result = DB_STORAGE_ERROR;
+	}
+
+	pthread_mutex_lock(&(tree->buck_cache_lock));
+	tmp_node = tree->buck_cache->in_cache.head->next;
+	while (tmp_node != tree->buck_cache->in_cache.tail) {
+		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
+			if (bucket_write(tree, tmp_node->id, &(tree->buck_cache->cache_t[tmp_node->pos].bucket))) {
+				UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
+			} else {
+				result = DB_STORAGE_ERROR;
+			}
+		}
+		tmp_node = tmp_node->next;
+	}
+	pthread_mutex_unlock(&(tree->buck_cache_lock));
+
+	pthread_mutex_lock(&(tree->node_cache_lock));
+	tmp_node = tree->node_cache->in_cache.head->next;
+	while (tmp_node != tree->node_cache->in_cache.tail) {
+		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
+			if (tree_write(tree, tmp_node->id, &(tree->node_cache->cache_t[tmp_node->pos].node))) {
+				UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
+			} else {
+				result = DB_STORAGE_ERROR;
+			}
+		}
+		tmp_node = tmp_node->next;
+	}
+	pthread_mutex_unlock(&(tree->node_cache_lock));
+
+	if (DB_ERROR(storage_sync(tree->bucket_storage)) || DB_ERROR(storage_sync(tree->tree_storage))) {
+		result = DB_STORAGE_ERROR;
+	}
+
+	return result;
+}
+
+static db_result_t delete(index_t *index, attribute_value_t *value, tuple_id_t tuple_id)
 {
 	int i_key;
 
 	i_key = db_value_to_long(value);
 	DB_LOG_D("delete index for value %d\n", i_key);
 
-	return delete_item_btree(index, i_key);
+	return delete_item_btree(index, i_key, (int)tuple_id);
 }
 
 /****************************************************************************
@@ -846,6 +908,7 @@ static tuple_id_t get_next(index_iterator_t *iterator, uint8_t matched_condition
 			rw_lock_write(&(tree->tree_lock));
 			pair_t *path = tree_find(tree, key_min);
 			if (path == NULL) {
+				rw_unlock_write(&(tree->tree_lock));
 				return INVALID_TUPLE;
 			}
 			uint16_t bucket_id = path[tree->levels].key;
@@ -860,6 +923,11 @@ static tuple_id_t get_next(index_iterator_t *iterator, uint8_t matched_condition
 		}
 	}
 
+	/* Skip a bucket whose key range lies outside of the search range */
+	if (cache.bucket->info[2] < key_min || cache.bucket->info[1] > key_max) {
+		cache.start = cache.end;
+	}
+
 	/* Iterate over the key-value pairs in the bucket and find the ones which satisfy the condition */
 	for (i = cache.start; i < cache.end; i++) {
 		if ((key_min <= cache.bucket->pairs[i].key) && (cache.bucket->pairs[i].key <= key_max)) {
@@ -2037,8 +2105,8 @@ static int db_flush(tree_t *tree, relation_t *rel)
 }
 #endif
 
-//caller need to free memory of rm_values
-static int bucket_remove_pair(bucket_t *bucket, int value, int **rm_values, int remove_all)
+//caller need to free memory of rm_values, tuple -1 matches the pairs of any tuple
+static int bucket_remove_pair(bucket_t *bucket, int value, int tuple, int **rm_values, int remove_all)
 {
 	int i;
 	int j;
@@ -2057,7 +2125,7 @@ static int bucket_remove_pair(bucket_t *bucket, int value, int **rm_values, int
 	}
 
 	for (i = 0; i < bucket->next_free_slot; i++) {
-		if (bucket->pairs[i].key == value) {
+		if (bucket->pairs[i].key == value && (tuple == -1 || bucket->pairs[i].value == tuple)) {
 			removed[rm_cnt++] = bucket->pairs[i].value;
 			bucket->next_free_slot--;
 			for (j = i; j < bucket->next_free_slot; j++) {
@@ -2192,7 +2260,7 @@ static int bucket_request_sibling(tree_t *tree, pair_t *path, bucket_t *bucket)
 			left_bucket = bucket_read(tree, n->id[index-1]);
 			if (left_bucket && left_bucket->next_free_slot > BUCKET_SIZE / 2) {
 				share_key = left_bucket->info[2];
-				value_cnt = bucket_remove_pair(left_bucket, share_key, &share_value, 1);
+				value_cnt = bucket_remove_pair(left_bucket, share_key, -1, &share_value, 1);
 
 				bucket->info[1] = share_key;
 				for (i = 0; i < value_cnt; i++) {
@@ -2218,7 +2286,7 @@ static int bucket_request_sibling(tree_t *tree, pair_t *path, bucket_t *bucket)
 			right_bucket = bucket_read(tree, n->id[index + 1]);
 			if (right_bucket && right_bucket->next_free_slot > BUCKET_SIZE / 2) {
 				share_key = right_bucket->info[1];
-				value_cnt = bucket_remove_pair(right_bucket, share_key, &share_value, 1);
+				value_cnt = bucket_remove_pair(right_bucket, share_key, -1, &share_value, 1);
 
 				bucket->info[2] = share_key;
 				for (i = 0; i < value_cnt; i++) {
@@ -2544,7 +2612,7 @@ static int bucket_merge_sibling(tree_t *tree, pair_t *path, bucket_t *bucket, in
 	return 0;
 }
 
-static db_result_t delete_item_btree(index_t *index, int value)
+static db_result_t delete_item_btree(index_t *index, int value, int tuple)
 {
 	db_result_t ret = DB_OK;
 	int bucket_id;
@@ -2552,6 +2620,7 @@ static db_result_t delete_item_btree(index_t *index, int value)
 	tree_t *tree;
 	bucket_t *tmp_bucket;
 	int *rm_value = NULL;
+	int rm_cnt;
 
 	tree = (tree_t*)index->opaque_data;
 	path = tree_find(tree, value);
@@ -2561,20 +2630,26 @@ static db_result_t delete_item_btree(index_t *index, int value)
 
 	bucket_id = path[tree->levels].key;
 	tmp_bucket = bucket_read(tree, bucket_id);
-	bucket_remove_pair(tmp_bucket, value, &rm_value, 0);
+	rm_cnt = bucket_remove_pair(tmp_bucket, value, tuple, &rm_value, 0);
 	free(rm_value);
 	modify_cache(tree, bucket_id, BUCKET, UNLOCK);
-	tree->inserted--;
 
-	if (tmp_bucket->next_free_slot >= BUCKET_SIZE / 2) { //no need re-orgnize
-		bucket_update_keys(tree, path, bucket_id, value);
-	} else { //need to re-orgnize the bucket and tree node
-		if (bucket_request_sibling(tree, path, tmp_bucket) == 0) {
+	if (rm_cnt == 0) {
+		/* No such pair, the tree is unchanged */
+		ret = DB_INDEX_ERROR;
+	} else {
+		tree->inserted--;
+
+		if (tmp_bucket->next_free_slot >= BUCKET_SIZE / 2) { //no need re-orgnize
 			bucket_update_keys(tree, path, bucket_id, value);
-			DB_LOG_D("request from sibling bucket successfully\n");
-		} else {
-			if (bucket_merge_sibling(tree, path, tmp_bucket, value) != 0) {
-				ret = DB_INDEX_ERROR;
+		} else { //need to re-orgnize the bucket and tree node
+			if (bucket_request_sibling(tree, path, tmp_bucket) == 0) {
+				bucket_update_keys(tree, path, bucket_id, value);
+				DB_LOG_D("request from sibling bucket successfully\n");
+			} else {
+				if (bucket_merge_sibling(tree, path, tmp_bucket, value) != 0) {
+					ret = DB_INDEX_ERROR;
+				}
 			}
 		}
 	}
@@ -73,7 +73,7 @@
 ****************************************************************************/
 static db_result_t null_op(index_t *);
 static db_result_t insert(index_t *, attribute_value_t *, tuple_id_t);
-static db_result_t delete(index_t *, attribute_value_t *);
+static db_result_t delete(index_t *, attribute_value_t *, tuple_id_t);
 static tuple_id_t get_next(index_iterator_t *, uint8_t);
 
 /****************************************************************************
@@ -103,7 +103,8 @@ index_api_t index_inline = {
 	null_op,
 	insert,
 	delete,
-	get_next
+	get_next,
+	null_op
 };
 
 /****************************************************************************
@@ -156,6 +157,9 @@ static tuple_id_t binary_search(index_iterator_t *index_iterator, attribute_valu
 
 		if (db_value_to_long(target_value) > db_value_to_long(cmp_value)) {
 			min = center + 1;
+		} else if (center == 0) {
+			/* The target precedes the first tuple. */
+			break;
 		} else {
 			max = center - 1;
 		}
@@ -206,7 +210,7 @@ static db_result_t insert(index_t *index, attribute_value_t *value, tuple_id_t t
 	return DB_OK;
 }
 
-static db_result_t delete(index_t *index, attribute_value_t *value)
+static db_result_t delete(index_t *index, attribute_value_t *value, tuple_id_t tuple_id)
 {
 	return DB_OK;
 }
@@ -307,13 +307,37 @@ db_result_t index_insert(index_t *index, attribute_value_t *value, tuple_id_t tu
 	return index->api->insert(index, value, tuple_id);
 }
 
-db_result_t index_delete(index_t *index, attribute_value_t *value)
+/* Delete the entry of a key which refers to tuple_id, or any entry of the
+   key when tuple_id is INVALID_TUPLE. */
+db_result_t index_delete(index_t *index, attribute_value_t *value, tuple_id_t tuple_id)
 {
 	if (index->state != INDEX_READY) {
 		return DB_INDEX_ERROR;
 	}
 
-	return index->api->delete(index, value);
+	return index->api->delete(index, value, tuple_id);
+}
+
+/* Check whether the index has an entry of the key which refers to tuple_id. */
+int index_has_tuple(index_t *index, attribute_value_t *value, tuple_id_t tuple_id)
+{
+	index_iterator_t iterator;
+	tuple_id_t next;
+	int found;
+
+	if (DB_ERROR(index_get_iterator(&iterator, index, value, value))) {
+		return 0;
+	}
+
+	/* The B+-tree keeps its buckets locked until the iteration ends. */
+	found = 0;
+	while ((next = index_get_next(&iterator, TRUE)) != INVALID_TUPLE) {
+		if (next == tuple_id) {
+			found = 1;
+		}
+	}
+
+	return found;
 }
 
 db_result_t index_get_iterator(index_iterator_t *iterator, index_t *index, attribute_value_t *min_value, attribute_value_t *max_value)
@@ -366,6 +390,7 @@ db_result_t index_get_iterator(index_iterator_t *iterator, index_t *index, attri
 	iterator->min_value = *min_value;
 	iterator->max_value = *max_value;
 	iterator->next_item_no = 0;
+	iterator->found_items = 0;
 
 	DB_LOG_D("DB: Acquired an index iterator for %s.%s over the range (%ld,%ld)\n", index->rel->name, index->attr->name, min_value->u.long_value, max_value->u.long_value);
 
@@ -382,7 +407,9 @@ tuple_id_t index_get_next(index_iterator_t *iterator, uint8_t matched_condition)
 		return INVALID_TUPLE;
 	}
 
-	if ((iterator->index->attr->flags & ATTRIBUTE_FLAG_UNIQUE) && iterator->next_item_no == 1) {
+	/* Only the inline index can be abandoned in the middle of an iteration;
+	   the B+-tree keeps its buckets locked until it reaches the end. */
+	if (iterator->index->type == INDEX_INLINE && (iterator->index->attr->flags & ATTRIBUTE_FLAG_UNIQUE) && iterator->next_item_no == 1) {
 		min = db_value_to_long(&iterator->min_value);
 		max = db_value_to_long(&iterator->max_value);
 		if (min == max) {
@@ -398,6 +425,26 @@ tuple_id_t index_get_next(index_iterator_t *iterator, uint8_t matched_condition)
 	return iterator->index->api->get_next(iterator, matched_condition);
 }
 
+/* Make every loaded index durable on flash. */
+db_result_t index_sync_all(void)
+{
+	index_t *index;
+	db_result_t result;
+
+	result = DB_OK;
+	for (index = list_head(indices); index != NULL; index = index->next) {
+		if (index->state != INDEX_READY || index->api->sync == NULL) {
+			continue;
+		}
+		if (DB_ERROR(index->api->sync(index))) {
+			DB_LOG_E("DB: Failed to sync index on %s.%s\n", index->rel->name, index->attr->name);
+			result = DB_STORAGE_ERROR;
+		}
+	}
+
+	return result;
+}
+
 /****************************************************************************
 * Private Functions
 ****************************************************************************/
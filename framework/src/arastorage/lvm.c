@@ -540,14 +540,10 @@ static void create_union(derivation_t *result, derivation_t *d1, derivation_t *d
 	int i;
 
 	for (i = 0; i < LVM_MAX_VARIABLE_ID; i++) {
-		if (!d1[i].derived && !d2[i].derived) {
+		if (!d1[i].derived || !d2[i].derived) {
+			/* One side of the disjunction leaves the variable
+			   unconstrained, so the union has no bounds either. */
 			continue;
-		} else if (d1[i].derived && !d2[i].derived) {
-			result[i].min.l = d1[i].min.l;
-			result[i].max.l = d1[i].max.l;
-		} else if (!d1[i].derived && d2[i].derived) {
-			result[i].min.l = d2[i].min.l;
-			result[i].max.l = d2[i].max.l;
 		} else {
 			/* Both derivations have been made; create a
 			   union of the ranges. */
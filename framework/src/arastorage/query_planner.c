@@ -0,0 +1,316 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "db_debug.h"
+#include "db_options.h"
+#include "index.h"
+#include "list.h"
+#include "lvm.h"
+#include "relation.h"
+#include "result.h"
+#include "query_planner.h"
+
+/****************************************************************************
+* Private Type Definitions
+****************************************************************************/
+/* An index which can narrow down the derived range of one attribute. */
+struct plan_candidate_s {
+	index_t *index;
+	attribute_value_t min;
+	attribute_value_t max;
+	tuple_id_t rows;			/* Estimated number of matching tuples */
+	unsigned long cost;			/* Estimated cost of reading the index */
+};
+typedef struct plan_candidate_s plan_candidate_t;
+
+/****************************************************************************
+* Private Functions
+****************************************************************************/
+static unsigned long plan_log2(tuple_id_t n)
+{
+	unsigned long log2 = 1;
+
+	while (n >>= 1) {
+		log2++;
+	}
+	return log2;
+}
+
+/*
+ * Estimate how many tuples fall into the range of a candidate and what it
+ * costs to find them through its index. There are no column statistics,
+ * so a bounded range is assumed to hold at most one tuple per key, and a
+ * range open at one end is assumed to select 1/DB_PLAN_OPEN_RANGE_DIVISOR
+ * of the relation.
+ */
+static void plan_estimate(plan_candidate_t *cand, tuple_id_t cardinality)
+{
+	long min;
+	long max;
+	unsigned long range;
+
+	min = VALUE_LONG(&cand->min);
+	max = VALUE_LONG(&cand->max);
+
+	if (min > max) {
+		/* Contradicting conditions such as "a < 5 AND a > 10" */
+		cand->rows = 0;
+	} else if (min <= DB_LONG_MIN || max >= DB_LONG_MAX) {
+		cand->rows = cardinality / DB_PLAN_OPEN_RANGE_DIVISOR + 1;
+	} else {
+		range = (unsigned long)max - (unsigned long)min;
+		cand->rows = range < cardinality ? range + 1 : cardinality;
+	}
+
+	if (cand->rows > cardinality) {
+		cand->rows = cardinality;
+	}
+
+	if (cand->index->type == INDEX_INLINE) {
+		/* Two binary searches over the tuple file give a contiguous
+		   run of tuple ids, so no index entries are read. */
+		cand->cost = 2 * plan_log2(cardinality) * DB_PLAN_ROW_COST;
+	} else {
+		cand->cost = (unsigned long)cand->rows * DB_PLAN_INDEX_ENTRY_COST;
+	}
+}
+
+/*
+ * Collect the indexed attributes for which the LVM derived a value range,
+ * keeping at most DB_PLAN_INDEX_LIMIT of them sorted by ascending row
+ * estimate.
+ */
+static int plan_collect(db_handle_t *handle, plan_candidate_t *cands, tuple_id_t cardinality)
+{
+	attribute_t *attr;
+	operand_value_t min;
+	operand_value_t max;
+	plan_candidate_t cand;
+	int ncands;
+	int i;
+
+	ncands = 0;
+	for (attr = list_head(handle->rel->attributes); attr != NULL; attr = attr->next) {
+		if (attr->index == NULL || ((index_t *)attr->index)->state != INDEX_READY) {
+			continue;
+		}
+		if (LVM_ERROR(lvm_get_derived_range(handle->lvm_instance, attr->name, &min, &max))) {
+			continue;
+		}
+
+		cand.index = (index_t *)attr->index;
+		cand.min.domain = cand.max.domain = DOMAIN_INT;
+		VALUE_LONG(&cand.min) = min.l;
+		VALUE_LONG(&cand.max) = max.l;
+		plan_estimate(&cand, cardinality);
+
+		DB_LOG_D("DB: Index on \"%s\" covers (%ld,%ld), about %lu tuples at cost %lu\n", attr->name, min.l, max.l, (unsigned long)cand.rows, cand.cost);
+
+		for (i = ncands; i > 0 && cands[i - 1].rows > cand.rows; i--) {
+			if (i < DB_PLAN_INDEX_LIMIT) {
+				cands[i] = cands[i - 1];
+			}
+		}
+		if (i < DB_PLAN_INDEX_LIMIT) {
+			cands[i] = cand;
+			if (ncands < DB_PLAN_INDEX_LIMIT) {
+				ncands++;
+			}
+		}
+	}
+
+	return ncands;
+}
+
+/*
+ * Drain the index of a candidate into a tuple id bitmap. The range has
+ * already been pushed into the index iterator, so only matching entries
+ * are returned.
+ */
+static db_result_t plan_scan_index(plan_candidate_t *cand, uint32_t *bitmap, size_t nwords, tuple_id_t cardinality)
+{
+	index_iterator_t iterator;
+	tuple_id_t tuple_id;
+	db_result_t result;
+
+	memset(bitmap, 0, nwords * sizeof(uint32_t));
+
+	if (VALUE_LONG(&cand->min) > VALUE_LONG(&cand->max)) {
+		/* Nothing can match. */
+		return DB_OK;
+	}
+
+	memset(&iterator, 0, sizeof(iterator));
+	result = index_get_iterator(&iterator, cand->index, &cand->min, &cand->max);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+
+	while ((tuple_id = index_get_next(&iterator, TRUE)) != INVALID_TUPLE) {
+		if (tuple_id < cardinality) {
+			BIT_SET(bitmap[GET_INDEX(tuple_id)], GET_POS(tuple_id));
+		}
+	}
+
+	/* The inline index reports a failed search the same way as an empty
+	   range. Let the caller fall back rather than drop matching tuples. */
+	if (iterator.next_item_no == 0 && cand->index->type == INDEX_INLINE) {
+		return DB_INDEX_ERROR;
+	}
+
+	return DB_OK;
+}
+
+/****************************************************************************
+* Public Functions
+****************************************************************************/
+
+/*
+ * Choose the indexes used to evaluate a selection. Indexes are added in
+ * order of selectivity for as long as reading one more index is cheaper
+ * than the tuple reads it is expected to save, assuming the conditions
+ * are independent. The chosen indexes are intersected into a bitmap of
+ * candidate tuple ids, which the selection then visits in storage order.
+ * If no index pays off, the handle is left to do a full scan. The LVM
+ * still checks every visited tuple, so the plan only has to be a superset
+ * of the result.
+ */
+void planner_build(db_handle_t *handle)
+{
+	plan_candidate_t cands[DB_PLAN_INDEX_LIMIT];
+	tuple_id_t cardinality;
+	tuple_id_t rows;
+	tuple_id_t narrowed;
+	uint32_t *bitmap;
+	uint32_t *scratch;
+	uint32_t *target;
+	size_t nwords;
+	size_t i;
+	int ncands;
+	int nchosen;
+	int nused;
+	int n;
+
+	cardinality = relation_cardinality(handle->rel);
+	if (cardinality == INVALID_TUPLE || cardinality == 0) {
+		return;
+	}
+
+	ncands = plan_collect(handle, cands, cardinality);
+
+	rows = cardinality;
+	for (nchosen = 0; nchosen < ncands; nchosen++) {
+		narrowed = (tuple_id_t)(((unsigned long long)rows * cands[nchosen].rows) / cardinality);
+		if (cands[nchosen].cost >= (unsigned long)(rows - narrowed) * DB_PLAN_ROW_COST) {
+			break;
+		}
+		rows = narrowed;
+	}
+
+	if (nchosen == 0) {
+		DB_LOG_D("DB: Full scan over %lu tuples of %s\n", (unsigned long)cardinality, handle->rel->name);
+		return;
+	}
+
+	nwords = GET_CURSOR_DATA_ARR_SIZE(cardinality);
+	bitmap = (uint32_t *)malloc(nwords * sizeof(uint32_t));
+	if (bitmap == NULL) {
+		DB_LOG_E("DB: Failed to allocate the plan bitmap, falling back to a full scan\n");
+		return;
+	}
+
+	scratch = NULL;
+	if (nchosen > 1) {
+		scratch = (uint32_t *)malloc(nwords * sizeof(uint32_t));
+		if (scratch == NULL) {
+			nchosen = 1;
+		}
+	}
+
+	nused = 0;
+	for (n = 0; n < nchosen; n++) {
+		target = nused == 0 ? bitmap : scratch;
+		if (DB_ERROR(plan_scan_index(&cands[n], target, nwords, cardinality))) {
+			DB_LOG_D("DB: Dropped index on \"%s\" from the plan\n", cands[n].index->attr->name);
+			continue;
+		}
+		if (nused > 0) {
+			for (i = 0; i < nwords; i++) {
+				bitmap[i] &= scratch[i];
+			}
+		}
+		nused++;
+	}
+
+	if (scratch != NULL) {
+		free(scratch);
+	}
+
+	if (nused == 0) {
+		free(bitmap);
+		return;
+	}
+
+	DB_LOG_D("DB: Intersected %d index(es), expecting about %lu of %lu tuples\n", nused, (unsigned long)rows, (unsigned long)cardinality);
+
+	handle->plan_bitmap = bitmap;
+	handle->plan_size = cardinality;
+	handle->flags |= DB_HANDLE_FLAG_PLAN_BITMAP;
+}
+
+/* Return the next tuple id in the plan bitmap after handle->tuple_id. */
+tuple_id_t planner_next(db_handle_t *handle)
+{
+	tuple_id_t tuple_id;
+	uint32_t word;
+
+	tuple_id = handle->tuple_id + 1;
+	while (tuple_id < handle->plan_size) {
+		word = handle->plan_bitmap[GET_INDEX(tuple_id)] >> GET_POS(tuple_id);
+		if (word == 0) {
+			tuple_id = (GET_INDEX(tuple_id) + 1) * (sizeof(uint32_t) * 8);
+			continue;
+		}
+		while (!(word & 1)) {
+			word >>= 1;
+			tuple_id++;
+		}
+		return tuple_id;
+	}
+
+	return INVALID_TUPLE;
+}
+
+void planner_release(db_handle_t *handle)
+{
+	if (handle->plan_bitmap != NULL) {
+		free(handle->plan_bitmap);
+		handle->plan_bitmap = NULL;
+	}
+	handle->plan_size = 0;
+	handle->flags &= ~DB_HANDLE_FLAG_PLAN_BITMAP;
+}
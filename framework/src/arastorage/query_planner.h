@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef QUERY_PLANNER_H
+#define QUERY_PLANNER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include "result.h"
+
+/****************************************************************************
+* Global Function Prototypes
+****************************************************************************/
+void planner_build(db_handle_t *handle);
+tuple_id_t planner_next(db_handle_t *handle);
+void planner_release(db_handle_t *handle);
+
+#endif							/* QUERY_PLANNER_H */
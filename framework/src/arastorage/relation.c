@@ -68,6 +68,7 @@
 #include "list.h"
 #include "aql.h"
 #include "relation.h"
+#include "query_planner.h"
 
 /****************************************************************************
 * Global Function Prototypes
@@ -315,6 +316,36 @@ relation_t *relation_create(char *name, db_direction_t dir)
 	return NULL;
 }
 
+/*
+ * Create a memory-only relation which is private to one query. It is
+ * neither registered in the relation list nor backed by storage, so it
+ * must be freed with relation_destroy_transient.
+ */
+relation_t *relation_create_transient(char *name)
+{
+	relation_t *rel;
+
+	rel = relation_allocate();
+	if (rel == NULL) {
+		return NULL;
+	}
+
+	rel->cardinality = 0;
+	rel->dir = DB_MEMORY;
+	rel->references = 1;
+	strncpy(rel->name, name, sizeof(rel->name) - 1);
+	rel->name[sizeof(rel->name) - 1] = '\0';
+
+	return rel;
+}
+
+void relation_destroy_transient(relation_t *rel)
+{
+	if (rel != NULL) {
+		relation_free(rel);
+	}
+}
+
 db_result_t relation_rename(char *old_name, char *new_name)
 {
 	DB_LOG_D("old_name is %s, new_name is %s\n", old_name, new_name);
@@ -510,8 +541,21 @@ db_result_t relation_remove(relation_t *rel, int remove_tuples)
 
 db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
 {
-	attribute_t *attr;
 	unsigned char record[rel->row_length];
+	db_result_t result;
+
+	result = relation_build_row(rel, values, record);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+
+	return relation_insert_row(rel, record);
+}
+
+/* Convert the values of a new tuple into the physical row representation. */
+db_result_t relation_build_row(relation_t *rel, attribute_value_t *values, unsigned char *record)
+{
+	attribute_t *attr;
 	unsigned char *ptr;
 	attribute_value_t *value;
 	db_result_t result;
@@ -563,22 +607,132 @@ db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
 			DB_LOG_V(", ");
 		}
 #endif              /* DEBUG */
+		ptr += attr->element_size;
+		attr = attr->next;
+		value++;
+	}
+
+	DB_LOG_V(")\n");
+
+	return DB_OK;
+}
+
+/* Remove the keys of a row from the indexes of the attributes before 'last',
+   or of all attributes if 'last' is NULL. */
+static void relation_unindex_row(relation_t *rel, unsigned char *record, tuple_id_t tuple_id, attribute_t *last)
+{
+	attribute_t *attr;
+	attribute_value_t value;
+	unsigned char *ptr;
+
+	ptr = record;
+	for (attr = list_head(rel->attributes); attr != last; attr = attr->next) {
+		if (attr->index != NULL && !(attr->flags & ATTRIBUTE_FLAG_INVALID) && DB_SUCCESS(db_phy_to_value(&value, attr, ptr))) {
+			if (DB_ERROR(index_delete(attr->index, &value, tuple_id))) {
+				DB_LOG_E("DB: Failed to remove a key of tuple %lu from %s.%s\n", (unsigned long)tuple_id, rel->name, attr->name);
+			}
+		}
+		ptr += attr->element_size;
+	}
+}
+
+/* Add the keys of a row to the indexes of the relation. On failure the
+   keys added before are removed again.
+
+   With 'recover', keys which are already indexed for the tuple are skipped,
+   so that a WAL replay can run again over rows which were partly applied.
+   Nothing is removed on failure then, as the log is kept and replayed. */
+static db_result_t relation_index_row(relation_t *rel, unsigned char *record, tuple_id_t tuple_id, uint8_t recover)
+{
+	attribute_t *attr;
+	attribute_value_t value;
+	unsigned char *ptr;
+	db_result_t result;
+
+	result = DB_OK;
+	ptr = record;
+	for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next) {
 		if (attr->index == NULL) {
 			index_load(rel, attr);
 		}
-		ptr += attr->element_size;
-		if (attr->index != NULL) {
-			if (DB_ERROR(index_insert(attr->index, value, rel->next_row))) {
-				return DB_INDEX_ERROR;
+		if (attr->index != NULL && !(attr->flags & ATTRIBUTE_FLAG_INVALID)) {
+			if (DB_ERROR(db_phy_to_value(&value, attr, ptr))) {
+				result = DB_TYPE_ERROR;
+				break;
+			}
+			if (recover && ((index_t *)attr->index)->type != INDEX_INLINE && index_has_tuple(attr->index, &value, tuple_id)) {
+				ptr += attr->element_size;
+				continue;
+			}
+			if (DB_ERROR(index_insert(attr->index, &value, tuple_id))) {
+				result = DB_INDEX_ERROR;
+				break;
 			}
 		}
-		attr = attr->next;
-		value++;
+		ptr += attr->element_size;
 	}
 
-	DB_LOG_V(")\n");
+	if (DB_ERROR(result) && !recover) {
+		relation_unindex_row(rel, record, tuple_id, attr);
+	}
+
+	return result;
+}
+
+static db_result_t relation_store_row(relation_t *rel, unsigned char *record, tuple_id_t tuple_id, uint8_t recover)
+{
+	db_result_t result;
+
+	/* The keys are added first, as a stored row can not be removed again
+	   if indexing it fails. Keys of a row which is not stored yet are
+	   ignored by queries, which stop at the relation cardinality. */
+	result = relation_index_row(rel, record, tuple_id, recover);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+
+	result = storage_put_row(rel, record, FALSE);
+	if (DB_ERROR(result) && !recover) {
+		relation_unindex_row(rel, record, tuple_id, NULL);
+	}
+
+	return result;
+}
+
+/* Insert a row which is already in the physical storage representation,
+   and add its keys to the indexes of the relation. */
+db_result_t relation_insert_row(relation_t *rel, unsigned char *record)
+{
+	tuple_id_t tuple_id;
+
+	tuple_id = relation_cardinality(rel);
+	if (tuple_id == INVALID_TUPLE) {
+		return DB_STORAGE_ERROR;
+	}
+
+	return relation_store_row(rel, record, tuple_id, FALSE);
+}
+
+/* Apply a logged row whose tuple id is known. A crash may have stopped an
+   earlier apply after the keys or after the row were stored, so the keys
+   which are missing are added and the row is stored only if it is not. */
+db_result_t relation_recover_row(relation_t *rel, unsigned char *record, tuple_id_t tuple_id)
+{
+	tuple_id_t cardinality;
+
+	cardinality = relation_cardinality(rel);
+	if (cardinality == INVALID_TUPLE) {
+		return DB_STORAGE_ERROR;
+	}
+	if (tuple_id < cardinality) {
+		return relation_index_row(rel, record, tuple_id, TRUE);
+	}
+	if (tuple_id != cardinality) {
+		DB_LOG_E("DB: Logged tuple %lu of %s is past the end of the relation\n", (unsigned long)tuple_id, rel->name);
+		return DB_STORAGE_ERROR;
+	}
 
-	return storage_put_row(rel, record, FALSE);
+	return relation_store_row(rel, record, tuple_id, TRUE);
 }
 
 /*
@@ -678,46 +832,6 @@ static db_result_t generate_attribute_map(source_dest_map_t *attr_map, unsigned
 	return DB_OK;
 }
 
-static void select_index(db_handle_t **handle)
-{
-	index_t *index;
-	attribute_t *attr;
-	operand_value_t min;
-	operand_value_t max;
-	attribute_value_t av_min;
-	attribute_value_t av_max;
-	long range;
-	unsigned long min_range;
-	index = NULL;
-	min_range = ULONG_MAX;
-
-	/* Find all indexed and derived attributes, and select the index of
-	   the attribute with the smallest range. */
-	attr = list_head((*handle)->rel->attributes);
-	while (attr != NULL) {
-		if (attr->index != NULL && !LVM_ERROR(lvm_get_derived_range((*handle)->lvm_instance, attr->name, &min, &max))) {
-			range = (unsigned long)max.l - (unsigned long)min.l;
-			DB_LOG_D("DB: The search range for attribute \"%s\" comprises %ld values\n", attr->name, range + 1);
-			if (range <= min_range) {
-				index = attr->index;
-				av_min.domain = av_max.domain = DOMAIN_INT;
-				VALUE_LONG(&av_min) = min.l;
-				VALUE_LONG(&av_max) = max.l;
-			}
-		}
-		attr = attr->next;
-	}
-
-	if (index != NULL) {
-		/* We found a suitable index; get an iterator for it. */
-		if (index_get_iterator(&((*handle)->index_iterator), index, &av_min, &av_max) == DB_OK) {
-			(*handle)->flags |= DB_HANDLE_FLAG_SEARCH_INDEX;
-		}
-	} else {
-		(*handle)->flags = DB_HANDLE_FLAG_INVALID;
-	}
-}
-
 static void relation_index_clear(relation_t *rel)
 {
 	char *filename;
@@ -751,7 +865,7 @@ static void relation_delete_index_item(db_handle_t **handle, unsigned char *row_
 	while (from_attr != NULL) {
 		if (from_attr->index != NULL) {
 			if (relation_get_value((*handle)->rel, from_attr, row_ptr, &index_key) == DB_OK) {
-				index_delete(from_attr->index, &index_key);
+				index_delete(from_attr->index, &index_key, INVALID_TUPLE);
 				if (update_index) { //update with new tuple_id
 					tuple_id = (*handle)->result_rel->cardinality - 1; //cardinality increased when storage_put_row
 					index_insert(from_attr->index, &index_key, tuple_id);
@@ -795,10 +909,13 @@ static db_result_t generate_selection_result(db_handle_t **handle, relation_t *r
 		return DB_IMPLEMENTATION_ERROR;
 	}
 
-	if ((*handle)->lvm_instance != NULL) {
-		/* Try to establish acceptable ranges for the attribute values. */
+	/* A removal reads every tuple anyway, as it copies the ones which do
+	   not match into the new relation, so only a selection is planned. */
+	if ((*handle)->lvm_instance != NULL && AQL_GET_EXEC_TYPE((*handle)->optype) == AQL_TYPE_SELECT) {
+		/* Try to establish acceptable ranges for the attribute values,
+		   and let the planner narrow the scan down with indexes. */
 		if (!LVM_ERROR(lvm_derive((*handle)->lvm_instance))) {
-			select_index(handle);
+			planner_build(*handle);
 		}
 	}
 
@@ -865,13 +982,11 @@ db_result_t relation_process_select(db_handle_t **handle, db_cursor_t *cursor)
 	attribute_count = (*handle)->result_rel->attribute_count;
 	attr_map_end = (*handle)->attr_map + attribute_count;
 
-	if ((*handle)->flags & DB_HANDLE_FLAG_SEARCH_INDEX) {
-		(*handle)->tuple_id = index_get_next(&((*handle)->index_iterator), TRUE);
+	if ((*handle)->flags & DB_HANDLE_FLAG_PLAN_BITMAP) {
+		/* Visit only the tuples left over by the index plan. */
+		(*handle)->tuple_id = planner_next(*handle);
 		if ((*handle)->tuple_id == INVALID_TUPLE) {
-			DB_LOG_E("DB: An attribute value could not be found in the index\n");
-			if ((*handle)->index_iterator.next_item_no == 0) {
-				return DB_INDEX_ERROR;
-			}
+			planner_release(*handle);
 			if ((*handle)->adt_flags & AQL_FLAG_AGGREGATE) {
 				result = DB_FINISHED;
 				goto processing_aggregation;
@@ -943,9 +1058,31 @@ db_result_t relation_process_select(db_handle_t **handle, db_cursor_t *cursor)
 				}
 			}
 		} else {
-			result = cursor_data_add(cursor, (*handle)->tuple_id);
-			if (DB_ERROR(result)) {
-				goto errout;
+			if ((*handle)->flags & DB_HANDLE_FLAG_STREAM) {
+				/* Hand the row over to the streaming cursor. */
+				cursor_stream_set_row(cursor, (*handle)->tuple_id, row);
+				result = DB_GOT_ROW;
+			} else {
+				result = cursor_data_add(cursor, (*handle)->tuple_id);
+				if (DB_ERROR(result)) {
+					goto errout;
+				}
+			}
+
+			if ((*handle)->limit > 0 && (*handle)->current_row >= (*handle)->limit) {
+				/* LIMIT reached, the remaining tuples need not be read. */
+				planner_release(*handle);
+				free(row);
+				if (result == DB_GOT_ROW) {
+					(*handle)->flags &= ~DB_HANDLE_FLAG_PROCESSING;
+					return DB_GOT_ROW;
+				}
+				return DB_FINISHED;
+			}
+
+			if (result == DB_GOT_ROW) {
+				free(row);
+				return DB_GOT_ROW;
 			}
 		}
 	}
@@ -972,6 +1109,19 @@ processing_aggregation:
 	(*handle)->current_row = 0;
 	(*handle)->adt_flags &= ~AQL_FLAG_AGGREGATE; /* Stop the aggregation. */
 
+	if ((*handle)->flags & DB_HANDLE_FLAG_STREAM) {
+		/* The aggregated row is the only row of the stream. */
+		cursor->total_rows = 1;
+		cursor->current_storage_row = 0;
+		cursor->current_cursor_row = 0;
+		cursor->cursor_rows = 1;
+		(*handle)->flags &= ~DB_HANDLE_FLAG_PROCESSING;
+		if (row != NULL) {
+			free(row);
+		}
+		return DB_GOT_ROW;
+	}
+
 	result = cursor_data_add(cursor, (*handle)->current_row);
 	if (DB_ERROR(result)) {
 		goto errout;
@@ -1182,6 +1332,7 @@ db_result_t relation_select(db_handle_t **handle, relation_t *rel, void *adt_ptr
 	DB_LOG_D("relation_select... optype = %d\n", (*handle)->optype);
 	(*handle)->adt_flags = AQL_GET_FLAGS(adt);
 	(*handle)->lvm_instance = (lvm_instance_t *)adt->lvm_instance;
+	(*handle)->limit = adt->tuple_limit;
 
 	if (AQL_GET_FLAGS(adt) & AQL_FLAG_ASSIGN) {
 		name = adt->relations[0];
@@ -1191,10 +1342,16 @@ db_result_t relation_select(db_handle_t **handle, relation_t *rel, void *adt_ptr
 		dir = DB_MEMORY;
 	}
 
-	res_rel = relation_load(name);
-	relation_remove(res_rel, 1);
-	relation_create(name, dir);
-	(*handle)->result_rel = relation_load(name);
+	if (((*handle)->flags & DB_HANDLE_FLAG_STREAM) && dir == DB_MEMORY) {
+		/* A streaming cursor reads rows straight from the relation, so
+		   the result relation only describes the projection. */
+		(*handle)->result_rel = relation_create_transient(name);
+	} else {
+		res_rel = relation_load(name);
+		relation_remove(res_rel, 1);
+		relation_create(name, dir);
+		(*handle)->result_rel = relation_load(name);
+	}
 
 	if ((*handle)->result_rel == NULL) {
 		DB_LOG_E("DB: Failed to load a relation for the query result\n");
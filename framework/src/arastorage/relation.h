@@ -97,7 +97,7 @@
 #define IS_INVALID_CURSOR_ROW(a) ((a) == NULL || ((a)->current_cursor_row >= (a)->cursor_rows))
 
 /* check current storage row is valid or invalid*/
-#define IS_INVALID_STORAGE_ROW(a) ((a) == NULL || ((a)->current_storage_row >= (a)->total_rows) || (a)->current_storage_row >= DB_CURSOR_RESULT_ENTRY)
+#define IS_INVALID_STORAGE_ROW(a) ((a) == NULL || ((a)->current_storage_row >= (a)->total_rows) || ((a)->stream == NULL && (a)->current_storage_row >= DB_CURSOR_RESULT_ENTRY))
 
 #define RELATION_HAS_TUPLES(rel) ((rel)->tuple_storage >= 0)
 
@@ -159,6 +159,8 @@ struct _db_cursor_s {
 	attribute_id_t attribute_count;
 	size_t storage_row_length;
 	uint32_t *row_arr;
+	db_handle_t *stream;			/* Query handle of a streaming cursor */
+	unsigned char *stream_row;		/* Current row of a streaming cursor */
 	unsigned char tuple[DB_MAX_ELEMENT_SIZE + 1];
 	char name[TUPLE_NAME_LENGTH + 1];
 	char rel_name[RELATION_NAME_LENGTH + 1];
@@ -173,6 +175,8 @@ db_result_t cursor_init(db_cursor_t **cursor, relation_t *rel);
 db_result_t cursor_load(db_cursor_t **target, db_cursor_t *src);
 db_result_t cursor_data_add(db_cursor_t *cursor, tuple_id_t tuple_id);
 db_result_t cursor_deinit(db_cursor_t *cursor);
+db_cursor_t *cursor_stream_open(db_handle_t *handle);
+void cursor_stream_set_row(db_cursor_t *cursor, tuple_id_t tuple_id, unsigned char *row);
 
 
 /* API for relations. */
@@ -180,10 +184,14 @@ db_result_t relation_init(void);
 db_result_t relation_deinit(void);
 db_result_t relation_process_remove(db_handle_t **, db_cursor_t *);
 db_result_t relation_process_select(db_handle_t **, db_cursor_t *);
+db_result_t relation_process(db_handle_t **, db_cursor_t *);
 db_cursor_t *relation_process_result(db_handle_t *);
+int db_processing_status(db_handle_t *);
 relation_t *relation_load(char *);
 db_result_t relation_release(relation_t *);
 relation_t *relation_create(char *, db_direction_t);
+relation_t *relation_create_transient(char *);
+void relation_destroy_transient(relation_t *);
 db_result_t relation_rename(char *, char *);
 attribute_t *relation_attribute_add(relation_t *, db_direction_t, char *, domain_t, size_t);
 attribute_t *relation_attribute_get(relation_t *, char *);
@@ -192,6 +200,9 @@ db_result_t relation_attribute_remove(relation_t *, char *);
 db_result_t relation_set_primary_key(relation_t *, char *);
 db_result_t relation_remove(relation_t *, int);
 db_result_t relation_insert(relation_t *, attribute_value_t *);
+db_result_t relation_build_row(relation_t *, attribute_value_t *, unsigned char *);
+db_result_t relation_insert_row(relation_t *, unsigned char *);
+db_result_t relation_recover_row(relation_t *, unsigned char *, tuple_id_t);
 db_result_t relation_select(db_handle_t **, relation_t *, void *);
 tuple_id_t relation_cardinality(relation_t *);
 
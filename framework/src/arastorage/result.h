@@ -69,8 +69,9 @@
 #define RESULT_TUPLE_SIZE(handle)       (handle).rel->row_length
 
 #define DB_HANDLE_FLAG_INDEX_STEP       0x01
-#define DB_HANDLE_FLAG_SEARCH_INDEX     0x02
+#define DB_HANDLE_FLAG_PLAN_BITMAP      0x02
 #define DB_HANDLE_FLAG_PROCESSING       0x04
+#define DB_HANDLE_FLAG_STREAM           0x08
 #define DB_HANDLE_FLAG_INVALID          0x00
 
 /****************************************************************************
@@ -95,9 +96,11 @@ struct source_dest_map_s {
 typedef struct source_dest_map_s source_dest_map_t;
 
 struct _db_handle_s {
-	index_iterator_t index_iterator;
 	tuple_id_t tuple_id;
 	tuple_id_t current_row;
+	tuple_id_t limit;
+	tuple_id_t plan_size;
+	uint32_t *plan_bitmap;
 	relation_t *rel;
 	relation_t *result_rel;
 	tuple_t tuple;
@@ -28,6 +28,7 @@
 #endif
 #include "db_debug.h"
 #include "storage.h"
+#include "storage_cache.h"
 
 /****************************************************************************
 * Public Functions
@@ -48,14 +49,28 @@ db_storage_id_t storage_open(const char *filename, int oflag)
 		return INVALID_STORAGE_ID;
 	}
 	snprintf(rel_path, DB_MAX_FILENAME_LENGTH, "%s%s\0", CONFIG_MOUNT_POINT, filename);
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	if (oflag & O_TRUNC) {
+		storage_cache_invalidate(filename);
+	}
+#endif
 	fd = open(rel_path, oflag);
 	free(rel_path);
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	if (fd >= 0 && DB_ERROR(storage_cache_bind(fd, filename))) {
+		close(fd);
+		fd = INVALID_STORAGE_ID;
+	}
+#endif
 	return fd;
 }
 
 /* It mapped with close function in specific file system */
 db_storage_id_t storage_close(db_storage_id_t fd)
 {
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	storage_cache_unbind(fd);
+#endif
 	return close(fd);
 }
 
@@ -69,6 +84,9 @@ db_result_t storage_remove(const char *filename)
 		return DB_STORAGE_ERROR;
 	}
 	snprintf(rel_path, DB_MAX_FILENAME_LENGTH, "%s%s\0", CONFIG_MOUNT_POINT, filename);
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	storage_cache_invalidate(filename);
+#endif
 	if (unlink(rel_path) == OK) {
 		res = DB_OK;
 	}
@@ -95,6 +113,10 @@ db_result_t storage_rename(const char *old_name, const char *new_name)
 
 	snprintf(old_path, DB_MAX_FILENAME_LENGTH, "%s%s\0", CONFIG_MOUNT_POINT, old_name);
 	snprintf(new_path, DB_MAX_FILENAME_LENGTH, "%s%s\0", CONFIG_MOUNT_POINT, new_name);
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	storage_cache_invalidate(old_name);
+	storage_cache_invalidate(new_name);
+#endif
 
 	if (rename(old_path, new_path) == OK) {
 		res = DB_OK;
@@ -107,19 +129,59 @@ db_result_t storage_rename(const char *old_name, const char *new_name)
 /* It mapped with seek function in specific file system */
 off_t storage_seek(db_storage_id_t fd, unsigned long offset, int whence)
 {
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	if (whence == SEEK_END) {
+		/* Cached writes beyond the end of the file change its size. */
+		storage_cache_sync(fd);
+	}
+#endif
 	return lseek(fd, offset, whence);
 }
 
 /* It mapped with read function in specific file system */
 ssize_t storage_read(db_storage_id_t fd, void *buffer, unsigned length)
 {
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	storage_cache_sync(fd);
+#endif
 	return read(fd, buffer, length);
 }
 
 /* It mapped with write function in specific file system */
 ssize_t storage_write(db_storage_id_t fd, void *buffer, unsigned length)
 {
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	ssize_t r;
+	off_t end;
+
+	storage_cache_sync(fd);
+	r = write(fd, buffer, length);
+	if (r > 0) {
+		/* The descriptor may append, so locate the data from where it ended. */
+		end = lseek(fd, 0, SEEK_CUR);
+		if (end != (off_t)-1) {
+			storage_cache_update(fd, buffer, end - r, r);
+		}
+	}
+	return r;
+#else
 	return write(fd, buffer, length);
+#endif
+}
+
+/* It mapped with fsync function in specific file system */
+db_result_t storage_sync(db_storage_id_t fd)
+{
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	/* Data written through the page cache is not in the file yet. */
+	if (DB_ERROR(storage_cache_sync(fd))) {
+		return DB_STORAGE_ERROR;
+	}
+#endif
+	if (fsync(fd) != OK) {
+		return DB_STORAGE_ERROR;
+	}
+	return DB_OK;
 }
 
 #ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
@@ -0,0 +1,614 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "db_debug.h"
+#include "db_options.h"
+#include "storage_cache.h"
+
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+
+/****************************************************************************
+* Private Type Definitions
+****************************************************************************/
+/*
+ * A cached page of a database file. Pages are looked up by file name so
+ * that they survive the frequent open/close of the same file. The bytes in
+ * [0, valid) mirror the file, and [dirty_start, dirty_end) is not written
+ * back yet through the descriptor which modified it.
+ */
+struct cache_page_s {
+	char name[DB_MAX_FILENAME_LENGTH];	/* Empty if the page is free */
+	unsigned long index;			/* Page number in the file */
+	uint32_t used;				/* LRU stamp */
+	uint16_t valid;
+	uint16_t dirty_start;
+	uint16_t dirty_end;			/* 0 if the page is clean */
+	db_storage_id_t owner;
+	unsigned char *data;
+};
+
+/* An open descriptor of a database file. */
+struct cache_file_s {
+	db_storage_id_t fd;			/* -1 if the slot is free */
+	unsigned long next_page;		/* Page which continues a sequential read */
+	char name[DB_MAX_FILENAME_LENGTH];
+};
+
+struct storage_cache_s {
+	struct cache_page_s pages[DB_PAGE_CACHE_PAGES];
+	struct cache_file_s files[DB_PAGE_CACHE_FILES];
+	unsigned char *memory;
+	uint32_t clock;
+	db_cache_stats_t stats;
+	pthread_mutex_t lock;
+};
+
+/****************************************************************************
+* Private Variables
+****************************************************************************/
+static struct storage_cache_s g_cache;
+
+/****************************************************************************
+* Private Functions
+****************************************************************************/
+static struct cache_file_s *cache_file(db_storage_id_t fd)
+{
+	int i;
+
+	if (g_cache.memory == NULL || fd < 0) {
+		return NULL;
+	}
+	for (i = 0; i < DB_PAGE_CACHE_FILES; i++) {
+		if (g_cache.files[i].fd == fd) {
+			return &g_cache.files[i];
+		}
+	}
+	return NULL;
+}
+
+static struct cache_page_s *cache_lookup(const char *name, unsigned long index)
+{
+	int i;
+
+	for (i = 0; i < DB_PAGE_CACHE_PAGES; i++) {
+		if (g_cache.pages[i].index == index && strncmp(g_cache.pages[i].name, name, DB_MAX_FILENAME_LENGTH) == 0) {
+			return &g_cache.pages[i];
+		}
+	}
+	return NULL;
+}
+
+/* Access the file at an offset without moving the position of the descriptor,
+   which the callers of storage_read() and storage_write() rely on. */
+static ssize_t cache_raw_io(db_storage_id_t fd, void *buffer, unsigned long offset, size_t length, bool write_io)
+{
+	off_t pos;
+	ssize_t r;
+
+	pos = lseek(fd, 0, SEEK_CUR);
+	if (pos == (off_t)-1 || lseek(fd, offset, SEEK_SET) == (off_t)-1) {
+		return -1;
+	}
+	if (write_io) {
+		r = write(fd, buffer, length);
+	} else {
+		r = read(fd, buffer, length);
+	}
+	lseek(fd, pos, SEEK_SET);
+
+	return r;
+}
+
+static db_result_t cache_writeback(struct cache_page_s *page)
+{
+	size_t length;
+
+	if (page->dirty_end == 0) {
+		return DB_OK;
+	}
+
+	length = page->dirty_end - page->dirty_start;
+	if (cache_raw_io(page->owner, page->data + page->dirty_start, page->index * DB_PAGE_SIZE + page->dirty_start, length, true) != length) {
+		DB_LOG_E("DB: Failed to write back page %lu of %s\n", page->index, page->name);
+		return DB_STORAGE_ERROR;
+	}
+	page->dirty_start = 0;
+	page->dirty_end = 0;
+	g_cache.stats.writebacks++;
+
+	return DB_OK;
+}
+
+static void cache_drop(struct cache_page_s *page)
+{
+	page->name[0] = '\0';
+	page->dirty_start = 0;
+	page->dirty_end = 0;
+}
+
+/* Take a free page, or evict the least recently used one other than 'keep'.
+   A page which fails to be written back keeps its data and is skipped. */
+static struct cache_page_s *cache_victim(struct cache_page_s *keep)
+{
+	struct cache_page_s *victim;
+	uint32_t floor;
+	int i;
+
+	/* LRU stamps of used pages are unique, so skipping the pages older
+	   than a failed victim tries every page at most once. */
+	floor = 0;
+	for (;;) {
+		victim = NULL;
+		for (i = 0; i < DB_PAGE_CACHE_PAGES; i++) {
+			if (&g_cache.pages[i] == keep) {
+				continue;
+			}
+			if (g_cache.pages[i].name[0] == '\0') {
+				return &g_cache.pages[i];
+			}
+			if (g_cache.pages[i].used >= floor && (victim == NULL || g_cache.pages[i].used < victim->used)) {
+				victim = &g_cache.pages[i];
+			}
+		}
+		if (victim == NULL) {
+			return NULL;
+		}
+		if (DB_SUCCESS(cache_writeback(victim))) {
+			break;
+		}
+		floor = victim->used + 1;
+	}
+	cache_drop(victim);
+
+	return victim;
+}
+
+/* Read a page into the cache. Returns NULL if no page can be reused,
+   then the caller accesses the file directly. */
+static struct cache_page_s *cache_fill(struct cache_file_s *file, unsigned long index, struct cache_page_s *keep)
+{
+	struct cache_page_s *page;
+	ssize_t r;
+
+	page = cache_victim(keep);
+	if (page == NULL) {
+		return NULL;
+	}
+
+	r = cache_raw_io(file->fd, page->data, index * DB_PAGE_SIZE, DB_PAGE_SIZE, false);
+	if (r < 0) {
+		return NULL;
+	}
+
+	memcpy(page->name, file->name, DB_MAX_FILENAME_LENGTH);
+	page->index = index;
+	page->valid = (uint16_t)r;
+	page->used = ++g_cache.clock;
+
+	return page;
+}
+
+/* Read ahead the pages following a sequentially read page, which must
+   stay in the cache for the caller. */
+static void cache_prefetch(struct cache_file_s *file, struct cache_page_s *current)
+{
+	struct cache_page_s *page;
+	unsigned long index;
+	unsigned long last;
+
+	index = current->index;
+	for (last = index + DB_PAGE_PREFETCH; index < last; index++) {
+		if (cache_lookup(file->name, index + 1) != NULL) {
+			continue;
+		}
+		page = cache_fill(file, index + 1, current);
+		if (page == NULL) {
+			return;
+		}
+		g_cache.stats.prefetches++;
+		if (page->valid < DB_PAGE_SIZE) {
+			/* Reached the end of the file. */
+			return;
+		}
+	}
+}
+
+/****************************************************************************
+* Public Functions
+****************************************************************************/
+db_result_t storage_cache_init(void)
+{
+	int i;
+
+	if (g_cache.memory != NULL) {
+		return DB_OK;
+	}
+
+	g_cache.memory = (unsigned char *)malloc(DB_PAGE_CACHE_PAGES * DB_PAGE_SIZE);
+	if (g_cache.memory == NULL) {
+		DB_LOG_E("DB: Failed to allocate page cache\n");
+		return DB_ALLOCATION_ERROR;
+	}
+
+	for (i = 0; i < DB_PAGE_CACHE_PAGES; i++) {
+		cache_drop(&g_cache.pages[i]);
+		g_cache.pages[i].used = 0;
+		g_cache.pages[i].data = g_cache.memory + i * DB_PAGE_SIZE;
+	}
+	for (i = 0; i < DB_PAGE_CACHE_FILES; i++) {
+		g_cache.files[i].fd = -1;
+	}
+	g_cache.clock = 0;
+	memset(&g_cache.stats, 0, sizeof(g_cache.stats));
+	pthread_mutex_init(&g_cache.lock, NULL);
+
+	return DB_OK;
+}
+
+void storage_cache_deinit(void)
+{
+	int i;
+
+	if (g_cache.memory == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	for (i = 0; i < DB_PAGE_CACHE_PAGES; i++) {
+		cache_writeback(&g_cache.pages[i]);
+	}
+	for (i = 0; i < DB_PAGE_CACHE_FILES; i++) {
+		g_cache.files[i].fd = -1;
+	}
+	free(g_cache.memory);
+	g_cache.memory = NULL;
+	pthread_mutex_unlock(&g_cache.lock);
+	pthread_mutex_destroy(&g_cache.lock);
+}
+
+/* Every open descriptor must be bound. Pages are shared by filename, so
+   accessing a file around the cache through one descriptor would miss or
+   leave stale the pages of another. */
+db_result_t storage_cache_bind(db_storage_id_t fd, const char *filename)
+{
+	int i;
+
+	if (g_cache.memory == NULL) {
+		return DB_OK;
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	for (i = 0; i < DB_PAGE_CACHE_FILES; i++) {
+		if (g_cache.files[i].fd < 0) {
+			g_cache.files[i].fd = fd;
+			g_cache.files[i].next_page = 0;
+			strncpy(g_cache.files[i].name, filename, DB_MAX_FILENAME_LENGTH - 1);
+			g_cache.files[i].name[DB_MAX_FILENAME_LENGTH - 1] = '\0';
+			break;
+		}
+	}
+	pthread_mutex_unlock(&g_cache.lock);
+
+	if (i == DB_PAGE_CACHE_FILES) {
+		DB_LOG_E("DB: Failed to open %s, too many open files\n", filename);
+		return DB_LIMIT_ERROR;
+	}
+
+	return DB_OK;
+}
+
+/* Write back the pages modified through a descriptor before it is closed. */
+void storage_cache_unbind(db_storage_id_t fd)
+{
+	struct cache_file_s *file;
+	int i;
+
+	if (g_cache.memory == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	file = cache_file(fd);
+	if (file != NULL) {
+		for (i = 0; i < DB_PAGE_CACHE_PAGES; i++) {
+			if (g_cache.pages[i].dirty_end != 0 && g_cache.pages[i].owner == fd && DB_ERROR(cache_writeback(&g_cache.pages[i]))) {
+				/* Keeping the page would write it through a stale descriptor. */
+				cache_drop(&g_cache.pages[i]);
+			}
+		}
+		file->fd = -1;
+	}
+	pthread_mutex_unlock(&g_cache.lock);
+}
+
+/* Write back every modified page of the file, so that a plain read
+   or the size of the file reflects them. */
+db_result_t storage_cache_sync(db_storage_id_t fd)
+{
+	struct cache_file_s *file;
+	db_result_t res;
+	int i;
+
+	if (g_cache.memory == NULL) {
+		return DB_OK;
+	}
+
+	res = DB_OK;
+	pthread_mutex_lock(&g_cache.lock);
+	file = cache_file(fd);
+	if (file != NULL) {
+		for (i = 0; i < DB_PAGE_CACHE_PAGES; i++) {
+			if (g_cache.pages[i].dirty_end != 0 && strncmp(g_cache.pages[i].name, file->name, DB_MAX_FILENAME_LENGTH) == 0 && DB_ERROR(cache_writeback(&g_cache.pages[i]))) {
+				res = DB_STORAGE_ERROR;
+			}
+		}
+	}
+	pthread_mutex_unlock(&g_cache.lock);
+
+	return res;
+}
+
+/* Apply data written around the cache to the cached pages of the file. */
+void storage_cache_update(db_storage_id_t fd, const void *buffer, off_t offset, size_t length)
+{
+	struct cache_file_s *file;
+	struct cache_page_s *page;
+	const unsigned char *src;
+	unsigned long index;
+	size_t in_page;
+	size_t n;
+
+	if (g_cache.memory == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	file = cache_file(fd);
+	src = (const unsigned char *)buffer;
+	while (file != NULL && length > 0) {
+		index = offset / DB_PAGE_SIZE;
+		in_page = offset % DB_PAGE_SIZE;
+		n = DB_PAGE_SIZE - in_page;
+		if (n > length) {
+			n = length;
+		}
+
+		page = cache_lookup(file->name, index);
+		if (page != NULL) {
+			if (in_page > page->valid) {
+				/* The page cannot describe a hole in the file. */
+				if (DB_ERROR(cache_writeback(page))) {
+					DB_LOG_E("DB: Dropping page %lu of %s\n", index, page->name);
+				}
+				cache_drop(page);
+			} else {
+				memcpy(page->data + in_page, src, n);
+				if (in_page + n > page->valid) {
+					page->valid = in_page + n;
+				}
+			}
+		}
+
+		src += n;
+		offset += n;
+		length -= n;
+	}
+	pthread_mutex_unlock(&g_cache.lock);
+}
+
+/* Forget the pages of a file which is removed, truncated or renamed. */
+void storage_cache_invalidate(const char *filename)
+{
+	int i;
+
+	if (g_cache.memory == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	for (i = 0; i < DB_PAGE_CACHE_PAGES; i++) {
+		if (strncmp(g_cache.pages[i].name, filename, DB_MAX_FILENAME_LENGTH) == 0) {
+			cache_drop(&g_cache.pages[i]);
+		}
+	}
+	pthread_mutex_unlock(&g_cache.lock);
+}
+
+ssize_t storage_cache_read(db_storage_id_t fd, void *buffer, unsigned long offset, unsigned length)
+{
+	struct cache_file_s *file;
+	struct cache_page_s *page;
+	unsigned char *dst;
+	unsigned long index;
+	size_t in_page;
+	size_t n;
+	ssize_t total;
+	ssize_t r;
+
+	if (g_cache.memory == NULL) {
+		return cache_raw_io(fd, buffer, offset, length, false);
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	file = cache_file(fd);
+	if (file == NULL) {
+		pthread_mutex_unlock(&g_cache.lock);
+		return cache_raw_io(fd, buffer, offset, length, false);
+	}
+
+	dst = (unsigned char *)buffer;
+	total = 0;
+	while (length > 0) {
+		index = offset / DB_PAGE_SIZE;
+		in_page = offset % DB_PAGE_SIZE;
+
+		page = cache_lookup(file->name, index);
+		if (page != NULL) {
+			g_cache.stats.hits++;
+			page->used = ++g_cache.clock;
+		} else {
+			g_cache.stats.misses++;
+			page = cache_fill(file, index, NULL);
+			if (page == NULL) {
+				/* The page is not cached, so the file is up to date for it. */
+				n = DB_PAGE_SIZE - in_page;
+				if (n > length) {
+					n = length;
+				}
+				r = cache_raw_io(fd, dst, offset, n, false);
+				if (r <= 0) {
+					total = total > 0 ? total : r;
+					break;
+				}
+				dst += r;
+				offset += r;
+				length -= r;
+				total += r;
+				if (r < n) {
+					break;
+				}
+				continue;
+			}
+			if (DB_PAGE_PREFETCH > 0 && file->next_page == index && page->valid == DB_PAGE_SIZE) {
+				cache_prefetch(file, page);
+			}
+		}
+		file->next_page = index + 1;
+
+		if (in_page >= page->valid) {
+			/* End of the file. */
+			break;
+		}
+		n = page->valid - in_page;
+		if (n > length) {
+			n = length;
+		}
+		memcpy(dst, page->data + in_page, n);
+
+		dst += n;
+		offset += n;
+		length -= n;
+		total += n;
+		if (page->valid < DB_PAGE_SIZE) {
+			break;
+		}
+	}
+	pthread_mutex_unlock(&g_cache.lock);
+
+	return total;
+}
+
+ssize_t storage_cache_write(db_storage_id_t fd, const void *buffer, unsigned long offset, unsigned length)
+{
+	struct cache_file_s *file;
+	struct cache_page_s *page;
+	const unsigned char *src;
+	unsigned long index;
+	size_t in_page;
+	size_t n;
+	ssize_t total;
+
+	if (g_cache.memory == NULL) {
+		return cache_raw_io(fd, (void *)buffer, offset, length, true);
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	file = cache_file(fd);
+	if (file == NULL) {
+		pthread_mutex_unlock(&g_cache.lock);
+		return cache_raw_io(fd, (void *)buffer, offset, length, true);
+	}
+
+	src = (const unsigned char *)buffer;
+	total = 0;
+	while (length > 0) {
+		index = offset / DB_PAGE_SIZE;
+		in_page = offset % DB_PAGE_SIZE;
+		n = DB_PAGE_SIZE - in_page;
+		if (n > length) {
+			n = length;
+		}
+
+		page = cache_lookup(file->name, index);
+		if (page == NULL) {
+			page = cache_fill(file, index, NULL);
+		}
+		if (page != NULL && (in_page > page->valid || (page->dirty_end != 0 && page->owner != fd))) {
+			/* A page holds the changes of one descriptor, and cannot describe
+			   a hole in the file. */
+			if (DB_ERROR(cache_writeback(page)) || in_page > page->valid) {
+				cache_drop(page);
+				page = NULL;
+			}
+		}
+
+		if (page == NULL) {
+			if (cache_raw_io(fd, (void *)src, offset, n, true) != n) {
+				total = total > 0 ? total : -1;
+				break;
+			}
+		} else {
+			memcpy(page->data + in_page, src, n);
+			if (page->dirty_end == 0) {
+				page->dirty_start = in_page;
+				page->dirty_end = in_page + n;
+			} else {
+				page->dirty_start = in_page < page->dirty_start ? in_page : page->dirty_start;
+				page->dirty_end = in_page + n > page->dirty_end ? in_page + n : page->dirty_end;
+			}
+			if (in_page + n > page->valid) {
+				page->valid = in_page + n;
+			}
+			page->owner = fd;
+			page->used = ++g_cache.clock;
+		}
+
+		src += n;
+		offset += n;
+		length -= n;
+		total += n;
+	}
+	pthread_mutex_unlock(&g_cache.lock);
+
+	return total;
+}
+
+void storage_cache_get_stats(db_cache_stats_t *stats)
+{
+	if (g_cache.memory == NULL) {
+		memset(stats, 0, sizeof(db_cache_stats_t));
+		return;
+	}
+
+	pthread_mutex_lock(&g_cache.lock);
+	memcpy(stats, &g_cache.stats, sizeof(db_cache_stats_t));
+	pthread_mutex_unlock(&g_cache.lock);
+}
+
+#endif							/* CONFIG_ARASTORAGE_PAGE_CACHE */
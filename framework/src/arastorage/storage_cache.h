@@ -0,0 +1,45 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef STORAGE_CACHE_H
+#define STORAGE_CACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <sys/types.h>
+
+#include <arastorage/arastorage.h>
+
+/****************************************************************************
+* Global Function Prototypes
+****************************************************************************/
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+db_result_t storage_cache_init(void);
+void storage_cache_deinit(void);
+db_result_t storage_cache_bind(db_storage_id_t fd, const char *filename);
+void storage_cache_unbind(db_storage_id_t fd);
+db_result_t storage_cache_sync(db_storage_id_t fd);
+void storage_cache_update(db_storage_id_t fd, const void *buffer, off_t offset, size_t length);
+void storage_cache_invalidate(const char *filename);
+ssize_t storage_cache_read(db_storage_id_t fd, void *buffer, unsigned long offset, unsigned length);
+ssize_t storage_cache_write(db_storage_id_t fd, const void *buffer, unsigned long offset, unsigned length);
+void storage_cache_get_stats(db_cache_stats_t *stats);
+#endif
+
+#endif							/* STORAGE_CACHE_H */
@@ -67,6 +67,7 @@
 #include "db_debug.h"
 #include "random.h"
 #include "storage.h"
+#include "storage_cache.h"
 
 /****************************************************************************
 * Private Types
@@ -510,11 +511,15 @@ db_result_t storage_get_row(relation_t *rel, tuple_id_t *tuple_id, storage_row_t
 		return DB_FINISHED;
 	}
 
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	r = storage_cache_read(rel->tuple_storage, row, *tuple_id * rel->row_length, rel->row_length);
+#else
 	if (storage_seek(rel->tuple_storage, *tuple_id * rel->row_length, SEEK_SET) == (off_t)-1) {
 		return DB_STORAGE_ERROR;
 	}
 
 	r = storage_read(rel->tuple_storage, row, rel->row_length);
+#endif
 	DB_LOG_V("read row = %s, r = %d\n", row, r);
 
 	if (r == 0) {
@@ -621,11 +626,15 @@ db_result_t storage_read_from(db_storage_id_t fd, void *buffer, unsigned long of
 {
 	ssize_t r;
 
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	r = storage_cache_read(fd, buffer, offset, length);
+#else
 	if (storage_seek(fd, offset, SEEK_SET) == (off_t)-1) {
 		return DB_STORAGE_ERROR;
 	}
 
 	r = storage_read(fd, buffer, length);
+#endif
 	if (r <= 0) {
 		return DB_STORAGE_ERROR;
 	}
@@ -636,11 +645,15 @@ db_result_t storage_write_to(db_storage_id_t fd, void *buffer, unsigned long off
 {
 	ssize_t r;
 
+#ifdef CONFIG_ARASTORAGE_PAGE_CACHE
+	r = storage_cache_write(fd, buffer, offset, length);
+#else
 	if (storage_seek(fd, offset, SEEK_SET) == (off_t)-1) {
 		return DB_STORAGE_ERROR;
 	}
 
 	r = storage_write(fd, buffer, length);
+#endif
 	if (r != length) {
 		return DB_STORAGE_ERROR;
 	}
@@ -0,0 +1,266 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <crc32.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "db_debug.h"
+#include "db_options.h"
+#include "index.h"
+#include "relation.h"
+#include "storage.h"
+#include "wal.h"
+
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+
+/****************************************************************************
+* Pre-processor Definitions
+****************************************************************************/
+#define WAL_RECORD_MAGIC        0x4c415741	/* "AWAL" */
+
+/****************************************************************************
+* Private Type Definitions
+****************************************************************************/
+/*
+ * Every committed batch is one record in the log: this header followed by
+ * row_count rows in the physical row representation of the relation.
+ * A record whose checksum does not match was torn by a power loss and ends
+ * the log.
+ */
+struct wal_record_s {
+	uint32_t magic;
+	uint32_t checksum;			/* crc32 of the header (checksum = 0) and rows */
+	uint32_t base_row;			/* Tuple id of the first row */
+	uint16_t row_length;
+	uint16_t row_count;
+	char rel_name[RELATION_NAME_LENGTH + 1];
+};
+typedef struct wal_record_s wal_record_t;
+
+/* Rows logged since the last checkpoint, all for the same relation. */
+struct wal_state_s {
+	char rel_name[RELATION_NAME_LENGTH + 1];
+	tuple_id_t next_row;
+	size_t size;
+};
+
+/****************************************************************************
+* Private Variables
+****************************************************************************/
+static struct wal_state_s g_wal;
+
+/****************************************************************************
+* Private Functions
+****************************************************************************/
+static uint32_t wal_checksum(wal_record_t *record, unsigned char *rows)
+{
+	uint32_t checksum;
+	uint32_t crc;
+
+	checksum = record->checksum;
+	record->checksum = 0;
+	crc = crc32((uint8_t *)record, sizeof(wal_record_t));
+	crc = crc32part(rows, (size_t)record->row_length * record->row_count, crc);
+	record->checksum = checksum;
+
+	return crc;
+}
+
+/* Apply the rows of one record which are not in the relation yet. */
+static db_result_t wal_apply(wal_record_t *record, unsigned char *rows)
+{
+	relation_t *rel;
+	db_result_t res;
+	int i;
+
+	rel = relation_load(record->rel_name);
+	if (rel == NULL) {
+		/* The relation was dropped, nothing to apply. */
+		DB_LOG_E("DB: WAL relation %s does not exist\n", record->rel_name);
+		return DB_OK;
+	}
+
+	res = DB_OK;
+	if (rel->row_length != record->row_length) {
+		DB_LOG_E("DB: WAL row length %u does not match relation %s\n", record->row_length, rel->name);
+		goto done;
+	}
+
+	/* Every logged row is newer than the last checkpoint. Rows below the
+	   cardinality of the relation were stored before a crash or a failed
+	   checkpoint, but their keys may not be, so they are recovered too. */
+	for (i = 0; i < record->row_count; i++) {
+		res = relation_recover_row(rel, rows + i * record->row_length, record->base_row + i);
+		if (DB_ERROR(res)) {
+			DB_LOG_E("DB: Failed to apply WAL row %d of %s\n", i, rel->name);
+			goto done;
+		}
+	}
+
+#ifndef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
+	res = storage_sync(rel->tuple_storage);
+#endif
+
+done:
+	relation_release(rel);
+	return res;
+}
+
+/****************************************************************************
+* Public Functions
+****************************************************************************/
+/* Log a batch of rows for one relation and make it durable with one sync. */
+db_result_t wal_append(relation_t *rel, unsigned char *rows, uint16_t row_count)
+{
+	wal_record_t record;
+	size_t length;
+	int fd;
+
+	if (g_wal.size > 0 && strncmp(g_wal.rel_name, rel->name, RELATION_NAME_LENGTH) != 0) {
+		/* Tuple ids are tracked for one relation at a time. */
+		if (DB_ERROR(wal_checkpoint())) {
+			return DB_STORAGE_ERROR;
+		}
+	}
+	if (g_wal.size == 0) {
+		memcpy(g_wal.rel_name, rel->name, sizeof(g_wal.rel_name));
+		g_wal.next_row = relation_cardinality(rel);
+	}
+
+	memset(&record, 0, sizeof(wal_record_t));
+	record.magic = WAL_RECORD_MAGIC;
+	record.base_row = g_wal.next_row;
+	record.row_length = rel->row_length;
+	record.row_count = row_count;
+	memcpy(record.rel_name, rel->name, sizeof(record.rel_name));
+	record.checksum = wal_checksum(&record, rows);
+
+	length = (size_t)record.row_length * row_count;
+
+	fd = storage_open(DB_WAL_FILENAME, O_WRONLY | O_APPEND | O_CREAT);
+	if (fd < 0) {
+		DB_LOG_E("DB: Failed to open %s\n", DB_WAL_FILENAME);
+		return DB_STORAGE_ERROR;
+	}
+	if (storage_write(fd, &record, sizeof(wal_record_t)) != sizeof(wal_record_t) || storage_write(fd, rows, length) != length) {
+		DB_LOG_E("DB: Failed to write WAL record\n");
+		storage_close(fd);
+		return DB_STORAGE_ERROR;
+	}
+	if (DB_ERROR(storage_sync(fd))) {
+		storage_close(fd);
+		return DB_STORAGE_ERROR;
+	}
+	storage_close(fd);
+
+	g_wal.next_row += row_count;
+	g_wal.size += sizeof(wal_record_t) + length;
+	DB_LOG_D("DB: Logged %u rows of %s, WAL size %u\n", row_count, rel->name, g_wal.size);
+
+	if (g_wal.size >= CONFIG_ARASTORAGE_WAL_CHECKPOINT_SIZE) {
+		/* The batch is already durable, a failed checkpoint is retried later. */
+		if (DB_ERROR(wal_checkpoint())) {
+			DB_LOG_E("DB: WAL checkpoint failed\n");
+		}
+	}
+
+	return DB_OK;
+}
+
+/* Apply every complete record of the log to its relation and indexes,
+   then truncate the log. Also used to recover the log on db_init(). */
+db_result_t wal_checkpoint(void)
+{
+	wal_record_t record;
+	unsigned char *rows;
+	size_t length;
+	db_result_t res;
+	int fd;
+
+	fd = storage_open(DB_WAL_FILENAME, O_RDONLY);
+	if (fd < 0) {
+		/* No log, nothing to apply. */
+		memset(&g_wal, 0, sizeof(g_wal));
+		return DB_OK;
+	}
+
+	res = DB_OK;
+	while (storage_read(fd, &record, sizeof(wal_record_t)) == sizeof(wal_record_t)) {
+		if (record.magic != WAL_RECORD_MAGIC) {
+			DB_LOG_E("DB: Invalid WAL record, discard the rest of the log\n");
+			break;
+		}
+		length = (size_t)record.row_length * record.row_count;
+		rows = (unsigned char *)malloc(length);
+		if (rows == NULL) {
+			res = DB_ALLOCATION_ERROR;
+			break;
+		}
+		if (storage_read(fd, rows, length) != length || wal_checksum(&record, rows) != record.checksum) {
+			/* A torn record was never acknowledged to the caller. */
+			DB_LOG_E("DB: Incomplete WAL record, discard the rest of the log\n");
+			free(rows);
+			break;
+		}
+		record.rel_name[RELATION_NAME_LENGTH] = '\0';
+		res = wal_apply(&record, rows);
+		free(rows);
+		if (DB_ERROR(res)) {
+			break;
+		}
+	}
+	storage_close(fd);
+
+#ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
+	if (DB_SUCCESS(res)) {
+		res = storage_flush_insert_buffer();
+	}
+#endif
+	if (DB_SUCCESS(res)) {
+		/* The index entries of the applied rows are rebuilt only from the log. */
+		res = index_sync_all();
+	}
+	if (DB_ERROR(res)) {
+		/* Keep the log, applying it again recovers the rows applied so far. */
+		return res;
+	}
+
+	storage_remove(DB_WAL_FILENAME);
+	memset(&g_wal, 0, sizeof(g_wal));
+	DB_LOG_D("DB: WAL checkpoint done\n");
+
+	return DB_OK;
+}
+
+/* The number of logged rows of a relation which are not applied yet. */
+tuple_id_t wal_pending_rows(relation_t *rel)
+{
+	if (g_wal.size == 0 || strncmp(g_wal.rel_name, rel->name, RELATION_NAME_LENGTH) != 0) {
+		return 0;
+	}
+	return g_wal.next_row - relation_cardinality(rel);
+}
+
+#endif							/* CONFIG_ARASTORAGE_ENABLE_WAL */
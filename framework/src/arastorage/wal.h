@@ -0,0 +1,38 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef WAL_H
+#define WAL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <stdint.h>
+
+#include "relation.h"
+
+/****************************************************************************
+* Global Function Prototypes
+****************************************************************************/
+#ifdef CONFIG_ARASTORAGE_ENABLE_WAL
+db_result_t wal_append(relation_t *rel, unsigned char *rows, uint16_t row_count);
+db_result_t wal_checkpoint(void);
+tuple_id_t wal_pending_rows(relation_t *rel);
+#endif
+
+#endif							/* WAL_H */
@@ -33,7 +33,8 @@ namespace stream {
 InputHandler::InputHandler() :
 	mDecoder(nullptr),
 	mState(BUFFER_STATE_EMPTY),
-	mTotalBytes(0)
+	mTotalBytes(0),
+	mInputBufSize(0)
 {
 	mWorkerStackSize = CONFIG_INPUT_DATASOURCE_STACKSIZE;
 }
@@ -111,6 +112,24 @@ ssize_t InputHandler::read(unsigned char *buf, size_t size)
 	return (ssize_t)rlen;
 }
 
+ssize_t InputHandler::peek(const unsigned char **buf, size_t size)
+{
+	size_t rlen = 0;
+
+	if (mBufferReader) {
+		rlen = mBufferReader->peek(buf, size);
+	}
+
+	return (ssize_t)rlen;
+}
+
+void InputHandler::consume(size_t size)
+{
+	if (mBufferReader) {
+		mBufferReader->consume(size);
+	}
+}
+
 void InputHandler::resetWorker()
 {
 	mState = BUFFER_STATE_EMPTY;
@@ -121,22 +140,44 @@ bool InputHandler::processWorker()
 {
 	size_t size = getAvailSpace();
 	if (size > 0) {
-		auto buf = new unsigned char[size];
-		if (!buf) {
-			meddbg("run out of memory! size: 0x%x\n", size);
-			return false;
+		if (!mDemuxer && !mDecoder) {
+			// PCM needs no conversion, read from source into stream buffer in place.
+			unsigned char *buf;
+			size = mBufferWriter->reserve(&buf, size, false);
+			if (size == 0) {
+				return true;
+			}
+			ssize_t readLen = readFromSource(buf, size);
+			if (readLen <= 0) {
+				// Error occurred, or inputting finished
+				mBufferWriter->setEndOfStream();
+				return false;
+			}
+
+			mBufferWriter->commit((size_t)readLen);
+			return true;
+		}
+
+		// Input buffer is kept over iterations, it only grows on demand.
+		if (size > mInputBufSize) {
+			mInputBuf.reset(new unsigned char[size]);
+			if (!mInputBuf) {
+				meddbg("run out of memory! size: 0x%x\n", size);
+				mInputBufSize = 0;
+				return false;
+			}
+			mInputBufSize = size;
 		}
 
+		unsigned char *buf = mInputBuf.get();
 		ssize_t readLen = readFromSource(buf, size);
 		if (readLen <= 0) {
 			// Error occurred, or inputting finished
 			mBufferWriter->setEndOfStream();
-			delete[] buf;
 			return false;
 		}
 
 		ssize_t writeLen = writeToStreamBuffer(buf, (size_t)readLen);
-		delete[] buf;
 		if (writeLen <= 0) {
 			meddbg("write to stream buffer failed!\n");
 			mBufferWriter->setEndOfStream();
@@ -255,6 +296,23 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 		while (1) {
 			unsigned char *buffPCM = buf;
 			size_t sizePCM = used;
+			bool inPlace = false;
+			if (mDecoder) {
+				// Let decoder output PCM into stream buffer directly.
+				unsigned char *space;
+				size_t sizeSpace = mBufferWriter->reserve(&space, mStreamBuffer->getBufferSize());
+				if (sizeSpace == 0) {
+					meddbg("End of writting!\n");
+					return EOF;
+				}
+				// Decoder outputs whole 16bit samples only, otherwise use 'buf' as before.
+				if (sizeSpace >= 2) {
+					buffPCM = space;
+					sizePCM = sizeSpace;
+					inPlace = true;
+				}
+			}
+
 			ret = getPCM(buffES, sizeES, &usedES, &buffPCM, &sizePCM);
 			if (ret < 0) {
 				meddbg("getPCM failed! error: %d\n", ret);
@@ -265,6 +323,11 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 				break;
 			}
 
+			if (inPlace) {
+				mBufferWriter->commit(sizePCM);
+				continue;
+			}
+
 			// write PCM data to stream buffer
 			size_t written = mBufferWriter->write(buffPCM, sizePCM);
 			if (written != sizePCM) {
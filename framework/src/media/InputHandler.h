@@ -49,6 +49,8 @@ public:
 	bool open() override;
 	bool close() override;
 	ssize_t read(unsigned char *buf, size_t size);
+	ssize_t peek(const unsigned char **buf, size_t size);
+	void consume(size_t size);
 
 	void setBufferState(buffer_state_t state);
 
@@ -87,6 +89,8 @@ private:
 
 	buffer_state_t mState;
 	size_t mTotalBytes;
+	std::unique_ptr<unsigned char[]> mInputBuf;
+	size_t mInputBufSize;
 };
 } // namespace stream
 } // namespace media
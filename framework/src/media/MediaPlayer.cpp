@@ -92,6 +92,11 @@ player_result_t MediaPlayer::setObserver(std::shared_ptr<MediaPlayerObserverInte
 	return mPMpImpl->setObserver(observer);
 }
 
+player_result_t MediaPlayer::setStreamInfo(std::shared_ptr<stream_info_t> stream_info)
+{
+	return mPMpImpl->setStreamInfo(stream_info);
+}
+
 bool MediaPlayer::operator==(const MediaPlayer &rhs)
 {
 	return this->mId == rhs.mId;
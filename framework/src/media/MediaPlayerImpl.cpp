@@ -16,6 +16,7 @@
  *
  ******************************************************************/
 
+#include <tinyara/config.h>
 #include <media/MediaPlayer.h>
 #include "PlayerWorker.h"
 #include "MediaPlayerImpl.h"
@@ -23,6 +24,43 @@
 #include <debug.h>
 #include <errno.h>
 #include "audio/audio_manager.h"
+#ifdef CONFIG_AUDIO_MIXER
+#include "audio/audio_mixer.h"
+#endif
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+#include <sched.h>
+#include <chrono>
+#endif
+
+#ifndef CONFIG_MEDIA_PLAYER_XRUN_MAX_RECOVERY
+#define CONFIG_MEDIA_PLAYER_XRUN_MAX_RECOVERY 3
+#endif
+
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+#ifndef CONFIG_MEDIA_PLAYER_PIPELINE_PERIODS
+#define CONFIG_MEDIA_PLAYER_PIPELINE_PERIODS 4
+#endif
+
+#ifndef CONFIG_MEDIA_PLAYER_PIPELINE_PREFILL
+#define CONFIG_MEDIA_PLAYER_PIPELINE_PREFILL 2
+#endif
+
+#ifndef CONFIG_MEDIA_PLAYER_OUTPUT_PRIORITY
+#define CONFIG_MEDIA_PLAYER_OUTPUT_PRIORITY 150
+#endif
+
+#ifndef CONFIG_MEDIA_PLAYER_OUTPUT_STACKSIZE
+#define CONFIG_MEDIA_PLAYER_OUTPUT_STACKSIZE 2048
+#endif
+
+/* Upper bound of waiting for the output thread in playback(), so PlayerWorker checks commands */
+#define PIPELINE_WAIT_MS 100
+#endif
+
+#ifdef CONFIG_AUDIO_MIXER
+/* Upper bound of waiting for the mixer at end of stream in playback(), about one mixer period */
+#define MIXER_DRAIN_WAIT_MS (CONFIG_AUDIO_MIXER_PERIOD_FRAMES * 1000 / CONFIG_AUDIO_MIXER_SAMPLE_RATE + 1)
+#endif
 
 namespace media {
 
@@ -35,6 +73,22 @@ MediaPlayerImpl::MediaPlayerImpl(MediaPlayer &player) : mPlayer(player)
 	mCurState = PLAYER_STATE_NONE;
 	mBuffer = nullptr;
 	mBufSize = 0;
+#ifdef CONFIG_AUDIO_MIXER
+	mMixerStream = -1;
+#else
+	mUnderrunCount = 0;
+	mXrunCount = 0;
+	mXrunRecovery = 0;
+#endif
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	mOutputThread = 0;
+	mOutputExit = false;
+	mOutputRun = false;
+	mOutputBusy = false;
+	mOutputPrefill = false;
+	mInputEos = false;
+	mOutputDrained = false;
+#endif
 }
 
 player_result_t MediaPlayerImpl::create()
@@ -152,6 +206,13 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	if (!openMixerStream()) {
+		meddbg("MediaPlayer prepare fail : openMixerStream fail\n");
+		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+		return notifySync();
+	}
+#else
 	auto source = mInputHandler.getDataSource();
 	if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 							 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
@@ -161,6 +222,7 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 	}
 
 	mBufSize = get_user_output_frames_to_byte(get_output_frame_count());
+#endif
 	if (mBufSize < 0) {
 		meddbg("MediaPlayer prepare fail : get_output_frames_byte_size fail\n");
 		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
@@ -180,6 +242,19 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	if (!startOutput()) {
+		meddbg("MediaPlayer prepare fail : startOutput fail\n");
+		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+		return notifySync();
+	}
+#endif
+#ifndef CONFIG_AUDIO_MIXER
+	mUnderrunCount = 0;
+	mXrunCount = 0;
+	mXrunRecovery = 0;
+#endif
+
 	mCurState = PLAYER_STATE_READY;
 	return notifySync();
 }
@@ -250,17 +325,32 @@ void MediaPlayerImpl::unpreparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	// Output thread writes from mBuffer, stop it first.
+	stopOutput();
+#endif
+
 	if (mBuffer) {
 		delete[] mBuffer;
 		mBuffer = nullptr;
 	}
 	mBufSize = 0;
 
+#ifdef CONFIG_AUDIO_MIXER
+	PlayerWorker::getWorker().removePlayer(shared_from_this());
+	if (audio_mixer_close(mMixerStream) != AUDIO_MANAGER_SUCCESS) {
+		meddbg("MediaPlayer unprepare fail : audio_mixer_close fail\n");
+		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+		return notifySync();
+	}
+	mMixerStream = -1;
+#else
 	if (reset_audio_stream_out() != AUDIO_MANAGER_SUCCESS) {
 		meddbg("MediaPlayer unprepare fail : reset_audio_stream_out fail\n");
 		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
 		return notifySync();
 	}
+#endif
 
 	mInputHandler.close();
 
@@ -296,6 +386,16 @@ void MediaPlayerImpl::startPlayer()
 		return;
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	// Other players keep playing, mixer sums all of them.
+	if (audio_mixer_pause(mMixerStream, false) != AUDIO_MANAGER_SUCCESS) {
+		meddbg("MediaPlayer startPlayer fail : audio_mixer_pause fail\n");
+		notifyObserver(PLAYER_OBSERVER_COMMAND_START_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+		return;
+	}
+
+	mpw.addPlayer(shared_from_this());
+#else
 	if (mCurState == PLAYER_STATE_PAUSED) {
 		auto source = mInputHandler.getDataSource();
 		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
@@ -315,8 +415,12 @@ void MediaPlayerImpl::startPlayer()
 		}
 		mpw.setPlayer(curPlayer);
 	}
+#endif
 
 	mCurState = PLAYER_STATE_PLAYING;
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	resumeOutput();
+#endif
 	notifyObserver(PLAYER_OBSERVER_COMMAND_STARTED);
 }
 
@@ -358,13 +462,37 @@ player_result_t MediaPlayerImpl::stopPlayback()
 	}
 
 	mCurState = PLAYER_STATE_READY;
+#ifdef CONFIG_AUDIO_MIXER
+	mpw.removePlayer(shared_from_this());
+
+	audio_manager_result_t result = audio_mixer_pause(mMixerStream, true);
+	if (result == AUDIO_MANAGER_SUCCESS) {
+		result = audio_mixer_flush(mMixerStream);
+	}
+	if (result != AUDIO_MANAGER_SUCCESS) {
+		meddbg("stop mixer stream failed ret : %d\n", result);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
+#else
 	mpw.setPlayer(nullptr);
 
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	pauseOutput();
+	{
+		// Frames not written to the card yet are dropped, like pcm_drop.
+		std::lock_guard<std::mutex> lock(mOutputMtx);
+		rb_reset(&mPcmRing);
+		mInputEos = false;
+		mOutputDrained = false;
+	}
+#endif
+
 	audio_manager_result_t result = stop_audio_stream_out();
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("stop_audio_stream_out failed ret : %d\n", result);
 		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
 	}
+#endif
 
 	return PLAYER_OK;
 }
@@ -397,6 +525,19 @@ void MediaPlayerImpl::pausePlayer()
 		return;
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	audio_manager_result_t result = audio_mixer_pause(mMixerStream, true);
+	if (result != AUDIO_MANAGER_SUCCESS) {
+		meddbg("audio_mixer_pause failed ret : %d\n", result);
+		notifyObserver(PLAYER_OBSERVER_COMMAND_PAUSE_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+		return;
+	}
+
+	mpw.removePlayer(shared_from_this());
+#else
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	pauseOutput();
+#endif
 	audio_manager_result_t result = pause_audio_stream_out();
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("pause_audio_stream_in failed ret : %d\n", result);
@@ -409,6 +550,7 @@ void MediaPlayerImpl::pausePlayer()
 	if (prevPlayer == curPlayer) {
 		mpw.setPlayer(nullptr);
 	}
+#endif
 	mCurState = PLAYER_STATE_PAUSED;
 	notifyObserver(PLAYER_OBSERVER_COMMAND_PAUSED);
 }
@@ -598,6 +740,63 @@ void MediaPlayerImpl::setPlayerObserver(std::shared_ptr<MediaPlayerObserverInter
 	notifySync();
 }
 
+player_result_t MediaPlayerImpl::setStreamInfo(std::shared_ptr<stream_info_t> stream_info)
+{
+	player_result_t ret = PLAYER_OK;
+
+	std::unique_lock<std::mutex> lock(mCmdMtx);
+	medvdbg("MediaPlayer setStreamInfo\n");
+
+	PlayerWorker &mpw = PlayerWorker::getWorker();
+	if (!mpw.isAlive()) {
+		meddbg("PlayerWorker is not alive\n");
+		return PLAYER_ERROR_NOT_ALIVE;
+	}
+
+	mpw.enQueue(&MediaPlayerImpl::setPlayerStreamInfo, shared_from_this(), stream_info, std::ref(ret));
+	mSyncCv.wait(lock);
+
+	return ret;
+}
+
+void MediaPlayerImpl::setPlayerStreamInfo(std::shared_ptr<stream_info_t> stream_info, player_result_t &ret)
+{
+	if (mCurState != PLAYER_STATE_IDLE && mCurState != PLAYER_STATE_CONFIGURED) {
+		meddbg("%s Fail : invalid state\n", __func__);
+		LOG_STATE_DEBUG(mCurState);
+		ret = PLAYER_ERROR_INVALID_STATE;
+		return notifySync();
+	}
+
+	mStreamInfo = stream_info;
+	notifySync();
+}
+
+#ifdef CONFIG_AUDIO_MIXER
+bool MediaPlayerImpl::openMixerStream()
+{
+	auto source = mInputHandler.getDataSource();
+	unsigned int flags = AUDIO_MIXER_FLAG_NONE;
+
+	// Prompts are mixed over other players, which are ducked meanwhile.
+	if (mStreamInfo && (mStreamInfo->policy == STREAM_TYPE_NOTIFY || mStreamInfo->policy == STREAM_TYPE_EMERGENCY)) {
+		flags |= AUDIO_MIXER_FLAG_DUCKING;
+	}
+
+	mMixerStream = audio_mixer_open(source->getChannels(), source->getSampleRate(), flags);
+	if (mMixerStream < 0) {
+		meddbg("audio_mixer_open failed ret : %d\n", mMixerStream);
+		return false;
+	}
+
+	// Stays paused until player starts.
+	audio_mixer_pause(mMixerStream, true);
+
+	mBufSize = audio_mixer_get_frame_count(mMixerStream) * source->getChannels() * sizeof(int16_t);
+	return true;
+}
+#endif
+
 bool MediaPlayerImpl::isPlaying()
 {
 	bool ret = false;
@@ -684,6 +883,11 @@ void MediaPlayerImpl::notifyObserver(player_observer_command_t cmd, ...)
 			// Because data buffer would be released after this function returned.
 			mPlayerObserver->onPlaybackBufferDataReached(mPlayer, data, size);
 		} break;
+		case PLAYER_OBSERVER_COMMAND_XRUN: {
+			unsigned int underrunCount = va_arg(ap, unsigned int);
+			unsigned int xrunCount = va_arg(ap, unsigned int);
+			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackXrun, mPlayerObserver, mPlayer, underrunCount, xrunCount);
+		} break;
 		case PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED:
 			player_error_t error = (player_error_t)va_arg(ap, int);
 			if (error != PLAYER_ERROR_NONE) {
@@ -711,6 +915,12 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 	case PLAYER_EVENT_SOURCE_PREPARED: {
 		// Input handler has been opened successfully by InputHandler::doStandBy().
 		// Now setup audio manager and notify player observer the result.
+#ifdef CONFIG_AUDIO_MIXER
+		if (!openMixerStream()) {
+			meddbg("MediaPlayer prepare fail : openMixerStream fail\n");
+			return notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+		}
+#else
 		auto source = mInputHandler.getDataSource();
 		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 								 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
@@ -719,6 +929,7 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 		}
 
 		mBufSize = get_user_output_frames_to_byte(get_output_frame_count());
+#endif
 		if (mBufSize < 0) {
 			meddbg("MediaPlayer prepare fail : get_user_output_frames_to_byte fail\n");
 			return notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
@@ -735,6 +946,18 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 			return notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 		}
 
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+		if (!startOutput()) {
+			meddbg("MediaPlayer prepare fail : startOutput fail\n");
+			return notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+		}
+#endif
+#ifndef CONFIG_AUDIO_MIXER
+		mUnderrunCount = 0;
+		mXrunCount = 0;
+		mXrunRecovery = 0;
+#endif
+
 		mCurState = PLAYER_STATE_READY;
 		return notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_NONE);
 	}
@@ -746,10 +969,90 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 
 void MediaPlayerImpl::playback()
 {
-	ssize_t num_read = mInputHandler.read(mBuffer, (int)mBufSize);
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	// Decoded PCM is queued ahead to mPcmRing, the output thread writes it to the card.
+	std::unique_lock<std::mutex> lock(mOutputMtx);
+	if (mInputEos) {
+		if (mOutputDrained) {
+			lock.unlock();
+			finishPlayback();
+		} else {
+			mOutputCv.wait_for(lock, std::chrono::milliseconds(PIPELINE_WAIT_MS));
+		}
+		return;
+	}
+
+	void *space;
+	size_t size = rb_write_reserve(&mPcmRing, &space);
+	if (size == 0) {
+		mOutputCv.wait_for(lock, std::chrono::milliseconds(PIPELINE_WAIT_MS));
+		return;
+	}
+	lock.unlock();
+
+	if (size > (size_t)mBufSize) {
+		size = (size_t)mBufSize;
+	}
+	ssize_t num_read = mInputHandler.read((unsigned char *)space, size);
+	medvdbg("num_read : %d\n", num_read);
+	if (num_read >= 0) {
+		lock.lock();
+		if (num_read > 0) {
+			rb_write_commit(&mPcmRing, (size_t)num_read);
+		} else {
+			mInputEos = true;
+		}
+		mOutputCv.notify_all();
+	} else {
+		meddbg("InputDatasource read error\n");
+		notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+		PlayerWorker &mpw = PlayerWorker::getWorker();
+		mpw.enQueue(&MediaPlayerImpl::stopPlayer, shared_from_this(), PLAYER_ERROR_INVALID_OPERATION);
+	}
+#else
+	// Write the stream buffer to the output in place, and consume() what was written.
+#ifdef CONFIG_AUDIO_MIXER
+	size_t frameBytes = mInputHandler.getDataSource()->getChannels() * sizeof(int16_t);
+#else
+	size_t frameBytes = get_user_output_frames_to_byte(1);
+#endif
+	const unsigned char *data;
+	bool inPlace = true;
+	ssize_t num_read = mInputHandler.peek(&data, (size_t)mBufSize);
+	if (num_read > 0 && (size_t)num_read < frameBytes) {
+		// A frame is split at the end of the stream buffer, copy it out to join it.
+		num_read = mInputHandler.read(mBuffer, (int)mBufSize);
+		data = mBuffer;
+		inPlace = false;
+	}
 	medvdbg("num_read : %d\n", num_read);
 	if (num_read > 0) {
-		int ret = start_audio_stream_out(mBuffer, get_user_output_bytes_to_frame((unsigned int)num_read));
+		size_t len = (size_t)num_read - (size_t)num_read % frameBytes;
+		if (len == 0) {
+			// Only part of a frame was left at the end of stream, drop it.
+			return;
+		}
+#ifdef CONFIG_AUDIO_MIXER
+		int ret = audio_mixer_write(mMixerStream, data, (unsigned int)(len / frameBytes));
+#else
+		int ret = start_audio_stream_out((void *)data, get_user_output_bytes_to_frame((unsigned int)len));
+#endif
+		if (ret >= 0) {
+			// The output may take fewer frames than offered, the rest stays in the stream buffer.
+			len = (size_t)ret * frameBytes;
+		}
+		if (inPlace && (ret >= 0 || ret == AUDIO_MANAGER_XRUN_STATE)) {
+			mInputHandler.consume(len);
+		}
+#ifndef CONFIG_AUDIO_MIXER
+		if (ret == AUDIO_MANAGER_XRUN_STATE && recoverXrun()) {
+			// Frames of this period are lost, next write restarts the card.
+			return;
+		}
+		if (ret >= 0) {
+			mXrunRecovery = 0;
+		}
+#endif
 		if (ret < 0) {
 			notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 			PlayerWorker &mpw = PlayerWorker::getWorker();
@@ -765,19 +1068,199 @@ void MediaPlayerImpl::playback()
 			}
 		}
 	} else if (num_read == 0) {
-		player_result_t errcode = stopPlayback();
-		if (errcode != PLAYER_OK) {
-			notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, errcode);
-		} else {
-			notifyObserver(PLAYER_OBSERVER_COMMAND_FINISHIED);
+#ifdef CONFIG_AUDIO_MIXER
+		// Let the queued frames be played out, polling so PlayerWorker keeps serving the others.
+		if (audio_mixer_drain(mMixerStream, MIXER_DRAIN_WAIT_MS) > 0) {
+			return;
 		}
+#endif
+		finishPlayback();
 	} else {
 		meddbg("InputDatasource read error\n");
 		notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 		PlayerWorker &mpw = PlayerWorker::getWorker();
 		mpw.enQueue(&MediaPlayerImpl::stopPlayer, shared_from_this(), PLAYER_ERROR_INVALID_OPERATION);
 	}
+#endif
+}
+
+void MediaPlayerImpl::finishPlayback()
+{
+	player_result_t errcode = stopPlayback();
+	if (errcode != PLAYER_OK) {
+		notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, errcode);
+	} else {
+		notifyObserver(PLAYER_OBSERVER_COMMAND_FINISHIED);
+	}
+}
+
+#ifndef CONFIG_AUDIO_MIXER
+/**
+ * Called when the card failed with XRUN, even after re-preparing it in audio manager.
+ * Returns true if playback goes on, false if it should be stopped.
+ */
+bool MediaPlayerImpl::recoverXrun()
+{
+	mXrunCount++;
+	notifyObserver(PLAYER_OBSERVER_COMMAND_XRUN, mUnderrunCount, mXrunCount);
+
+	if (mXrunRecovery >= CONFIG_MEDIA_PLAYER_XRUN_MAX_RECOVERY) {
+		meddbg("XRUN not recovered after %d tries\n", mXrunRecovery);
+		return false;
+	}
+	mXrunRecovery++;
+
+	// Drop the frames queued in the card, the next write prepares and restarts it.
+	pause_audio_stream_out();
+	if (stop_audio_stream_out() != AUDIO_MANAGER_SUCCESS) {
+		meddbg("stop_audio_stream_out failed while recovering XRUN\n");
+		return false;
+	}
+
+	medvdbg("XRUN recovered, count : %u\n", mXrunCount);
+	return true;
+}
+#endif
+
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+bool MediaPlayerImpl::startOutput()
+{
+	struct sched_param sparam;
+	pthread_attr_t attr;
+
+	if (!rb_init(&mPcmRing, (size_t)mBufSize * CONFIG_MEDIA_PLAYER_PIPELINE_PERIODS)) {
+		meddbg("Fail to allocate PCM ring\n");
+		return false;
+	}
+
+	mOutputExit = false;
+	mOutputRun = false;
+	mOutputBusy = false;
+	mOutputPrefill = true;
+	mInputEos = false;
+	mOutputDrained = false;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_MEDIA_PLAYER_OUTPUT_STACKSIZE);
+	sparam.sched_priority = CONFIG_MEDIA_PLAYER_OUTPUT_PRIORITY;
+	pthread_attr_setschedparam(&attr, &sparam);
+	if (pthread_create(&mOutputThread, &attr, static_cast<pthread_startroutine_t>(MediaPlayerImpl::outputLooper), this) != OK) {
+		meddbg("Fail to create output thread\n");
+		rb_free(&mPcmRing);
+		return false;
+	}
+	pthread_setname_np(mOutputThread, "PlayerOutput");
+
+	return true;
+}
+
+void MediaPlayerImpl::stopOutput()
+{
+	{
+		std::lock_guard<std::mutex> lock(mOutputMtx);
+		mOutputExit = true;
+		mOutputCv.notify_all();
+	}
+
+	pthread_join(mOutputThread, NULL);
+	rb_free(&mPcmRing);
+}
+
+void MediaPlayerImpl::pauseOutput()
+{
+	std::unique_lock<std::mutex> lock(mOutputMtx);
+	mOutputRun = false;
+	mOutputCv.notify_all();
+
+	// The card can be controlled once output thread has left start_audio_stream_out().
+	while (mOutputBusy) {
+		mOutputCv.wait(lock);
+	}
+}
+
+void MediaPlayerImpl::resumeOutput()
+{
+	std::lock_guard<std::mutex> lock(mOutputMtx);
+	mOutputRun = true;
+	mOutputPrefill = true;
+	mOutputCv.notify_all();
+}
+
+void *MediaPlayerImpl::outputLooper(void *arg)
+{
+	auto player = static_cast<MediaPlayerImpl *>(arg);
+	medvdbg("MediaPlayerImpl : outputLooper\n");
+
+	player->outputLoop();
+	return NULL;
+}
+
+void MediaPlayerImpl::outputLoop()
+{
+	size_t frameBytes = get_user_output_frames_to_byte(1);
+	size_t prefill = (size_t)mBufSize * CONFIG_MEDIA_PLAYER_PIPELINE_PREFILL;
+	std::unique_lock<std::mutex> lock(mOutputMtx);
+
+	while (!mOutputExit) {
+		if (!mOutputRun) {
+			mOutputCv.wait(lock);
+			continue;
+		}
+
+		size_t used = rb_used(&mPcmRing);
+		if (used < frameBytes) {
+			if (mInputEos) {
+				// Everything is written, playback() finishes it on PlayerWorker.
+				mOutputDrained = true;
+				mOutputCv.notify_all();
+			} else if (!mOutputPrefill) {
+				// Ran dry before the end, start again once enough frames are queued.
+				mOutputPrefill = true;
+				mUnderrunCount++;
+				notifyObserver(PLAYER_OBSERVER_COMMAND_XRUN, mUnderrunCount, mXrunCount);
+			}
+			mOutputCv.wait(lock);
+			continue;
+		}
+
+		if (mOutputPrefill) {
+			if (used < prefill && !mInputEos) {
+				mOutputCv.wait(lock);
+				continue;
+			}
+			mOutputPrefill = false;
+		}
+
+		size_t size = used < (size_t)mBufSize ? used : (size_t)mBufSize;
+		size -= size % frameBytes;
+		rb_read(&mPcmRing, mBuffer, size);
+		mOutputBusy = true;
+		mOutputCv.notify_all();
+		lock.unlock();
+
+		int ret = start_audio_stream_out(mBuffer, get_user_output_bytes_to_frame((unsigned int)size));
+		bool recovered = false;
+		if (ret == AUDIO_MANAGER_XRUN_STATE) {
+			recovered = recoverXrun();
+		} else if (ret >= 0) {
+			mXrunRecovery = 0;
+		}
+
+		lock.lock();
+		mOutputBusy = false;
+		if (recovered) {
+			// Restart with frames queued ahead, rather than running dry again at once.
+			mOutputPrefill = true;
+		} else if (ret < 0) {
+			meddbg("audio manager error : %d\n", ret);
+			mOutputRun = false;
+			notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+			PlayerWorker::getWorker().enQueue(&MediaPlayerImpl::stopPlayer, shared_from_this(), PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+		}
+		mOutputCv.notify_all();
+	}
 }
+#endif
 
 MediaPlayerImpl::~MediaPlayerImpl()
 {
@@ -19,9 +19,13 @@
 #ifndef __MEDIA_MEDIAPLAYERIMPL_H
 #define __MEDIA_MEDIAPLAYERIMPL_H
 
+#include <tinyara/config.h>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+#include <pthread.h>
+#endif
 
 #include <media/MediaPlayer.h>
 #include <media/InputDataSource.h>
@@ -29,6 +33,9 @@
 
 #include "PlayerObserverWorker.h"
 #include "InputHandler.h"
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+#include "utils/rb.h"
+#endif
 
 namespace media {
 /**
@@ -78,6 +85,7 @@ typedef enum player_observer_command_e {
 	PLAYER_OBSERVER_COMMAND_BUFFER_UPDATED,
 	PLAYER_OBSERVER_COMMAND_BUFFER_STATECHANGED,
 	PLAYER_OBSERVER_COMMAND_BUFFER_DATAREACHED,
+	PLAYER_OBSERVER_COMMAND_XRUN,
 } player_observer_command_t;
 
 typedef enum player_event_e {
@@ -106,6 +114,7 @@ public:
 
 	player_result_t setDataSource(std::unique_ptr<stream::InputDataSource>);
 	player_result_t setObserver(std::shared_ptr<MediaPlayerObserverInterface>);
+	player_result_t setStreamInfo(std::shared_ptr<stream_info_t> stream_info);
 
 	player_state_t getState();
 	bool isPlaying();
@@ -130,6 +139,22 @@ private:
 	void setPlayerVolume(uint8_t vol, player_result_t &ret);
 	void setPlayerObserver(std::shared_ptr<MediaPlayerObserverInterface> observer);
 	void setPlayerDataSource(std::shared_ptr<stream::InputDataSource> dataSource, player_result_t &ret);
+	void setPlayerStreamInfo(std::shared_ptr<stream_info_t> stream_info, player_result_t &ret);
+#ifdef CONFIG_AUDIO_MIXER
+	bool openMixerStream();
+#endif
+#ifndef CONFIG_AUDIO_MIXER
+	bool recoverXrun();
+#endif
+	void finishPlayback();
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	bool startOutput();
+	void stopOutput();
+	void pauseOutput();
+	void resumeOutput();
+	void outputLoop();
+	static void *outputLooper(void *arg);
+#endif
 
 private:
 	MediaPlayer &mPlayer;
@@ -141,6 +166,26 @@ private:
 	std::shared_ptr<stream_info_t> mStreamInfo;
 	std::shared_ptr<MediaPlayerObserverInterface> mPlayerObserver;
 	stream::InputHandler mInputHandler;
+#ifdef CONFIG_AUDIO_MIXER
+	int mMixerStream;
+#endif
+#ifndef CONFIG_AUDIO_MIXER
+	unsigned int mUnderrunCount;
+	unsigned int mXrunCount;
+	int mXrunRecovery;
+#endif
+#ifdef CONFIG_MEDIA_PLAYER_PIPELINE
+	rb_t mPcmRing;
+	pthread_t mOutputThread;
+	std::mutex mOutputMtx;
+	std::condition_variable mOutputCv;
+	bool mOutputExit;
+	bool mOutputRun;
+	bool mOutputBusy;
+	bool mOutputPrefill;
+	bool mInputEos;
+	bool mOutputDrained;
+#endif
 };
 } // namespace media
 #endif
@@ -47,12 +47,28 @@ PlayerWorker& PlayerWorker::getWorker()
 
 bool PlayerWorker::processLoop()
 {
+#ifdef CONFIG_AUDIO_MIXER
+	// Each playback() writes one mixer period, so players go at the same pace.
+	bool playing = false;
+	auto it = mPlayers.begin();
+	while (it != mPlayers.end()) {
+		// playback() may remove the player from the list, step over it first.
+		auto player = *it++;
+		if (player->getState() == PLAYER_STATE_PLAYING) {
+			player->playback();
+			playing = true;
+		}
+	}
+
+	return playing;
+#else
 	if (mCurPlayer && (mCurPlayer->getState() == PLAYER_STATE_PLAYING)) {
 		mCurPlayer->playback();
 		return true;
 	}
 
 	return false;
+#endif
 }
 
 void PlayerWorker::setPlayer(std::shared_ptr<MediaPlayerImpl> player)
@@ -65,4 +81,21 @@ std::shared_ptr<MediaPlayerImpl> PlayerWorker::getPlayer()
 	return mCurPlayer;
 }
 
+#ifdef CONFIG_AUDIO_MIXER
+void PlayerWorker::addPlayer(std::shared_ptr<MediaPlayerImpl> player)
+{
+	for (auto &p : mPlayers) {
+		if (p == player) {
+			return;
+		}
+	}
+	mPlayers.push_back(player);
+}
+
+void PlayerWorker::removePlayer(std::shared_ptr<MediaPlayerImpl> player)
+{
+	mPlayers.remove(player);
+}
+#endif
+
 } // namespace media
@@ -92,6 +92,26 @@ size_t StreamBuffer::write(unsigned char *buf, size_t size)
 	return rb_write(&mRingBuf, buf, size);
 }
 
+size_t StreamBuffer::reserve(unsigned char **buf)
+{
+	return rb_write_reserve(&mRingBuf, (void **)buf);
+}
+
+size_t StreamBuffer::commit(size_t size)
+{
+	return rb_write_commit(&mRingBuf, size);
+}
+
+size_t StreamBuffer::peek(const unsigned char **buf)
+{
+	return rb_read_peek(&mRingBuf, (const void **)buf);
+}
+
+size_t StreamBuffer::consume(size_t size)
+{
+	return rb_read(&mRingBuf, NULL, size);
+}
+
 size_t StreamBuffer::sizeOfSpace()
 {
 	return rb_avail(&mRingBuf);
@@ -87,6 +87,24 @@ public:
 	 * Write(push) data into stream buffer.
 	 */
 	size_t write(unsigned char *buf, size_t size);
+	/**
+	 * Get the contiguous free space at the write position, so that data can
+	 * be produced in place. It becomes readable only after commit().
+	 */
+	size_t reserve(unsigned char **buf);
+	/**
+	 * Publish data produced in place after reserve().
+	 */
+	size_t commit(size_t size);
+	/**
+	 * Get the contiguous data at the read position without copying it.
+	 * It stays in stream buffer until consume().
+	 */
+	size_t peek(const unsigned char **buf);
+	/**
+	 * Drop data used in place after peek().
+	 */
+	size_t consume(size_t size);
 	/**
 	 * Get bytes of data available in stream buffer.
 	 */
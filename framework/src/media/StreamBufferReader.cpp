@@ -86,6 +86,50 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 	return rlen;
 }
 
+size_t StreamBufferReader::peek(const unsigned char **buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len = mStream->peek(buf);
+
+	while (sync && len == 0) {
+		// There's no data
+		if (mStream->isEndOfStream()) {
+			medvdbg("EOS break\n");
+			break;
+		}
+
+		// Notify observer and wait notification from writer.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		mStream->getCondv().notify_one();
+		mStream->getCondv().wait(lock);
+		len = mStream->peek(buf);
+	}
+
+	if (len > size) {
+		len = size;
+	}
+
+	medvdbg("peeked %lu\n", len);
+	return len;
+}
+
+size_t StreamBufferReader::consume(size_t size)
+{
+	medvdbg("size %lu\n", size);
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+
+	size_t rlen = mStream->consume(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) rlen));
+
+	// Writer may be waiting for more spaces, so it's necessary to notify after reading.
+	mStream->getCondv().notify_one();
+
+	medvdbg("consumed %lu\n", rlen);
+	return rlen;
+}
+
 size_t StreamBufferReader::sizeOfData()
 {
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
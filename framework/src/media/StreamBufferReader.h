@@ -34,6 +34,16 @@ public:
 	virtual size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
 	virtual size_t read(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfData();
+	/**
+	 * Get contiguous data in stream buffer to be used in place, at most 'size' bytes.
+	 * With 'sync', wait until there's some data or end-of-stream was set.
+	 * Data stays in stream buffer until consume() is called.
+	 */
+	virtual size_t peek(const unsigned char **buf, size_t size, bool sync = true);
+	/**
+	 * Drop 'size' bytes used in place after peek().
+	 */
+	virtual size_t consume(size_t size);
 
 public:
 	bool isEndOfStream();
@@ -76,6 +76,50 @@ size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 	return wlen;
 }
 
+size_t StreamBufferWriter::reserve(unsigned char **buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len = mStream->reserve(buf);
+
+	while (sync && len == 0) {
+		// Streaming may be stopped (EOS was set)
+		if (mStream->isEndOfStream()) {
+			medvdbg("EOS break\n");
+			break;
+		}
+
+		// There's no space, notify observer and wait notification from reader.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		mStream->getCondv().notify_one();
+		mStream->getCondv().wait(lock);
+		len = mStream->reserve(buf);
+	}
+
+	if (len > size) {
+		len = size;
+	}
+
+	medvdbg("reserved %lu\n", len);
+	return len;
+}
+
+size_t StreamBufferWriter::commit(size_t size)
+{
+	medvdbg("size %lu\n", size);
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+
+	size_t wlen = mStream->commit(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) wlen);
+
+	// Reader may be waiting for more data, so it's necessary to notify after writing.
+	mStream->getCondv().notify_one();
+
+	medvdbg("committed %lu\n", wlen);
+	return wlen;
+}
+
 size_t StreamBufferWriter::sizeOfSpace()
 {
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
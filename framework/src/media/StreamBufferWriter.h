@@ -33,6 +33,16 @@ public:
 public:
 	virtual size_t write(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfSpace();
+	/**
+	 * Get contiguous space in stream buffer to be filled in place, at most 'size' bytes.
+	 * With 'sync', wait until there's some space or end-of-stream was set.
+	 * Only one writer may hold a reserved space, until it calls commit().
+	 */
+	virtual size_t reserve(unsigned char **buf, size_t size, bool sync = true);
+	/**
+	 * Publish 'size' bytes filled in the space returned by reserve().
+	 */
+	virtual size_t commit(size_t size);
 
 public:
 	void setEndOfStream();
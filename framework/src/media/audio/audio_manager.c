@@ -936,6 +936,7 @@ int start_audio_stream_out(void *data, unsigned int frames)
 {
 	int ret = 0;
 	int prepare_retry = AUDIO_STREAM_RETRY_COUNT;
+	unsigned int written;
 	audio_card_info_t *card;
 	medvdbg("start_audio_stream_out(%u)\n", frames);
 
@@ -953,9 +954,11 @@ int start_audio_stream_out(void *data, unsigned int frames)
 
 	pthread_mutex_lock(&(card->card_mutex));
 
+	written = frames;
 	if (card->resample.necessary) {
 		if (frames > get_output_frame_count()) {
 			frames = get_output_frame_count();
+			written = frames;
 		}
 		// Process resampling
 		ret = (int)resample_stream_out(card, data, frames);
@@ -1007,6 +1010,10 @@ int start_audio_stream_out(void *data, unsigned int frames)
 		}
 	} while (ret == OK);
 
+	// pcm_writei() writes all frames or fails, but counts only the last buffer of the card.
+	// Report the frames taken from 'data' instead, fewer than requested if resampling cut them.
+	ret = (int)written;
+
 error_with_lock:
 	pthread_mutex_unlock(&(card->card_mutex));
 
@@ -172,7 +172,8 @@ int start_audio_stream_in(void *data, unsigned int frames);
  *   frames: number of frames to be written
  *
  * Return Value:
- *   On success, the number of frames written. Otherwise, a negative value.
+ *   On success, the number of frames taken from data, which may be less than
+ *   frames if the output is resampled. Otherwise, a negative value.
  ****************************************************************************/
 int start_audio_stream_out(void *data, unsigned int frames);
 
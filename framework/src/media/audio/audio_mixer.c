@@ -0,0 +1,666 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <debug.h>
+#include <tinyalsa/tinyalsa.h>
+
+#include "audio_mixer.h"
+#include "resample/samplerate.h"
+#include "../utils/rb.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#ifndef CONFIG_AUDIO_MIXER_MAX_STREAMS
+#define CONFIG_AUDIO_MIXER_MAX_STREAMS 4
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_SAMPLE_RATE
+#define CONFIG_AUDIO_MIXER_SAMPLE_RATE 44100
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_CHANNELS
+#define CONFIG_AUDIO_MIXER_CHANNELS 2
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_PERIOD_FRAMES
+#define CONFIG_AUDIO_MIXER_PERIOD_FRAMES 1024
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_STREAM_PERIODS
+#define CONFIG_AUDIO_MIXER_STREAM_PERIODS 4
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_DUCK_GAIN
+#define CONFIG_AUDIO_MIXER_DUCK_GAIN 64
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_PRIORITY
+#define CONFIG_AUDIO_MIXER_PRIORITY 150
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_STACKSIZE
+#define CONFIG_AUDIO_MIXER_STACKSIZE 2048
+#endif
+
+#ifndef CONFIG_AUDIO_RESAMPLER_BUFSIZE
+#define CONFIG_AUDIO_RESAMPLER_BUFSIZE 4096
+#endif
+
+#define MIXER_FRAME_BYTES (CONFIG_AUDIO_MIXER_CHANNELS * sizeof(int16_t))
+#define MIXER_PERIOD_SAMPLES (CONFIG_AUDIO_MIXER_PERIOD_FRAMES * CONFIG_AUDIO_MIXER_CHANNELS)
+#define MIXER_STREAM_BUFSIZE (CONFIG_AUDIO_MIXER_STREAM_PERIODS * CONFIG_AUDIO_MIXER_PERIOD_FRAMES * MIXER_FRAME_BYTES)
+
+/* Gain of ducked streams in Q15 */
+#define MIXER_DUCK_GAIN ((AUDIO_MIXER_GAIN_UNITY * CONFIG_AUDIO_MIXER_DUCK_GAIN) >> 8)
+
+/* Gains are ramped in Q15 with 8 more fractional bits */
+#define MIXER_RAMP_SHIFT 8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+struct audio_mixer_stream_s {
+	bool used;
+	bool paused;
+	unsigned int flags;
+	unsigned int channels;      // channels of user data
+	unsigned int sample_rate;   // sample rate of user data
+	unsigned int frame_count;   // user frames lasting one mixer period
+	uint16_t gain;              // gain requested by user
+	uint16_t cur_gain;          // gain applied at the end of last period
+	rb_t rb;                    // frames converted to mixer format, waiting for mixing
+	src_handle_t src;           // converter, NULL if user format is same as mixer
+	int16_t *conv;              // converted frames not queued to rb yet
+	unsigned int conv_frames;   // number of frames in conv
+	unsigned int conv_offset;   // number of frames in conv queued already
+};
+
+struct audio_mixer_s {
+	pthread_mutex_t ctl_mutex;  // serializes open and close
+	pthread_mutex_t mutex;      // protects streams, shared with the mixer thread
+	pthread_cond_t cond;        // signaled when space, data or state of streams changed
+	pthread_t thread;
+	bool running;
+	int nstreams;
+	int32_t *acc;               // accumulator of one period
+	int16_t *out;               // mixed frames of one period
+	struct audio_mixer_stream_s streams[CONFIG_AUDIO_MIXER_MAX_STREAMS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static struct audio_mixer_s g_mixer = {
+	PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_COND_INITIALIZER,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static inline int16_t mixer_sat16(int32_t value)
+{
+	if (value > INT16_MAX) {
+		return INT16_MAX;
+	}
+	if (value < INT16_MIN) {
+		return INT16_MIN;
+	}
+	return (int16_t)value;
+}
+
+static struct audio_mixer_stream_s *mixer_get_stream(int id)
+{
+	if (id < 0 || id >= CONFIG_AUDIO_MIXER_MAX_STREAMS || !g_mixer.streams[id].used) {
+		meddbg("Invalid mixer stream id %d\n", id);
+		return NULL;
+	}
+
+	return &g_mixer.streams[id];
+}
+
+static void mixer_release_stream(struct audio_mixer_stream_s *stream)
+{
+	rb_free(&stream->rb);
+	if (stream->src) {
+		src_destroy(stream->src);
+		stream->src = NULL;
+	}
+	if (stream->conv) {
+		free(stream->conv);
+		stream->conv = NULL;
+	}
+	stream->used = false;
+}
+
+/*
+ * Accumulate one period of the stream to acc[], with the gain ramped from
+ * the last one to the target one. Missing frames are regarded as silence
+ * and do not advance the ramp.
+ * Called with g_mixer.mutex held.
+ */
+static void mixer_accumulate(struct audio_mixer_stream_s *stream, int32_t *acc, bool ducked)
+{
+	int32_t target = stream->gain;
+	if (ducked) {
+		target = (target * MIXER_DUCK_GAIN) >> 15;
+	}
+
+	int32_t gain = (int32_t)stream->cur_gain << MIXER_RAMP_SHIFT;
+	int32_t step = ((target - stream->cur_gain) * (1 << MIXER_RAMP_SHIFT)) / CONFIG_AUDIO_MIXER_PERIOD_FRAMES;
+	unsigned int frames = 0;
+
+	while (frames < CONFIG_AUDIO_MIXER_PERIOD_FRAMES) {
+		const void *ptr;
+		unsigned int n = rb_read_peek(&stream->rb, &ptr) / MIXER_FRAME_BYTES;
+		if (n == 0) {
+			break;
+		}
+		if (n > CONFIG_AUDIO_MIXER_PERIOD_FRAMES - frames) {
+			n = CONFIG_AUDIO_MIXER_PERIOD_FRAMES - frames;
+		}
+
+		const int16_t *in = (const int16_t *)ptr;
+		int32_t *out = acc + frames * CONFIG_AUDIO_MIXER_CHANNELS;
+		unsigned int i;
+		for (i = 0; i < n; i++) {
+			gain += step;
+			int32_t g = gain >> MIXER_RAMP_SHIFT;
+			out[0] += (in[0] * g) >> 15;
+#if CONFIG_AUDIO_MIXER_CHANNELS == 2
+			out[1] += (in[1] * g) >> 15;
+#endif
+			in += CONFIG_AUDIO_MIXER_CHANNELS;
+			out += CONFIG_AUDIO_MIXER_CHANNELS;
+		}
+
+		rb_read(&stream->rb, NULL, n * MIXER_FRAME_BYTES);
+		frames += n;
+	}
+
+	/* If the stream ran dry, the ramp stopped where the last frame was mixed
+	 * and goes on from there next period.
+	 */
+	if (frames == CONFIG_AUDIO_MIXER_PERIOD_FRAMES) {
+		stream->cur_gain = (uint16_t)target;
+	} else {
+		stream->cur_gain = (uint16_t)(gain >> MIXER_RAMP_SHIFT);
+	}
+}
+
+static void *mixer_thread(void *arg)
+{
+	bool idle = true;
+
+	pthread_mutex_lock(&g_mixer.mutex);
+	while (g_mixer.running) {
+		struct audio_mixer_stream_s *stream;
+		bool playing = false;
+		bool ducking = false;
+		int i;
+
+		for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+			stream = &g_mixer.streams[i];
+			if (stream->used && !stream->paused) {
+				playing = true;
+				if ((stream->flags & AUDIO_MIXER_FLAG_DUCKING) && rb_used(&stream->rb) > 0) {
+					ducking = true;
+				}
+			}
+		}
+
+		if (!playing) {
+			// Nothing to play, pause the card and wait for a stream.
+			if (!idle) {
+				idle = true;
+				pthread_mutex_unlock(&g_mixer.mutex);
+				pause_audio_stream_out();
+				pthread_mutex_lock(&g_mixer.mutex);
+				continue;
+			}
+			pthread_cond_wait(&g_mixer.cond, &g_mixer.mutex);
+			continue;
+		}
+		idle = false;
+
+		// Mix exactly one period, so the cost of a cycle is bounded by the number of streams.
+		memset(g_mixer.acc, 0, MIXER_PERIOD_SAMPLES * sizeof(int32_t));
+		for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+			stream = &g_mixer.streams[i];
+			if (stream->used && !stream->paused) {
+				mixer_accumulate(stream, g_mixer.acc, ducking && !(stream->flags & AUDIO_MIXER_FLAG_DUCKING));
+			}
+		}
+
+		// Writers may be waiting for space.
+		pthread_cond_broadcast(&g_mixer.cond);
+		pthread_mutex_unlock(&g_mixer.mutex);
+
+		for (i = 0; i < MIXER_PERIOD_SAMPLES; i++) {
+			g_mixer.out[i] = mixer_sat16(g_mixer.acc[i]);
+		}
+
+		// Writing to the card blocks until there's space, it paces the mixer.
+		// The card may take less than a period per write, write the rest after it.
+		unsigned int written = 0;
+		while (written < CONFIG_AUDIO_MIXER_PERIOD_FRAMES) {
+			int ret = start_audio_stream_out(g_mixer.out + written * CONFIG_AUDIO_MIXER_CHANNELS, CONFIG_AUDIO_MIXER_PERIOD_FRAMES - written);
+			if (ret <= 0) {
+				meddbg("start_audio_stream_out failed, ret : %d\n", ret);
+				usleep(((CONFIG_AUDIO_MIXER_PERIOD_FRAMES - written) * 1000000ULL) / CONFIG_AUDIO_MIXER_SAMPLE_RATE);
+				break;
+			}
+			written += (unsigned int)ret;
+		}
+
+		pthread_mutex_lock(&g_mixer.mutex);
+	}
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	return NULL;
+}
+
+static audio_manager_result_t mixer_start(void)
+{
+	audio_manager_result_t ret;
+	struct sched_param sparam;
+	pthread_attr_t attr;
+
+	ret = set_audio_stream_out(CONFIG_AUDIO_MIXER_CHANNELS, CONFIG_AUDIO_MIXER_SAMPLE_RATE, PCM_FORMAT_S16_LE);
+	if (ret != AUDIO_MANAGER_SUCCESS) {
+		meddbg("set_audio_stream_out failed, ret : %d\n", ret);
+		return ret;
+	}
+
+	g_mixer.acc = (int32_t *)malloc(MIXER_PERIOD_SAMPLES * sizeof(int32_t));
+	g_mixer.out = (int16_t *)malloc(MIXER_PERIOD_SAMPLES * sizeof(int16_t));
+	if (!g_mixer.acc || !g_mixer.out) {
+		meddbg("Out of memory\n");
+		ret = AUDIO_MANAGER_OPERATION_FAIL;
+		goto error_with_card;
+	}
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_AUDIO_MIXER_STACKSIZE);
+	sparam.sched_priority = CONFIG_AUDIO_MIXER_PRIORITY;
+	pthread_attr_setschedparam(&attr, &sparam);
+	pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+
+	g_mixer.running = true;
+	if (pthread_create(&g_mixer.thread, &attr, mixer_thread, NULL) != OK) {
+		meddbg("Fail to create mixer thread\n");
+		g_mixer.running = false;
+		ret = AUDIO_MANAGER_OPERATION_FAIL;
+		goto error_with_card;
+	}
+	pthread_setname_np(g_mixer.thread, "AudioMixer");
+
+	return AUDIO_MANAGER_SUCCESS;
+
+error_with_card:
+	free(g_mixer.acc);
+	free(g_mixer.out);
+	g_mixer.acc = NULL;
+	g_mixer.out = NULL;
+	reset_audio_stream_out();
+	return ret;
+}
+
+static void mixer_stop(void)
+{
+	pthread_mutex_lock(&g_mixer.mutex);
+	g_mixer.running = false;
+	pthread_cond_broadcast(&g_mixer.cond);
+	pthread_mutex_unlock(&g_mixer.mutex);
+	pthread_join(g_mixer.thread, NULL);
+
+	stop_audio_stream_out();
+	reset_audio_stream_out();
+
+	free(g_mixer.acc);
+	free(g_mixer.out);
+	g_mixer.acc = NULL;
+	g_mixer.out = NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+int audio_mixer_open(unsigned int channels, unsigned int sample_rate, unsigned int flags)
+{
+	struct audio_mixer_stream_s *stream = NULL;
+	audio_manager_result_t ret;
+	int id;
+
+	if ((channels == 0) || (sample_rate == 0)) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	if (!src_is_valid_ratio((float)sample_rate / CONFIG_AUDIO_MIXER_SAMPLE_RATE)) {
+		meddbg("Sample rate %u is not supported\n", sample_rate);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	pthread_mutex_lock(&g_mixer.ctl_mutex);
+
+	for (id = 0; id < CONFIG_AUDIO_MIXER_MAX_STREAMS; id++) {
+		if (!g_mixer.streams[id].used) {
+			stream = &g_mixer.streams[id];
+			break;
+		}
+	}
+
+	if (!stream) {
+		meddbg("All of %d mixer streams are in use\n", CONFIG_AUDIO_MIXER_MAX_STREAMS);
+		pthread_mutex_unlock(&g_mixer.ctl_mutex);
+		return AUDIO_MANAGER_DEVICE_ALREADY_IN_USE;
+	}
+
+	memset(stream, 0, sizeof(struct audio_mixer_stream_s));
+	stream->flags = flags;
+	stream->channels = channels;
+	stream->sample_rate = sample_rate;
+	stream->frame_count = (CONFIG_AUDIO_MIXER_PERIOD_FRAMES * sample_rate + CONFIG_AUDIO_MIXER_SAMPLE_RATE - 1) / CONFIG_AUDIO_MIXER_SAMPLE_RATE;
+	stream->gain = AUDIO_MIXER_GAIN_UNITY;
+	stream->cur_gain = AUDIO_MIXER_GAIN_UNITY;
+
+	if (!rb_init(&stream->rb, MIXER_STREAM_BUFSIZE)) {
+		meddbg("Out of memory\n");
+		ret = AUDIO_MANAGER_OPERATION_FAIL;
+		goto error_with_stream;
+	}
+
+	if ((channels != CONFIG_AUDIO_MIXER_CHANNELS) || (sample_rate != CONFIG_AUDIO_MIXER_SAMPLE_RATE)) {
+		// Yes, converting is necessary, and it would be processed in src_simple().
+		stream->src = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+		stream->conv = (int16_t *)malloc(CONFIG_AUDIO_MIXER_PERIOD_FRAMES * MIXER_FRAME_BYTES);
+		if (!stream->src || !stream->conv) {
+			meddbg("Fail to prepare converting %u/%u -> %u/%u\n", channels, sample_rate, CONFIG_AUDIO_MIXER_CHANNELS, CONFIG_AUDIO_MIXER_SAMPLE_RATE);
+			ret = AUDIO_MANAGER_RESAMPLE_FAIL;
+			goto error_with_stream;
+		}
+	}
+
+	if (g_mixer.nstreams == 0) {
+		ret = mixer_start();
+		if (ret != AUDIO_MANAGER_SUCCESS) {
+			goto error_with_stream;
+		}
+	}
+
+	pthread_mutex_lock(&g_mixer.mutex);
+	stream->used = true;
+	g_mixer.nstreams++;
+	pthread_cond_broadcast(&g_mixer.cond);
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	pthread_mutex_unlock(&g_mixer.ctl_mutex);
+	medvdbg("mixer stream %d opened, %u/%u frame_count %u\n", id, channels, sample_rate, stream->frame_count);
+	return id;
+
+error_with_stream:
+	mixer_release_stream(stream);
+	pthread_mutex_unlock(&g_mixer.ctl_mutex);
+	return ret;
+}
+
+audio_manager_result_t audio_mixer_close(int id)
+{
+	struct audio_mixer_stream_s *stream;
+
+	pthread_mutex_lock(&g_mixer.ctl_mutex);
+	pthread_mutex_lock(&g_mixer.mutex);
+
+	stream = mixer_get_stream(id);
+	if (!stream) {
+		pthread_mutex_unlock(&g_mixer.mutex);
+		pthread_mutex_unlock(&g_mixer.ctl_mutex);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	mixer_release_stream(stream);
+	g_mixer.nstreams--;
+	pthread_cond_broadcast(&g_mixer.cond);
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	if (g_mixer.nstreams == 0) {
+		mixer_stop();
+	}
+
+	pthread_mutex_unlock(&g_mixer.ctl_mutex);
+	medvdbg("mixer stream %d closed\n", id);
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+/*
+ * Queue converted frames kept in stream->conv to the ring-buffer as much as
+ * possible. Called with g_mixer.mutex held.
+ */
+static void mixer_queue_converted(struct audio_mixer_stream_s *stream)
+{
+	unsigned int n = rb_avail(&stream->rb) / MIXER_FRAME_BYTES;
+	if (n > stream->conv_frames - stream->conv_offset) {
+		n = stream->conv_frames - stream->conv_offset;
+	}
+
+	rb_write(&stream->rb, stream->conv + stream->conv_offset * CONFIG_AUDIO_MIXER_CHANNELS, n * MIXER_FRAME_BYTES);
+	stream->conv_offset += n;
+	if (stream->conv_offset == stream->conv_frames) {
+		stream->conv_frames = 0;
+		stream->conv_offset = 0;
+	}
+}
+
+int audio_mixer_write(int id, const void *data, unsigned int frames)
+{
+	struct audio_mixer_stream_s *stream;
+	unsigned int used_frames = 0;
+	int ret = 0;
+
+	pthread_mutex_lock(&g_mixer.mutex);
+
+	stream = mixer_get_stream(id);
+	if (!stream || !data) {
+		pthread_mutex_unlock(&g_mixer.mutex);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	unsigned int frame_bytes = stream->channels * sizeof(int16_t);
+
+	while (stream->used && !stream->paused) {
+		if (!stream->src) {
+			// Same format as mixer, queue frames directly.
+			unsigned int n = rb_avail(&stream->rb) / MIXER_FRAME_BYTES;
+			if (n > frames - used_frames) {
+				n = frames - used_frames;
+			}
+			rb_write(&stream->rb, (const uint8_t *)data + used_frames * frame_bytes, n * MIXER_FRAME_BYTES);
+			used_frames += n;
+			if (used_frames == frames) {
+				break;
+			}
+		} else if (stream->conv_frames > 0) {
+			mixer_queue_converted(stream);
+			if (stream->conv_frames > 0) {
+				pthread_cond_wait(&g_mixer.cond, &g_mixer.mutex);
+			}
+			continue;
+		} else if (used_frames < frames) {
+			src_data_t srcData = { 0, };
+			srcData.origin_channel_num = stream->channels;
+			srcData.origin_sample_rate = stream->sample_rate;
+			srcData.origin_sample_width = SAMPLE_WIDTH_16BITS;
+			srcData.desired_channel_num = CONFIG_AUDIO_MIXER_CHANNELS;
+			srcData.desired_sample_rate = CONFIG_AUDIO_MIXER_SAMPLE_RATE;
+			srcData.desired_sample_width = SAMPLE_WIDTH_16BITS;
+			srcData.data_in = (const void *)((const uint8_t *)data + used_frames * frame_bytes);
+			srcData.input_frames = frames - used_frames;
+			srcData.data_out = (void *)stream->conv;
+			srcData.out_buf_length = CONFIG_AUDIO_MIXER_PERIOD_FRAMES * MIXER_FRAME_BYTES;
+
+			// Converting takes long, don't block the mixer thread meanwhile.
+			pthread_mutex_unlock(&g_mixer.mutex);
+			int src_ret = src_simple(stream->src, &srcData);
+			pthread_mutex_lock(&g_mixer.mutex);
+			if (src_ret < 0 || (srcData.input_frames_used == 0 && srcData.output_frames_gen == 0)) {
+				meddbg("Fail to convert %u/%u, error %d\n", used_frames, frames, src_ret);
+				ret = AUDIO_MANAGER_RESAMPLE_FAIL;
+				break;
+			}
+			used_frames += srcData.input_frames_used;
+			stream->conv_frames = srcData.output_frames_gen;
+			stream->conv_offset = 0;
+			continue;
+		} else {
+			break;
+		}
+
+		// Wait for the mixer thread consuming frames.
+		pthread_cond_wait(&g_mixer.cond, &g_mixer.mutex);
+	}
+
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	if (ret < 0) {
+		return ret;
+	}
+	return (int)used_frames;
+}
+
+unsigned int audio_mixer_get_frame_count(int id)
+{
+	struct audio_mixer_stream_s *stream;
+	unsigned int frames = 0;
+
+	pthread_mutex_lock(&g_mixer.mutex);
+	stream = mixer_get_stream(id);
+	if (stream) {
+		frames = stream->frame_count;
+	}
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	return frames;
+}
+
+audio_manager_result_t audio_mixer_pause(int id, bool pause)
+{
+	struct audio_mixer_stream_s *stream;
+
+	pthread_mutex_lock(&g_mixer.mutex);
+	stream = mixer_get_stream(id);
+	if (!stream) {
+		pthread_mutex_unlock(&g_mixer.mutex);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	stream->paused = pause;
+	pthread_cond_broadcast(&g_mixer.cond);
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+int audio_mixer_drain(int id, unsigned int timeout_ms)
+{
+	struct audio_mixer_stream_s *stream;
+	struct timespec abstime;
+	unsigned int frames;
+
+	clock_gettime(CLOCK_REALTIME, &abstime);
+	abstime.tv_sec += timeout_ms / 1000;
+	abstime.tv_nsec += (timeout_ms % 1000) * 1000000;
+	if (abstime.tv_nsec >= 1000000000) {
+		abstime.tv_sec++;
+		abstime.tv_nsec -= 1000000000;
+	}
+
+	pthread_mutex_lock(&g_mixer.mutex);
+	stream = mixer_get_stream(id);
+	if (!stream) {
+		pthread_mutex_unlock(&g_mixer.mutex);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	// The mixer thread signals after each period it mixed.
+	while (stream->used && !stream->paused && rb_used(&stream->rb) > 0) {
+		if (pthread_cond_timedwait(&g_mixer.cond, &g_mixer.mutex, &abstime) == ETIMEDOUT) {
+			break;
+		}
+	}
+
+	frames = 0;
+	if (stream->used && !stream->paused) {
+		frames = rb_used(&stream->rb) / MIXER_FRAME_BYTES;
+	}
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	return (int)frames;
+}
+
+audio_manager_result_t audio_mixer_flush(int id)
+{
+	struct audio_mixer_stream_s *stream;
+
+	pthread_mutex_lock(&g_mixer.mutex);
+	stream = mixer_get_stream(id);
+	if (!stream) {
+		pthread_mutex_unlock(&g_mixer.mutex);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	rb_reset(&stream->rb);
+	stream->conv_frames = 0;
+	stream->conv_offset = 0;
+	pthread_cond_broadcast(&g_mixer.cond);
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+audio_manager_result_t audio_mixer_set_gain(int id, uint16_t gain)
+{
+	struct audio_mixer_stream_s *stream;
+
+	if (gain > AUDIO_MIXER_GAIN_UNITY) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	pthread_mutex_lock(&g_mixer.mutex);
+	stream = mixer_get_stream(id);
+	if (!stream) {
+		pthread_mutex_unlock(&g_mixer.mutex);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	stream->gain = gain;
+	pthread_mutex_unlock(&g_mixer.mutex);
+
+	return AUDIO_MANAGER_SUCCESS;
+}
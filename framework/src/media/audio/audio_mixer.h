@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file audio_mixer.h
+ * @brief Software mixer, sums PCM of several players into the output card.
+ */
+
+#ifndef __AUDIO_MIXER_H
+#define __AUDIO_MIXER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "audio_manager.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+/**
+ * @brief Unity gain of a mixer stream, gains are Q15 fixed-point values.
+ */
+#define AUDIO_MIXER_GAIN_UNITY 0x8000
+
+/**
+ * @brief Stream flags given to audio_mixer_open()
+ */
+enum audio_mixer_flag_e {
+	AUDIO_MIXER_FLAG_NONE = 0,
+	/* While this stream is playing, the other streams are ducked */
+	AUDIO_MIXER_FLAG_DUCKING = 1
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: audio_mixer_open
+ *
+ * Description:
+ *   Open a stream on the mixer. The output card is set up and the mixer
+ *   thread is started with the first stream. PCM written to the stream is
+ *   converted to the mixer format, then mixed with the other streams.
+ *
+ * Input parameters:
+ *   channels: number of channels of the stream
+ *   sample_rate: sample rate of the stream
+ *   flags: bitwise OR of audio_mixer_flag_e
+ *
+ * Return Value:
+ *   On success, the stream id (zero or positive). Otherwise, a negative value.
+ ****************************************************************************/
+int audio_mixer_open(unsigned int channels, unsigned int sample_rate, unsigned int flags);
+
+/****************************************************************************
+ * Name: audio_mixer_close
+ *
+ * Description:
+ *   Close the stream, data not mixed yet is dropped. The mixer thread is
+ *   stopped and the output card is reset with the last stream.
+ *
+ * Input parameters:
+ *   id: stream id returned by audio_mixer_open()
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_close(int id);
+
+/****************************************************************************
+ * Name: audio_mixer_write
+ *
+ * Description:
+ *   Write frames to the stream. It is blocked until all frames are queued,
+ *   or the stream is paused or closed.
+ *
+ * Input parameters:
+ *   id: stream id returned by audio_mixer_open()
+ *   data: 16bit PCM in the stream format
+ *   frames: number of frames in data
+ *
+ * Return Value:
+ *   On success, the number of frames written. Otherwise, a negative value.
+ ****************************************************************************/
+int audio_mixer_write(int id, const void *data, unsigned int frames);
+
+/****************************************************************************
+ * Name: audio_mixer_get_frame_count
+ *
+ * Description:
+ *   Get number of frames in the stream format, lasting one mixer period.
+ *   Writing this many frames per call keeps all streams in pace.
+ *
+ * Input parameters:
+ *   id: stream id returned by audio_mixer_open()
+ *
+ * Return Value:
+ *   On success, the number of frames. Otherwise, 0.
+ ****************************************************************************/
+unsigned int audio_mixer_get_frame_count(int id);
+
+/****************************************************************************
+ * Name: audio_mixer_pause
+ *
+ * Description:
+ *   Pause or resume the stream. Paused stream keeps its queued data, but it
+ *   is not mixed. Pending audio_mixer_write() returns at pausing.
+ *
+ * Input parameters:
+ *   id: stream id returned by audio_mixer_open()
+ *   pause: true to pause, false to resume
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_pause(int id, bool pause);
+
+/****************************************************************************
+ * Name: audio_mixer_drain
+ *
+ * Description:
+ *   Wait until all data queued in the stream is mixed, it is paused, or
+ *   timeout_ms passed. The caller polls again while frames are left, so it
+ *   is never blocked for long.
+ *
+ * Input parameters:
+ *   id: stream id returned by audio_mixer_open()
+ *   timeout_ms: upper bound of the wait in milliseconds
+ *
+ * Return Value:
+ *   The number of frames still queued, 0 once drained. Otherwise, a negative
+ *   value.
+ ****************************************************************************/
+int audio_mixer_drain(int id, unsigned int timeout_ms);
+
+/****************************************************************************
+ * Name: audio_mixer_flush
+ *
+ * Description:
+ *   Drop data queued in the stream, which was not mixed yet.
+ *
+ * Input parameters:
+ *   id: stream id returned by audio_mixer_open()
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_flush(int id);
+
+/****************************************************************************
+ * Name: audio_mixer_set_gain
+ *
+ * Description:
+ *   Set gain of the stream, applied together with ducking while mixing.
+ *   Changes are ramped over one period to avoid clicks.
+ *
+ * Input parameters:
+ *   id: stream id returned by audio_mixer_open()
+ *   gain: Q15 gain, AUDIO_MIXER_GAIN_UNITY means 0dB
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_set_gain(int id, uint16_t gain);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,753 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Polyphase FIR coefficient tables used by resample_poly() in samplerate.c.
+ *
+ * Each table holds 'phases' rows of 'taps' Q15 coefficients. Row p is the
+ * windowed-sinc lowpass sampled at the distances (k - taps / 2 + 1 - p / phases),
+ * k = 0..taps-1, between the output position and the input frames. Each row
+ * is normalized to unity DC gain. Taps are even, so a row can be read in
+ * pairs of coefficients by dual 16-bit MAC instructions.
+ */
+
+#ifndef __POLYPHASE_COEFF_H
+#define __POLYPHASE_COEFF_H
+
+#include <stdint.h>
+
+/* Up resampling, e.g. 16K->44.1K/48K, 44.1K->48K.
+ * 128 phases x 16 taps, cutoff 0.45 of input rate, Kaiser beta 5.0 */
+static const int16_t poly_coeff_up[128 * 16] = {
+	137, -381, 796, -1370, 2032, -2659, 3110, 29466,
+	3110, -2659, 2032, -1370, 796, -381, 137, -28,
+	138, -381, 791, -1354, 1990, -2564, 2873, 29466,
+	3348, -2753, 2073, -1386, 799, -380, 136, -28,
+	139, -381, 787, -1337, 1948, -2469, 2640, 29455,
+	3589, -2846, 2113, -1401, 803, -379, 134, -27,
+	140, -381, 782, -1320, 1905, -2374, 2408, 29443,
+	3832, -2939, 2153, -1415, 806, -378, 133, -27,
+	141, -381, 777, -1302, 1861, -2279, 2180, 29425,
+	4078, -3032, 2192, -1429, 808, -377, 132, -26,
+	141, -381, 771, -1284, 1817, -2184, 1954, 29405,
+	4325, -3123, 2230, -1442, 810, -376, 130, -25,
+	142, -380, 765, -1265, 1772, -2088, 1730, 29378,
+	4575, -3215, 2268, -1455, 812, -374, 128, -25,
+	143, -379, 759, -1246, 1727, -1992, 1510, 29343,
+	4827, -3305, 2304, -1467, 813, -372, 127, -24,
+	143, -378, 753, -1226, 1681, -1897, 1292, 29306,
+	5081, -3395, 2340, -1478, 814, -370, 125, -23,
+	143, -377, 746, -1206, 1635, -1801, 1077, 29264,
+	5337, -3484, 2375, -1489, 815, -368, 123, -22,
+	144, -376, 739, -1185, 1588, -1705, 864, 29217,
+	5595, -3572, 2409, -1499, 815, -365, 121, -22,
+	144, -374, 731, -1164, 1541, -1609, 655, 29165,
+	5854, -3660, 2442, -1508, 815, -362, 119, -21,
+	144, -372, 723, -1143, 1494, -1514, 448, 29110,
+	6116, -3746, 2474, -1517, 814, -359, 116, -20,
+	144, -370, 715, -1121, 1446, -1419, 245, 29048,
+	6379, -3831, 2505, -1525, 813, -356, 114, -19,
+	144, -368, 707, -1099, 1398, -1323, 44, 28984,
+	6643, -3916, 2535, -1532, 811, -353, 111, -18,
+	144, -366, 698, -1076, 1350, -1229, -153, 28911,
+	6910, -3999, 2564, -1538, 809, -349, 109, -17,
+	143, -364, 689, -1053, 1302, -1134, -348, 28836,
+	7178, -4081, 2592, -1544, 807, -345, 106, -16,
+	143, -361, 680, -1030, 1253, -1040, -539, 28756,
+	7447, -4162, 2619, -1549, 804, -341, 103, -15,
+	143, -358, 671, -1007, 1204, -946, -727, 28669,
+	7718, -4242, 2645, -1553, 801, -337, 101, -14,
+	142, -355, 661, -983, 1155, -853, -913, 28582,
+	7990, -4320, 2669, -1557, 797, -332, 98, -13,
+	142, -352, 651, -959, 1105, -760, -1094, 28486,
+	8263, -4397, 2693, -1560, 793, -327, 95, -11,
+	141, -349, 641, -934, 1056, -668, -1273, 28389,
+	8537, -4472, 2715, -1562, 788, -322, 91, -10,
+	140, -346, 630, -910, 1006, -576, -1449, 28288,
+	8813, -4547, 2737, -1563, 783, -317, 88, -9,
+	140, -342, 620, -885, 957, -485, -1621, 28176,
+	9090, -4619, 2757, -1563, 777, -311, 85, -8,
+	139, -338, 609, -860, 907, -394, -1790, 28065,
+	9367, -4690, 2776, -1563, 771, -306, 81, -6,
+	138, -335, 598, -834, 857, -304, -1955, 27948,
+	9646, -4760, 2793, -1562, 765, -300, 78, -5,
+	137, -331, 586, -809, 807, -215, -2117, 27827,
+	9925, -4827, 2810, -1560, 758, -293, 74, -4,
+	136, -327, 575, -783, 758, -126, -2276, 27701,
+	10205, -4894, 2825, -1557, 750, -287, 70, -2,
+	135, -322, 563, -757, 708, -39, -2432, 27573,
+	10486, -4958, 2838, -1554, 742, -280, 66, -1,
+	134, -318, 551, -731, 658, 48, -2584, 27436,
+	10767, -5020, 2851, -1549, 734, -273, 63, 1,
+	133, -314, 540, -705, 609, 134, -2733, 27298,
+	11049, -5081, 2862, -1544, 725, -266, 59, 2,
+	131, -309, 527, -679, 560, 219, -2878, 27156,
+	11332, -5140, 2872, -1538, 716, -259, 54, 4,
+	130, -305, 515, -652, 510, 304, -3020, 27009,
+	11614, -5197, 2880, -1531, 706, -251, 50, 6,
+	129, -300, 503, -626, 461, 387, -3158, 26856,
+	11898, -5251, 2887, -1523, 696, -244, 46, 7,
+	127, -295, 490, -599, 412, 469, -3293, 26703,
+	12181, -5304, 2893, -1515, 685, -236, 41, 9,
+	126, -290, 477, -573, 364, 550, -3424, 26543,
+	12464, -5355, 2897, -1505, 674, -227, 37, 10,
+	124, -285, 465, -546, 315, 631, -3552, 26378,
+	12748, -5403, 2900, -1495, 663, -219, 32, 12,
+	123, -280, 452, -519, 267, 710, -3677, 26210,
+	13032, -5450, 2901, -1484, 651, -210, 28, 14,
+	121, -275, 439, -492, 219, 788, -3797, 26040,
+	13315, -5494, 2901, -1472, 638, -202, 23, 16,
+	119, -269, 426, -466, 172, 865, -3915, 25865,
+	13598, -5536, 2900, -1459, 625, -193, 18, 18,
+	118, -264, 412, -439, 124, 941, -4029, 25686,
+	13881, -5575, 2897, -1445, 612, -183, 13, 19,
+	116, -259, 399, -412, 77, 1015, -4139, 25504,
+	14164, -5612, 2892, -1430, 598, -174, 8, 21,
+	114, -253, 386, -385, 31, 1089, -4246, 25315,
+	14447, -5647, 2886, -1415, 584, -164, 3, 23,
+	112, -247, 372, -359, -15, 1161, -4349, 25126,
+	14729, -5679, 2878, -1399, 569, -154, -2, 25,
+	110, -242, 359, -332, -61, 1232, -4449, 24933,
+	15010, -5709, 2869, -1382, 554, -144, -7, 27,
+	109, -236, 345, -306, -106, 1301, -4545, 24735,
+	15291, -5736, 2859, -1364, 538, -134, -12, 29,
+	107, -230, 332, -279, -151, 1370, -4638, 24533,
+	15571, -5761, 2846, -1345, 523, -124, -17, 31,
+	105, -225, 318, -253, -196, 1437, -4727, 24331,
+	15850, -5783, 2833, -1325, 506, -113, -23, 33,
+	103, -219, 305, -227, -240, 1503, -4813, 24123,
+	16129, -5802, 2817, -1304, 489, -103, -28, 35,
+	101, -213, 291, -200, -283, 1567, -4895, 23912,
+	16406, -5819, 2801, -1283, 472, -92, -34, 37,
+	99, -207, 277, -174, -326, 1630, -4974, 23698,
+	16683, -5832, 2782, -1261, 454, -81, -39, 39,
+	97, -201, 264, -149, -369, 1691, -5050, 23483,
+	16958, -5843, 2762, -1238, 436, -69, -45, 41,
+	95, -195, 250, -123, -410, 1752, -5121, 23261,
+	17232, -5852, 2741, -1214, 418, -58, -51, 43,
+	93, -189, 237, -97, -452, 1810, -5190, 23038,
+	17505, -5857, 2717, -1189, 399, -46, -56, 45,
+	91, -183, 223, -72, -492, 1868, -5255, 22812,
+	17777, -5860, 2693, -1164, 380, -35, -62, 47,
+	88, -177, 209, -47, -533, 1923, -5316, 22585,
+	18047, -5859, 2666, -1137, 361, -23, -68, 49,
+	86, -171, 196, -22, -572, 1978, -5374, 22351,
+	18316, -5856, 2638, -1110, 341, -11, -74, 52,
+	84, -165, 182, 3, -611, 2031, -5429, 22117,
+	18583, -5849, 2609, -1082, 320, 1, -80, 54,
+	82, -158, 169, 27, -649, 2082, -5480, 21878,
+	18848, -5840, 2578, -1053, 300, 14, -86, 56,
+	80, -152, 156, 51, -687, 2132, -5528, 21639,
+	19112, -5827, 2545, -1024, 279, 26, -92, 58,
+	78, -146, 142, 75, -724, 2180, -5573, 21398,
+	19374, -5812, 2511, -993, 257, 39, -98, 60,
+	76, -140, 129, 99, -760, 2227, -5614, 21152,
+	19634, -5793, 2475, -962, 236, 51, -104, 62,
+	73, -134, 116, 123, -795, 2272, -5652, 20902,
+	19893, -5771, 2438, -930, 214, 64, -110, 65,
+	71, -128, 103, 146, -830, 2316, -5687, 20654,
+	20149, -5746, 2399, -898, 191, 77, -116, 67,
+	69, -122, 90, 169, -864, 2358, -5718, 20403,
+	20401, -5718, 2358, -864, 169, 90, -122, 69,
+	67, -116, 77, 191, -898, 2399, -5746, 20149,
+	20654, -5687, 2316, -830, 146, 103, -128, 71,
+	65, -110, 64, 214, -930, 2438, -5771, 19893,
+	20902, -5652, 2272, -795, 123, 116, -134, 73,
+	62, -104, 51, 236, -962, 2475, -5793, 19634,
+	21152, -5614, 2227, -760, 99, 129, -140, 76,
+	60, -98, 39, 257, -993, 2511, -5812, 19374,
+	21398, -5573, 2180, -724, 75, 142, -146, 78,
+	58, -92, 26, 279, -1024, 2545, -5827, 19112,
+	21639, -5528, 2132, -687, 51, 156, -152, 80,
+	56, -86, 14, 300, -1053, 2578, -5840, 18848,
+	21878, -5480, 2082, -649, 27, 169, -158, 82,
+	54, -80, 1, 320, -1082, 2609, -5849, 18583,
+	22117, -5429, 2031, -611, 3, 182, -165, 84,
+	52, -74, -11, 341, -1110, 2638, -5856, 18316,
+	22351, -5374, 1978, -572, -22, 196, -171, 86,
+	49, -68, -23, 361, -1137, 2666, -5859, 18047,
+	22585, -5316, 1923, -533, -47, 209, -177, 88,
+	47, -62, -35, 380, -1164, 2693, -5860, 17777,
+	22812, -5255, 1868, -492, -72, 223, -183, 91,
+	45, -56, -46, 399, -1189, 2717, -5857, 17505,
+	23038, -5190, 1810, -452, -97, 237, -189, 93,
+	43, -51, -58, 418, -1214, 2741, -5852, 17232,
+	23261, -5121, 1752, -410, -123, 250, -195, 95,
+	41, -45, -69, 436, -1238, 2762, -5843, 16958,
+	23483, -5050, 1691, -369, -149, 264, -201, 97,
+	39, -39, -81, 454, -1261, 2782, -5832, 16683,
+	23698, -4974, 1630, -326, -174, 277, -207, 99,
+	37, -34, -92, 472, -1283, 2801, -5819, 16406,
+	23912, -4895, 1567, -283, -200, 291, -213, 101,
+	35, -28, -103, 489, -1304, 2817, -5802, 16129,
+	24123, -4813, 1503, -240, -227, 305, -219, 103,
+	33, -23, -113, 506, -1325, 2833, -5783, 15850,
+	24331, -4727, 1437, -196, -253, 318, -225, 105,
+	31, -17, -124, 523, -1345, 2846, -5761, 15571,
+	24533, -4638, 1370, -151, -279, 332, -230, 107,
+	29, -12, -134, 538, -1364, 2859, -5736, 15291,
+	24735, -4545, 1301, -106, -306, 345, -236, 109,
+	27, -7, -144, 554, -1382, 2869, -5709, 15010,
+	24933, -4449, 1232, -61, -332, 359, -242, 110,
+	25, -2, -154, 569, -1399, 2878, -5679, 14729,
+	25126, -4349, 1161, -15, -359, 372, -247, 112,
+	23, 3, -164, 584, -1415, 2886, -5647, 14447,
+	25315, -4246, 1089, 31, -385, 386, -253, 114,
+	21, 8, -174, 598, -1430, 2892, -5612, 14164,
+	25504, -4139, 1015, 77, -412, 399, -259, 116,
+	19, 13, -183, 612, -1445, 2897, -5575, 13881,
+	25686, -4029, 941, 124, -439, 412, -264, 118,
+	18, 18, -193, 625, -1459, 2900, -5536, 13598,
+	25865, -3915, 865, 172, -466, 426, -269, 119,
+	16, 23, -202, 638, -1472, 2901, -5494, 13315,
+	26040, -3797, 788, 219, -492, 439, -275, 121,
+	14, 28, -210, 651, -1484, 2901, -5450, 13032,
+	26210, -3677, 710, 267, -519, 452, -280, 123,
+	12, 32, -219, 663, -1495, 2900, -5403, 12748,
+	26378, -3552, 631, 315, -546, 465, -285, 124,
+	10, 37, -227, 674, -1505, 2897, -5355, 12464,
+	26543, -3424, 550, 364, -573, 477, -290, 126,
+	9, 41, -236, 685, -1515, 2893, -5304, 12181,
+	26703, -3293, 469, 412, -599, 490, -295, 127,
+	7, 46, -244, 696, -1523, 2887, -5251, 11898,
+	26856, -3158, 387, 461, -626, 503, -300, 129,
+	6, 50, -251, 706, -1531, 2880, -5197, 11614,
+	27009, -3020, 304, 510, -652, 515, -305, 130,
+	4, 54, -259, 716, -1538, 2872, -5140, 11332,
+	27156, -2878, 219, 560, -679, 527, -309, 131,
+	2, 59, -266, 725, -1544, 2862, -5081, 11049,
+	27298, -2733, 134, 609, -705, 540, -314, 133,
+	1, 63, -273, 734, -1549, 2851, -5020, 10767,
+	27436, -2584, 48, 658, -731, 551, -318, 134,
+	-1, 66, -280, 742, -1554, 2838, -4958, 10486,
+	27573, -2432, -39, 708, -757, 563, -322, 135,
+	-2, 70, -287, 750, -1557, 2825, -4894, 10205,
+	27701, -2276, -126, 758, -783, 575, -327, 136,
+	-4, 74, -293, 758, -1560, 2810, -4827, 9925,
+	27827, -2117, -215, 807, -809, 586, -331, 137,
+	-5, 78, -300, 765, -1562, 2793, -4760, 9646,
+	27948, -1955, -304, 857, -834, 598, -335, 138,
+	-6, 81, -306, 771, -1563, 2776, -4690, 9367,
+	28065, -1790, -394, 907, -860, 609, -338, 139,
+	-8, 85, -311, 777, -1563, 2757, -4619, 9090,
+	28176, -1621, -485, 957, -885, 620, -342, 140,
+	-9, 88, -317, 783, -1563, 2737, -4547, 8813,
+	28288, -1449, -576, 1006, -910, 630, -346, 140,
+	-10, 91, -322, 788, -1562, 2715, -4472, 8537,
+	28389, -1273, -668, 1056, -934, 641, -349, 141,
+	-11, 95, -327, 793, -1560, 2693, -4397, 8263,
+	28486, -1094, -760, 1105, -959, 651, -352, 142,
+	-13, 98, -332, 797, -1557, 2669, -4320, 7990,
+	28582, -913, -853, 1155, -983, 661, -355, 142,
+	-14, 101, -337, 801, -1553, 2645, -4242, 7718,
+	28669, -727, -946, 1204, -1007, 671, -358, 143,
+	-15, 103, -341, 804, -1549, 2619, -4162, 7447,
+	28756, -539, -1040, 1253, -1030, 680, -361, 143,
+	-16, 106, -345, 807, -1544, 2592, -4081, 7178,
+	28836, -348, -1134, 1302, -1053, 689, -364, 143,
+	-17, 109, -349, 809, -1538, 2564, -3999, 6910,
+	28911, -153, -1229, 1350, -1076, 698, -366, 144,
+	-18, 111, -353, 811, -1532, 2535, -3916, 6643,
+	28984, 44, -1323, 1398, -1099, 707, -368, 144,
+	-19, 114, -356, 813, -1525, 2505, -3831, 6379,
+	29048, 245, -1419, 1446, -1121, 715, -370, 144,
+	-20, 116, -359, 814, -1517, 2474, -3746, 6116,
+	29110, 448, -1514, 1494, -1143, 723, -372, 144,
+	-21, 119, -362, 815, -1508, 2442, -3660, 5854,
+	29165, 655, -1609, 1541, -1164, 731, -374, 144,
+	-22, 121, -365, 815, -1499, 2409, -3572, 5595,
+	29217, 864, -1705, 1588, -1185, 739, -376, 144,
+	-22, 123, -368, 815, -1489, 2375, -3484, 5337,
+	29264, 1077, -1801, 1635, -1206, 746, -377, 143,
+	-23, 125, -370, 814, -1478, 2340, -3395, 5081,
+	29306, 1292, -1897, 1681, -1226, 753, -378, 143,
+	-24, 127, -372, 813, -1467, 2304, -3305, 4827,
+	29343, 1510, -1992, 1727, -1246, 759, -379, 143,
+	-25, 128, -374, 812, -1455, 2268, -3215, 4575,
+	29378, 1730, -2088, 1772, -1265, 765, -380, 142,
+	-25, 130, -376, 810, -1442, 2230, -3123, 4325,
+	29405, 1954, -2184, 1817, -1284, 771, -381, 141,
+	-26, 132, -377, 808, -1429, 2192, -3032, 4078,
+	29425, 2180, -2279, 1861, -1302, 777, -381, 141,
+	-27, 133, -378, 806, -1415, 2153, -2939, 3832,
+	29443, 2408, -2374, 1905, -1320, 782, -381, 140,
+	-27, 134, -379, 803, -1401, 2113, -2846, 3589,
+	29455, 2640, -2469, 1948, -1337, 787, -381, 139,
+	-28, 136, -380, 799, -1386, 2073, -2753, 3348,
+	29466, 2873, -2564, 1990, -1354, 791, -381, 138,
+};
+
+/* Down resampling in ratio [0.85, 1), e.g. 48K->44.1K.
+ * 128 phases x 16 taps, cutoff 0.41 of input rate, Kaiser beta 5.0 */
+static const int16_t poly_coeff_near[128 * 16] = {
+	-124, 100, 246, -1112, 2497, -4101, 5403, 26903,
+	5403, -4101, 2497, -1112, 246, 100, -124, 47,
+	-120, 91, 260, -1125, 2492, -4041, 5187, 26900,
+	5620, -4160, 2501, -1098, 232, 108, -127, 48,
+	-117, 83, 274, -1138, 2486, -3980, 4973, 26892,
+	5838, -4217, 2504, -1084, 218, 117, -130, 49,
+	-114, 75, 287, -1150, 2479, -3917, 4759, 26884,
+	6058, -4274, 2506, -1069, 203, 125, -133, 49,
+	-110, 67, 300, -1162, 2471, -3854, 4548, 26870,
+	6279, -4329, 2506, -1053, 188, 134, -137, 50,
+	-107, 58, 313, -1173, 2462, -3790, 4338, 26854,
+	6501, -4383, 2506, -1037, 173, 142, -140, 51,
+	-104, 50, 326, -1183, 2452, -3725, 4129, 26832,
+	6724, -4436, 2505, -1020, 158, 151, -143, 52,
+	-100, 42, 338, -1193, 2441, -3659, 3922, 26807,
+	6948, -4487, 2503, -1002, 142, 160, -146, 52,
+	-97, 35, 350, -1202, 2429, -3592, 3717, 26779,
+	7174, -4537, 2499, -984, 126, 168, -150, 53,
+	-94, 27, 362, -1210, 2416, -3524, 3514, 26745,
+	7400, -4585, 2495, -966, 110, 177, -153, 54,
+	-90, 19, 374, -1218, 2402, -3455, 3312, 26708,
+	7627, -4632, 2489, -946, 94, 186, -156, 54,
+	-87, 11, 385, -1225, 2388, -3386, 3112, 26669,
+	7855, -4678, 2482, -927, 78, 195, -159, 55,
+	-84, 4, 396, -1232, 2372, -3316, 2914, 26625,
+	8084, -4722, 2474, -906, 61, 204, -162, 56,
+	-81, -4, 407, -1238, 2356, -3245, 2717, 26578,
+	8314, -4765, 2466, -885, 45, 212, -165, 56,
+	-77, -11, 417, -1244, 2339, -3173, 2523, 26527,
+	8544, -4806, 2455, -864, 28, 221, -168, 57,
+	-74, -19, 427, -1249, 2321, -3101, 2330, 26474,
+	8775, -4845, 2444, -842, 11, 230, -171, 57,
+	-71, -26, 437, -1253, 2302, -3029, 2140, 26415,
+	9007, -4883, 2432, -819, -7, 239, -174, 58,
+	-68, -33, 447, -1257, 2282, -2955, 1951, 26352,
+	9240, -4919, 2418, -796, -24, 248, -177, 59,
+	-64, -40, 456, -1260, 2262, -2882, 1765, 26288,
+	9472, -4954, 2404, -772, -42, 256, -180, 59,
+	-61, -47, 465, -1263, 2241, -2807, 1580, 26217,
+	9706, -4986, 2388, -748, -60, 265, -182, 60,
+	-58, -54, 474, -1265, 2219, -2733, 1398, 26145,
+	9940, -5017, 2371, -723, -78, 274, -185, 60,
+	-55, -60, 482, -1267, 2196, -2658, 1217, 26071,
+	10174, -5046, 2353, -698, -96, 283, -188, 60,
+	-52, -67, 490, -1268, 2173, -2582, 1039, 25991,
+	10409, -5074, 2334, -672, -114, 291, -191, 61,
+	-49, -73, 498, -1268, 2148, -2506, 863, 25907,
+	10644, -5099, 2313, -646, -132, 300, -193, 61,
+	-46, -80, 506, -1268, 2124, -2430, 689, 25819,
+	10879, -5123, 2292, -619, -150, 309, -196, 62,
+	-43, -86, 513, -1268, 2098, -2353, 517, 25732,
+	11114, -5145, 2269, -592, -169, 317, -198, 62,
+	-40, -92, 520, -1267, 2072, -2277, 348, 25640,
+	11349, -5165, 2245, -564, -188, 326, -201, 62,
+	-37, -98, 526, -1265, 2045, -2200, 181, 25542,
+	11585, -5182, 2220, -536, -206, 334, -203, 62,
+	-34, -104, 533, -1263, 2018, -2123, 16, 25440,
+	11820, -5198, 2194, -507, -225, 343, -205, 63,
+	-31, -110, 539, -1260, 1989, -2045, -147, 25338,
+	12056, -5212, 2167, -478, -244, 351, -208, 63,
+	-28, -115, 544, -1257, 1961, -1968, -307, 25231,
+	12291, -5224, 2138, -448, -263, 360, -210, 63,
+	-25, -121, 550, -1253, 1932, -1891, -465, 25120,
+	12527, -5234, 2109, -418, -282, 368, -212, 63,
+	-22, -126, 555, -1249, 1902, -1813, -620, 25005,
+	12762, -5241, 2078, -387, -301, 376, -214, 63,
+	-20, -132, 560, -1244, 1871, -1735, -773, 24890,
+	12997, -5247, 2046, -356, -320, 384, -216, 63,
+	-17, -137, 564, -1239, 1840, -1658, -924, 24773,
+	13231, -5250, 2013, -325, -340, 392, -218, 63,
+	-14, -142, 569, -1233, 1809, -1580, -1072, 24647,
+	13465, -5251, 1979, -293, -359, 400, -220, 63,
+	-12, -147, 573, -1227, 1777, -1503, -1218, 24522,
+	13699, -5250, 1943, -261, -378, 408, -221, 63,
+	-9, -152, 576, -1221, 1745, -1426, -1361, 24393,
+	13932, -5247, 1907, -228, -397, 416, -223, 63,
+	-6, -156, 580, -1213, 1712, -1348, -1502, 24258,
+	14165, -5241, 1869, -195, -417, 424, -225, 63,
+	-4, -161, 583, -1206, 1679, -1271, -1640, 24125,
+	14397, -5234, 1830, -162, -436, 431, -226, 63,
+	-1, -165, 586, -1198, 1645, -1195, -1775, 23985,
+	14629, -5224, 1790, -128, -455, 439, -228, 63,
+	1, -169, 588, -1190, 1611, -1118, -1909, 23846,
+	14860, -5211, 1749, -94, -475, 446, -229, 62,
+	3, -173, 591, -1181, 1577, -1041, -2039, 23700,
+	15090, -5197, 1707, -60, -494, 453, -230, 62,
+	6, -177, 592, -1171, 1542, -965, -2167, 23551,
+	15320, -5180, 1664, -25, -513, 460, -231, 62,
+	8, -181, 594, -1162, 1507, -890, -2293, 23403,
+	15548, -5160, 1620, 10, -532, 467, -232, 61,
+	10, -185, 596, -1152, 1471, -814, -2415, 23248,
+	15776, -5138, 1574, 46, -551, 474, -233, 61,
+	13, -189, 597, -1141, 1435, -739, -2536, 23094,
+	16002, -5114, 1528, 81, -570, 481, -234, 60,
+	15, -192, 598, -1130, 1399, -664, -2653, 22934,
+	16228, -5088, 1481, 117, -589, 487, -235, 60,
+	17, -195, 598, -1119, 1363, -590, -2768, 22772,
+	16453, -5058, 1432, 153, -608, 494, -235, 59,
+	19, -199, 599, -1107, 1326, -516, -2881, 22610,
+	16676, -5027, 1382, 190, -627, 500, -236, 59,
+	21, -202, 599, -1095, 1289, -443, -2991, 22443,
+	16899, -4993, 1332, 227, -646, 506, -236, 58,
+	23, -205, 598, -1083, 1252, -370, -3098, 22276,
+	17120, -4956, 1280, 264, -665, 512, -237, 57,
+	25, -207, 598, -1070, 1215, -297, -3202, 22100,
+	17340, -4917, 1227, 301, -683, 518, -237, 57,
+	27, -210, 597, -1057, 1177, -226, -3304, 21929,
+	17558, -4876, 1174, 338, -702, 524, -237, 56,
+	29, -213, 596, -1044, 1140, -154, -3403, 21752,
+	17776, -4832, 1119, 375, -720, 529, -237, 55,
+	30, -215, 595, -1030, 1102, -84, -3500, 21574,
+	17991, -4785, 1064, 413, -738, 534, -237, 54,
+	32, -217, 594, -1016, 1064, -14, -3594, 21391,
+	18206, -4736, 1007, 451, -756, 540, -237, 53,
+	34, -220, 592, -1002, 1026, 56, -3685, 21209,
+	18418, -4684, 950, 489, -774, 544, -237, 52,
+	35, -222, 590, -987, 988, 125, -3773, 21021,
+	18630, -4630, 891, 527, -791, 549, -236, 51,
+	37, -223, 588, -972, 949, 193, -3859, 20833,
+	18839, -4573, 832, 565, -809, 554, -236, 50,
+	39, -225, 585, -957, 911, 260, -3943, 20643,
+	19047, -4513, 772, 603, -826, 558, -235, 49,
+	40, -227, 583, -941, 872, 327, -4023, 20449,
+	19253, -4451, 711, 642, -843, 562, -234, 48,
+	42, -228, 580, -926, 834, 393, -4101, 20254,
+	19457, -4386, 649, 680, -860, 566, -233, 47,
+	43, -230, 577, -910, 795, 458, -4176, 20058,
+	19660, -4319, 586, 719, -877, 570, -232, 46,
+	44, -231, 573, -893, 757, 522, -4249, 19860,
+	19862, -4249, 522, 757, -893, 573, -231, 44,
+	46, -232, 570, -877, 719, 586, -4319, 19660,
+	20058, -4176, 458, 795, -910, 577, -230, 43,
+	47, -233, 566, -860, 680, 649, -4386, 19457,
+	20254, -4101, 393, 834, -926, 580, -228, 42,
+	48, -234, 562, -843, 642, 711, -4451, 19253,
+	20449, -4023, 327, 872, -941, 583, -227, 40,
+	49, -235, 558, -826, 603, 772, -4513, 19047,
+	20643, -3943, 260, 911, -957, 585, -225, 39,
+	50, -236, 554, -809, 565, 832, -4573, 18839,
+	20833, -3859, 193, 949, -972, 588, -223, 37,
+	51, -236, 549, -791, 527, 891, -4630, 18630,
+	21021, -3773, 125, 988, -987, 590, -222, 35,
+	52, -237, 544, -774, 489, 950, -4684, 18418,
+	21209, -3685, 56, 1026, -1002, 592, -220, 34,
+	53, -237, 540, -756, 451, 1007, -4736, 18206,
+	21391, -3594, -14, 1064, -1016, 594, -217, 32,
+	54, -237, 534, -738, 413, 1064, -4785, 17991,
+	21574, -3500, -84, 1102, -1030, 595, -215, 30,
+	55, -237, 529, -720, 375, 1119, -4832, 17776,
+	21752, -3403, -154, 1140, -1044, 596, -213, 29,
+	56, -237, 524, -702, 338, 1174, -4876, 17558,
+	21929, -3304, -226, 1177, -1057, 597, -210, 27,
+	57, -237, 518, -683, 301, 1227, -4917, 17340,
+	22100, -3202, -297, 1215, -1070, 598, -207, 25,
+	57, -237, 512, -665, 264, 1280, -4956, 17120,
+	22276, -3098, -370, 1252, -1083, 598, -205, 23,
+	58, -236, 506, -646, 227, 1332, -4993, 16899,
+	22443, -2991, -443, 1289, -1095, 599, -202, 21,
+	59, -236, 500, -627, 190, 1382, -5027, 16676,
+	22610, -2881, -516, 1326, -1107, 599, -199, 19,
+	59, -235, 494, -608, 153, 1432, -5058, 16453,
+	22772, -2768, -590, 1363, -1119, 598, -195, 17,
+	60, -235, 487, -589, 117, 1481, -5088, 16228,
+	22934, -2653, -664, 1399, -1130, 598, -192, 15,
+	60, -234, 481, -570, 81, 1528, -5114, 16002,
+	23094, -2536, -739, 1435, -1141, 597, -189, 13,
+	61, -233, 474, -551, 46, 1574, -5138, 15776,
+	23248, -2415, -814, 1471, -1152, 596, -185, 10,
+	61, -232, 467, -532, 10, 1620, -5160, 15548,
+	23403, -2293, -890, 1507, -1162, 594, -181, 8,
+	62, -231, 460, -513, -25, 1664, -5180, 15320,
+	23551, -2167, -965, 1542, -1171, 592, -177, 6,
+	62, -230, 453, -494, -60, 1707, -5197, 15090,
+	23700, -2039, -1041, 1577, -1181, 591, -173, 3,
+	62, -229, 446, -475, -94, 1749, -5211, 14860,
+	23846, -1909, -1118, 1611, -1190, 588, -169, 1,
+	63, -228, 439, -455, -128, 1790, -5224, 14629,
+	23985, -1775, -1195, 1645, -1198, 586, -165, -1,
+	63, -226, 431, -436, -162, 1830, -5234, 14397,
+	24125, -1640, -1271, 1679, -1206, 583, -161, -4,
+	63, -225, 424, -417, -195, 1869, -5241, 14165,
+	24258, -1502, -1348, 1712, -1213, 580, -156, -6,
+	63, -223, 416, -397, -228, 1907, -5247, 13932,
+	24393, -1361, -1426, 1745, -1221, 576, -152, -9,
+	63, -221, 408, -378, -261, 1943, -5250, 13699,
+	24522, -1218, -1503, 1777, -1227, 573, -147, -12,
+	63, -220, 400, -359, -293, 1979, -5251, 13465,
+	24647, -1072, -1580, 1809, -1233, 569, -142, -14,
+	63, -218, 392, -340, -325, 2013, -5250, 13231,
+	24773, -924, -1658, 1840, -1239, 564, -137, -17,
+	63, -216, 384, -320, -356, 2046, -5247, 12997,
+	24890, -773, -1735, 1871, -1244, 560, -132, -20,
+	63, -214, 376, -301, -387, 2078, -5241, 12762,
+	25005, -620, -1813, 1902, -1249, 555, -126, -22,
+	63, -212, 368, -282, -418, 2109, -5234, 12527,
+	25120, -465, -1891, 1932, -1253, 550, -121, -25,
+	63, -210, 360, -263, -448, 2138, -5224, 12291,
+	25231, -307, -1968, 1961, -1257, 544, -115, -28,
+	63, -208, 351, -244, -478, 2167, -5212, 12056,
+	25338, -147, -2045, 1989, -1260, 539, -110, -31,
+	63, -205, 343, -225, -507, 2194, -5198, 11820,
+	25440, 16, -2123, 2018, -1263, 533, -104, -34,
+	62, -203, 334, -206, -536, 2220, -5182, 11585,
+	25542, 181, -2200, 2045, -1265, 526, -98, -37,
+	62, -201, 326, -188, -564, 2245, -5165, 11349,
+	25640, 348, -2277, 2072, -1267, 520, -92, -40,
+	62, -198, 317, -169, -592, 2269, -5145, 11114,
+	25732, 517, -2353, 2098, -1268, 513, -86, -43,
+	62, -196, 309, -150, -619, 2292, -5123, 10879,
+	25819, 689, -2430, 2124, -1268, 506, -80, -46,
+	61, -193, 300, -132, -646, 2313, -5099, 10644,
+	25907, 863, -2506, 2148, -1268, 498, -73, -49,
+	61, -191, 291, -114, -672, 2334, -5074, 10409,
+	25991, 1039, -2582, 2173, -1268, 490, -67, -52,
+	60, -188, 283, -96, -698, 2353, -5046, 10174,
+	26071, 1217, -2658, 2196, -1267, 482, -60, -55,
+	60, -185, 274, -78, -723, 2371, -5017, 9940,
+	26145, 1398, -2733, 2219, -1265, 474, -54, -58,
+	60, -182, 265, -60, -748, 2388, -4986, 9706,
+	26217, 1580, -2807, 2241, -1263, 465, -47, -61,
+	59, -180, 256, -42, -772, 2404, -4954, 9472,
+	26288, 1765, -2882, 2262, -1260, 456, -40, -64,
+	59, -177, 248, -24, -796, 2418, -4919, 9240,
+	26352, 1951, -2955, 2282, -1257, 447, -33, -68,
+	58, -174, 239, -7, -819, 2432, -4883, 9007,
+	26415, 2140, -3029, 2302, -1253, 437, -26, -71,
+	57, -171, 230, 11, -842, 2444, -4845, 8775,
+	26474, 2330, -3101, 2321, -1249, 427, -19, -74,
+	57, -168, 221, 28, -864, 2455, -4806, 8544,
+	26527, 2523, -3173, 2339, -1244, 417, -11, -77,
+	56, -165, 212, 45, -885, 2466, -4765, 8314,
+	26578, 2717, -3245, 2356, -1238, 407, -4, -81,
+	56, -162, 204, 61, -906, 2474, -4722, 8084,
+	26625, 2914, -3316, 2372, -1232, 396, 4, -84,
+	55, -159, 195, 78, -927, 2482, -4678, 7855,
+	26669, 3112, -3386, 2388, -1225, 385, 11, -87,
+	54, -156, 186, 94, -946, 2489, -4632, 7627,
+	26708, 3312, -3455, 2402, -1218, 374, 19, -90,
+	54, -153, 177, 110, -966, 2495, -4585, 7400,
+	26745, 3514, -3524, 2416, -1210, 362, 27, -94,
+	53, -150, 168, 126, -984, 2499, -4537, 7174,
+	26779, 3717, -3592, 2429, -1202, 350, 35, -97,
+	52, -146, 160, 142, -1002, 2503, -4487, 6948,
+	26807, 3922, -3659, 2441, -1193, 338, 42, -100,
+	52, -143, 151, 158, -1020, 2505, -4436, 6724,
+	26832, 4129, -3725, 2452, -1183, 326, 50, -104,
+	51, -140, 142, 173, -1037, 2506, -4383, 6501,
+	26854, 4338, -3790, 2462, -1173, 313, 58, -107,
+	50, -137, 134, 188, -1053, 2506, -4329, 6279,
+	26870, 4548, -3854, 2471, -1162, 300, 67, -110,
+	49, -133, 125, 203, -1069, 2506, -4274, 6058,
+	26884, 4759, -3917, 2479, -1150, 287, 75, -114,
+	49, -130, 117, 218, -1084, 2504, -4217, 5838,
+	26892, 4973, -3980, 2486, -1138, 274, 83, -117,
+	48, -127, 108, 232, -1098, 2501, -4160, 5620,
+	26900, 5187, -4041, 2492, -1125, 260, 91, -120,
+};
+
+/* Down resampling in ratio [1/3, 0.37], e.g. 44.1K/48K->16K.
+ * 32 phases x 48 taps, cutoff 0.15 of input rate, Kaiser beta 6.0 */
+static const int16_t poly_coeff_third[32 * 48] = {
+	4, 20, 27, 0, -56, -90, -39, 97,
+	213, 158, -104, -399, -419, 0, 630, 907,
+	363, -859, -1849, -1419, 1029, 4864, 8395, 9826,
+	8395, 4864, 1029, -1419, -1849, -859, 363, 907,
+	630, 0, -419, -399, -104, 158, 213, 97,
+	-39, -90, -56, 0, 27, 20, 4, -4,
+	3, 20, 27, 1, -54, -90, -42, 92,
+	211, 164, -94, -392, -425, -19, 612, 910,
+	393, -818, -1834, -1463, 925, 4739, 8309, 9823,
+	8479, 4990, 1134, -1373, -1863, -899, 332, 904,
+	647, 19, -412, -405, -115, 153, 214, 102,
+	-36, -90, -58, -1, 27, 21, 4, -4,
+	3, 19, 27, 3, -52, -90, -45, 88,
+	209, 169, -84, -386, -430, -37, 594, 911,
+	422, -777, -1818, -1505, 822, 4613, 8220, 9822,
+	8561, 5115, 1241, -1326, -1875, -940, 301, 900,
+	664, 38, -405, -411, -125, 147, 215, 107,
+	-32, -90, -60, -3, 26, 21, 5, -4,
+	3, 19, 28, 4, -51, -90, -48, 83,
+	207, 173, -74, -378, -435, -55, 576, 912,
+	451, -735, -1800, -1544, 721, 4487, 8130, 9811,
+	8641, 5239, 1350, -1276, -1886, -980, 268, 895,
+	680, 57, -398, -417, -135, 142, 217, 111,
+	-29, -90, -61, -4, 26, 22, 5, -4,
+	2, 18, 28, 6, -49, -90, -51, 78,
+	205, 178, -64, -371, -440, -73, 557, 912,
+	479, -694, -1781, -1582, 621, 4361, 8038, 9802,
+	8718, 5363, 1460, -1224, -1895, -1020, 235, 889,
+	696, 77, -390, -423, -145, 136, 218, 116,
+	-26, -89, -63, -6, 26, 22, 6, -3,
+	2, 18, 28, 7, -47, -89, -54, 73,
+	202, 182, -54, -363, -444, -90, 538, 911,
+	506, -653, -1760, -1617, 523, 4235, 7943, 9792,
+	8793, 5487, 1571, -1170, -1903, -1060, 202, 882,
+	712, 96, -382, -428, -156, 129, 218, 121,
+	-22, -89, -65, -8, 25, 23, 6, -3,
+	2, 17, 28, 8, -45, -89, -57, 69,
+	200, 186, -44, -356, -448, -108, 519, 909,
+	532, -611, -1739, -1650, 427, 4109, 7847, 9774,
+	8866, 5610, 1683, -1113, -1909, -1099, 167, 874,
+	727, 116, -373, -433, -166, 123, 219, 125,
+	-18, -88, -66, -9, 25, 23, 7, -3,
+	1, 17, 28, 9, -43, -88, -59, 64,
+	197, 190, -35, -347, -451, -124, 500, 907,
+	558, -570, -1716, -1682, 332, 3983, 7749, 9754,
+	8936, 5732, 1796, -1055, -1913, -1138, 133, 866,
+	742, 136, -364, -437, -176, 116, 219, 130,
+	-14, -88, -68, -11, 24, 24, 7, -3,
+	1, 16, 28, 10, -41, -88, -62, 59,
+	194, 193, -25, -339, -454, -141, 480, 903,
+	582, -529, -1692, -1711, 239, 3857, 7649, 9736,
+	9004, 5854, 1911, -995, -1915, -1176, 97, 856,
+	756, 156, -354, -441, -186, 109, 220, 134,
+	-11, -87, -69, -13, 24, 24, 8, -3,
+	1, 16, 28, 12, -40, -87, -64, 55,
+	191, 197, -16, -331, -456, -157, 461, 899,
+	606, -487, -1666, -1738, 148, 3731, 7547, 9709,
+	9070, 5974, 2026, -932, -1916, -1214, 61, 846,
+	770, 176, -344, -445, -197, 102, 220, 138,
+	-7, -86, -71, -14, 23, 24, 8, -3,
+	0, 15, 28, 13, -38, -86, -66, 50,
+	188, 200, -6, -322, -458, -173, 441, 895,
+	629, -446, -1640, -1763, 59, 3606, 7444, 9676,
+	9133, 6094, 2143, -868, -1916, -1251, 25, 835,
+	783, 197, -333, -448, -207, 95, 219, 143,
+	-3, -85, -72, -16, 23, 25, 9, -3,
+	0, 15, 28, 14, -36, -85, -68, 45,
+	185, 203, 3, -313, -460, -189, 421, 889,
+	651, -406, -1612, -1787, -29, 3481, 7339, 9651,
+	9193, 6213, 2261, -802, -1913, -1288, -12, 822,
+	796, 217, -322, -451, -217, 87, 219, 147,
+	1, -84, -74, -18, 22, 25, 9, -3,
+	0, 14, 27, 15, -34, -84, -70, 41,
+	182, 205, 12, -304, -461, -204, 401, 883,
+	672, -365, -1584, -1808, -115, 3356, 7233, 9613,
+	9251, 6331, 2380, -733, -1909, -1323, -50, 809,
+	808, 237, -311, -454, -227, 80, 218, 151,
+	6, -83, -75, -19, 22, 26, 10, -2,
+	-1, 13, 27, 16, -32, -84, -72, 36,
+	178, 208, 21, -295, -461, -218, 380, 876,
+	692, -324, -1554, -1827, -199, 3232, 7125, 9581,
+	9306, 6448, 2499, -663, -1903, -1359, -88, 795,
+	820, 258, -299, -456, -237, 72, 217, 155,
+	10, -82, -77, -21, 21, 26, 10, -2,
+	-1, 13, 27, 17, -30, -83, -74, 32,
+	175, 210, 30, -286, -462, -233, 360, 868,
+	712, -284, -1524, -1845, -281, 3108, 7015, 9542,
+	9358, 6564, 2619, -590, -1895, -1393, -126, 780,
+	831, 278, -286, -458, -247, 64, 216, 160,
+	14, -81, -78, -23, 20, 26, 11, -2,
+	-1, 12, 27, 18, -28, -81, -76, 27,
+	171, 212, 39, -276, -461, -247, 340, 860,
+	730, -244, -1493, -1860, -361, 2985, 6904, 9499,
+	9408, 6679, 2741, -516, -1885, -1427, -165, 765,
+	841, 299, -274, -460, -257, 56, 215, 163,
+	18, -79, -79, -25, 19, 26, 11, -2,
+	-1, 12, 27, 18, -27, -80, -78, 23,
+	167, 214, 47, -267, -461, -260, 319, 851,
+	748, -205, -1460, -1874, -440, 2862, 6792, 9455,
+	9459, 6792, 2862, -440, -1874, -1460, -205, 748,
+	851, 319, -260, -461, -267, 47, 214, 167,
+	23, -78, -80, -27, 18, 27, 12, -1,
+	-2, 11, 26, 19, -25, -79, -79, 18,
+	163, 215, 56, -257, -460, -274, 299, 841,
+	765, -165, -1427, -1885, -516, 2741, 6679, 9408,
+	9499, 6904, 2985, -361, -1860, -1493, -244, 730,
+	860, 340, -247, -461, -276, 39, 212, 171,
+	27, -76, -81, -28, 18, 27, 12, -1,
+	-2, 11, 26, 20, -23, -78, -81, 14,
+	160, 216, 64, -247, -458, -286, 278, 831,
+	780, -126, -1393, -1895, -590, 2619, 6564, 9358,
+	9542, 7015, 3108, -281, -1845, -1524, -284, 712,
+	868, 360, -233, -462, -286, 30, 210, 175,
+	32, -74, -83, -30, 17, 27, 13, -1,
+	-2, 10, 26, 21, -21, -77, -82, 10,
+	155, 217, 72, -237, -456, -299, 258, 820,
+	795, -88, -1359, -1903, -663, 2499, 6448, 9306,
+	9581, 7125, 3232, -199, -1827, -1554, -324, 692,
+	876, 380, -218, -461, -295, 21, 208, 178,
+	36, -72, -84, -32, 16, 27, 13, -1,
+	-2, 10, 26, 22, -19, -75, -83, 6,
+	151, 218, 80, -227, -454, -311, 237, 808,
+	809, -50, -1323, -1909, -733, 2380, 6331, 9251,
+	9613, 7233, 3356, -115, -1808, -1584, -365, 672,
+	883, 401, -204, -461, -304, 12, 205, 182,
+	41, -70, -84, -34, 15, 27, 14, 0,
+	-3, 9, 25, 22, -18, -74, -84, 1,
+	147, 219, 87, -217, -451, -322, 217, 796,
+	822, -12, -1288, -1913, -802, 2261, 6213, 9193,
+	9651, 7339, 3481, -29, -1787, -1612, -406, 651,
+	889, 421, -189, -460, -313, 3, 203, 185,
+	45, -68, -85, -36, 14, 28, 15, 0,
+	-3, 9, 25, 23, -16, -72, -85, -3,
+	143, 219, 95, -207, -448, -333, 197, 783,
+	835, 25, -1251, -1916, -868, 2143, 6094, 9133,
+	9676, 7444, 3606, 59, -1763, -1640, -446, 629,
+	895, 441, -173, -458, -322, -6, 200, 188,
+	50, -66, -86, -38, 13, 28, 15, 0,
+	-3, 8, 24, 23, -14, -71, -86, -7,
+	138, 220, 102, -197, -445, -344, 176, 770,
+	846, 61, -1214, -1916, -932, 2026, 5974, 9070,
+	9709, 7547, 3731, 148, -1738, -1666, -487, 606,
+	899, 461, -157, -456, -331, -16, 197, 191,
+	55, -64, -87, -40, 12, 28, 16, 1,
+	-3, 8, 24, 24, -13, -69, -87, -11,
+	134, 220, 109, -186, -441, -354, 156, 756,
+	856, 97, -1176, -1915, -995, 1911, 5854, 9004,
+	9736, 7649, 3857, 239, -1711, -1692, -529, 582,
+	903, 480, -141, -454, -339, -25, 193, 194,
+	59, -62, -88, -41, 10, 28, 16, 1,
+	-3, 7, 24, 24, -11, -68, -88, -14,
+	130, 219, 116, -176, -437, -364, 136, 742,
+	866, 133, -1138, -1913, -1055, 1796, 5732, 8936,
+	9754, 7749, 3983, 332, -1682, -1716, -570, 558,
+	907, 500, -124, -451, -347, -35, 190, 197,
+	64, -59, -88, -43, 9, 28, 17, 1,
+	-3, 7, 23, 25, -9, -66, -88, -18,
+	125, 219, 123, -166, -433, -373, 116, 727,
+	874, 167, -1099, -1909, -1113, 1683, 5610, 8866,
+	9774, 7847, 4109, 427, -1650, -1739, -611, 532,
+	909, 519, -108, -448, -356, -44, 186, 200,
+	69, -57, -89, -45, 8, 28, 17, 2,
+	-3, 6, 23, 25, -8, -65, -89, -22,
+	121, 218, 129, -156, -428, -382, 96, 712,
+	882, 202, -1060, -1903, -1170, 1571, 5487, 8793,
+	9792, 7943, 4235, 523, -1617, -1760, -653, 506,
+	911, 538, -90, -444, -363, -54, 182, 202,
+	73, -54, -89, -47, 7, 28, 18, 2,
+	-3, 6, 22, 26, -6, -63, -89, -26,
+	116, 218, 136, -145, -423, -390, 77, 696,
+	889, 235, -1020, -1895, -1224, 1460, 5363, 8718,
+	9802, 8038, 4361, 621, -1582, -1781, -694, 479,
+	912, 557, -73, -440, -371, -64, 178, 205,
+	78, -51, -90, -49, 6, 28, 18, 2,
+	-4, 5, 22, 26, -4, -61, -90, -29,
+	111, 217, 142, -135, -417, -398, 57, 680,
+	895, 268, -980, -1886, -1276, 1350, 5239, 8641,
+	9811, 8130, 4487, 721, -1544, -1800, -735, 451,
+	912, 576, -55, -435, -378, -74, 173, 207,
+	83, -48, -90, -51, 4, 28, 19, 3,
+	-4, 5, 21, 26, -3, -60, -90, -32,
+	107, 215, 147, -125, -411, -405, 38, 664,
+	900, 301, -940, -1875, -1326, 1241, 5115, 8561,
+	9822, 8220, 4613, 822, -1505, -1818, -777, 422,
+	911, 594, -37, -430, -386, -84, 169, 209,
+	88, -45, -90, -52, 3, 27, 19, 3,
+	-4, 4, 21, 27, -1, -58, -90, -36,
+	102, 214, 153, -115, -405, -412, 19, 647,
+	904, 332, -899, -1863, -1373, 1134, 4990, 8479,
+	9823, 8309, 4739, 925, -1463, -1834, -818, 393,
+	910, 612, -19, -425, -392, -94, 164, 211,
+	92, -42, -90, -54, 1, 27, 20, 3,
+};
+
+#endif
@@ -24,13 +24,20 @@
 ** file at : https://github.com/erikd/libsamplerate/blob/master/COPYING
 */
 
+#include <tinyara/config.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#if defined(__ARM_FEATURE_DSP) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_acle.h>
+#endif
 #include "samplerate.h"
 #include "../../utils/remix.h"
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+#include "polyphase_coeff.h"
+#endif
 
 
 /****************************************************************************
@@ -93,6 +100,13 @@
 // Check src context initialized or not
 #define CHECK_SRC_CONTEXT_INIT(src) ((src)->in_buffer != NULL)
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+// Use packed 16-bit dual MAC (SMLAD) kernels if the core supports DSP extension
+#if defined(__ARM_FEATURE_DSP) && !defined(__ARM_BIG_ENDIAN)
+#define POLY_USE_SMLAD
+#endif
+#endif
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -119,6 +133,13 @@ struct src_context_s {
 	float ratio;            // (float)new_sample_rate / (float)old_sample_rate
 	float inverse_ratio;    // (float)old_sample_rate / (float)new_sample_rate
 	uint32_t fp_frac;       // fraction part value of last fixed point index
+	int out_buffer_frames;  // capability in frames of the external output buffer
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	const struct poly_filter_s *poly; // polyphase filter, NULL if not used
+	uint32_t poly_frac;     // fraction part of last index, in 1/new_sample_rate frames
+	uint32_t step_int;      // int part of input frames per output frame
+	uint32_t step_frac;     // fraction part of input frames per output frame, in 1/new_sample_rate frames
+#endif
 	/**
 	 * @brief   Function pointer to resampling process function
 	 * @param   src_context_t *: pointer to resampler object.
@@ -131,6 +152,25 @@ struct src_context_s {
 
 typedef struct src_context_s src_context_t;
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+/**
+ * @structure poly_filter_s: polyphase FIR filter, and range of ratio it serves.
+ */
+struct poly_filter_s {
+	const int16_t *coeff;   // coefficient table, 'phases' rows of 'taps' Q15 values
+	int32_t taps;           // number of taps in each phase, always even
+	int32_t phase_bits;     // log2 of number of phases
+	float min_ratio;        // (float)new_sample_rate / (float)old_sample_rate
+	float max_ratio;
+};
+
+static const struct poly_filter_s poly_filters[] = {
+	{poly_coeff_up, 16, 7, 1.0f, SRC_MAX_RATIO},
+	{poly_coeff_near, 16, 7, 0.85f, 1.0f},
+	{poly_coeff_third, 48, 5, SRC_MIN_RATIO, 0.37f},
+};
+#endif
+
 /**
  * 16.16 fixed point FIR filter coefficients for conversion 44100 -> 22050.
  * (Works equivalently for 22010 -> 11025 or any other halving, of course.)
@@ -214,6 +254,149 @@ static int32_t resample_frac(src_context_t *src, int32_t *num_frames_in)
 	return num_frames_out;
 }
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+#ifdef POLY_USE_SMLAD
+static inline uint32_t poly_load_pair(const int16_t *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+// Pack bottom halves of a (to bottom) and b (to top) into one word
+static inline uint32_t poly_pkhbt(uint32_t a, uint32_t b)
+{
+	uint32_t r;
+	__asm__("pkhbt %0, %1, %2, lsl #16" : "=r"(r) : "r"(a), "r"(b));
+	return r;
+}
+
+// Pack top halves of b (to bottom) and a (to top) into one word
+static inline uint32_t poly_pkhtb(uint32_t a, uint32_t b)
+{
+	uint32_t r;
+	__asm__("pkhtb %0, %1, %2, asr #16" : "=r"(r) : "r"(a), "r"(b));
+	return r;
+}
+#endif
+
+/**
+ * @brief   Apply one phase of polyphase filter to mono frames.
+ * @param   input: pointer to the first frame covered by the filter.
+ * @param   coeff: pointer to Q15 coefficients of the phase.
+ * @param   taps: number of coefficients, it must be even.
+ * @return  filtered value in Q15 (rounding offset included).
+ */
+static inline int32_t poly_fir_mono(const int16_t *input, const int16_t *coeff, int32_t taps)
+{
+	int32_t sum = 1 << 14;
+	int32_t k;
+#ifdef POLY_USE_SMLAD
+	for (k = 0; k < taps; k += 2) {
+		sum = __smlad(poly_load_pair(input + k), poly_load_pair(coeff + k), sum);
+	}
+#else
+	for (k = 0; k < taps; k += 2) {
+		sum += input[k] * coeff[k];
+		sum += input[k + 1] * coeff[k + 1];
+	}
+#endif
+	return sum;
+}
+
+/**
+ * @brief   Apply one phase of polyphase filter to interleaved stereo frames.
+ * @param   input: pointer to the first frame covered by the filter.
+ * @param   coeff: pointer to Q15 coefficients of the phase.
+ * @param   taps: number of coefficients, it must be even.
+ * @param   right: retrieves filtered value of right channel.
+ * @return  filtered value of left channel in Q15 (rounding offset included).
+ */
+static inline int32_t poly_fir_stereo(const int16_t *input, const int16_t *coeff, int32_t taps, int32_t *right)
+{
+	int32_t suml = 1 << 14;
+	int32_t sumr = 1 << 14;
+	int32_t k;
+#ifdef POLY_USE_SMLAD
+	for (k = 0; k < taps; k += 2) {
+		// Repack two frames (L0 R0)(L1 R1) to (L0 L1)(R0 R1), then one SMLAD per channel
+		uint32_t f0 = poly_load_pair(input + 2 * k);
+		uint32_t f1 = poly_load_pair(input + 2 * k + 2);
+		uint32_t c = poly_load_pair(coeff + k);
+		suml = __smlad(poly_pkhbt(f0, f1), c, suml);
+		sumr = __smlad(poly_pkhtb(f1, f0), c, sumr);
+	}
+#else
+	for (k = 0; k < taps; k++) {
+		suml += input[2 * k] * coeff[k];
+		sumr += input[2 * k + 1] * coeff[k];
+	}
+#endif
+	*right = sumr;
+	return suml;
+}
+
+/**
+ * It handles converting ratios served by poly_filters[], filtering and resampling in one pass.
+ * The index is kept as exact rational (int part + poly_frac / new_sample_rate), so it does
+ * not drift like 16.16 fixed point index. The fraction part selects the phase (nearest lower
+ * one), and each output frame is computed from 'taps' input frames starting at the int part.
+ * That reads up to 'taps - 1' frames beyond the last index, which are the overlap frames.
+ */
+static int32_t resample_poly(src_context_t *src, int32_t *num_frames_in)
+{
+	const struct poly_filter_s *poly = src->poly;
+	const int16_t *input = src->in_buffer;
+	int16_t *output = src->out_buffer;
+	int32_t channels_num = src->new_channel_num;
+	int32_t taps = poly->taps;
+	uint32_t denominator = (uint32_t)src->new_sample_rate;
+	uint32_t whole = 0;
+	uint32_t frac = src->poly_frac;
+	int32_t num_frames_out = 0;
+
+	while ((whole < (uint32_t)*num_frames_in) && (num_frames_out < src->out_buffer_frames)) {
+		const int16_t *in = input + whole * channels_num;
+		const int16_t *coeff = poly->coeff + ((frac << poly->phase_bits) / denominator) * taps;
+		if (channels_num == 2) {
+			int32_t right;
+			int32_t left = poly_fir_stereo(in, coeff, taps, &right);
+			*output++ = clip(left >> 15);
+			*output++ = clip(right >> 15);
+		} else {
+			*output++ = clip(poly_fir_mono(in, coeff, taps) >> 15);
+		}
+		num_frames_out++;
+		whole += src->step_int;
+		frac += src->step_frac;
+		if (frac >= denominator) {
+			frac -= denominator;
+			whole++;
+		}
+	}
+
+	*num_frames_in = whole;
+	src->poly_frac = frac;
+	return num_frames_out;
+}
+
+/**
+ * @brief   Find polyphase filter which serves the converting ratio.
+ * @param   ratio: (float)new_sample_rate / (float)old_sample_rate
+ * @return  pointer to the filter, NULL if there's no filter for the ratio.
+ */
+static const struct poly_filter_s *find_poly_filter(float ratio)
+{
+	int i;
+	for (i = 0; i < (int)(sizeof(poly_filters) / sizeof(poly_filters[0])); i++) {
+		if ((ratio >= poly_filters[i].min_ratio) && (ratio <= poly_filters[i].max_ratio)) {
+			return &poly_filters[i];
+		}
+	}
+	return NULL;
+}
+#endif
+
 /**
  * It handles sample rate down scaling cases in inverse ratio 2.0 and 3.0 without fraction.
  * This function has same logic as resample_frac(), that means resample_frac() also works,
@@ -335,6 +518,20 @@ static int init_src_context(src_context_t *src, src_data_t *src_data)
 	src->inverse_ratio = (float)src->old_sample_rate / (float)src->new_sample_rate;
 
 	// Set overlap frame number and converting function as per converting ratio
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	src->poly = find_poly_filter(src->ratio);
+	if (src->poly != NULL) {
+		// Polyphase filter does filtering and resampling in one pass
+		src->filter_coeff = NULL;
+		src->overlap_frames = src->poly->taps - 1;
+		src->poly_frac = 0;
+		src->step_int = src->old_sample_rate / src->new_sample_rate;
+		src->step_frac = src->old_sample_rate % src->new_sample_rate;
+		src->src_func = resample_poly;
+		return SRC_ERR_NO_ERROR;
+	}
+#endif
+
 	if (src->old_sample_rate > src->new_sample_rate) {
 		// down resampling
 		if (src->old_sample_rate % src->new_sample_rate == 0) {
@@ -442,6 +639,7 @@ int src_simple(src_handle_t handle, src_data_t *src_data)
 
 	// Update output buffer to src context (used in converting proccess functions)
 	src->out_buffer = (int16_t *)src_data->data_out;
+	src->out_buffer_frames = out_buffer_frames;
 
 	// Move remaining frames in internal buffer
 	if ((src->used_frames > 0) && (src->left_frames > 0)) {
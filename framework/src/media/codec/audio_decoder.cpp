@@ -116,6 +116,9 @@ using namespace media;
 #define OPUS_PACKET_SYNC_VERIFY(buf) (strncmp((const char *)buf, "Opus", 4) == 0)
 #define OPUS_PACKET_GETSIZE(buf) (OPUS_PACKET_HEADER_LEN + _u32_at(buf+4))
 
+// Max len of the frame headers above, parsed by _frame_resync()
+#define FRAME_SYNC_HEADER_MAX_LEN AAC_ADTS_FRAME_HEADER_LEN
+
 #define BYTES_PER_SAMPLE sizeof(signed short)
 
 /****************************************************************************
@@ -137,6 +140,17 @@ struct pcm_data_s {
 typedef struct pcm_data_s pcm_data_t;
 typedef struct pcm_data_s *pcm_data_p;
 
+/**
+ * @struct  frame_sync_s
+ * @brief   Frame header description of a stream format, used by _frame_resync().
+ */
+struct frame_sync_s {
+	size_t header_len;          /* bytes required to parse a frame header */
+	/* Parse the frame header in 'buf', it should match 'ref' if 'ref' is not 0 and the format
+	 * has fixed header fields. Returns true with frame size (header included) if it's valid. */
+	bool (*parse)(const uint8_t *buf, uint32_t ref, uint32_t *header, size_t *frame_size);
+};
+
 /**
  * @struct  priv_data_s
  * @brief   Player private data structure define.
@@ -259,134 +273,152 @@ static ssize_t _source_read_at(rbstream_p fp, ssize_t offset, void *data, size_t
 	return rbs_read(data, 1, size, fp);
 }
 
-// Resync to next valid MP3 frame in the file.
-static bool mp3_resync(rbstream_p fp, uint32_t match_header, ssize_t *inout_pos, uint32_t *out_header)
+// Read stream from 'pos' to the window, keeping bytes from 'pos' which are in it already.
+static void _frame_window_fill(rbstream_p fp, uint8_t *buf, ssize_t *base, ssize_t *len, ssize_t pos, bool *reachEOS)
 {
-	medvdbg("[%s] Line %d, match_header %#x, *pos %d\n", __FUNCTION__, __LINE__, match_header, *inout_pos);
-
-	if (*inout_pos == 0) {
-		// Skip an optional ID3 header if syncing at the very beginning of the datasource.
-		for (;;) {
-			uint8_t id3header[MP3_HEAD_ID3_TAG_LEN];
-			int retVal = _source_read_at(fp, *inout_pos, id3header, sizeof(id3header));
-			RETURN_VAL_IF_FAIL((retVal == (ssize_t) sizeof(id3header)), false);
+	ssize_t keep = *base + *len - pos;
+	if (keep > 0) {
+		memmove(buf, buf + (pos - *base), keep);
+	} else {
+		keep = 0;
+	}
 
-			if (memcmp("ID3", id3header, 3)) {
-				break;
-			}
-			// Skip the ID3v2 header.
-			size_t len = MP3_HEAD_ID3_FRAME_GETSIZE(id3header);
-			len += MP3_HEAD_ID3_TAG_LEN;
-			*inout_pos += len;
-		}
+	ssize_t bytesToRead = FRAME_RESYNC_READ_BYTES - keep;
+	ssize_t bytesRead = _source_read_at(fp, pos + keep, buf + keep, bytesToRead);
+	if (bytesRead < 0) {
+		bytesRead = 0;
 	}
 
-	ssize_t pos = *inout_pos;
-	bool valid = false;
+	*base = pos;
+	*len = keep + bytesRead;
+	*reachEOS = (bytesRead != bytesToRead);
+}
+
+/*
+ * Resync to the next valid frame, which is followed by FRAME_MATCH_REQUIRED valid frames.
+ * Headers are parsed from a window read ahead sequentially from the stream. When successors
+ * of a candidate frame are out of the window, the window moves to start at the candidate,
+ * so usually they are checked in the window as well, instead of seeking the stream for each.
+ */
+static bool _frame_resync(rbstream_p fp, const struct frame_sync_s *sync, uint32_t match_header, ssize_t *inout_pos, uint32_t *out_header)
+{
 	uint8_t buf[FRAME_RESYNC_READ_BYTES];
-	ssize_t bytesToRead = FRAME_RESYNC_READ_BYTES;
-	ssize_t totalBytesRead = 0;
-	ssize_t remainingBytes = 0;
+	ssize_t base = *inout_pos;  // stream offset of buf[0]
+	ssize_t len = 0;            // valid bytes in buf
 	bool reachEOS = false;
-	uint8_t *buf_ptr = buf;
-
-	do {
-		if (pos >= *inout_pos + FRAME_RESYNC_MAX_CHECK_BYTES) {
-			medvdbg("[%s] resync range < %d\n", __FUNCTION__, FRAME_RESYNC_MAX_CHECK_BYTES);
-			break;
-		}
+	ssize_t pos = *inout_pos;
 
-		if (remainingBytes < (ssize_t)U32_LEN_IN_BYTES) {
+	while (pos < *inout_pos + FRAME_RESYNC_MAX_CHECK_BYTES) {
+		if (pos + (ssize_t)sync->header_len > base + len) {
 			if (reachEOS) {
 				break;
 			}
-
-			memcpy(buf, buf_ptr, remainingBytes);
-			bytesToRead = FRAME_RESYNC_READ_BYTES - remainingBytes;
-
-			/*
-			 * The next read position should start from the end of
-			 * the last buffer, and thus should include the remaining
-			 * bytes in the buffer.
-			 */
-			totalBytesRead = _source_read_at(fp, pos + remainingBytes, buf + remainingBytes, bytesToRead);
-
-			if (totalBytesRead <= 0) {
-				break;
-			}
-
-			reachEOS = (totalBytesRead != bytesToRead);
-			remainingBytes += totalBytesRead;
-			buf_ptr = buf;
-			continue;
-		}
-
-		uint32_t header = _u32_at(buf_ptr);
-
-		if (match_header != 0 && (header & MP3_FRAME_HEADER_MASK) != (match_header & MP3_FRAME_HEADER_MASK)) {
-			++pos;
-			++buf_ptr;
-			--remainingBytes;
+			_frame_window_fill(fp, buf, &base, &len, pos, &reachEOS);
 			continue;
 		}
 
+		uint32_t header;
 		size_t frame_size;
-		if (!_parse_header(header, &frame_size)) {
+		if (!sync->parse(buf + (pos - base), match_header, &header, &frame_size)) {
 			++pos;
-			++buf_ptr;
-			--remainingBytes;
 			continue;
 		}
 
 		// We found what looks like a valid frame,
 		// now find its successors.
-		valid = true;
+		bool valid = true;
+		bool moved = false;
 		ssize_t test_pos = pos + frame_size;
-		medvdbg("[%s] Line %d, valid frame at pos %#x + framesize %#x = %#x\n", __FUNCTION__, __LINE__, pos, frame_size, test_pos);
 		int j;
 		for (j = 0; j < FRAME_MATCH_REQUIRED; ++j) {
-			uint8_t temp[U32_LEN_IN_BYTES];
-			ssize_t retval = _source_read_at(fp, test_pos, temp, sizeof(temp));
-			if (retval < (ssize_t) sizeof(temp)) {
+			uint8_t temp[FRAME_SYNC_HEADER_MAX_LEN];
+			const uint8_t *ptr;
+			if (test_pos + (ssize_t)sync->header_len <= base + len) {
+				ptr = buf + (test_pos - base);
+			} else if (reachEOS) {
 				valid = false;
 				break;
-			}
-
-			uint32_t test_header = _u32_at(temp);
-
-			if ((test_header & MP3_FRAME_HEADER_MASK) != (header & MP3_FRAME_HEADER_MASK)) {
-				medvdbg("[%s] Line %d, invalid frame at pos1 %#x\n", __FUNCTION__, __LINE__, test_pos);
-				valid = false;
+			} else if (base != pos) {
+				moved = true;
 				break;
+			} else {
+				// Frames are larger than the window, read the header directly.
+				ssize_t retval = _source_read_at(fp, test_pos, temp, sync->header_len);
+				if (retval < (ssize_t)sync->header_len) {
+					valid = false;
+					break;
+				}
+				ptr = temp;
 			}
 
+			uint32_t test_header;
 			size_t test_frame_size;
-			if (!_parse_header(test_header, &test_frame_size)) {
-				medvdbg("[%s] Line %d, invalid frame at pos2 %#x\n", __FUNCTION__, __LINE__, test_pos);
+			if (!sync->parse(ptr, header, &test_header, &test_frame_size)) {
+				medvdbg("[%s] Line %d, invalid frame at pos %#x\n", __FUNCTION__, __LINE__, test_pos);
 				valid = false;
 				break;
 			}
-
-			medvdbg("[%s] Line %d, valid frame at pos %#x + framesize %#x = %#x\n", __FUNCTION__, __LINE__, test_pos, test_frame_size, test_pos + test_frame_size);
 			test_pos += test_frame_size;
 		}
 
+		if (moved) {
+			_frame_window_fill(fp, buf, &base, &len, pos, &reachEOS);
+			continue;
+		}
+
 		if (valid) {
 			*inout_pos = pos;
-
 			if (out_header != NULL) {
 				*out_header = header;
 			}
-
 			medvdbg("[%s] Line %d, find header %#x at pos %d(%#x)\n", __FUNCTION__, __LINE__, header, pos, pos);
+			return true;
 		}
 
 		++pos;
-		++buf_ptr;
-		--remainingBytes;
-	} while (!valid);
+	}
+
+	medvdbg("[%s] no frame found in [%d, %d)\n", __FUNCTION__, *inout_pos, pos);
+	return false;
+}
 
-	return valid;
+static bool mp3_parse_sync(const uint8_t *buf, uint32_t ref, uint32_t *header, size_t *frame_size)
+{
+	*header = _u32_at(buf);
+	if (ref != 0 && (*header & MP3_FRAME_HEADER_MASK) != (ref & MP3_FRAME_HEADER_MASK)) {
+		return false;
+	}
+
+	return _parse_header(*header, frame_size);
+}
+
+static const struct frame_sync_s mp3_sync = {
+	U32_LEN_IN_BYTES, mp3_parse_sync
+};
+
+// Resync to next valid MP3 frame in the file.
+static bool mp3_resync(rbstream_p fp, uint32_t match_header, ssize_t *inout_pos, uint32_t *out_header)
+{
+	medvdbg("[%s] Line %d, match_header %#x, *pos %d\n", __FUNCTION__, __LINE__, match_header, *inout_pos);
+
+	if (*inout_pos == 0) {
+		// Skip an optional ID3 header if syncing at the very beginning of the datasource.
+		for (;;) {
+			uint8_t id3header[MP3_HEAD_ID3_TAG_LEN];
+			int retVal = _source_read_at(fp, *inout_pos, id3header, sizeof(id3header));
+			RETURN_VAL_IF_FAIL((retVal == (ssize_t) sizeof(id3header)), false);
+
+			if (memcmp("ID3", id3header, 3)) {
+				break;
+			}
+			// Skip the ID3v2 header.
+			size_t len = MP3_HEAD_ID3_FRAME_GETSIZE(id3header);
+			len += MP3_HEAD_ID3_TAG_LEN;
+			*inout_pos += len;
+		}
+	}
+
+	return _frame_resync(fp, &mp3_sync, match_header, inout_pos, out_header);
 }
 
 // Initialize the MP3 reader.
@@ -469,88 +501,23 @@ bool mp3_check_type(rbstream_p rbsp)
 	return result;
 }
 
-// Resync to next valid MP3 frame in the file.
-static bool aac_resync(rbstream_p fp, ssize_t *inout_pos)
+static bool aac_parse_sync(const uint8_t *buf, uint32_t ref, uint32_t *header, size_t *frame_size)
 {
-	ssize_t pos = *inout_pos;
-	bool valid = false;
+	RETURN_VAL_IF_FAIL(AAC_ADTS_SYNC_VERIFY(buf), false);
 
-	uint8_t buf[FRAME_RESYNC_READ_BYTES];
-	ssize_t bytesToRead = FRAME_RESYNC_READ_BYTES;
-	ssize_t totalBytesRead = 0;
-	ssize_t remainingBytes = 0;
-	bool reachEOS = false;
-	uint8_t *buf_ptr = buf;
-
-	do {
-		if (pos >= *inout_pos + FRAME_RESYNC_MAX_CHECK_BYTES) {
-			break;
-		}
-
-		if (remainingBytes < AAC_ADTS_FRAME_HEADER_LEN) {
-			if (reachEOS) {
-				break;
-			}
-
-			memcpy(buf, buf_ptr, remainingBytes);
-			bytesToRead = FRAME_RESYNC_READ_BYTES - remainingBytes;
-
-			/*
-			 * The next read position should start from the end of
-			 * the last buffer, and thus should include the remaining
-			 * bytes in the buffer.
-			 */
-			totalBytesRead = _source_read_at(fp, pos + remainingBytes, buf + remainingBytes, bytesToRead);
-			if (totalBytesRead <= 0) {
-				break;
-			}
-
-			reachEOS = (totalBytesRead != bytesToRead);
-			remainingBytes += totalBytesRead;
-			buf_ptr = buf;
-			continue;
-		}
-
-		if (!AAC_ADTS_SYNC_VERIFY(buf_ptr)) {
-			++pos;
-			++buf_ptr;
-			--remainingBytes;
-			continue;
-		}
-
-		// We found what looks like a valid frame,
-		// now find its successors.
-		valid = true;
-		int frame_size = AAC_ADTS_FRAME_GETSIZE(buf_ptr);
-		ssize_t test_pos = pos + frame_size;
-		int j;
-		for (j = 0; j < FRAME_MATCH_REQUIRED; ++j) {
-			uint8_t temp[AAC_ADTS_FRAME_HEADER_LEN];
-			ssize_t retval = _source_read_at(fp, test_pos, temp, sizeof(temp));
-			if (retval < (ssize_t) sizeof(temp)) {
-				valid = false;
-				break;
-			}
-
-			if (!AAC_ADTS_SYNC_VERIFY(temp)) {
-				valid = false;
-				break;
-			}
-
-			int test_frame_size = AAC_ADTS_FRAME_GETSIZE(temp);
-			test_pos += test_frame_size;
-		}
-
-		if (valid) {
-			*inout_pos = pos;
-		}
+	*header = _u32_at(buf);
+	*frame_size = AAC_ADTS_FRAME_GETSIZE(buf);
+	return *frame_size >= AAC_ADTS_FRAME_HEADER_LEN;
+}
 
-		++pos;
-		++buf_ptr;
-		--remainingBytes;
-	} while (!valid);
+static const struct frame_sync_s aac_sync = {
+	AAC_ADTS_FRAME_HEADER_LEN, aac_parse_sync
+};
 
-	return valid;
+// Resync to next valid AAC frame in the file.
+static bool aac_resync(rbstream_p fp, ssize_t *inout_pos)
+{
+	return _frame_resync(fp, &aac_sync, 0, inout_pos, NULL);
 }
 
 // Initialize the aac reader.
@@ -625,88 +592,23 @@ bool aac_check_type(rbstream_p rbsp)
 }
 
 #ifdef CONFIG_CODEC_LIBOPUS
-// Resync to next valid Opus frame in the file.
-static bool opus_resync(rbstream_p fp, ssize_t *inout_pos)
+static bool opus_parse_sync(const uint8_t *buf, uint32_t ref, uint32_t *header, size_t *frame_size)
 {
-	ssize_t pos = *inout_pos;
-	bool valid = false;
+	RETURN_VAL_IF_FAIL(OPUS_PACKET_SYNC_VERIFY(buf), false);
 
-	uint8_t buf[FRAME_RESYNC_READ_BYTES];
-	ssize_t bytesToRead = FRAME_RESYNC_READ_BYTES;
-	ssize_t totalBytesRead = 0;
-	ssize_t remainingBytes = 0;
-	bool reachEOS = false;
-	uint8_t *buf_ptr = buf;
-
-	do {
-		if (pos >= *inout_pos + FRAME_RESYNC_MAX_CHECK_BYTES) {
-			break;
-		}
-
-		if (remainingBytes < OPUS_PACKET_HEADER_LEN) {
-			if (reachEOS) {
-				break;
-			}
-
-			memcpy(buf, buf_ptr, remainingBytes);
-			bytesToRead = FRAME_RESYNC_READ_BYTES - remainingBytes;
-
-			/*
-			 * The next read position should start from the end of
-			 * the last buffer, and thus should include the remaining
-			 * bytes in the buffer.
-			 */
-			totalBytesRead = _source_read_at(fp, pos + remainingBytes, buf + remainingBytes, bytesToRead);
-			if (totalBytesRead <= 0) {
-				break;
-			}
-
-			reachEOS = (totalBytesRead != bytesToRead);
-			remainingBytes += totalBytesRead;
-			buf_ptr = buf;
-			continue;
-		}
-
-		if (!OPUS_PACKET_SYNC_VERIFY(buf_ptr)) {
-			++pos;
-			++buf_ptr;
-			--remainingBytes;
-			continue;
-		}
-
-		// We found what looks like a valid frame,
-		// now find its successors.
-		valid = true;
-		int frame_size = OPUS_PACKET_GETSIZE(buf_ptr);
-		ssize_t test_pos = pos + frame_size;
-		int j;
-		for (j = 0; j < FRAME_MATCH_REQUIRED; ++j) {
-			uint8_t temp[OPUS_PACKET_HEADER_LEN];
-			ssize_t retval = _source_read_at(fp, test_pos, temp, sizeof(temp));
-			if (retval < (ssize_t) sizeof(temp)) {
-				valid = false;
-				break;
-			}
-
-			if (!OPUS_PACKET_SYNC_VERIFY(temp)) {
-				valid = false;
-				break;
-			}
-
-			int test_frame_size = OPUS_PACKET_GETSIZE(temp);
-			test_pos += test_frame_size;
-		}
-
-		if (valid) {
-			*inout_pos = pos;
-		}
+	*header = _u32_at(buf);
+	*frame_size = OPUS_PACKET_GETSIZE(buf);
+	return true;
+}
 
-		++pos;
-		++buf_ptr;
-		--remainingBytes;
-	} while (!valid);
+static const struct frame_sync_s opus_sync = {
+	OPUS_PACKET_HEADER_LEN, opus_parse_sync
+};
 
-	return valid;
+// Resync to next valid Opus frame in the file.
+static bool opus_resync(rbstream_p fp, ssize_t *inout_pos)
+{
+	return _frame_resync(fp, &opus_sync, 0, inout_pos, NULL);
 }
 
 // Initialize the Opus reader.
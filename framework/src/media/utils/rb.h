@@ -102,6 +102,34 @@ size_t rb_read(rb_p rbp, void *ptr, size_t len);
  */
 size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset);
 
+/**
+ * @brief  Get the contiguous free space at wr_idx, so that the caller can
+ *         fill it in place and then call rb_write_commit().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer saving the start address of the free space
+ * @return size of contiguous free space in bytes, range[0, rb_avail(rbp)]
+ */
+size_t rb_write_reserve(rb_p rbp, void **ptr);
+
+/**
+ * @brief  Commit data filled in place after rb_write_reserve(),
+ *         wr_idx will be increased.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data filled
+ * @return size wr_idx increased, range[0, len]
+ */
+size_t rb_write_commit(rb_p rbp, size_t len);
+
+/**
+ * @brief  Get the contiguous data at rd_idx without copying it,
+ *         rd_idx will not be increased. Call rb_read(rbp, NULL, len)
+ *         to drop the data after using it.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer saving the start address of the data
+ * @return size of contiguous data in bytes, range[0, rb_used(rbp)]
+ */
+size_t rb_read_peek(rb_p rbp, const void **ptr);
+
 /**
  * @brief  Reset ring-buffer, data in ring-buffer will be dropped.
  * @param  rbp: Pointer to the ring-buffer object
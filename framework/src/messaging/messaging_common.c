@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <mqueue.h>
+#include <sched.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -121,6 +122,9 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
 	uint32_t parsing_version;
 	int ret = OK;
 	uint32_t offset;
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+	messaging_shared_buf_t *shared;
+#endif
 
 	my_version = messaging_get_version();
 
@@ -144,6 +148,17 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
 		memcpy(buf, packet + offset, buflen);
 		ret = OK;
 		break;
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+	case 2:
+		/* Version 2 carries a reference to the sender's buffer. Copy it out and drop the reference. */
+		*sender_pid = ((messaging_packet_t *)packet)->sender_pid;
+		*msg_type = ((messaging_packet_t *)packet)->msg_type;
+		memcpy(&shared, packet + offset, sizeof(messaging_shared_buf_t *));
+		memcpy(buf, shared->msg, shared->msglen < buflen ? shared->msglen : buflen);
+		messaging_shared_release(shared);
+		ret = OK;
+		break;
+#endif
 	default:
 		msgdbg("[Messaging] Invalid version.\n");
 		ret = ERROR;
@@ -152,6 +167,78 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
 
 	return ret;
 }
+/****************************************************************************
+ * Name : messaging_packet_size
+ *
+ * Description:
+ *  Return the size a version 1 packet carrying the same message would have.
+ *  This must be called before the packet is parsed.
+ ****************************************************************************/
+int messaging_packet_size(char *packet, int size)
+{
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+	messaging_shared_buf_t *shared;
+
+	if (((messaging_packet_t *)packet)->version == MSG_VERSION_SHARED) {
+		memcpy(&shared, packet + ((messaging_packet_t *)packet)->offset, sizeof(messaging_shared_buf_t *));
+		return MSG_HEADER_SIZE + shared->msglen;
+	}
+#endif
+	return size;
+}
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+/****************************************************************************
+ * Name : messaging_shared_alloc
+ *
+ * Description:
+ *  Copy the message into a new shared buffer. The caller holds the only reference.
+ ****************************************************************************/
+messaging_shared_buf_t *messaging_shared_alloc(msg_send_data_t *send_data)
+{
+	messaging_shared_buf_t *shared;
+
+	shared = (messaging_shared_buf_t *)MSG_ALLOC(offsetof(messaging_shared_buf_t, msg) + send_data->msglen);
+	if (shared == NULL) {
+		msgdbg("[Messaging] send fail : out of memory for shared buffer.\n");
+		return NULL;
+	}
+	shared->refcnt = 1;
+	shared->msglen = send_data->msglen;
+	memcpy(shared->msg, send_data->msg, send_data->msglen);
+
+	return shared;
+}
+/****************************************************************************
+ * Name : messaging_shared_hold
+ *
+ * Description:
+ *  Take one more reference for a receiver.
+ ****************************************************************************/
+void messaging_shared_hold(messaging_shared_buf_t *shared)
+{
+	sched_lock();
+	shared->refcnt++;
+	sched_unlock();
+}
+/****************************************************************************
+ * Name : messaging_shared_release
+ *
+ * Description:
+ *  Drop one reference. The buffer is freed with the last one.
+ ****************************************************************************/
+void messaging_shared_release(messaging_shared_buf_t *shared)
+{
+	int refcnt;
+
+	sched_lock();
+	refcnt = --shared->refcnt;
+	sched_unlock();
+
+	if (refcnt == 0) {
+		MSG_FREE(shared);
+	}
+}
+#endif
 /****************************************************************************
  * Name : messaging_set_notification
  * 
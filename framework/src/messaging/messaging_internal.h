@@ -34,7 +34,13 @@
 #define MSG_ASPRINTF asprintf
 #endif
 
-#define MSG_VERSION 1
+#define MSG_VERSION_COPY   1
+#define MSG_VERSION_SHARED 2
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+#define MSG_VERSION MSG_VERSION_SHARED
+#else
+#define MSG_VERSION MSG_VERSION_COPY
+#endif
 /* Messaging Version 1 */
 struct messaging_packet_s {
 	uint32_t version;
@@ -46,6 +52,17 @@ struct messaging_packet_s {
 typedef struct messaging_packet_s messaging_packet_t;
 #define MSG_HEADER_SIZE (sizeof(messaging_packet_t) - sizeof(char *)) /* Messaging Version 1 */
 
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+/* Messaging Version 2 : the same header, followed by a pointer to a shared buffer instead of the message. */
+struct messaging_shared_buf_s {
+	int refcnt;
+	int msglen;
+	char msg[1];
+};
+typedef struct messaging_shared_buf_s messaging_shared_buf_t;
+#define MSG_SHARED_PACKET_SIZE (MSG_HEADER_SIZE + sizeof(messaging_shared_buf_t *))
+#endif
+
 #define MAX_PORT_NAME_SIZE 64
 
 /**
@@ -138,10 +155,26 @@ void messaging_run_callback(int signo, siginfo_t *data);
  * @brief Internal function for parsing received packet
  */
 int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pid, int *msg_type);
+/**
+ * @brief Internal function for getting the message size of received packet in version 1 terms
+ */
+int messaging_packet_size(char *packet, int size);
 /**
  * @brief Internal function for getting g_port_info_list
  */
 sq_queue_t *messaging_get_port_info_list(void);
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+/**
+ * @brief Internal functions for the reference-counted buffer of zero-copy multicast
+ */
+messaging_shared_buf_t *messaging_shared_alloc(msg_send_data_t *send_data);
+void messaging_shared_hold(messaging_shared_buf_t *shared);
+void messaging_shared_release(messaging_shared_buf_t *shared);
+/**
+ * @brief Internal function for sending a reference to a shared buffer
+ */
+int messaging_send_shared_packet(const char *port_name, messaging_shared_buf_t *shared, int priority);
+#endif
 /*
  *@endcond
  */
@@ -146,7 +146,7 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	 */
 
 	/* Add data header for message version and msg offset. */
-	msg_version = messaging_get_version();
+	msg_version = MSG_VERSION_COPY;
 	((messaging_packet_t *)send_packet)->version = msg_version;
 	msg_offset = MSG_HEADER_SIZE;
 	((messaging_packet_t *)send_packet)->offset = msg_offset;
@@ -181,6 +181,57 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	return ret;
 }
 
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+/****************************************************************************
+ * Name : messaging_send_shared_packet
+ *
+ * Description:
+ *  This function sends a version 2 packet, which carries a reference to
+ *  the shared buffer instead of the message. The receiver drops the
+ *  reference after copying the message out.
+ *
+ * Return Value:
+ *  On success, 0 (OK) is returned.; On failure, -1 (ERROR) is returned.
+ ****************************************************************************/
+int messaging_send_shared_packet(const char *port_name, messaging_shared_buf_t *shared, int priority)
+{
+	int ret;
+	mqd_t mqdes;
+	struct mq_attr internal_attr;
+	char send_packet[MSG_SHARED_PACKET_SIZE];
+
+	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
+	internal_attr.mq_msgsize = MSG_SHARED_PACKET_SIZE;
+	internal_attr.mq_flags = 0;
+
+	mqdes = mq_open(port_name, O_WRONLY, 0666, &internal_attr);
+	if (mqdes == (mqd_t)ERROR) {
+		msgdbg("[Messaging] send fail : open fail, errno %d.\n", errno);
+		return ERROR;
+	}
+
+	((messaging_packet_t *)send_packet)->version = MSG_VERSION_SHARED;
+	((messaging_packet_t *)send_packet)->offset = MSG_HEADER_SIZE;
+	((messaging_packet_t *)send_packet)->sender_pid = getpid();
+	((messaging_packet_t *)send_packet)->msg_type = MSG_REPLY_NO_REQUIRED;
+	memcpy(send_packet + MSG_HEADER_SIZE, &shared, sizeof(messaging_shared_buf_t *));
+
+	/* The reference belongs to the receiver once the packet is queued. */
+	messaging_shared_hold(shared);
+	ret = mq_send(mqdes, send_packet, MSG_SHARED_PACKET_SIZE, priority);
+	if (ret != OK) {
+		msgdbg("[Messaging] send fail : errno %d.\n", errno);
+		messaging_shared_release(shared);
+		mq_close(mqdes);
+		mq_unlink(port_name);
+		return ERROR;
+	}
+
+	mq_close(mqdes);
+	return OK;
+}
+#endif
+
 static void messaging_init_recv_arr(int *arr)
 {
 	int arr_idx;
@@ -212,13 +263,25 @@ int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg
 	int recv_arr[CONFIG_MESSAGING_RECV_LIST_SIZE];
 	char *private_portname;
 	int recv_cnt;
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+	messaging_shared_buf_t *shared = NULL;
+
+	if (msg_type == MSG_SEND_MULTI) {
+		/* The message is copied once here, whatever the number of receivers. */
+		shared = messaging_shared_alloc(send_data);
+		if (shared == NULL) {
+			return ERROR;
+		}
+	}
+#endif
 
 	/* Check that how many receivers are waiting. */
 	while (read_status != MSG_READ_ALL) {
 		(void)messaging_init_recv_arr(recv_arr);
 		read_status = READ_MSG_RECEIVER(port_name, recv_arr, recv_cnt);
 		if (read_status == ERROR) {
-			return ERROR;
+			ret = ERROR;
+			break;
 		}
 
 		if (msg_type != MSG_SEND_MULTI && recv_cnt > 1) {
@@ -234,6 +297,11 @@ int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg
 			MSG_ASPRINTF(&private_portname, "%s%d", port_name, recv_arr[recv_idx]);
 			if (private_portname == NULL) {
 				msgdbg("[Messaging] send fail : out of memory for private portname.\n");
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+				if (shared != NULL) {
+					messaging_shared_release(shared);
+				}
+#endif
 				return ERROR;
 			}
 			if (msg_type == MSG_SEND_ASYNC) {
@@ -245,12 +313,22 @@ int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg
 					}
 				}
 				ret = messaging_send_packet(private_portname, msg_type, send_data, cb_info);
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+			} else if (shared != NULL) {
+				ret = messaging_send_shared_packet(private_portname, shared, send_data->priority);
+#endif
 			} else {
 				ret = messaging_send_packet(private_portname, msg_type, send_data, NULL);
 			}
 			MSG_FREE(private_portname);
 		}
 	}
+#ifdef CONFIG_MESSAGING_ZEROCOPY
+	if (shared != NULL) {
+		/* Drop the sender's reference. Receivers which have not read the message yet keep it alive. */
+		messaging_shared_release(shared);
+	}
+#endif
 	if (ret == OK) {
 		return recv_cnt;
 	}
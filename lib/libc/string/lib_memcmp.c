@@ -60,8 +60,16 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/************************************************************
+ * Pre-processor Definitions
+ ************************************************************/
+
+#define WORD_SIZE      sizeof(uint32_t)
+#define WORD_MASK      (WORD_SIZE - 1)
+
 /************************************************************
  * Global Functions
  ************************************************************/
@@ -72,6 +80,28 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
 	unsigned char *p1 = (unsigned char *)s1;
 	unsigned char *p2 = (unsigned char *)s2;
 
+	/* If both areas have the same alignment, skip over equal words.  The
+	 * first word which differs is compared byte by byte below.
+	 */
+
+	if (n >= 2 * WORD_SIZE && (((uintptr_t)p1 ^ (uintptr_t)p2) & WORD_MASK) == 0) {
+		while (((uintptr_t)p1 & WORD_MASK) != 0) {
+			if (*p1 != *p2) {
+				return *p1 < *p2 ? -1 : 1;
+			}
+
+			p1++;
+			p2++;
+			n--;
+		}
+
+		while (n >= WORD_SIZE && *(uint32_t *)p1 == *(uint32_t *)p2) {
+			p1 += WORD_SIZE;
+			p2 += WORD_SIZE;
+			n -= WORD_SIZE;
+		}
+	}
+
 	while (n-- > 0) {
 		if (*p1 < *p2) {
 			return -1;
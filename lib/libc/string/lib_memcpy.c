@@ -60,24 +60,121 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORD_SIZE      sizeof(uint32_t)
+#define WORD_MASK      (WORD_SIZE - 1)
+
+/* Shorter copies are done byte by byte, aligning them would cost more than
+ * copying words saves.
+ */
+
+#define MEMCPY_BYTES   (2 * WORD_SIZE)
+
+/* Combine the tail of the word w0 and the head of the next word w1 into
+ * the word starting 'shift' bits into w0, as laid out in memory.
+ */
+
+#ifdef CONFIG_ENDIAN_BIG
+#define MERGE(w0, w1, shift) (((w0) << (shift)) | ((w1) >> (32 - (shift))))
+#else
+#define MERGE(w0, w1, shift) (((w0) >> (shift)) | ((w1) << (32 - (shift))))
+#endif
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
 
 /****************************************************************************
  * Name: memcpy
+ *
+ * Description:
+ *   Once the destination is word aligned, whole words are copied, four at
+ *   a time while possible.  If the source is not aligned as well, aligned
+ *   source words are read and shifted together, so no unaligned access is
+ *   ever made.
+ *
  ****************************************************************************/
 
 #ifndef CONFIG_ARCH_MEMCPY
 FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
 	FAR unsigned char *pout = (FAR unsigned char *)dest;
-	FAR unsigned char *pin = (FAR unsigned char *)src;
+	FAR const unsigned char *pin = (FAR const unsigned char *)src;
+	FAR uint32_t *wout;
+	FAR const uint32_t *win;
+	uint32_t w0;
+	uint32_t w1;
+	uint32_t w2;
+	uint32_t w3;
+	unsigned int shift;
+
+	if (n >= MEMCPY_BYTES) {
+		/* Align the destination to a word boundary */
+
+		while (((uintptr_t)pout & WORD_MASK) != 0) {
+			*pout++ = *pin++;
+			n--;
+		}
+
+		wout = (FAR uint32_t *)pout;
+		shift = ((uintptr_t)pin & WORD_MASK) * 8;
+
+		if (shift == 0) {
+			/* Both are aligned, copy four words per loop then single words */
+
+			win = (FAR const uint32_t *)pin;
+
+			while (n >= 4 * WORD_SIZE) {
+				w0 = win[0];
+				w1 = win[1];
+				w2 = win[2];
+				w3 = win[3];
+				wout[0] = w0;
+				wout[1] = w1;
+				wout[2] = w2;
+				wout[3] = w3;
+				win += 4;
+				wout += 4;
+				n -= 4 * WORD_SIZE;
+			}
+
+			while (n >= WORD_SIZE) {
+				*wout++ = *win++;
+				n -= WORD_SIZE;
+			}
+
+			pin = (FAR const unsigned char *)win;
+		} else {
+			/* Read the aligned words around the source.  The bytes before
+			 * and after the source in these words are read but unused, they
+			 * are in the same words as bytes copied, so always accessible.
+			 */
+
+			win = (FAR const uint32_t *)((uintptr_t)pin & ~WORD_MASK);
+			w0 = *win++;
+
+			while (n >= WORD_SIZE) {
+				w1 = *win++;
+				*wout++ = MERGE(w0, w1, shift);
+				w0 = w1;
+				pin += WORD_SIZE;
+				n -= WORD_SIZE;
+			}
+		}
+
+		pout = (FAR unsigned char *)wout;
+	}
+
 	while (n-- > 0) {
 		*pout++ = *pin++;
 	}
+
 	return dest;
 }
 #endif
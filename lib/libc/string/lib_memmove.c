@@ -60,28 +60,194 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
 /************************************************************
- * Global Functions
+ * Pre-processor Definitions
  ************************************************************/
 
+#define WORD_SIZE      sizeof(uint32_t)
+#define WORD_MASK      (WORD_SIZE - 1)
+
+/* Shorter moves are done byte by byte */
+
+#define MEMMOVE_BYTES  (2 * WORD_SIZE)
+
+/* Combine the tail of the word w0 and the head of the next word w1 into
+ * the word starting 'shift' bits into w0, as laid out in memory.
+ */
+
+#ifdef CONFIG_ENDIAN_BIG
+#define MERGE(w0, w1, shift) (((w0) << (shift)) | ((w1) >> (32 - (shift))))
+#else
+#define MERGE(w0, w1, shift) (((w0) >> (shift)) | ((w1) << (32 - (shift))))
+#endif
+
 #ifndef CONFIG_ARCH_MEMMOVE
+
+/************************************************************
+ * Private Functions
+ ************************************************************/
+
+/************************************************************
+ * Name: memmove_forward
+ *
+ * Description:
+ *   Copy from the lowest address up, for dest below src.  Each
+ *   word is read before the word overlapping it is written.
+ *
+ ************************************************************/
+
+static void memmove_forward(FAR unsigned char *pout, FAR const unsigned char *pin, size_t n)
+{
+	FAR uint32_t *wout;
+	FAR const uint32_t *win;
+	uint32_t w0;
+	uint32_t w1;
+	uint32_t w2;
+	uint32_t w3;
+	unsigned int shift;
+
+	if (n >= MEMMOVE_BYTES) {
+		while (((uintptr_t)pout & WORD_MASK) != 0) {
+			*pout++ = *pin++;
+			n--;
+		}
+
+		wout = (FAR uint32_t *)pout;
+		shift = ((uintptr_t)pin & WORD_MASK) * 8;
+
+		if (shift == 0) {
+			win = (FAR const uint32_t *)pin;
+
+			while (n >= 4 * WORD_SIZE) {
+				w0 = win[0];
+				w1 = win[1];
+				w2 = win[2];
+				w3 = win[3];
+				wout[0] = w0;
+				wout[1] = w1;
+				wout[2] = w2;
+				wout[3] = w3;
+				win += 4;
+				wout += 4;
+				n -= 4 * WORD_SIZE;
+			}
+
+			while (n >= WORD_SIZE) {
+				*wout++ = *win++;
+				n -= WORD_SIZE;
+			}
+
+			pin = (FAR const unsigned char *)win;
+		} else {
+			win = (FAR const uint32_t *)((uintptr_t)pin & ~WORD_MASK);
+			w0 = *win++;
+
+			while (n >= WORD_SIZE) {
+				w1 = *win++;
+				*wout++ = MERGE(w0, w1, shift);
+				w0 = w1;
+				pin += WORD_SIZE;
+				n -= WORD_SIZE;
+			}
+		}
+
+		pout = (FAR unsigned char *)wout;
+	}
+
+	while (n-- > 0) {
+		*pout++ = *pin++;
+	}
+}
+
+/************************************************************
+ * Name: memmove_backward
+ *
+ * Description:
+ *   Copy from the highest address down, for dest above src.
+ *   pout and pin point just past the end of the areas.
+ *
+ ************************************************************/
+
+static void memmove_backward(FAR unsigned char *pout, FAR const unsigned char *pin, size_t n)
+{
+	FAR uint32_t *wout;
+	FAR const uint32_t *win;
+	uint32_t w0;
+	uint32_t w1;
+	uint32_t w2;
+	uint32_t w3;
+	unsigned int shift;
+
+	if (n >= MEMMOVE_BYTES) {
+		while (((uintptr_t)pout & WORD_MASK) != 0) {
+			*--pout = *--pin;
+			n--;
+		}
+
+		wout = (FAR uint32_t *)pout;
+		shift = ((uintptr_t)pin & WORD_MASK) * 8;
+
+		if (shift == 0) {
+			win = (FAR const uint32_t *)pin;
+
+			while (n >= 4 * WORD_SIZE) {
+				win -= 4;
+				wout -= 4;
+				w3 = win[3];
+				w2 = win[2];
+				w1 = win[1];
+				w0 = win[0];
+				wout[3] = w3;
+				wout[2] = w2;
+				wout[1] = w1;
+				wout[0] = w0;
+				n -= 4 * WORD_SIZE;
+			}
+
+			while (n >= WORD_SIZE) {
+				*--wout = *--win;
+				n -= WORD_SIZE;
+			}
+
+			pin = (FAR const unsigned char *)win;
+		} else {
+			/* As in memcpy, the unused bytes read are in the same words
+			 * as bytes copied.
+			 */
+
+			win = (FAR const uint32_t *)((uintptr_t)pin & ~WORD_MASK);
+			w1 = *win;
+
+			while (n >= WORD_SIZE) {
+				w0 = *--win;
+				*--wout = MERGE(w0, w1, shift);
+				w1 = w0;
+				pin -= WORD_SIZE;
+				n -= WORD_SIZE;
+			}
+		}
+
+		pout = (FAR unsigned char *)wout;
+	}
+
+	while (n-- > 0) {
+		*--pout = *--pin;
+	}
+}
+
+/************************************************************
+ * Global Functions
+ ************************************************************/
+
 FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
 {
-	char *tmp, *s;
 	if (dest <= src) {
-		tmp = (char *)dest;
-		s = (char *)src;
-		while (count--) {
-			*tmp++ = *s++;
-		}
+		memmove_forward((FAR unsigned char *)dest, (FAR const unsigned char *)src, count);
 	} else {
-		tmp = (char *)dest + count;
-		s = (char *)src + count;
-		while (count--) {
-			*--tmp = *--s;
-		}
+		memmove_backward((FAR unsigned char *)dest + count, (FAR const unsigned char *)src + count, count);
 	}
 
 	return dest;
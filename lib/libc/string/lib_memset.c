@@ -119,7 +119,18 @@ void *memset(void *s, int c, size_t n)
 				n -= 2;
 			}
 #ifndef CONFIG_MEMSET_64BIT
-			/* Loop while there are at least 32-bits left to be written */
+			/* Loop while there are at least four 32-bit words left, then
+			 * while there is at least one.
+			 */
+
+			while (n >= 16) {
+				((uint32_t *)addr)[0] = val32;
+				((uint32_t *)addr)[1] = val32;
+				((uint32_t *)addr)[2] = val32;
+				((uint32_t *)addr)[3] = val32;
+				addr += 16;
+				n -= 16;
+			}
 
 			while (n >= 4) {
 				*(uint32_t *)addr = val32;
@@ -229,6 +229,12 @@ int trace_sched(struct tcb_s *prev_tcb, struct tcb_s *next_tcb)
 	int tag = TTRACE_TAG_TASK;
 	struct trace_packet packet;
 
+#ifdef CONFIG_TTRACE_EVENTS
+	/* Context switches are recorded by ttrace_event_sched() */
+
+	return TTRACE_VALID;
+#endif
+
 	if (is_fd_available() < 0 || !is_tag_available(tag)) {
 		return TTRACE_INVALID;
 	}
@@ -263,6 +269,11 @@ int trace_begin(int tag, char *str, ...)
 	struct trace_packet packet;
 	va_list ap;
 
+#ifdef CONFIG_TTRACE_EVENTS
+	ttrace_event(tag, TTRACE_EVENT_BEGIN, (uint32_t)(uintptr_t)str);
+	return TTRACE_VALID;
+#endif
+
 	if (is_fd_available() < 0 || !is_tag_available(tag)) {
 		return TTRACE_INVALID;
 	}
@@ -288,6 +299,11 @@ int trace_begin_uid(int tag, int8_t uniqueid)
 	int ret = TTRACE_VALID;
 	struct trace_packet packet;
 
+#ifdef CONFIG_TTRACE_EVENTS
+	ttrace_event(tag, TTRACE_EVENT_BEGIN_UID, (uint32_t)(uint8_t)uniqueid);
+	return TTRACE_VALID;
+#endif
+
 	if (is_fd_available() < 0 || !is_tag_available(tag)) {
 		return TTRACE_INVALID;
 	}
@@ -321,6 +337,11 @@ int trace_end(int tag)
 	int ret = TTRACE_VALID;
 	struct trace_packet packet;
 
+#ifdef CONFIG_TTRACE_EVENTS
+	ttrace_event(tag, TTRACE_EVENT_END, 0);
+	return TTRACE_VALID;
+#endif
+
 	if (is_fd_available() < 0 || !is_tag_available(tag)) {
 		return TTRACE_INVALID;
 	}
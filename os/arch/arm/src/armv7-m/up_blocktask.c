@@ -61,6 +61,7 @@
 #include <debug.h>
 
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "up_internal.h"
@@ -159,6 +160,7 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			 * of the g_readytorun task list.
 			 */
 
+			ttrace_event_sched(rtcb, this_task());
 			rtcb = this_task();
 
 #ifdef CONFIG_TASK_SCHED_HISTORY
@@ -188,6 +190,7 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			 */
 
 			struct tcb_s *nexttcb = this_task();
+			ttrace_event_sched(rtcb, nexttcb);
 #ifdef CONFIG_TASK_SCHED_HISTORY
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(nexttcb);
@@ -59,6 +59,7 @@
 #include <sched.h>
 #include <debug.h>
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "up_internal.h"
@@ -122,6 +123,7 @@ void up_release_pending(void)
 			 * of the g_readytorun task list.
 			 */
 
+			ttrace_event_sched(rtcb, this_task());
 			rtcb = this_task();
 			sllvdbg("New Active Task TCB=%p\n", rtcb);
 
@@ -151,6 +153,7 @@ void up_release_pending(void)
 			 */
 
 			struct tcb_s *nexttcb = this_task();
+			ttrace_event_sched(rtcb, nexttcb);
 #ifdef CONFIG_TASK_SCHED_HISTORY
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(nexttcb);
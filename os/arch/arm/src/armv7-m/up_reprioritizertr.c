@@ -61,6 +61,7 @@
 #include <sched.h>
 #include <debug.h>
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "up_internal.h"
@@ -174,6 +175,7 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 				 * of the g_readytorun task list.
 				 */
 
+				ttrace_event_sched(rtcb, this_task());
 				rtcb = this_task();
 				sllvdbg("New Active Task TCB=%p\n", rtcb);
 
@@ -202,6 +204,7 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 				 */
 
 				struct tcb_s *nexttcb = this_task();
+				ttrace_event_sched(rtcb, nexttcb);
 #ifdef CONFIG_TASK_SCHED_HISTORY
 				/* Save the task name which will be scheduled */
 				save_task_scheduling_status(nexttcb);
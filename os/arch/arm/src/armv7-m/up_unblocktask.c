@@ -59,6 +59,7 @@
 #include <sched.h>
 #include <debug.h>
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "clock/clock.h"
@@ -145,6 +146,7 @@ void up_unblock_task(struct tcb_s *tcb)
 			 * of the g_readytorun task list.
 			 */
 
+			ttrace_event_sched(rtcb, this_task());
 			rtcb = this_task();
 
 #ifdef CONFIG_TASK_SCHED_HISTORY
@@ -174,6 +176,7 @@ void up_unblock_task(struct tcb_s *tcb)
 			 */
 
 			struct tcb_s *nexttcb = this_task();
+			ttrace_event_sched(rtcb, nexttcb);
 #ifdef CONFIG_TASK_SCHED_HISTORY
 			/* Save the task name which will be scheduled */
 			save_task_scheduling_status(nexttcb);
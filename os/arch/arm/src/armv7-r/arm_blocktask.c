@@ -61,6 +61,7 @@
 #include <debug.h>
 
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
 #include <tinyara/sched.h>
 
 #include "sched/sched.h"
@@ -141,6 +142,7 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			 * of the g_readytorun task list.
 			 */
 
+			ttrace_event_sched(rtcb, this_task());
 			rtcb = this_task();
 
 #ifdef CONFIG_TASK_SCHED_HISTORY
@@ -162,6 +164,7 @@ void up_block_task(struct tcb_s *tcb, tstate_t task_state)
 			 * of the g_readytorun task list.
 			 */
 
+			ttrace_event_sched(rtcb, this_task());
 			rtcb = this_task();
 
 #ifdef CONFIG_TASK_SCHED_HISTORY
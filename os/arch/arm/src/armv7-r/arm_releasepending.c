@@ -59,6 +59,7 @@
 #include <sched.h>
 #include <debug.h>
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
 #include <tinyara/sched.h>
 
 #include "sched/sched.h"
@@ -110,6 +111,7 @@ void up_release_pending(void)
 			 * of the g_readytorun task list.
 			 */
 
+			ttrace_event_sched(rtcb, this_task());
 			rtcb = this_task();
 
 #ifdef CONFIG_TASK_SCHED_HISTORY
@@ -134,6 +136,7 @@ void up_release_pending(void)
 			 * of the g_readytorun task list.
 			 */
 
+			ttrace_event_sched(rtcb, this_task());
 			rtcb = this_task();
 
 #ifdef CONFIG_TASK_SCHED_HISTORY
@@ -61,6 +61,7 @@
 #include <sched.h>
 #include <debug.h>
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
 #include <tinyara/sched.h>
 
 #include "sched/sched.h"
@@ -159,6 +160,7 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 				 * of the g_readytorun task list.
 				 */
 
+				ttrace_event_sched(rtcb, this_task());
 				rtcb = this_task();
 
 				/* Then switch contexts.  Any necessary address environment
@@ -181,6 +183,7 @@ void up_reprioritize_rtr(struct tcb_s *tcb, uint8_t priority)
 				 * of the g_readytorun task list.
 				 */
 
+				ttrace_event_sched(rtcb, this_task());
 				rtcb = this_task();
 
 				/* Then switch contexts */
@@ -66,23 +66,36 @@
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
+#ifndef CONFIG_BCH_CACHE_SECTORS
+#define CONFIG_BCH_CACHE_SECTORS	1
+#endif
+
 #define bchlib_semgive(d)	sem_post(&(d)->sem)	/* To match bchlib_semtake */
 #define MAX_OPENCNT			(255)				/* Limit of uint8_t */
 
 /****************************************************************************
  * Public Types
  ****************************************************************************/
+/* One slot of the sector cache */
+
+struct bch_sector_s {
+	size_t sector;				/* The sector in the buffer, (size_t)-1 if none */
+	uint32_t lastuse;			/* Access time for LRU replacement */
+	bool dirty;					/* true: Data has been written to the buffer */
+	FAR uint8_t *buffer;		/* One sector buffer */
+};
+
 struct bchlib_s {
 	FAR struct inode *inode;	/* I-node of the block driver */
 	uint32_t sectsize;			/* The size of one sector on the device */
 	size_t nsectors;			/* Number of sectors supported by the device */
-	size_t sector;				/* The current sector in the buffer */
 	sem_t sem;					/* For atomic accesses to this structure */
 	uint8_t refs;				/* Number of references */
-	bool dirty;					/* true: Data has been written to the buffer */
 	bool readonly;				/* true: Only read operations are supported */
 	bool unlinked;				/* true: The driver has been unlinked */
-	FAR uint8_t *buffer;		/* One sector buffer */
+	uint32_t tick;				/* LRU clock of the sector cache */
+	FAR uint8_t *buffer;		/* Buffers of all cache slots, contiguous */
+	struct bch_sector_s cache[CONFIG_BCH_CACHE_SECTORS];	/* Sector cache */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
 	uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];	/* Encryption key */
@@ -108,6 +121,8 @@ EXTERN const struct file_operations bch_fops;
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN ssize_t bchlib_readsectors(FAR struct bchlib_s *bch, FAR uint8_t *buffer, size_t sector, size_t nsectors);
+EXTERN ssize_t bchlib_writesectors(FAR struct bchlib_s *bch, FAR const uint8_t *buffer, size_t sector, size_t nsectors);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -150,6 +150,7 @@ static int bch_close(FAR struct file *filep)
 {
 	FAR struct inode *inode = filep->f_inode;
 	FAR struct bchlib_s *bch;
+	int flushret;
 	int ret = OK;
 
 	DEBUGASSERT(inode && inode->i_private);
@@ -157,7 +158,10 @@ static int bch_close(FAR struct file *filep)
 
 	/* Flush any dirty pages remaining in the cache */
 	bchlib_semtake(bch);
-	(void)bchlib_flushsector(bch);
+	flushret = bchlib_flushsector(bch);
+	if (flushret < 0) {
+		fdbg("ERROR: Flush failed: %d\n", flushret);
+	}
 
 	/*
 	 * Decrement the reference count (I don't use bchlib_decref() because I
@@ -185,12 +189,16 @@ static int bch_close(FAR struct file *filep)
 			DEBUGASSERT(ret >= 0);
 			if (ret >= 0) {
 				/* Return without releasing the stale semaphore */
-				return OK;
+				return flushret;
 			}
 		}
 	}
 
 	bchlib_semgive(bch);
+	if (ret == OK) {
+		ret = flushret;
+	}
+
 	return ret;
 }
 
@@ -57,6 +57,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -86,28 +87,35 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
 
 /****************************************************************************
  * Name: bch_cypher
+ *
+ * Description:
+ *   Encrypt or decrypt, in place, one sector of data held in 'buffer'.
+ *   The buffer need not be word aligned.
+ *
  ****************************************************************************/
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, FAR uint8_t *buffer, size_t sector, int encrypt)
 {
 	int blocks = bch->sectsize / 16;
-	FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
 	int i;
 
-	for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t)) {
+	for (i = 0; i < blocks; i++, buffer += 16) {
+		uint32_t B[4];
 		uint32_t T[4];
 		uint32_t X[4] = {
-			bch->sector, 0, 0, i
+			sector, 0, 0, i
 		};
 
+		memcpy(B, buffer, 16);
 		aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
 						AES_MODE_ECB, CYPHER_ENCRYPT);
 
 		/* Xor-Encrypt-Xor */
-		bch_xor(T, X, buffer);
+		bch_xor(T, X, B);
 		aes_cypher(T, T, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
 						AES_MODE_ECB, encrypt);
-		bch_xor(buffer, X, T);
+		bch_xor(B, X, T);
+		memcpy(buffer, B, 16);
 	}
 
 	return OK;
@@ -115,19 +123,17 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-/****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bch_flushslot
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Write one cache slot to the media if it is dirty
  *
- * Assumptions:
- *   Caller must assume mutual exclusion
+ * Returned Value:
+ *   OK on success; a negated errno value if the media write failed, in
+ *   which case the slot is left dirty.
  *
  ****************************************************************************/
-int bchlib_flushsector(FAR struct bchlib_s *bch)
+static int bch_flushslot(FAR struct bchlib_s *bch, FAR struct bch_sector_s *slot)
 {
 	FAR struct inode *inode;
 	ssize_t ret = OK;
@@ -136,18 +142,18 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 	 * Check if the sector has been modified and is out of sync with the
 	 * media.
 	 */
-	if (bch->dirty) {
+	if (slot->dirty) {
 		inode = bch->inode;
 
 #if defined(CONFIG_BCH_ENCRYPTION)
 		/* Encrypt data as necessary */
-		bch_cypher(bch, CYPHER_ENCRYPT);
+		bch_cypher(bch, slot->buffer, slot->sector, CYPHER_ENCRYPT);
 #endif
 
 		/* Write the sector to the media */
-		ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-		if (ret < 0) {
-			fdbg("Write failed: %d\n");
+		ret = inode->u.i_bops->write(inode, slot->buffer, slot->sector, 1);
+		if (ret == 0) {
+			ret = -EIO;
 		}
 
 #if defined(CONFIG_BCH_ENCRYPTION)
@@ -155,21 +161,87 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 		 * Computation overhead to save memory for extra sector buffer
 		 * TODO: Add configuration switch for extra sector buffer
 		 */
-		bch_cypher(bch, CYPHER_DECRYPT);
+		bch_cypher(bch, slot->buffer, slot->sector, CYPHER_DECRYPT);
 #endif
 
+		/*
+		 * On failure the slot stays dirty, so that a later flush or
+		 * eviction retries the write.
+		 */
+		if (ret < 0) {
+			fdbg("Write failed: %d\n", ret);
+			return (int)ret;
+		}
+
 		/* The sector is now in sync with the media */
-		bch->dirty = false;
+		slot->dirty = false;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bch_invalidate
+ *
+ * Description:
+ *   Drop the cached copies of sectors [sector, sector + nsectors), without
+ *   writing them.  Used when those sectors are about to be overwritten.
+ *
+ ****************************************************************************/
+static void bch_invalidate(FAR struct bchlib_s *bch, size_t sector, size_t nsectors)
+{
+	FAR struct bch_sector_s *slot;
+	int i;
+
+	for (i = 0; i < CONFIG_BCH_CACHE_SECTORS; i++) {
+		slot = &bch->cache[i];
+		if (slot->sector != (size_t)-1 && slot->sector >= sector && slot->sector - sector < nsectors) {
+			slot->sector = (size_t)-1;
+			slot->dirty = false;
+		}
 	}
+}
 
-	return (int)ret;
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush the contents of all dirty sector buffers
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+int bchlib_flushsector(FAR struct bchlib_s *bch)
+{
+	int ret = OK;
+	int err;
+	int i;
+
+	for (i = 0; i < CONFIG_BCH_CACHE_SECTORS; i++) {
+		err = bch_flushslot(bch, &bch->cache[i]);
+		if (err < 0 && ret == OK) {
+			ret = err;
+		}
+	}
+
+	return ret;
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Make 'sector' present in the sector cache, reading it from the media
+ *   if needed.  The least recently used slot is replaced, after writing it
+ *   back if dirty.
+ *
+ * Returned Value:
+ *   The index of the slot in bch->cache holding the sector on success; a
+ *   negated errno value on failure.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -178,23 +250,160 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
 	FAR struct inode *inode;
-	ssize_t ret = OK;
-
-	if (bch->sector != sector) {
-		inode = bch->inode;
+	FAR struct bch_sector_s *slot;
+	ssize_t ret;
+	int victim;
+	int i;
 
-		(void)bchlib_flushsector(bch);
-		bch->sector = (size_t)-1;
+	/* Is the sector already cached?  If not, pick a free slot or the least
+	 * recently used one.
+	 */
+	victim = 0;
+	for (i = 0; i < CONFIG_BCH_CACHE_SECTORS; i++) {
+		slot = &bch->cache[i];
+		if (slot->sector == sector) {
+			slot->lastuse = ++bch->tick;
+			return i;
+		}
 
-		ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
-		if (ret < 0) {
-			fdbg("Read failed: %d\n");
+		if (bch->cache[victim].sector != (size_t)-1 &&
+			(slot->sector == (size_t)-1 || (int32_t)(slot->lastuse - bch->cache[victim].lastuse) < 0)) {
+			victim = i;
 		}
-		bch->sector = sector;
+	}
+
+	inode = bch->inode;
+	slot = &bch->cache[victim];
+
+	ret = bch_flushslot(bch, slot);
+	if (ret < 0) {
+		return (int)ret;
+	}
+
+	slot->sector = (size_t)-1;
+
+	ret = inode->u.i_bops->read(inode, slot->buffer, sector, 1);
+	if (ret < 0) {
+		fdbg("Read failed: %d\n", ret);
+		return (int)ret;
+	}
 #if defined(CONFIG_BCH_ENCRYPTION)
-		bch_cypher(bch, CYPHER_DECRYPT);
+	bch_cypher(bch, slot->buffer, sector, CYPHER_DECRYPT);
 #endif
+
+	slot->sector = sector;
+	slot->lastuse = ++bch->tick;
+	return victim;
+}
+
+/****************************************************************************
+ * Name: bchlib_readsectors
+ *
+ * Description:
+ *   Read whole sectors from the media directly into the caller's buffer,
+ *   bypassing the sector cache.  Cached sectors that have not been written
+ *   back yet are newer than the media and are copied over the result.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+ssize_t bchlib_readsectors(FAR struct bchlib_s *bch, FAR uint8_t *buffer, size_t sector, size_t nsectors)
+{
+	FAR struct inode *inode = bch->inode;
+	FAR struct bch_sector_s *slot;
+	ssize_t ret;
+	size_t i;
+
+	ret = inode->u.i_bops->read(inode, buffer, sector, nsectors);
+	if (ret < 0) {
+		fdbg("Read failed: %d\n", ret);
+		return ret;
+	}
+#if defined(CONFIG_BCH_ENCRYPTION)
+	for (i = 0; i < nsectors; i++) {
+		bch_cypher(bch, &buffer[i * bch->sectsize], sector + i, CYPHER_DECRYPT);
 	}
-	return (int)ret;
+#endif
+
+	for (i = 0; i < CONFIG_BCH_CACHE_SECTORS; i++) {
+		slot = &bch->cache[i];
+		if (slot->dirty && slot->sector >= sector && slot->sector - sector < nsectors) {
+			memcpy(&buffer[(slot->sector - sector) * bch->sectsize], slot->buffer, bch->sectsize);
+		}
+	}
+
+	return (ssize_t)nsectors;
 }
 
+/****************************************************************************
+ * Name: bchlib_writesectors
+ *
+ * Description:
+ *   Write whole sectors from the caller's buffer to the media, bypassing
+ *   the sector cache.  Cached copies of these sectors are dropped.  With
+ *   encryption, the data cannot be encrypted in the caller's buffer, so it
+ *   is staged through the cache buffers, CONFIG_BCH_CACHE_SECTORS sectors
+ *   per transfer, and stays cached afterwards.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+ssize_t bchlib_writesectors(FAR struct bchlib_s *bch, FAR const uint8_t *buffer, size_t sector, size_t nsectors)
+{
+	FAR struct inode *inode = bch->inode;
+	ssize_t ret;
+#if defined(CONFIG_BCH_ENCRYPTION)
+	FAR struct bch_sector_s *slot;
+	size_t count;
+	size_t done;
+	size_t i;
+#endif
+
+	bch_invalidate(bch, sector, nsectors);
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+	/* All slots are reused for staging, write back what they hold */
+	ret = bchlib_flushsector(bch);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (done = 0; done < nsectors; done += count) {
+		count = nsectors - done;
+		if (count > CONFIG_BCH_CACHE_SECTORS) {
+			count = CONFIG_BCH_CACHE_SECTORS;
+		}
+
+		memcpy(bch->buffer, &buffer[done * bch->sectsize], count * bch->sectsize);
+		for (i = 0; i < count; i++) {
+			bch_cypher(bch, bch->cache[i].buffer, sector + done + i, CYPHER_ENCRYPT);
+		}
+
+		ret = inode->u.i_bops->write(inode, bch->buffer, sector + done, count);
+
+		/* Put the plain data back, the slots now cache these sectors */
+		memcpy(bch->buffer, &buffer[done * bch->sectsize], count * bch->sectsize);
+		for (i = 0; i < count; i++) {
+			slot = &bch->cache[i];
+			slot->sector = ret < 0 ? (size_t)-1 : sector + done + i;
+			slot->dirty = false;
+			slot->lastuse = ++bch->tick;
+		}
+
+		if (ret < 0) {
+			fdbg("Write failed: %d\n", ret);
+			return ret;
+		}
+	}
+#else
+	ret = inode->u.i_bops->write(inode, buffer, sector, nsectors);
+	if (ret < 0) {
+		fdbg("Write failed: %d\n", ret);
+		return ret;
+	}
+#endif
+
+	return (ssize_t)nsectors;
+}
@@ -100,7 +100,8 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 	uint16_t	sectoffset;
 	size_t		nbytes;
 	size_t		bytesread;
-	int			ret;
+	int			slot;
+	ssize_t		ret;
 
 	/* Get rid of this special case right away */
 	if (len < 1) {
@@ -120,8 +121,11 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 
 	bytesread = 0;
 	if (sectoffset > 0) {
-		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the sector into the sector cache */
+		slot = bchlib_readsector(bch, sector);
+		if (slot < 0) {
+			return slot;
+		}
 
 		/* Copy the tail end of the sector to the user buffer */
 		if (sectoffset + len > bch->sectsize) {
@@ -130,7 +134,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 			nbytes = len;
 		}
 
-		memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+		memcpy(buffer, &bch->cache[slot].buffer[sectoffset], nbytes);
 
 		/* Adjust pointers and counts */
 		sector++;
@@ -154,11 +158,10 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 			nsectors = bch->nsectors - sector;
 		}
 
-		ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
-						sector, nsectors);
+		ret = bchlib_readsectors(bch, (FAR uint8_t *)buffer, sector, nsectors);
 		if (ret < 0) {
-			fdbg("ERROR: Read failed: %d\n");
-			return ret;
+			fdbg("ERROR: Read failed: %d\n", ret);
+			return bytesread > 0 ? bytesread : ret;
 		}
 
 		/* Adjust pointers and counts */
@@ -176,11 +179,14 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 
 	/* Then read any partial final sector */
 	if (len > 0) {
-		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the sector into the sector cache */
+		slot = bchlib_readsector(bch, sector);
+		if (slot < 0) {
+			return bytesread > 0 ? bytesread : slot;
+		}
 
 		/* Copy the head end of the sector to the user buffer */
-		memcpy(buffer, bch->buffer, len);
+		memcpy(buffer, bch->cache[slot].buffer, len);
 
 		/* Adjust counts */
 		bytesread += len;
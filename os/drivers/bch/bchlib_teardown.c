@@ -87,8 +87,10 @@ int bchlib_teardown(FAR void *handle)
 		return -EBUSY;
 	}
 
-	/* Flush any pending data to the block driver */
-	bchlib_flushsector(bch);
+	/* Flush any pending data to the block driver, nothing is left to retry it */
+	if (bchlib_flushsector(bch) < 0) {
+		fdbg("ERROR: Flush failed, dirty sectors are lost\n");
+	}
 
 	/* Close the block driver */
 	(void)close_blockdriver(bch->inode);
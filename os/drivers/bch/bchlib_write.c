@@ -87,7 +87,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 	uint16_t sectoffset;
 	size_t   nbytes;
 	size_t   byteswritten;
-	int      ret;
+	int      slot;
+	ssize_t  ret;
 
 	/* Get rid of this special case right away */
 	if (len < 1) {
@@ -106,8 +107,11 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 
 	byteswritten = 0;
 	if (sectoffset > 0) {
-		/* Read the full sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the full sector into the sector cache */
+		slot = bchlib_readsector(bch, sector);
+		if (slot < 0) {
+			return slot;
+		}
 
 		/* Copy the tail end of the sector from the user buffer */
 		if (sectoffset + len > bch->sectsize) {
@@ -116,8 +120,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 			nbytes = len;
 		}
 
-		memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-		bch->dirty = true;
+		memcpy(&bch->cache[slot].buffer[sectoffset], buffer, nbytes);
+		bch->cache[slot].dirty = true;
 
 		/* Adjust pointers and counts */
 		sector++;
@@ -142,8 +146,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 		}
 
 		/* Write the contiguous sectors */
-		ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
-				sector, nsectors);
+		ret = bchlib_writesectors(bch, (FAR const uint8_t *)buffer, sector, nsectors);
 		if (ret < 0) {
 			fdbg("ERROR: Write failed: %d\n", ret);
 			return ret;
@@ -164,23 +167,28 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 
 	/* Then write any partial final sector */
 	if (len > 0) {
-		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the sector into the sector cache */
+		slot = bchlib_readsector(bch, sector);
+		if (slot < 0) {
+			return slot;
+		}
 
 		/* Copy the head end of the sector from the user buffer */
-		memcpy(bch->buffer, buffer, len);
-		bch->dirty = true;
+		memcpy(bch->cache[slot].buffer, buffer, len);
+		bch->cache[slot].dirty = true;
 
 		/* Adjust counts */
 		byteswritten += len;
 	}
 
+#ifndef CONFIG_BCH_CACHE_WRITEBACK
 	/* Finally, flush any cached writes to the device as well */
 	ret = bchlib_flushsector(bch);
 	if (ret < 0) {
 		fdbg("ERROR: Flush failed: %d\n", ret);
 		return ret;
 	}
+#endif
 
 	return byteswritten;
 }
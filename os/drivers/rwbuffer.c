@@ -639,6 +639,7 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 		/* Initialize write buffer parameters */
 
 		rwb_resetwrbuffer(rwb);
+		memset(&rwb->work, 0, sizeof(struct work_s));
 
 		/* Allocate the write buffer */
 
@@ -41,6 +41,11 @@
 #include <tinyara/fs/fs.h>
 #include <tinyara/arch.h>
 #include <tinyara/ringbuf.h>
+#ifdef CONFIG_TTRACE_EVENTS
+#include <tinyara/sched.h>
+#include <tinyara/clock.h>
+#include <tinyara/ttrace.h>
+#endif
 
 #include <arch/irq.h>
 
@@ -67,6 +72,18 @@
 
 #define NO_HOLDER               ((pid_t)-1)
 
+#ifdef CONFIG_TTRACE_EVENTS
+#if (CONFIG_TTRACE_EVENTS_PER_TASK & (CONFIG_TTRACE_EVENTS_PER_TASK - 1)) != 0
+#error "CONFIG_TTRACE_EVENTS_PER_TASK must be a power of two"
+#endif
+
+/* The last ring is shared by interrupt handlers */
+
+#define TTRACE_EVBUF_SHARED     CONFIG_MAX_TASKS
+#define TTRACE_EVBUF_NUM        (CONFIG_MAX_TASKS + 1)
+#define TTRACE_EVBUF_MASK       (CONFIG_TTRACE_EVENTS_PER_TASK - 1)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -77,6 +94,23 @@ struct ttrace_dev_s {
 	FAR char *ttrace_packets;  /* Trace packets buffer */
 };
 
+#ifdef CONFIG_TTRACE_EVENTS
+/* Binary events of one task.  The task is the only producer of its ring,
+ * so it records an event without any lock: it fills the slot at head and
+ * then publishes it by advancing head.  The ring keeps at most
+ * CONFIG_TTRACE_EVENTS_PER_TASK - 1 events, the slot at head may be being
+ * written by a producer which was preempted when tracing stopped.
+ */
+
+struct ttrace_evbuf_s {
+	volatile uint32_t head;    /* Number of events written, owned by the producer */
+	uint32_t dropped;          /* Events lost because the ring was full */
+	uint32_t rdpos;            /* Next event to merge, owned by the reader */
+	uint32_t rdend;            /* End of the events to merge */
+	struct ttrace_event_s events[CONFIG_TTRACE_EVENTS_PER_TASK];
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -110,6 +144,12 @@ static struct ringbuf g_ringbuf = {
 static uint32_t g_state = TTRACE_STATE_IDLE;
 static uint32_t g_selected_tag = 0;
 
+#ifdef CONFIG_TTRACE_EVENTS
+/* Per-task event rings indexed by PIDHASH(), allocated on the first start */
+
+static FAR struct ttrace_evbuf_s *g_evbufs;
+#endif
+
 /* This is the device structure for the T-trace function. It
  * must be statically initialized because the T-trace ttrace_putc function
  * could be called before the driver initialization logic executes.
@@ -125,6 +165,111 @@ static struct ttrace_dev_s g_sysdev = {
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_TTRACE_EVENTS
+/****************************************************************************
+ * Name: ttrace_event_put
+ *
+ * Description:
+ *   Record one event into evbuf.  The caller must be the only producer of
+ *   evbuf while this runs.
+ *
+ ****************************************************************************/
+
+static void ttrace_event_put(FAR struct ttrace_evbuf_s *evbuf, pid_t pid, uint8_t type, uint8_t aux, uint32_t arg)
+{
+	FAR struct ttrace_event_s *ev;
+	struct timespec ts;
+	uint32_t head = evbuf->head;
+
+	if (head >= TTRACE_EVBUF_MASK && !g_ringbuf.is_overwritable) {
+		evbuf->dropped++;
+		return;
+	}
+
+	clock_systimespec(&ts);
+
+	ev = &evbuf->events[head & TTRACE_EVBUF_MASK];
+	ev->sec = ts.tv_sec;
+	ev->usec = ts.tv_nsec / 1000;
+	ev->pid = pid;
+	ev->type = type;
+	ev->aux = aux;
+	ev->arg = arg;
+
+	evbuf->head = head + 1;
+}
+
+/****************************************************************************
+ * Name: ttrace_event_used
+ ****************************************************************************/
+
+static int ttrace_event_used(void)
+{
+	int used = 0;
+	int i;
+
+	for (i = 0; i < TTRACE_EVBUF_NUM; i++) {
+		used += g_evbufs[i].head < TTRACE_EVBUF_MASK ? g_evbufs[i].head : TTRACE_EVBUF_MASK;
+	}
+
+	return used;
+}
+
+/****************************************************************************
+ * Name: ttrace_event_read
+ *
+ * Description:
+ *   Merge the events of all rings into one list ordered by time.  Each ring
+ *   is already ordered, so this only picks the oldest head of all rings.
+ *
+ ****************************************************************************/
+
+static int ttrace_event_read(FAR struct ttrace_event_s *events, int nevents)
+{
+	FAR struct ttrace_evbuf_s *evbuf;
+	FAR struct ttrace_event_s *ev;
+	FAR struct ttrace_event_s *oldest;
+	uint32_t head;
+	int ring;
+	int n;
+	int i;
+
+	for (i = 0; i < TTRACE_EVBUF_NUM; i++) {
+		evbuf = &g_evbufs[i];
+		head = evbuf->head;
+		evbuf->rdend = head;
+		evbuf->rdpos = head - (head < TTRACE_EVBUF_MASK ? head : TTRACE_EVBUF_MASK);
+	}
+
+	for (n = 0; n < nevents; n++) {
+		oldest = NULL;
+		ring = 0;
+
+		for (i = 0; i < TTRACE_EVBUF_NUM; i++) {
+			evbuf = &g_evbufs[i];
+			if (evbuf->rdpos == evbuf->rdend) {
+				continue;
+			}
+
+			ev = &evbuf->events[evbuf->rdpos & TTRACE_EVBUF_MASK];
+			if (oldest == NULL || ev->sec < oldest->sec || (ev->sec == oldest->sec && ev->usec < oldest->usec)) {
+				oldest = ev;
+				ring = i;
+			}
+		}
+
+		if (oldest == NULL) {
+			break;
+		}
+
+		events[n] = *oldest;
+		g_evbufs[ring].rdpos++;
+	}
+
+	return n;
+}
+#endif
+
 /****************************************************************************
  * Name: ttrace_read
  ****************************************************************************/
@@ -190,6 +335,22 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 	switch (cmd) {
 	case TTRACE_START:
+#ifdef CONFIG_TTRACE_EVENTS
+		if (g_evbufs == NULL) {
+			g_evbufs = (FAR struct ttrace_evbuf_s *)kmm_zalloc(TTRACE_EVBUF_NUM * sizeof(struct ttrace_evbuf_s));
+			if (g_evbufs == NULL) {
+				ret = TTRACE_INVALID;
+				break;
+			}
+		} else {
+			int i;
+
+			for (i = 0; i < TTRACE_EVBUF_NUM; i++) {
+				g_evbufs[i].head = 0;
+				g_evbufs[i].dropped = 0;
+			}
+		}
+#endif
 		g_state = TTRACE_STATE_RUNNING;
 		priv->ttrace_head = 0;
 		break;
@@ -209,6 +370,19 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		ttdbg("Given buffer size: %d\r\n", CONFIG_TTRACE_BUFSIZE);
 		ttdbg("Buffer is_overwritten: %d\r\n", g_ringbuf.is_overwritten);
 		ttdbg("Buffer is_overwritable: %d\r\n", g_ringbuf.is_overwritable);
+#ifdef CONFIG_TTRACE_EVENTS
+		if (g_evbufs != NULL) {
+			int i;
+
+			ttdbg("Events per task: %d\r\n", CONFIG_TTRACE_EVENTS_PER_TASK);
+			ttdbg("Used events: %d\r\n", ttrace_event_used());
+			for (i = 0; i < TTRACE_EVBUF_NUM; i++) {
+				if (g_evbufs[i].dropped > 0) {
+					ttdbg("Dropped events of ring %d: %u\r\n", i, g_evbufs[i].dropped);
+				}
+			}
+		}
+#endif
 		break;
 	case TTRACE_SELECTED_TAG:
 		g_selected_tag |= arg;
@@ -227,6 +401,23 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		}
 		ttdbg("used bufsize: %d\r\n", ret);
 		break;
+#ifdef CONFIG_TTRACE_EVENTS
+	case TTRACE_USED_EVENTS:
+		ret = (g_evbufs != NULL) ? ttrace_event_used() : 0;
+		break;
+	case TTRACE_READ_EVENTS: {
+		FAR struct ttrace_evread_s *rd = (FAR struct ttrace_evread_s *)arg;
+
+		if (TTRACE_STATE_IDLE != g_state || rd == NULL) {
+			ret = TTRACE_INVALID;
+		} else if (g_evbufs == NULL) {
+			ret = 0;
+		} else {
+			ret = ttrace_event_read(rd->events, rd->nevents);
+		}
+		break;
+	}
+#endif
 	case TTRACE_BUFFER:
 		ttdbg("Resize of trace buffer is not supported yet.\r\n");
 		ttdbg("Trace buffer size should be defined by menuconfig.\r\n");
@@ -244,6 +435,67 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_TTRACE_EVENTS
+/****************************************************************************
+ * Name: ttrace_event
+ *
+ * Description:
+ *   Record an event into the ring of the calling task without taking
+ *   sched_lock().  In an interrupt handler the shared ring is used
+ *   instead, with interrupts disabled against nested handlers.
+ *
+ ****************************************************************************/
+
+void ttrace_event(int tag, uint8_t type, uint32_t arg)
+{
+	FAR struct tcb_s *tcb;
+	irqstate_t flags;
+
+	if (TTRACE_STATE_RUNNING != g_state || !(g_selected_tag & tag) || g_evbufs == NULL) {
+		return;
+	}
+
+	tcb = sched_self();
+
+	if (up_interrupt_context()) {
+		flags = irqsave();
+		ttrace_event_put(&g_evbufs[TTRACE_EVBUF_SHARED], tcb->pid, type, 0, arg);
+		irqrestore(flags);
+	} else {
+		ttrace_event_put(&g_evbufs[PIDHASH(tcb->pid)], tcb->pid, type, 0, arg);
+	}
+}
+
+/****************************************************************************
+ * Name: ttrace_event_sched
+ *
+ * Description:
+ *   Record a context switch from prev to next.  Outside of interrupt
+ *   handlers this still runs as prev, which owns the ring to use.
+ *
+ ****************************************************************************/
+
+void ttrace_event_sched(FAR struct tcb_s *prev, FAR struct tcb_s *next)
+{
+	irqstate_t flags;
+	uint32_t arg;
+
+	if (TTRACE_STATE_RUNNING != g_state || !(g_selected_tag & TTRACE_TAG_TASK) || g_evbufs == NULL) {
+		return;
+	}
+
+	arg = ((uint32_t)(uint16_t)next->pid << 16) | ((uint32_t)next->sched_priority << 8) | prev->task_state;
+
+	if (up_interrupt_context()) {
+		flags = irqsave();
+		ttrace_event_put(&g_evbufs[TTRACE_EVBUF_SHARED], prev->pid, TTRACE_EVENT_SCHED, prev->sched_priority, arg);
+		irqrestore(flags);
+	} else {
+		ttrace_event_put(&g_evbufs[PIDHASH(prev->pid)], prev->pid, TTRACE_EVENT_SCHED, prev->sched_priority, arg);
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: ttrace_init
  *
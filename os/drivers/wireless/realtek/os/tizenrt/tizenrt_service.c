@@ -18,6 +18,7 @@
 #include <../arch/arm/src/imxrt/imxrt_config.h>
 //#include <tcm_heap.h>
 #include <drv_types.h>
+#include <tinyara/mm/kmm_pool.h>
 /********************* os depended utilities ********************/
 
 #ifndef USE_MUTEX_FOR_SPINLOCK
@@ -673,12 +674,51 @@ static void _tizenrt_thread_exit(void)
 	task_delete(0);
 }
 
+#ifdef CONFIG_MM_KMM_POOL
+static FAR struct kmm_pool_s *g_timer_work_pool;
+#endif
+
+static struct work_s *_tizenrt_timer_work_alloc(void)
+{
+#ifdef CONFIG_MM_KMM_POOL
+	struct work_s *work;
+
+	/* Timers are created from several driver threads; create the pool once */
+
+	if (g_timer_work_pool == NULL) {
+		sched_lock();
+		if (g_timer_work_pool == NULL) {
+			g_timer_work_pool = kmm_pool_create("rtkwork", sizeof(struct work_s), CONFIG_MM_KMM_POOL_NWORK);
+		}
+		sched_unlock();
+	}
+
+	work = (struct work_s *)kmm_pool_alloc(g_timer_work_pool, sizeof(struct work_s));
+	if (work != NULL) {
+		memset(work, 0, sizeof(struct work_s));
+	}
+	return work;
+#else
+	return (struct work_s *)kmm_zalloc(sizeof(struct work_s));
+#endif
+}
+
+static void _tizenrt_timer_work_free(struct work_s *work)
+{
+#ifdef CONFIG_MM_KMM_POOL
+	if (kmm_pool_free(g_timer_work_pool, work)) {
+		return;
+	}
+#endif
+	kmm_free(work);
+}
+
 _timerHandle _tizenrt_timerCreate(_timer *timer, const signed char *pcTimerName,
 		osdepTickType xTimerPeriodInTicks,
 		u32 uxAutoReload,
 		void *pvTimerID)
 {
-	timer->work_hdl = (struct work_s *)kmm_zalloc(sizeof(struct work_s));
+	timer->work_hdl = _tizenrt_timer_work_alloc();
 
 	if (timer->work_hdl == NULL) {
 		DBG_ERR("Fail to alloc timer->work_hdl");
@@ -701,7 +741,7 @@ u32 _tizenrt_timerDelete(_timer *timer,
 	timer->timer_hdl = NULL;
 	timer->timevalue = 0;
 	timer->live = 0;
-	kmm_free(timer->work_hdl);
+	_tizenrt_timer_work_free(timer->work_hdl);
 	return _SUCCESS;
 
 cleanup:
@@ -709,14 +749,14 @@ cleanup:
 		timer->timer_hdl = NULL;
 		timer->timevalue = 0;
 		timer->live = 0;
-		kmm_free(timer->work_hdl);
+		_tizenrt_timer_work_free(timer->work_hdl);
 		DBG_ERR("_tizenrt_del_timer failed! ret = %d", ret);
 		return _FAIL;
 	}
 	timer->timer_hdl = NULL;
 	timer->timevalue = 0;
 	timer->live = 0;
-	kmm_free(timer->work_hdl);
+	_tizenrt_timer_work_free(timer->work_hdl);
 	//DBG_ERR("_tizenrt_del_timer is Done! timer->work_hdl = %x", timer->work_hdl);
 	return _SUCCESS;
 }
@@ -739,7 +779,7 @@ u32 _tizenrt_timerStop(_timer *timer,
 
 cleanup:
 	if (ret != -2) {
-		kmm_free(timer->work_hdl);
+		_tizenrt_timer_work_free(timer->work_hdl);
 		DBG_ERR("_tizenrt_stop_timer failed! ret = %d", ret);
 		return _FAIL;
 	}
@@ -795,7 +835,7 @@ u32 _tizenrt_timerChangePeriod(_timer *timer,
 	return _SUCCESS;
 
 cleanup:
-	kmm_free(timer->work_hdl);
+	_tizenrt_timer_work_free(timer->work_hdl);
 	timer->timer_hdl = NULL;
 	timer->live = 0;
 	DBG_ERR("_tizenrt_set_timer failed!");
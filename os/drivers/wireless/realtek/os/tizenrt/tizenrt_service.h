@@ -747,6 +747,7 @@ typedef struct work_s work_struct;
 		(_work)->arg = (FAR void *)(0); \
 		(_work)->qtime = 0;             \
 		(_work)->delay = 0;             \
+		(_work)->flags = 0;             \
 	} while (0)
 
 static inline void _init_workitem(_workitem *pwork, void *pfunc, void *cntx)
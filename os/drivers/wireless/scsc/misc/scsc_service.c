@@ -381,7 +381,7 @@ struct scsc_service *scsc_mx_service_open(struct scsc_mx *mx, enum scsc_service_
 
 		pthread_mutex_lock(&srvman->api_access_mutex);
 	}
-	service = kmm_malloc(sizeof(struct scsc_service));
+	service = kmm_zalloc(sizeof(struct scsc_service));
 	if (service) {
 		/* MaxwellManager Should allocate Mem and download FW */
 		ret = mxman_open(mxman);
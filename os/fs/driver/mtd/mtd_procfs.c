@@ -89,6 +89,7 @@
 struct mtd_file_s {
 	struct procfs_file_s base;	/* Base open file structure */
 	FAR struct mtd_dev_s *pnextmtd;	/* Pointer to next registered MTD */
+	FAR struct mtd_gcstats_s *pnextgc;	/* Pointer to next registered GC statistics */
 };
 
 /****************************************************************************
@@ -137,6 +138,7 @@ const struct procfs_operations mtd_procfsoperations = {
 
 static struct mtd_dev_s *g_pfirstmtd = NULL;
 static uint8_t g_nextmtdno = 0;
+static struct mtd_gcstats_s *g_pfirstgc = NULL;
 
 /****************************************************************************
  * Private Functions
@@ -172,6 +174,7 @@ static int mtd_open(FAR struct file *filep, FAR const char *relpath, int oflags,
 	}
 
 	attr->pnextmtd = g_pfirstmtd;
+	attr->pnextgc = g_pfirstgc;
 
 	/* Save the context as the open-specific state in filep->f_priv */
 
@@ -243,6 +246,36 @@ static ssize_t mtd_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
 		} while (priv->pnextmtd);
 	}
 
+	/* Then the garbage collection statistics, once all devices are listed */
+
+	if (priv->pnextmtd == NULL && priv->pnextgc) {
+		if (priv->pnextgc == g_pfirstgc) {
+			ret = snprintf(&buffer[total], buflen - total, "\nGC Device          Slices  Relocated  Reclaimed  Foreground  MaxSlice\n");
+			if (ret + total >= buflen) {
+				buffer[total] = '\0';
+				goto out;
+			}
+
+			total += ret;
+		}
+
+		do {
+			FAR struct mtd_gcstats_s *gc = priv->pnextgc;
+
+			ret = snprintf(&buffer[total], buflen - total, "   %-15s %6u  %9u  %9u  %10u  %8u\n", gc->name, gc->slices, gc->relocated, gc->reclaimed, gc->foreground, gc->maxslice);
+
+			if (ret + total < buflen) {
+				total += ret;
+				priv->pnextgc = gc->pnext;
+			} else {
+				buffer[total] = '\0';
+				break;
+			}
+		} while (priv->pnextgc);
+	}
+
+out:
+
 	/* Update the file offset */
 
 	if (total > 0) {
@@ -357,4 +390,37 @@ int mtd_register(FAR struct mtd_dev_s *mtd, FAR const char *name)
 	return OK;
 }
 
+/****************************************************************************
+ * Name: mtd_gcregister
+ *
+ * Description:
+ *   Registers a set of garbage collection statistics with the procfs file
+ *   system.  The statistics structure is owned by the caller, which keeps
+ *   it up to date; it is reported after the list of registered devices.
+ *
+ ****************************************************************************/
+
+int mtd_gcregister(FAR struct mtd_gcstats_s *stats, FAR const char *name)
+{
+	FAR struct mtd_gcstats_s *plast;
+
+	stats->name = name;
+	stats->pnext = NULL;
+
+	/* Add to the end of the list of registered statistics */
+
+	if (g_pfirstgc == NULL) {
+		g_pfirstgc = stats;
+	} else {
+		plast = g_pfirstgc;
+		while (plast->pnext) {
+			plast = plast->pnext;
+		}
+
+		plast->pnext = stats;
+	}
+
+	return OK;
+}
+
 #endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
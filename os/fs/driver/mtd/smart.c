@@ -80,6 +80,12 @@
 #include <tinyara/fs/smart_procfs.h>
 #include <tinyara/fs/smart.h>
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+#include <semaphore.h>
+#include <tinyara/clock.h>
+#include <tinyara/wqueue.h>
+#endif
+
 /****************************************************************************
  * Private Definitions
  ****************************************************************************/
@@ -170,6 +176,53 @@
 #define SMART_WEAR_ZERO_MASK                0x0F
 #define SMART_WEAR_BLOCK_MASK               0x01
 
+/* The map checkpoint restores sMap directly, so it is only available when
+ * the full logical to physical map is kept in RAM and the scan does not
+ * have to rebuild any other state.
+ */
+
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) || defined(CONFIG_SMARTFS_MULTI_ROOT_DIRS) || \
+	defined(CONFIG_SMARTFS_BAD_SECTOR)
+#undef CONFIG_MTD_SMART_MAP_CHECKPOINT
+#endif
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+#define SMART_CKPT_MAGIC                    0x504b4353	/* "SCKP" */
+#define SMART_CKPT_VERSION                  1
+#ifndef CONFIG_MTD_SMART_MAP_CHECKPOINT_DELTA
+#define CONFIG_MTD_SMART_MAP_CHECKPOINT_DELTA 32
+#endif
+#define SMART_CKPT_IS_LOGGED(d, b)          ((d)->ckptlog[(b) >> 3] & (1 << ((b) & 0x07)))
+#endif
+
+/* Background garbage collection runs on the low priority work queue (or the
+ * high priority one if there is no low priority queue).  There is nothing
+ * to collect on a read-only configuration.
+ */
+
+#if !defined(CONFIG_FS_WRITABLE) || !defined(CONFIG_SCHED_WORKQUEUE)
+#undef CONFIG_MTD_SMART_BACKGROUND_GC
+#endif
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+#ifndef CONFIG_MTD_SMART_GC_RESERVE_BLOCKS
+#define CONFIG_MTD_SMART_GC_RESERVE_BLOCKS  4
+#endif
+#ifndef CONFIG_MTD_SMART_GC_SLICE_SECTORS
+#define CONFIG_MTD_SMART_GC_SLICE_SECTORS   4
+#endif
+#ifndef CONFIG_MTD_SMART_GC_DELAY
+#define CONFIG_MTD_SMART_GC_DELAY           20
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+#define SMART_GC_WORK                       LPWORK
+#else
+#define SMART_GC_WORK                       HPWORK
+#endif
+#define SMART_GC_NONE                       0xFFFF
+#define SMART_GC_MIN_RELEASED(d)            (((d)->availSectPerBlk >> 2) + 1)
+#endif
+
 #if CONFIG_SMARTFS_ERASEDSTATE == 0xFF
 #define SECTOR_IS_RELEASED(h) ((h.status & SMART_STATUS_RELEASED) == 0 ? true : false)
 #define SECTOR_IS_COMMITTED(h) ((h.status & SMART_STATUS_COMMITTED) == 0 ? true : false)
@@ -351,6 +404,21 @@ struct smart_struct_s {
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	FAR uint8_t *erasecounts;	/* Number of erases for each erase block */
 #endif
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	uint16_t ckptblocks;		/* Erase blocks reserved for the map checkpoint */
+	uint16_t ckptlogged;		/* Number of erase blocks in the delta log */
+	bool ckptvalid;				/* Checkpoint plus delta log describe the device */
+	FAR uint8_t *ckptlog;		/* Bitmap of erase blocks in the delta log */
+#endif
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	sem_t exclsem;				/* Serializes the GC worker with the block driver */
+	struct work_s gcwork;		/* Background garbage collection work */
+	bool gcpending;				/* gcwork is queued */
+	uint16_t gcblock;			/* Erase block being collected or SMART_GC_NONE */
+	uint16_t gcsector;			/* Next physical sector to relocate out of gcblock */
+	char gcname[18];			/* Block device name reported in procfs */
+	struct mtd_gcstats_s gcstats;	/* Background collection statistics */
+#endif
 #ifdef CONFIG_MTD_SMART_ALLOC_DEBUG
 	size_t bytesalloc;
 	struct smart_alloc_s
@@ -433,6 +501,28 @@ typedef uint32_t crc_t;
 
 #endif
 
+/* Map checkpoint header.  It is stored at the start of the checkpoint
+ * region and is followed by the sMap / releasecount / freecount payload
+ * and the delta log of erase blocks modified since the checkpoint.
+ */
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+struct smart_ckpt_header_s {
+	uint32_t magic;				/* SMART_CKPT_MAGIC */
+	uint16_t version;			/* SMART_CKPT_VERSION */
+	uint16_t sectorsize;		/* Sector size the map was built for */
+	uint16_t totalsectors;		/* Number of entries in the map */
+	uint16_t neraseblocks;		/* Number of erase block counts */
+	uint16_t freesectors;		/* Total number of free sectors */
+	uint16_t releasesectors;	/* Total number of released sectors */
+	uint8_t formatstatus;		/* Format status of the device */
+	uint8_t formatversion;		/* Format version on the device */
+	uint8_t namesize;			/* Length of filenames on this device */
+	uint8_t reserved;
+	uint32_t crc;				/* CRC-32 of the header and payload */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -453,6 +543,7 @@ static uint16_t smart_findfreephyssector(FAR struct smart_struct_s *dev, uint8_t
 static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg);
 #endif
 static int smart_readsector(FAR struct smart_struct_s *dev, unsigned long arg);
+static int smart_readchain(FAR struct smart_struct_s *dev, unsigned long arg);
 
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 static int smart_read_wearstatus(FAR struct smart_struct_s *dev);
@@ -461,6 +552,11 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t block, uint8_t forceerase);
 static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsector, uint16_t newsector);
 static int smart_validate_crc(FAR struct smart_struct_s *dev);
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static void smart_ckpt_touch(FAR struct smart_struct_s *dev, uint16_t block);
+static void smart_ckpt_invalidate(FAR struct smart_struct_s *dev);
+static int smart_ckpt_write(FAR struct smart_struct_s *dev);
+#endif
 static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev);
 
 /****************************************************************************
@@ -551,6 +647,32 @@ static void smart_free(FAR struct smart_struct_s *dev, FAR void *ptr)
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: smart_semtake / smart_semgive
+ *
+ * Description: Get / release exclusive access to the device.  Only needed
+ *   when the background garbage collector can run concurrently with the
+ *   block driver; otherwise the file system's own lock serializes access.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static void smart_semtake(FAR struct smart_struct_s *dev)
+{
+	/* Take the semaphore (perhaps waiting) */
+
+	while (sem_wait(&dev->exclsem) != 0) {
+		/* The only case that an error should occur here is if
+		 * the wait was awakened by a signal.
+		 */
+
+		DEBUGASSERT(errno == EINTR);
+	}
+}
+
+#define smart_semgive(d) sem_post(&(d)->exclsem)
+#endif
+
 /****************************************************************************
  * Name: smart_open
  *
@@ -573,7 +695,28 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	FAR struct smart_struct_s *dev;
+#endif
+
 	fvdbg("Entry\n");
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	/* Checkpoint the map on a clean close (i.e. unmount) so the next mount
+	 * doesn't need to scan the device.
+	 */
+
+	DEBUGASSERT(inode && inode->i_private);
+	dev = (FAR struct smart_struct_s *)inode->i_private;
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	smart_semtake(dev);
+#endif
+	smart_ckpt_write(dev);
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	smart_semgive(dev);
+#endif
+#endif
+
 	return OK;
 }
 
@@ -808,6 +951,9 @@ static ssize_t smart_reload(struct smart_struct_s *dev, FAR uint8_t *buffer, off
 static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer, size_t start_sector, unsigned int nsectors)
 {
 	struct smart_struct_s *dev;
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	ssize_t ret;
+#endif
 
 	fvdbg("SMART: sector: %d nsectors: %d\n", start_sector, nsectors);
 
@@ -817,7 +963,14 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer, size_t
 #else
 	dev = (struct smart_struct_s *)inode->i_private;
 #endif
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	smart_semtake(dev);
+	ret = smart_reload(dev, buffer, start_sector, nsectors);
+	smart_semgive(dev);
+	return ret;
+#else
 	return smart_reload(dev, buffer, start_sector, nsectors);
+#endif
 }
 
 /****************************************************************************
@@ -854,6 +1007,16 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 
 	/* I think maybe we need to lock on a mutex here. */
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	smart_semtake(dev);
+#endif
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	/* Raw writes bypass the sector map, so the checkpoint can't describe them. */
+
+	smart_ckpt_invalidate(dev);
+#endif
+
 	/* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
 	 * per erase block is a power of 2, and (2) the erase begins with that same
 	 * alignment.
@@ -891,6 +1054,9 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 
 				/* Unlock the mutex if we add one. */
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+				smart_semgive(dev);
+#endif
 				return ret;
 			}
 		}
@@ -917,6 +1083,9 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 
 			/* Unlock the mutex if we add one. */
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+			smart_semgive(dev);
+#endif
 			return -EIO;
 		}
 
@@ -928,6 +1097,9 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 		alignedblock += mtdBlksPerErase;
 	}
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	smart_semgive(dev);
+#endif
 	return nsectors;
 }
 #endif							/* CONFIG_FS_WRITABLE */
@@ -1260,6 +1432,12 @@ errexit:
 	}
 #endif
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	if (dev->ckptlog) {
+		smart_free(dev, dev->ckptlog);
+	}
+#endif
+
 	kmm_free(dev);
 	return -ENOMEM;
 }
@@ -1278,6 +1456,10 @@ errexit:
 static ssize_t smart_bytewrite(FAR struct smart_struct_s *dev, size_t offset, int nbytes, FAR const uint8_t *buffer)
 {
 	ssize_t ret;
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	smart_ckpt_touch(dev, offset / dev->geo.erasesize);
+#endif
 #ifdef CONFIG_MTD_BYTE_WRITE
 	/* Check if the underlying MTD device supports write. */
 
@@ -1325,6 +1507,229 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smart_ckpt_blocks
+ *
+ * Description: Returns the number of erase blocks to reserve at the end of
+ *              the device for the map checkpoint, or zero if the device is
+ *              too small to give them up.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static uint16_t smart_ckpt_blocks(FAR const struct mtd_geometry_s *geo)
+{
+	uint32_t totalsectors;
+	uint32_t size;
+	uint32_t blocks;
+
+	if (geo->erasesize < CONFIG_MTD_SMART_SECTOR_SIZE || geo->neraseblocks >= 0xFFFF) {
+		return 0;
+	}
+
+	totalsectors = geo->neraseblocks * (geo->erasesize / CONFIG_MTD_SMART_SECTOR_SIZE);
+	if (totalsectors > 65534) {
+		totalsectors = 65534;
+	}
+
+	/* Header, map, release and free counts and one log entry per block. */
+
+	size = sizeof(struct smart_ckpt_header_s) + totalsectors * sizeof(uint16_t) + (geo->neraseblocks << 2);
+	blocks = (size + geo->erasesize - 1) / geo->erasesize;
+
+	/* Don't give away more than an eighth of the device. */
+
+	if ((blocks << 3) > geo->neraseblocks) {
+		return 0;
+	}
+
+	return (uint16_t)blocks;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_ckpt_payload
+ *
+ * Description: Returns the size of the checkpoint payload, which is the
+ *              sMap buffer along with the release and free counts that
+ *              are allocated behind it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static inline uint32_t smart_ckpt_payload(FAR struct smart_struct_s *dev)
+{
+	return dev->totalsectors * sizeof(uint16_t) + (dev->neraseblocks << 1);
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_ckpt_invalidate
+ *
+ * Description: Discards the checkpoint so the next mount does a full scan.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static void smart_ckpt_invalidate(FAR struct smart_struct_s *dev)
+{
+	if (dev->ckptblocks == 0) {
+		return;
+	}
+
+	dev->ckptvalid = false;
+
+	/* The header lives in the first block of the region. */
+
+	MTD_ERASE(dev->mtd, dev->geo.neraseblocks, 1);
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_ckpt_touch
+ *
+ * Description: Records an erase block in the delta log before it is
+ *              programmed or erased.  Each block is logged only once per
+ *              checkpoint, so the log can never hold more entries than
+ *              there are erase blocks.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static void smart_ckpt_touch(FAR struct smart_struct_s *dev, uint16_t block)
+{
+	uint16_t entry;
+	uint32_t offset;
+	ssize_t ret;
+
+	if (!dev->ckptvalid || block >= dev->geo.neraseblocks || SMART_CKPT_IS_LOGGED(dev, block)) {
+		return;
+	}
+
+	/* Entries are stored as block + 1 so neither erased state is a valid entry. */
+
+	entry = block + 1;
+	offset = dev->geo.neraseblocks * dev->geo.erasesize + sizeof(struct smart_ckpt_header_s) + smart_ckpt_payload(dev) + dev->ckptlogged * sizeof(uint16_t);
+
+	ret = smart_bytewrite(dev, offset, sizeof(uint16_t), (FAR const uint8_t *)&entry);
+	if (ret != sizeof(uint16_t)) {
+		fdbg("Error %d logging block %d, dropping checkpoint\n", ret, block);
+		smart_ckpt_invalidate(dev);
+		return;
+	}
+
+	dev->ckptlog[block >> 3] |= 1 << (block & 0x07);
+	dev->ckptlogged++;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_ckpt_write
+ *
+ * Description: Writes the logical to physical map and the per erase block
+ *              counts to the checkpoint region and empties the delta log.
+ *              The header is written last so an interrupted checkpoint is
+ *              simply invalid and the next mount falls back to a full scan.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int smart_ckpt_write(FAR struct smart_struct_s *dev)
+{
+	struct smart_ckpt_header_s header;
+	FAR const uint8_t *payload;
+	uint32_t base;
+	uint32_t offset;
+	uint32_t remaining;
+	uint32_t nbytes;
+	uint32_t crc;
+	ssize_t ret;
+
+	if (dev->ckptblocks == 0 || dev->formatstatus != SMART_FMT_STAT_FORMATTED) {
+		return -ENOSYS;
+	}
+
+	/* Nothing has changed since the last checkpoint. */
+
+	if (dev->ckptvalid && dev->ckptlogged == 0) {
+		return OK;
+	}
+
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+	/* Allocated sectors that are not yet written only exist in RAM. */
+
+	if (dev->allocsector != NULL) {
+		return -EBUSY;
+	}
+#endif
+
+	remaining = smart_ckpt_payload(dev);
+	if (sizeof(struct smart_ckpt_header_s) + remaining + (dev->neraseblocks << 1) > dev->ckptblocks * dev->geo.erasesize) {
+		fdbg("Checkpoint region too small for sector size %d\n", dev->sectorsize);
+		return -ENOSPC;
+	}
+
+	dev->ckptvalid = false;
+	base = dev->geo.neraseblocks * dev->geo.erasesize;
+	ret = MTD_ERASE(dev->mtd, dev->geo.neraseblocks, dev->ckptblocks);
+	if (ret < 0) {
+		fdbg("Error %d erasing checkpoint\n", -ret);
+		return ret;
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.magic = SMART_CKPT_MAGIC;
+	header.version = SMART_CKPT_VERSION;
+	header.sectorsize = dev->sectorsize;
+	header.totalsectors = dev->totalsectors;
+	header.neraseblocks = dev->neraseblocks;
+	header.freesectors = dev->freesectors;
+	header.releasesectors = dev->releasesectors;
+	header.formatstatus = dev->formatstatus;
+	header.formatversion = dev->formatversion;
+	header.namesize = dev->namesize;
+
+	payload = (FAR const uint8_t *)dev->sMap;
+	crc = crc32part((FAR const uint8_t *)&header, offsetof(struct smart_ckpt_header_s, crc), 0);
+	crc = crc32part(payload, remaining, crc);
+	header.crc = crc;
+
+	/* Write the payload without crossing a sector, as smart_bytewrite
+	 * only buffers one sector.
+	 */
+
+	offset = base + sizeof(struct smart_ckpt_header_s);
+	while (remaining > 0) {
+		nbytes = dev->sectorsize - (offset % dev->sectorsize);
+		if (nbytes > remaining) {
+			nbytes = remaining;
+		}
+
+		ret = smart_bytewrite(dev, offset, nbytes, payload);
+		if (ret != nbytes) {
+			fdbg("Error %d writing checkpoint\n", ret);
+			return ret < 0 ? ret : -EIO;
+		}
+
+		payload += nbytes;
+		offset += nbytes;
+		remaining -= nbytes;
+	}
+
+	ret = smart_bytewrite(dev, base, sizeof(struct smart_ckpt_header_s), (FAR const uint8_t *)&header);
+	if (ret != sizeof(struct smart_ckpt_header_s)) {
+		fdbg("Error %d writing checkpoint header\n", ret);
+		return ret < 0 ? ret : -EIO;
+	}
+
+	memset(dev->ckptlog, 0, (dev->neraseblocks + 7) >> 3);
+	dev->ckptlogged = 0;
+	dev->ckptvalid = true;
+
+	return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: smart_add_sector_to_cache
  *
@@ -1720,20 +2125,19 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev, uint16_t block,
 }
 #endif
 /****************************************************************************
- * Name: smart_scan
+ * Name: smart_scan_sectors
  *
- * Description: Perform a scan of the MTD device to search for format
- *              information and fill in logical sector mapping, freesector
- *              count, etc.
+ * Description: Scan the physical sectors in the range [start, end) and
+ *              merge them into the logical sector map and the per erase
+ *              block free / release counts.
  *
  ****************************************************************************/
 
-static int smart_scan(FAR struct smart_struct_s *dev)
+static int smart_scan_sectors(FAR struct smart_struct_s *dev, int start, int end, FAR uint8_t *sector_seq_log)
 {
 	int sector;
 	int ret;
 	uint16_t totalsectors;
-	uint16_t sectorsize, prerelease;
 	uint16_t logicalsector;
 	uint16_t loser;
 	uint16_t winner;
@@ -1742,7 +2146,6 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	uint16_t seq1;
 	uint16_t seq2;
 	struct smart_sect_header_s header;
-	uint8_t *sector_seq_log = NULL;
 	bool status_released, status_committed;
 	bool corrupted;
 #ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
@@ -1756,161 +2159,65 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #endif
 	int i;
 
-	fvdbg("Entry\n");
+	totalsectors = dev->totalsectors;
 
-	/* Find the sector size on the volume by reading headers from
-	 * sectors of decreasing size.  On a formatted volume, the sector
-	 * size is saved in the header status byte of seach sector, so
-	 * by starting with the largest supported sector size and
-	 * decreasing from there, we will be sure to find data that is
-	 * a header and not sector data.
-	 */
+	for (sector = start; sector < end; sector++) {
+		winner = sector;
+		corrupted = false;
+		fvdbg("Scan sector %d\n", sector);
 
-	sectorsize = 0xFFFF;
-	offset = 16384;
+		/* Calculate the read address for this sector. */
 
-	while (sectorsize == 0xFFFF) {
-		readaddress = 0;
+		readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
 
-		while (readaddress < dev->erasesize * dev->geo.neraseblocks) {
-			/* Read the next sector from the device. */
+		/* Read the header for this sector. */
 
-			ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
-			if (ret != sizeof(struct smart_sect_header_s)) {
-				goto err_out;
-			}
+		ret = MTD_BREAD(dev->mtd, sector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (uint8_t *)dev->rwbuffer);
+		if (ret != dev->mtdBlksPerSector) {
+			fdbg("Error reading physical sector %d.\n", sector);
+			goto errout;
+		}
+
+		memcpy(&header, dev->rwbuffer, sizeof(struct smart_sect_header_s));
+		ret = smart_validate_crc(dev);
+		if (ret != OK) {
+			if (HEADER_IS_CLEAN(header)) {
+				/* Header is cleaned but all blocks are not cleaned, it means corruption occurs during erasing. */
+				for (i = sizeof(struct smart_sect_header_s); i < dev->sectorsize; i++) {
+					if (dev->rwbuffer[i] != 0xFF) {
+						fdbg("It is not Erased value sector %u, offset %u, %x------------------\n", sector, i, dev->rwbuffer[i]);
+						corrupted = true;
+						break;
+					}
+				}
+				if (corrupted) {
+					fdbg("It seems erase-fail, physical sector : %d eraseblock : %d\n", sector, sector / dev->sectorsPerBlk);
+					smart_erase_block_if_empty(dev, sector / dev->sectorsPerBlk, TRUE);
+					sector = ((sector / dev->sectorsPerBlk) * dev->sectorsPerBlk) + dev->sectorsPerBlk - 1;
+					continue;
+				}
+			} else {
+				fdbg("It seems corrupted, physical sector : %d eraseblock : %d\n", sector, sector / dev->sectorsPerBlk);
+#ifdef CONFIG_DEBUG_FS
+//#if defined(CONFIG_DEBUG_FS) && defined(CONFIG_DEBUG_VERBOSE)
+				for (i = 0; i < sizeof(struct smart_sect_header_s); i++) {
+					fsdbg("%02x ", dev->rwbuffer[i]);
+				}
+				fsdbg("\n");
+#endif
+				fdbg("set Released and commited sector : %d\n", sector);
+#if CONFIG_SMARTFS_ERASEDSTATE == 0xFF
+				header.status = header.status & ~(SMART_STATUS_COMMITTED | SMART_STATUS_RELEASED);
+#else
+				header.status = header.status | SMART_STATUS_COMMITTED | SMART_STATUS_RELEASED;
+#endif
+				ret = smart_bytewrite(dev, readaddress + offsetof(struct smart_sect_header_s, status), 1, &header.status);
+				if (ret < 0) {
+					goto errout;
+				}
 
-			if (header.status != CONFIG_SMARTFS_ERASEDSTATE) {
-				sectorsize = (header.status & SMART_STATUS_SIZEBITS) << 7;
-				break;
 			}
-
-			readaddress += offset;
-		}
-
-		offset >>= 1;
-		if (offset < 256 && sectorsize == 0xFFFF) {
-			sectorsize = CONFIG_MTD_SMART_SECTOR_SIZE;
-		}
-	}
-
-	/* Now set the sectorsize and other sectorsize derived variables. */
-
-	ret = smart_setsectorsize(dev, sectorsize);
-	if (ret != OK) {
-		goto err_out;
-	}
-
-	/* Initialize the device variables. */
-
-	totalsectors = dev->totalsectors;
-
-	dev->reservedsector = SMART_FIRST_ALLOC_SECTOR;
-#ifdef CONFIG_SMARTFS_JOURNALING
-	if (totalsectors > CONFIG_SMARTFS_JOURNALING_THRESHOLD) {
-		dev->reservedsector += 2 * CONFIG_SMARTFS_NLOGGING_SECTORS;
-	}
-#endif
-
-	dev->formatstatus = SMART_FMT_STAT_NOFMT;
-	dev->freesectors = dev->availSectPerBlk * dev->geo.neraseblocks;
-	dev->releasesectors = 0;
-
-	/* Initialize the freecount and releasecount arrays. */
-
-	for (sector = 0; sector < dev->neraseblocks; sector++) {
-		if (sector == dev->neraseblocks - 1 && dev->totalsectors == 65534) {
-			prerelease = 2;
-		} else {
-			prerelease = 0;
-		}
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-		smart_set_count(dev, dev->freecount, sector, dev->availSectPerBlk - prerelease);
-		smart_set_count(dev, dev->releasecount, sector, prerelease);
-#else
-		dev->freecount[sector] = dev->availSectPerBlk - prerelease;
-		dev->releasecount[sector] = prerelease;
-#endif
-	}
-
-	/* Initialize the sector map. */
-
-#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	for (sector = 0; sector < totalsectors; sector++) {
-		dev->sMap[sector] = -1;
-	}
-#else
-	/* Clear all logical sector used bits. */
-
-	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
-#endif
-
-	/* Now scan the MTD device. */
-	sector_seq_log = (uint8_t *)kmm_zalloc(sizeof(uint8_t) * totalsectors);
-
-	if (sector_seq_log == NULL) {
-		ret = -ENOMEM;
-		goto err_out;
-	}
-
-	for (sector = 0; sector < totalsectors; sector++) {
-		winner = sector;
-		corrupted = false;
-		fvdbg("Scan sector %d\n", sector);
-
-		/* Calculate the read address for this sector. */
-
-		readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
-
-		/* Read the header for this sector. */
-
-		ret = MTD_BREAD(dev->mtd, sector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (uint8_t *)dev->rwbuffer);
-		if (ret != dev->mtdBlksPerSector) {
-			fdbg("Error reading physical sector %d.\n", sector);
-			goto err_out;
-		}
-
-		memcpy(&header, dev->rwbuffer, sizeof(struct smart_sect_header_s));
-		ret = smart_validate_crc(dev);
-		if (ret != OK) {
-			if (HEADER_IS_CLEAN(header)) {
-				/* Header is cleaned but all blocks are not cleaned, it means corruption occurs during erasing. */
-				for (i = sizeof(struct smart_sect_header_s); i < dev->sectorsize; i++) {
-					if (dev->rwbuffer[i] != 0xFF) {
-						fdbg("It is not Erased value sector %u, offset %u, %x------------------\n", sector, i, dev->rwbuffer[i]);
-						corrupted = true;
-						break;
-					}
-				}
-				if (corrupted) {
-					fdbg("It seems erase-fail, physical sector : %d eraseblock : %d\n", sector, sector / dev->sectorsPerBlk);
-					smart_erase_block_if_empty(dev, sector / dev->sectorsPerBlk, TRUE);
-					sector = ((sector / dev->sectorsPerBlk) * dev->sectorsPerBlk) + dev->sectorsPerBlk - 1;
-					continue;
-				}
-			} else {
-				fdbg("It seems corrupted, physical sector : %d eraseblock : %d\n", sector, sector / dev->sectorsPerBlk);
-#ifdef CONFIG_DEBUG_FS
-//#if defined(CONFIG_DEBUG_FS) && defined(CONFIG_DEBUG_VERBOSE)
-				for (i = 0; i < sizeof(struct smart_sect_header_s); i++) {
-					fsdbg("%02x ", dev->rwbuffer[i]);
-				}
-				fsdbg("\n");
-#endif
-				fdbg("set Released and commited sector : %d\n", sector);
-#if CONFIG_SMARTFS_ERASEDSTATE == 0xFF
-				header.status = header.status & ~(SMART_STATUS_COMMITTED | SMART_STATUS_RELEASED);
-#else
-				header.status = header.status | SMART_STATUS_COMMITTED | SMART_STATUS_RELEASED;
-#endif
-				ret = smart_bytewrite(dev, readaddress + offsetof(struct smart_sect_header_s, status), 1, &header.status);
-				if (ret < 0) {
-					goto err_out;
-				}
-
-			}
-		}
+		}
 
 
 		/* Get the logical sector number for this physical sector. */
@@ -1988,7 +2295,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 				status_released = true;
 				ret = smart_bytewrite(dev, readaddress + offsetof(struct smart_sect_header_s, status), 1, &header.status);
 				if (ret < 0) {
-					goto err_out;
+					goto errout;
 				}
 			} else {
 				continue;
@@ -2047,7 +2354,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			ret = MTD_READ(dev->mtd, readaddress, 32, (FAR uint8_t *)dev->rwbuffer);
 			if (ret != 32) {
 				fdbg("Error reading physical sector %d.\n", sector);
-				goto err_out;
+				goto errout;
 			}
 
 			dev->formatstatus = SMART_FMT_STAT_FORMATTED;
@@ -2076,7 +2383,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 				if (rootdirdev == NULL) {
 					fdbg("Memory alloc failed\n");
 					ret = -ENOMEM;
-					goto err_out;
+					goto errout;
 				}
 
 				/* Populate the rootdirdev. */
@@ -2134,7 +2441,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
 				ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
 				if (ret != sizeof(struct smart_sect_header_s)) {
-					goto err_out;
+					goto errout;
 				}
 
 				/* Get the logical sector number for this physical sector. */
@@ -2172,7 +2479,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
 			ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
 			if (ret != sizeof(struct smart_sect_header_s)) {
-				goto err_out;
+				goto errout;
 			}
 #if SMART_STATUS_VERSION == 1
 			if (header.status & SMART_STATUS_CRC) {
@@ -2212,7 +2519,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			readaddress = loser * dev->mtdBlksPerSector * dev->geo.blocksize;
 			ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
 			if (ret != sizeof(struct smart_sect_header_s)) {
-				goto err_out;
+				goto errout;
 			}
 #if CONFIG_SMARTFS_ERASEDSTATE == 0xFF
 			header.status &= ~SMART_STATUS_RELEASED;
@@ -2223,7 +2530,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			ret = smart_bytewrite(dev, offset, 1, &header.status);
 			if (ret < 0) {
 				fdbg("Error %d releasing duplicate sector\n", -ret);
-				goto err_out;
+				goto errout;
 			}
 		}
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
@@ -2240,6 +2547,334 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #endif
 	}
 
+	return OK;
+
+errout:
+	return ret;
+}
+
+/****************************************************************************
+ * Name: smart_ckpt_load
+ *
+ * Description: Loads the map and counts from the checkpoint region along
+ *              with its delta log.  The device state is only touched once
+ *              the checkpoint has been validated, except for the map
+ *              buffer which the full scan re-initializes on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int smart_ckpt_load(FAR struct smart_struct_s *dev)
+{
+	struct smart_ckpt_header_s header;
+	FAR uint16_t *entries;
+	uint32_t base;
+	uint32_t offset;
+	uint32_t length;
+	uint32_t crc;
+	uint16_t block;
+	int nentries;
+	int x;
+	ssize_t ret;
+
+	dev->ckptvalid = false;
+	if (dev->ckptblocks == 0) {
+		return -ENOENT;
+	}
+
+	base = dev->geo.neraseblocks * dev->geo.erasesize;
+	ret = MTD_READ(dev->mtd, base, sizeof(struct smart_ckpt_header_s), (FAR uint8_t *)&header);
+	if (ret != sizeof(struct smart_ckpt_header_s)) {
+		return -EIO;
+	}
+
+	if (header.magic != SMART_CKPT_MAGIC || header.version != SMART_CKPT_VERSION || header.sectorsize != dev->sectorsize || header.totalsectors != dev->totalsectors || header.neraseblocks != dev->neraseblocks) {
+		fvdbg("No usable checkpoint\n");
+		return -ENOENT;
+	}
+
+	length = smart_ckpt_payload(dev);
+	ret = MTD_READ(dev->mtd, base + sizeof(struct smart_ckpt_header_s), length, (FAR uint8_t *)dev->sMap);
+	if (ret != length) {
+		return -EIO;
+	}
+
+	crc = crc32part((FAR const uint8_t *)&header, offsetof(struct smart_ckpt_header_s, crc), 0);
+	crc = crc32part((FAR const uint8_t *)dev->sMap, length, crc);
+	if (crc != header.crc) {
+		fdbg("Checkpoint CRC mismatch\n");
+		return -EINVAL;
+	}
+
+	/* Read the delta log a sector worth of entries at a time. */
+
+	memset(dev->ckptlog, 0, (dev->neraseblocks + 7) >> 3);
+	dev->ckptlogged = 0;
+	offset = base + sizeof(struct smart_ckpt_header_s) + length;
+	entries = (FAR uint16_t *)dev->rwbuffer;
+
+	while (dev->ckptlogged < dev->neraseblocks) {
+		nentries = dev->sectorsize / sizeof(uint16_t);
+		if (nentries > dev->neraseblocks - dev->ckptlogged) {
+			nentries = dev->neraseblocks - dev->ckptlogged;
+		}
+
+		ret = MTD_READ(dev->mtd, offset, nentries * sizeof(uint16_t), (FAR uint8_t *)entries);
+		if (ret != nentries * sizeof(uint16_t)) {
+			return -EIO;
+		}
+
+		for (x = 0; x < nentries; x++) {
+			if (entries[x] == 0x0000 || entries[x] == 0xFFFF) {
+				break;
+			}
+
+			block = entries[x] - 1;
+			if (block >= dev->neraseblocks || SMART_CKPT_IS_LOGGED(dev, block)) {
+				fdbg("Corrupt checkpoint log entry %d\n", entries[x]);
+				return -EINVAL;
+			}
+
+			dev->ckptlog[block >> 3] |= 1 << (block & 0x07);
+			dev->ckptlogged++;
+		}
+
+		if (x < nentries) {
+			break;
+		}
+
+		offset += nentries * sizeof(uint16_t);
+	}
+
+	dev->freesectors = header.freesectors;
+	dev->releasesectors = header.releasesectors;
+	dev->formatstatus = header.formatstatus;
+	dev->formatversion = header.formatversion;
+	dev->namesize = header.namesize;
+	dev->ckptvalid = true;
+
+	fvdbg("Checkpoint loaded, %d blocks to rescan\n", dev->ckptlogged);
+	return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_ckpt_rescan
+ *
+ * Description: Drops the checkpointed state of every erase block in the
+ *              delta log and rebuilds it by scanning just those blocks.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int smart_ckpt_rescan(FAR struct smart_struct_s *dev, FAR uint8_t *sector_seq_log)
+{
+	uint16_t block;
+	uint16_t sector;
+	uint16_t prerelease;
+	uint32_t end;
+	int ret;
+
+	if (dev->ckptlogged == 0) {
+		return OK;
+	}
+
+	for (sector = 0; sector < dev->totalsectors; sector++) {
+		if (dev->sMap[sector] != 0xFFFF && SMART_CKPT_IS_LOGGED(dev, dev->sMap[sector] / dev->sectorsPerBlk)) {
+			dev->sMap[sector] = -1;
+		}
+	}
+
+	for (block = 0; block < dev->neraseblocks; block++) {
+		if (!SMART_CKPT_IS_LOGGED(dev, block)) {
+			continue;
+		}
+
+		if (block == dev->neraseblocks - 1 && dev->totalsectors == 65534) {
+			prerelease = 2;
+		} else {
+			prerelease = 0;
+		}
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		dev->freesectors += dev->availSectPerBlk - prerelease - smart_get_count(dev, dev->freecount, block);
+		dev->releasesectors -= smart_get_count(dev, dev->releasecount, block) - prerelease;
+		smart_set_count(dev, dev->freecount, block, dev->availSectPerBlk - prerelease);
+		smart_set_count(dev, dev->releasecount, block, prerelease);
+#else
+		dev->freesectors += dev->availSectPerBlk - prerelease - dev->freecount[block];
+		dev->releasesectors -= dev->releasecount[block] - prerelease;
+		dev->freecount[block] = dev->availSectPerBlk - prerelease;
+		dev->releasecount[block] = prerelease;
+#endif
+	}
+
+	for (block = 0; block < dev->neraseblocks; block++) {
+		if (!SMART_CKPT_IS_LOGGED(dev, block)) {
+			continue;
+		}
+
+		end = (block + 1) * dev->sectorsPerBlk;
+		if (end > dev->totalsectors) {
+			end = dev->totalsectors;
+		}
+
+		ret = smart_scan_sectors(dev, block * dev->sectorsPerBlk, end, sector_seq_log);
+		if (ret != OK) {
+			return ret;
+		}
+	}
+
+	return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_scan
+ *
+ * Description: Perform a scan of the MTD device to search for format
+ *              information and fill in logical sector mapping, freesector
+ *              count, etc.
+ *
+ ****************************************************************************/
+
+static int smart_scan(FAR struct smart_struct_s *dev)
+{
+	int sector;
+	int ret;
+	uint16_t totalsectors;
+	uint16_t sectorsize, prerelease;
+	uint32_t readaddress;
+	uint32_t offset;
+	struct smart_sect_header_s header;
+	uint8_t *sector_seq_log = NULL;
+
+	fvdbg("Entry\n");
+
+	/* Find the sector size on the volume by reading headers from
+	 * sectors of decreasing size.  On a formatted volume, the sector
+	 * size is saved in the header status byte of seach sector, so
+	 * by starting with the largest supported sector size and
+	 * decreasing from there, we will be sure to find data that is
+	 * a header and not sector data.
+	 */
+
+	sectorsize = 0xFFFF;
+	offset = 16384;
+
+	while (sectorsize == 0xFFFF) {
+		readaddress = 0;
+
+		while (readaddress < dev->erasesize * dev->geo.neraseblocks) {
+			/* Read the next sector from the device. */
+
+			ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+			if (ret != sizeof(struct smart_sect_header_s)) {
+				goto err_out;
+			}
+
+			if (header.status != CONFIG_SMARTFS_ERASEDSTATE) {
+				sectorsize = (header.status & SMART_STATUS_SIZEBITS) << 7;
+				break;
+			}
+
+			readaddress += offset;
+		}
+
+		offset >>= 1;
+		if (offset < 256 && sectorsize == 0xFFFF) {
+			sectorsize = CONFIG_MTD_SMART_SECTOR_SIZE;
+		}
+	}
+
+	/* Now set the sectorsize and other sectorsize derived variables. */
+
+	ret = smart_setsectorsize(dev, sectorsize);
+	if (ret != OK) {
+		goto err_out;
+	}
+
+	/* Initialize the device variables. */
+
+	totalsectors = dev->totalsectors;
+
+	dev->reservedsector = SMART_FIRST_ALLOC_SECTOR;
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	dev->gcblock = SMART_GC_NONE;
+#endif
+#ifdef CONFIG_SMARTFS_JOURNALING
+	if (totalsectors > CONFIG_SMARTFS_JOURNALING_THRESHOLD) {
+		dev->reservedsector += 2 * CONFIG_SMARTFS_NLOGGING_SECTORS;
+	}
+#endif
+
+	sector_seq_log = (uint8_t *)kmm_zalloc(sizeof(uint8_t) * totalsectors);
+
+	if (sector_seq_log == NULL) {
+		ret = -ENOMEM;
+		goto err_out;
+	}
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	/* Restore the map from the checkpoint if it is intact and rescan only
+	 * the erase blocks recorded in its delta log.
+	 */
+
+	if (smart_ckpt_load(dev) == OK) {
+		ret = smart_ckpt_rescan(dev, sector_seq_log);
+		if (ret != OK) {
+			goto err_out;
+		}
+
+		goto scan_done;
+	}
+#endif
+
+	dev->formatstatus = SMART_FMT_STAT_NOFMT;
+	dev->freesectors = dev->availSectPerBlk * dev->geo.neraseblocks;
+	dev->releasesectors = 0;
+
+	/* Initialize the freecount and releasecount arrays. */
+
+	for (sector = 0; sector < dev->neraseblocks; sector++) {
+		if (sector == dev->neraseblocks - 1 && dev->totalsectors == 65534) {
+			prerelease = 2;
+		} else {
+			prerelease = 0;
+		}
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		smart_set_count(dev, dev->freecount, sector, dev->availSectPerBlk - prerelease);
+		smart_set_count(dev, dev->releasecount, sector, prerelease);
+#else
+		dev->freecount[sector] = dev->availSectPerBlk - prerelease;
+		dev->releasecount[sector] = prerelease;
+#endif
+	}
+
+	/* Initialize the sector map. */
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+	for (sector = 0; sector < totalsectors; sector++) {
+		dev->sMap[sector] = -1;
+	}
+#else
+	/* Clear all logical sector used bits. */
+
+	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
+#endif
+
+	/* Now scan the MTD device. */
+
+	ret = smart_scan_sectors(dev, 0, totalsectors, sector_seq_log);
+	if (ret != OK) {
+		goto err_out;
+	}
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+scan_done:
+#endif
+
 #if defined(CONFIG_MTD_SMART_WEAR_LEVEL) && (SMART_STATUS_VERSION == 1)
 #ifdef CONFIG_MTD_SMART_CONVERT_WEAR_FORMAT
 
@@ -2310,6 +2945,14 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	smart_read_wearstatus(dev);
 #endif
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	/* Checkpoint the freshly scanned map so the next mount can skip the scan. */
+
+	if (!dev->ckptvalid) {
+		smart_ckpt_write(dev);
+	}
+#endif
+
 	fdbg("SMART Scan\n");
 	fdbg("   Erase size:   %10d\n", dev->sectorsPerBlk * dev->sectorsize);
 	fdbg("   Erase count:  %10d\n", dev->neraseblocks);
@@ -2425,6 +3068,9 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 		dev->unusedsectors += freecount;
 		dev->blockerases++;
+#endif
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+		smart_ckpt_touch(dev, block);
 #endif
 		MTD_ERASE(dev->mtd, block, 1);
 
@@ -2863,6 +3509,12 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 
 	/* Erase the MTD device. */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	dev->ckptvalid = false;
+#endif
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	dev->gcblock = SMART_GC_NONE;
+#endif
 	ret = MTD_IOCTL(dev->mtd, MTDIOC_BULKERASE, 0);
 	if (ret < 0) {
 		return ret;
@@ -3086,6 +3738,9 @@ static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsec
 
 	/* Write the data to the new physical sector location. */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	smart_ckpt_touch(dev, newsector / dev->sectorsPerBlk);
+#endif
 	ret = MTD_BWRITE(dev->mtd, newsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
 
 #else							/* CONFIG_MTD_SMART_ENABLE_CRC */
@@ -3099,6 +3754,9 @@ static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsec
 
 	/* Write the data to the new physical sector location. */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	smart_ckpt_touch(dev, newsector / dev->sectorsPerBlk);
+#endif
 	ret = MTD_BWRITE(dev->mtd, newsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
 
 	/* Commit the sector. */
@@ -3313,6 +3971,9 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 
 	/* Now erase the erase block. */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	smart_ckpt_touch(dev, block);
+#endif
 	MTD_ERASE(dev->mtd, block, 1);
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 	dev->unusedsectors += freecount;
@@ -3628,137 +4289,509 @@ retry:
 			}
 #endif
 		}
-	}
+	}
+
+error:
+	if (physicalsector == 0xFFFF || physicalsector >= dev->totalsectors) {
+		if (bitflipped) {
+			fdbg("retry allocation \n");
+			canrelocate = FALSE;
+			kmm_free(sector_buff);
+			goto retry;
+		}
+		if (physicalsector == 0xFFFF) {
+			dbg("Program bug!  Expected a free sector %d\n", allocblock);
+		} else if (physicalsector >= dev->totalsectors) {
+			dbg("Program bug!  Selected sector too big!!!\n");
+		}
+	}
+
+	kmm_free(sector_buff);
+
+	return physicalsector;
+}
+
+/****************************************************************************
+ * Name: smart_garbagecollect
+ *
+ * Description:  Perform garbage collection if needed.  This is determined
+ *               by the count of released sectors relative to free and
+ *               total sectors.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static int smart_garbagecollect(FAR struct smart_struct_s *dev)
+{
+	uint16_t collectblock;
+	uint16_t releasemax;
+	bool collect = TRUE;
+	int x;
+	int ret;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	uint8_t count;
+#endif
+
+	while (collect) {
+		collect = FALSE;
+
+		/* Test if the released sectors count is greater than the
+		 * free sectors.  If it is, then we will do garbage collection.
+		 * The background collector takes care of this case when enabled.
+		 */
+
+#ifndef CONFIG_MTD_SMART_BACKGROUND_GC
+		if (dev->releasesectors > dev->freesectors && dev->freesectors < (dev->totalsectors >> 5)) {
+			collect = TRUE;
+		}
+#endif
+
+		/* Test if we have more reached our reserved free sector limit. */
+
+		if (dev->freesectors <= (dev->sectorsPerBlk << 0) + 4) {
+			collect = TRUE;
+		}
+
+		/* Test if we need to garbage collect. */
+
+		if (collect) {
+			/* Find the block with the most released sectors. */
+
+			collectblock = 0xFFFF;
+			releasemax = 0;
+			for (x = 0; x < dev->neraseblocks; x++) {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+				/* Don't collect blocks that have been worn completely. */
+
+				if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
+					continue;
+				}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+				count = smart_get_count(dev, dev->releasecount, x);
+				if (count > releasemax) {
+					releasemax = count;
+					collectblock = x;
+				}
+#else
+				if (dev->releasecount[x] > releasemax) {
+					releasemax = dev->releasecount[x];
+					collectblock = x;
+				}
+#endif
+			}
+			//releasemax = smart_get_count(dev, dev->releasecount, collectblock);
+
+			if (collectblock == 0xFFFF) {
+				/* Need to collect, but no sectors with released blocks! */
+
+				ret = -ENOSPC;
+				goto errout;
+			}
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+			if (smart_checkfree(dev, __LINE__) != OK) {
+				fdbg("   ...before collecting block %d\n", collectblock);
+			}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+			fvdbg("Collecting block %d, free=%d released=%d, totalfree=%d, totalrelease=%d\n", collectblock, smart_get_count(dev, dev->freecount, collectblock), smart_get_count(dev, dev->releasecount, collectblock), dev->freesectors, dev->releasesectors);
+#else
+			fvdbg("Collecting block %d, free=%d released=%d\n", collectblock, dev->freecount[collectblock], dev->releasecount[collectblock]);
+#endif
+
+			/* Relocate the active data in the collection block. */
+
+			ret = smart_relocate_block(dev, collectblock);
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+			dev->gcstats.foreground++;
+#endif
+
+#ifdef CONFIG_SMART_LOCAL_CHECKFREE
+			if (smart_checkfree(dev, __LINE__) != OK) {
+				fdbg("   ...while collecting block %d\n", collectblock);
+			}
+#endif
+
+			if (ret != OK) {
+				goto errout;
+			}
+		}
+	}
+
+	return OK;
+
+errout:
+	return ret;
+}
+#endif							/* CONFIG_FS_WRITABLE */
+
+/****************************************************************************
+ * Name: smart_gc_needed
+ *
+ * Description:  Tests if the background collector should reclaim another
+ *               erase block.  It keeps CONFIG_MTD_SMART_GC_RESERVE_BLOCKS
+ *               erase blocks worth of free sectors above the limit at which
+ *               smart_garbagecollect() collects inline, and also covers the
+ *               released versus free sector test the inline path no longer
+ *               performs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static bool smart_gc_needed(FAR struct smart_struct_s *dev)
+{
+	uint32_t reserve;
+
+	if (dev->formatstatus != SMART_FMT_STAT_FORMATTED || dev->releasesectors == 0) {
+		return false;
+	}
+
+	if (dev->releasesectors > dev->freesectors && dev->freesectors < (dev->totalsectors >> 5)) {
+		return true;
+	}
+
+	reserve = (dev->sectorsPerBlk << 0) + 4 + CONFIG_MTD_SMART_GC_RESERVE_BLOCKS * dev->availSectPerBlk;
+	return dev->freesectors < reserve;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_gc_select
+ *
+ * Description:  Selects the next erase block for background collection.  A
+ *               block with no free sectors left is preferred; otherwise the
+ *               block with the most released sectors is taken and its
+ *               remaining free sectors are retired (counted as released) so
+ *               nothing is allocated from it while it is being emptied.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static int smart_gc_select(FAR struct smart_struct_s *dev)
+{
+	uint16_t collectblock;
+	uint16_t fullblock;
+	uint16_t releasemax;
+	uint16_t fullmax;
+	uint16_t freecount;
+	uint16_t releasecount;
+	int x;
+
+	collectblock = SMART_GC_NONE;
+	fullblock = SMART_GC_NONE;
+	releasemax = 0;
+	fullmax = 0;
+	for (x = 0; x < dev->neraseblocks; x++) {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+		/* Don't collect blocks that have been worn completely. */
+
+		if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
+			continue;
+		}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		releasecount = smart_get_count(dev, dev->releasecount, x);
+		freecount = smart_get_count(dev, dev->freecount, x);
+#else
+		releasecount = dev->releasecount[x];
+		freecount = dev->freecount[x];
+#endif
+
+		if (releasecount > releasemax) {
+			releasemax = releasecount;
+			collectblock = x;
+		}
+
+		if (freecount == 0 && releasecount > fullmax) {
+			fullmax = releasecount;
+			fullblock = x;
+		}
+	}
+
+	/* A full block costs nothing to retire, so take it unless a better
+	 * candidate would give back twice as much.
+	 */
+
+	if (fullblock != SMART_GC_NONE && fullmax >= (releasemax >> 1)) {
+		collectblock = fullblock;
+	}
+
+	if (collectblock == SMART_GC_NONE) {
+		return -ENOSPC;
+	}
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	freecount = smart_get_count(dev, dev->freecount, collectblock);
+	releasecount = smart_get_count(dev, dev->releasecount, collectblock);
+#else
+	freecount = dev->freecount[collectblock];
+	releasecount = dev->releasecount[collectblock];
+#endif
+
+	/* Erasing a block that gives back only a sector or two is left to the
+	 * inline collector, otherwise a nearly full volume would keep the worker
+	 * relocating and erasing for almost nothing.  Also ensure the live
+	 * sectors can be moved without the block's own free sectors.
+	 */
+
+	if (releasecount < SMART_GC_MIN_RELEASED(dev) || dev->freesectors - freecount <= dev->availSectPerBlk - releasecount - freecount) {
+		return -ENOSPC;
+	}
+
+	if (freecount > 0) {
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		smart_set_count(dev, dev->freecount, collectblock, 0);
+		smart_add_count(dev, dev->releasecount, collectblock, freecount);
+#else
+		dev->freecount[collectblock] = 0;
+		dev->releasecount[collectblock] += freecount;
+#endif
+		dev->freesectors -= freecount;
+		dev->releasesectors += freecount;
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+		dev->unusedsectors += freecount;
+#endif
+	}
+
+	fvdbg("Collecting block %d in the background, retired %d free sectors\n", collectblock, freecount);
+
+	dev->gcblock = collectblock;
+	dev->gcsector = collectblock * dev->sectorsPerBlk;
+	return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_gc_relocate
+ *
+ * Description:  Moves one physical sector out of the erase block being
+ *               collected in the background.  The old copy is counted as
+ *               released right away, so the free and release counts stay
+ *               consistent between time slices.
+ *
+ * Returned Value:
+ *   1 if a sector was moved, 0 if the sector held no live data, or a
+ *   negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static int smart_gc_relocate(FAR struct smart_struct_s *dev, uint16_t sector)
+{
+	FAR struct smart_sect_header_s *header;
+	uint16_t newsector;
+	uint16_t logical;
+	int ret;
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+	FAR struct smart_allocsector_s *allocsector;
+#endif
+
+	ret = MTD_BREAD(dev->mtd, sector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+	if (ret != dev->mtdBlksPerSector) {
+		fdbg("Error reading sector %d\n", sector);
+		return -EIO;
+	}
+
+	header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
+
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+	/* A temporary allocation has no data on the device yet, so only its
+	 * mapping has to move.
+	 */
+
+	allocsector = dev->allocsector;
+	while (allocsector) {
+		if (allocsector->physical == sector) {
+			break;
+		}
+		allocsector = allocsector->next;
+	}
+
+	if (allocsector) {
+		newsector = smart_findfreephyssector(dev, FALSE);
+		if (newsector == 0xFFFF) {
+			return -ENOSPC;
+		}
+
+		allocsector->physical = newsector;
+		logical = allocsector->logical;
+	} else
+#endif
+	{
+		if (((header->status & SMART_STATUS_COMMITTED) == (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_COMMITTED)) || ((header->status & SMART_STATUS_RELEASED) != (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_RELEASED))) {
+			/* Free or released, nothing to move. */
+
+			return 0;
+		}
 
-error:
-	if (physicalsector == 0xFFFF || physicalsector >= dev->totalsectors) {
-		if (bitflipped) {
-			fdbg("retry allocation \n");
-			canrelocate = FALSE;
-			kmm_free(sector_buff);
-			goto retry;
+		newsector = smart_findfreephyssector(dev, FALSE);
+		if (newsector == 0xFFFF) {
+			return -ENOSPC;
 		}
-		if (physicalsector == 0xFFFF) {
-			dbg("Program bug!  Expected a free sector %d\n", allocblock);
-		} else if (physicalsector >= dev->totalsectors) {
-			dbg("Program bug!  Selected sector too big!!!\n");
+
+		logical = UINT8TOUINT16(header->logicalsector);
+		ret = smart_relocate_sector(dev, sector, newsector);
+		if (ret < 0) {
+			return ret;
 		}
 	}
 
-	kmm_free(sector_buff);
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+	dev->sMap[logical] = newsector;
+#else
+	smart_update_cache(dev, logical, newsector);
+#endif
 
-	return physicalsector;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	smart_add_count(dev, dev->freecount, newsector / dev->sectorsPerBlk, -1);
+	smart_add_count(dev, dev->releasecount, sector / dev->sectorsPerBlk, 1);
+#else
+	dev->freecount[newsector / dev->sectorsPerBlk]--;
+	dev->releasecount[sector / dev->sectorsPerBlk]++;
+#endif
+	dev->freesectors--;
+	dev->releasesectors++;
+
+	return 1;
 }
+#endif
 
 /****************************************************************************
- * Name: smart_garbagecollect
+ * Name: smart_gc_slice
  *
- * Description:  Perform garbage collection if needed.  This is determined
- *               by the count of released sectors relative to free and
- *               total sectors.
+ * Description:  Runs one bounded step of background garbage collection:
+ *               relocates at most CONFIG_MTD_SMART_GC_SLICE_SECTORS live
+ *               sectors out of the block being collected and erases it once
+ *               it is empty.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_FS_WRITABLE
-static int smart_garbagecollect(FAR struct smart_struct_s *dev)
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static int smart_gc_slice(FAR struct smart_struct_s *dev)
 {
-	uint16_t collectblock;
-	uint16_t releasemax;
-	bool collect = TRUE;
-	int x;
+	uint16_t endsector;
+	uint16_t freecount;
+	int moved;
 	int ret;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-	uint8_t count;
-#endif
 
-	while (collect) {
-		collect = FALSE;
+	if (dev->gcblock == SMART_GC_NONE) {
+		if (!smart_gc_needed(dev)) {
+			return OK;
+		}
 
-		/* Test if the released sectors count is greater than the
-		 * free sectors.  If it is, then we will do garbage collection.
+		ret = smart_gc_select(dev);
+		if (ret < 0) {
+			return ret;
+		}
+	} else {
+		/* The block was reclaimed by a foreground collection since the
+		 * last slice.
 		 */
 
-		if (dev->releasesectors > dev->freesectors && dev->freesectors < (dev->totalsectors >> 5)) {
-			collect = TRUE;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		freecount = smart_get_count(dev, dev->freecount, dev->gcblock);
+#else
+		freecount = dev->freecount[dev->gcblock];
+#endif
+		if (freecount != 0) {
+			dev->gcblock = SMART_GC_NONE;
+			return OK;
 		}
+	}
 
-		/* Test if we have more reached our reserved free sector limit. */
-
-		if (dev->freesectors <= (dev->sectorsPerBlk << 0) + 4) {
-			collect = TRUE;
+	endsector = dev->gcblock * dev->sectorsPerBlk + dev->availSectPerBlk;
+	moved = 0;
+	while (dev->gcsector < endsector && moved < CONFIG_MTD_SMART_GC_SLICE_SECTORS) {
+		ret = smart_gc_relocate(dev, dev->gcsector);
+		if (ret < 0) {
+			return ret;
 		}
 
-		/* Test if we need to garbage collect. */
-
-		if (collect) {
-			/* Find the block with the most released sectors. */
+		dev->gcsector++;
+		moved += ret;
+	}
 
-			collectblock = 0xFFFF;
-			releasemax = 0;
-			for (x = 0; x < dev->neraseblocks; x++) {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-				/* Don't collect blocks that have been worn completely. */
+	dev->gcstats.relocated += moved;
 
-				if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
-					continue;
-				}
-#endif
+	if (dev->gcsector >= endsector) {
+		smart_erase_block_if_empty(dev, dev->gcblock, FALSE);
 
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
-				count = smart_get_count(dev, dev->releasecount, x);
-				if (count > releasemax) {
-					releasemax = count;
-					collectblock = x;
-				}
+		freecount = smart_get_count(dev, dev->freecount, dev->gcblock);
 #else
-				if (dev->releasecount[x] > releasemax) {
-					releasemax = dev->releasecount[x];
-					collectblock = x;
-				}
+		freecount = dev->freecount[dev->gcblock];
 #endif
-			}
-			//releasemax = smart_get_count(dev, dev->releasecount, collectblock);
+		if (freecount != 0) {
+			dev->gcstats.reclaimed++;
+		}
 
-			if (collectblock == 0xFFFF) {
-				/* Need to collect, but no sectors with released blocks! */
+		dev->gcblock = SMART_GC_NONE;
+	}
 
-				ret = -ENOSPC;
-				goto errout;
-			}
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-			if (smart_checkfree(dev, __LINE__) != OK) {
-				fdbg("   ...before collecting block %d\n", collectblock);
-			}
+	return OK;
+}
 #endif
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-			fvdbg("Collecting block %d, free=%d released=%d, totalfree=%d, totalrelease=%d\n", collectblock, smart_get_count(dev, dev->freecount, collectblock), smart_get_count(dev, dev->releasecount, collectblock), dev->freesectors, dev->releasesectors);
-#else
-			fvdbg("Collecting block %d, free=%d released=%d\n", collectblock, dev->freecount[collectblock], dev->releasecount[collectblock]);
-#endif
+/****************************************************************************
+ * Name: smart_gc_worker
+ *
+ * Description:  Work queue entry point of the background collector.  Runs
+ *               one time slice and re-queues itself until the free sector
+ *               reserve is restored.
+ *
+ ****************************************************************************/
 
-			/* Relocate the active data in the collection block. */
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static void smart_gc_worker(FAR void *arg)
+{
+	FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+	uint32_t start;
+	uint32_t elapsed;
+	int ret;
 
-			ret = smart_relocate_block(dev, collectblock);
+	smart_semtake(dev);
+	dev->gcpending = false;
 
-#ifdef CONFIG_SMART_LOCAL_CHECKFREE
-			if (smart_checkfree(dev, __LINE__) != OK) {
-				fdbg("   ...while collecting block %d\n", collectblock);
-			}
-#endif
+	start = clock_systimer();
+	ret = smart_gc_slice(dev);
+	elapsed = clock_systimer() - start;
 
-			if (ret != OK) {
-				goto errout;
-			}
-		}
+	dev->gcstats.slices++;
+	if (elapsed > dev->gcstats.maxslice) {
+		dev->gcstats.maxslice = elapsed;
 	}
 
-	return OK;
+	if (ret < 0) {
+		fvdbg("Background collection stopped: %d\n", ret);
+	} else if (dev->gcblock != SMART_GC_NONE || smart_gc_needed(dev)) {
+		dev->gcpending = true;
+		work_queue(SMART_GC_WORK, &dev->gcwork, smart_gc_worker, dev, MSEC2TICK(CONFIG_MTD_SMART_GC_DELAY));
+	}
 
-errout:
-	return ret;
+	smart_semgive(dev);
 }
-#endif							/* CONFIG_FS_WRITABLE */
+#endif
+
+/****************************************************************************
+ * Name: smart_gc_kick
+ *
+ * Description:  Queues the background collector if the free sector reserve
+ *               has dropped below its target.  Called with exclsem held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+static void smart_gc_kick(FAR struct smart_struct_s *dev)
+{
+	if (!dev->gcpending && (dev->gcblock != SMART_GC_NONE || smart_gc_needed(dev))) {
+		dev->gcpending = true;
+		work_queue(SMART_GC_WORK, &dev->gcwork, smart_gc_worker, dev, MSEC2TICK(CONFIG_MTD_SMART_GC_DELAY));
+	}
+}
+#endif
 
 /****************************************************************************
  * Name: smart_write_wearstatus
@@ -4024,6 +5057,9 @@ static int smart_write_alloc_sector(FAR struct smart_struct_s *dev, uint16_t log
 #ifndef CONFIG_MTD_SMART_ENABLE_CRC
 	header->crc8 = smart_calc_sector_crc(dev);
 	fvdbg("Write MTD block %d\n", physical * dev->mtdBlksPerSector);
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	smart_ckpt_touch(dev, physical / dev->sectorsPerBlk);
+#endif
 	ret = MTD_BWRITE(dev->mtd, physical * dev->mtdBlksPerSector, 1, (FAR uint8_t *)dev->rwbuffer);
 	if (ret != 1) {
 		/* The block is not empty!!  What to do? */
@@ -4350,6 +5386,9 @@ relocate_good_sector:
 	if (needsrelocate) {
 		/* Write the entire sector to the new physical location, uncommitted. */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+		smart_ckpt_touch(dev, physsector / dev->sectorsPerBlk);
+#endif
 		ret = MTD_BWRITE(dev->mtd, physsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
 		if (ret != dev->mtdBlksPerSector) {
 			fdbg("Error writing to physical sector %d\n", physsector);
@@ -4449,6 +5488,9 @@ relocate_good_sector:
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 		/* Write the entire sector to FLASH when CRC enabled. */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+		smart_ckpt_touch(dev, physsector / dev->sectorsPerBlk);
+#endif
 		ret = MTD_BWRITE(dev->mtd, physsector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
 		if (ret != dev->mtdBlksPerSector) {
 			fdbg("Error writing to physical sector %d\n", physsector);
@@ -4712,6 +5754,147 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smart_readchain
+ *
+ * Description:  Read up to nsectors sectors of a logical sector chain into
+ *               consecutive sectorsize slots of the caller's buffer.
+ *               Sectors of the chain that are also physically adjacent are
+ *               fetched with a single MTD read.  The run length doubles
+ *               while the next link (known from the sector map) directly
+ *               follows the last run and drops back to one sector when it
+ *               does not, so only a chain that jumps in the middle of a
+ *               run costs wasted reads.
+ *
+ *               Returns the number of sectors read.  The chain ends early
+ *               at an unallocated link (e.g. the erased 0xFFFF end marker).
+ *
+ ****************************************************************************/
+
+static int smart_readchain(FAR struct smart_struct_s *dev, unsigned long arg)
+{
+	int ret;
+	FAR struct smart_readchain_s *req;
+	FAR uint8_t *slot;
+	FAR struct smart_sect_header_s *header;
+	uint16_t logsector;
+	uint16_t physsector;
+	uint16_t nread;
+	uint16_t run;
+	uint16_t count;
+	uint16_t x;
+	uint32_t totalphys;
+	size_t linkpos;
+
+	fvdbg("Entry\n");
+	req = (FAR struct smart_readchain_s *)arg;
+	linkpos = sizeof(struct smart_sect_header_s) + req->linkoffset;
+	if (req->nsectors == 0 || linkpos + 2 > dev->sectorsize) {
+		return -EINVAL;
+	}
+
+	totalphys = (uint32_t)dev->geo.neraseblocks * dev->sectorsPerBlk;
+	logsector = req->logsector;
+	nread = 0;
+	run = 1;
+	ret = OK;
+
+	while (nread < req->nsectors && logsector < dev->totalsectors) {
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+		physsector = dev->sMap[logsector];
+#else
+		physsector = smart_cache_lookup(dev, logsector);
+#endif
+		if (physsector == 0xFFFF) {
+			break;
+		}
+
+		count = req->nsectors - nread;
+		if (count > run) {
+			count = run;
+		}
+
+		if (physsector + count > totalphys) {
+			count = totalphys - physsector;
+		}
+
+		slot = &req->buffer[nread * dev->sectorsize];
+		ret = MTD_BREAD(dev->mtd, physsector * dev->mtdBlksPerSector, count * dev->mtdBlksPerSector, slot);
+		if (ret != count * dev->mtdBlksPerSector) {
+			fdbg("Error reading phys sector %d\n", physsector);
+			ret = -EIO;
+			break;
+		}
+
+		/* Keep the sectors of the run that are the next links of the chain. */
+
+		ret = OK;
+		for (x = 0; x < count; x++, slot += dev->sectorsize) {
+			if (x > 0) {
+				if (logsector >= dev->totalsectors) {
+					break;
+				}
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+				if (dev->sMap[logsector] != physsector + x) {
+#else
+				if (smart_cache_lookup(dev, logsector) != physsector + x) {
+#endif
+					break;
+				}
+			}
+
+			header = (FAR struct smart_sect_header_s *)slot;
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+#if SMART_STATUS_VERSION == 1
+			if ((header->status & SMART_STATUS_CRC) != (CONFIG_SMARTFS_ERASEDSTATE & SMART_STATUS_CRC))
+#endif
+			{
+				memcpy(dev->rwbuffer, slot, dev->sectorsize);
+				ret = smart_validate_crc(dev);
+			}
+#else
+			if ((UINT8TOUINT16(header->logicalsector) != logsector) || (!(SECTOR_IS_COMMITTED((*header))))) {
+				ret = -EIO;
+			}
+#endif
+			if (ret != OK) {
+				fdbg("Error validating logical sector %d, phys=%d\n", logsector, physsector + x);
+				ret = -EIO;
+				break;
+			}
+
+			nread++;
+			logsector = (uint16_t)slot[linkpos] | ((uint16_t)slot[linkpos + 1] << 8);
+		}
+
+		if (ret != OK) {
+			break;
+		}
+
+		/* Only grow the run while the next link directly follows it. */
+
+		if (x < count || logsector >= dev->totalsectors) {
+			run = 1;
+			continue;
+		}
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+		if (dev->sMap[logsector] != physsector + count) {
+#else
+		if (smart_cache_lookup(dev, logsector) != physsector + count) {
+#endif
+			run = 1;
+		} else if (run < req->nsectors) {
+			run <<= 1;
+		}
+	}
+
+	if (nread > 0) {
+		return nread;
+	}
+
+	return ret == OK ? -EINVAL : ret;
+}
+
 /****************************************************************************
  * Name: smart_allocsector
  *
@@ -5049,6 +6232,10 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 	dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	smart_semtake(dev);
+#endif
+
 	/* Process the ioctl's we care about first, pass any we don't respond
 	 * to directly to the underlying MTD device.
 	 */
@@ -5063,7 +6250,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #ifdef CONFIG_DEBUG
 		if (arg == 0) {
 			fdbg("ERROR: BIOC_XIPBASE argument is NULL\n");
-			return -EINVAL;
+			ret = -EINVAL;
+			goto ok_out;
 		}
 #endif
 
@@ -5089,6 +6277,13 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 		ret = smart_readsector(dev, arg);
 		goto ok_out;
 
+	case BIOC_READCHAIN:
+
+		/* Read a run of chained logical sectors. */
+
+		ret = smart_readchain(dev, arg);
+		goto ok_out;
+
 #ifdef CONFIG_FS_WRITABLE
 	case BIOC_LLFORMAT:
 
@@ -5195,6 +6390,25 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 	}
 
 ok_out:
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+	/* Refresh the checkpoint once the delta log covers enough erase blocks
+	 * that replaying it would noticeably slow down the next mount.
+	 */
+
+	if (dev->ckptvalid && dev->ckptlogged >= CONFIG_MTD_SMART_MAP_CHECKPOINT_DELTA) {
+		smart_ckpt_write(dev);
+	}
+#endif
+
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+	/* Let the background collector restore the free sector reserve before
+	 * the next write has to collect inline.
+	 */
+
+	smart_gc_kick(dev);
+	smart_semgive(dev);
+#endif
+
 	return ret;
 }
 
@@ -5288,6 +6502,30 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 #endif
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 		dev->allocsector = NULL;
+#endif
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+		/* Reserve erase blocks at the end of the device for the map
+		 * checkpoint.  The rest of the driver only sees the remainder.
+		 */
+
+		dev->ckptblocks = smart_ckpt_blocks(&dev->geo);
+		dev->geo.neraseblocks -= dev->ckptblocks;
+		dev->ckptlogged = 0;
+		dev->ckptvalid = false;
+		dev->ckptlog = (FAR uint8_t *)smart_malloc(dev, (dev->geo.neraseblocks + 7) >> 3, "Checkpoint log");
+		if (dev->ckptlog == NULL) {
+			ret = -ENOMEM;
+			goto errout;
+		}
+
+		memset(dev->ckptlog, 0, (dev->geo.neraseblocks + 7) >> 3);
+#endif
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+		sem_init(&dev->exclsem, 0, 1);
+		memset(&dev->gcwork, 0, sizeof(struct work_s));
+		memset(&dev->gcstats, 0, sizeof(struct mtd_gcstats_s));
+		dev->gcpending = false;
+		dev->gcblock = SMART_GC_NONE;
 #endif
 		dev->sectorsize = 0;
 		ret = smart_setsectorsize(dev, CONFIG_MTD_SMART_SECTOR_SIZE);
@@ -5371,6 +6609,16 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 			goto errout;
 		}
 
+#ifdef CONFIG_MTD_SMART_BACKGROUND_GC
+		/* Report the background collector in the MTD procfs entry. */
+
+		strncpy(dev->gcname, dev->rwbuffer, sizeof(dev->gcname) - 1);
+		dev->gcname[sizeof(dev->gcname) - 1] = '\0';
+#ifdef CONFIG_MTD_REGISTRATION
+		mtd_gcregister(&dev->gcstats, dev->gcname);
+#endif
+#endif
+
 		/* Do a scan of the device. */
 
 		smart_scan(dev);
@@ -5402,6 +6650,11 @@ errout:
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	smart_free(dev, dev->erasecounts);
 #endif
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+	if (dev->ckptlog != NULL) {
+		smart_free(dev, dev->ckptlog);
+	}
+#endif
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
 	if (rootdirdev) {
 		smart_free(dev, rootdirdev);
@@ -0,0 +1,301 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfskmmpool.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <arch/irq.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+#include <tinyara/mm/kmm_pool.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_MM_KMM_POOL) && !defined(CONFIG_FS_PROCFS_EXCLUDE_KMMPOOL)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define KMMPOOL_LINELEN 64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct kmmpool_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	char line[KMMPOOL_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int kmmpool_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int kmmpool_close(FAR struct file *filep);
+static ssize_t kmmpool_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int kmmpool_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int kmmpool_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations kmmpool_operations = {
+	kmmpool_open,				/* open */
+	kmmpool_close,				/* close */
+	kmmpool_read,				/* read */
+	NULL,						/* write */
+
+	kmmpool_dup,				/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	kmmpool_stat				/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmmpool_open
+ ****************************************************************************/
+
+static int kmmpool_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct kmmpool_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "kmmpool" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "kmmpool") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct kmmpool_file_s *)kmm_zalloc(sizeof(struct kmmpool_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: kmmpool_close
+ ****************************************************************************/
+
+static int kmmpool_close(FAR struct file *filep)
+{
+	FAR struct kmmpool_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct kmmpool_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: kmmpool_read
+ *
+ * Description:
+ *   Print one line per pool: object and granule size, capacity, objects
+ *   in use, the highest occupancy seen and the number of allocations that
+ *   overflowed into the kernel heap.
+ *
+ ****************************************************************************/
+
+static ssize_t kmmpool_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct kmmpool_file_s *attr;
+	FAR struct kmm_pool_s *pool;
+	struct kmm_pool_s snap;
+	irqstate_t flags;
+	size_t remaining;
+	size_t linesize;
+	size_t copysize;
+	size_t totalsize;
+	off_t offset;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct kmmpool_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	offset = filep->f_pos;
+	remaining = buflen;
+	totalsize = 0;
+
+	linesize = snprintf(attr->line, KMMPOOL_LINELEN, "%-11s %7s %5s %5s %5s %5s %8s\n", "NAME", "OBJSIZE", "GRAN", "TOTAL", "USED", "PEAK", "FALLBACK");
+	copysize = procfs_memcpy(attr->line, linesize, buffer, remaining, &offset);
+	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	/* Pools are never destroyed, so the list can be walked without a lock.
+	 * Take a consistent copy of the counters, which are updated from
+	 * interrupt handlers.
+	 */
+
+	for (pool = g_kmm_pools; pool != NULL && totalsize < buflen; pool = pool->flink) {
+		flags = irqsave();
+		snap = *pool;
+		irqrestore(flags);
+
+		linesize = snprintf(attr->line, KMMPOOL_LINELEN, "%-11s %7u %5u %5u %5u %5u %8u\n", snap.name, snap.objsize, 1 << snap.log2gran, snap.nobjs, snap.nused, snap.peak, (unsigned int)snap.nfallback);
+		copysize = procfs_memcpy(attr->line, linesize, buffer, remaining, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+		remaining -= copysize;
+	}
+
+	if (totalsize > 0) {
+		filep->f_pos += totalsize;
+	}
+
+	return totalsize;
+}
+
+/****************************************************************************
+ * Name: kmmpool_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int kmmpool_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct kmmpool_file_s *oldattr;
+	FAR struct kmmpool_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct kmmpool_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct kmmpool_file_s *)kmm_malloc(sizeof(struct kmmpool_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct kmmpool_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: kmmpool_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int kmmpool_stat(const char *relpath, struct stat *buf)
+{
+	/* "kmmpool" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "kmmpool") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "kmmpool" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_MM_KMM_POOL && !CONFIG_FS_PROCFS_EXCLUDE_KMMPOOL */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
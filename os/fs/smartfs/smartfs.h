@@ -203,7 +203,17 @@
 /* Underlying MTD Block driver access functions */
 
 #define FS_BOPS(f)        (f)->fs_blkdriver->u.i_bops
-#define FS_IOCTL(f, c, a) (FS_BOPS(f)->ioctl ? FS_BOPS(f)->ioctl((f)->fs_blkdriver, c, a) : (-ENOSYS))
+#define FS_RAWIOCTL(f, c, a) (FS_BOPS(f)->ioctl ? FS_BOPS(f)->ioctl((f)->fs_blkdriver, c, a) : (-ENOSYS))
+
+/* With the sector cache, every sector access of the file system goes
+ * through the cache so that it stays coherent with the device.
+ */
+
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+#define FS_IOCTL(f, c, a) smartfs_cache_ioctl(f, c, (unsigned long)(a))
+#else
+#define FS_IOCTL(f, c, a) FS_RAWIOCTL(f, c, a)
+#endif
 
 /* The logical sector number of the root directory. */
 
@@ -241,6 +251,12 @@
 
 #define USED_ARRAY_SIZE                 2
 
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+#ifndef CONFIG_SMARTFS_SEEK_INDEX_ENTRIES
+#define CONFIG_SMARTFS_SEEK_INDEX_ENTRIES 64
+#endif
+#endif
+
 #if !defined(CONFIG_SMARTFS_DYNAMIC_HEADER) || !defined(CONFIG_MTD_SMART_SECTOR_SIZE)
 #undef  CONFIG_SMARTFS_DYNAMIC_HEADER
 #endif
@@ -335,6 +351,65 @@ struct smartfs_chain_header_s {
 };
 #endif
 
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+/* This structure describes one slot of the per-mount sector cache.  The
+ * data of a slot is the whole logical sector, chain header included.
+ */
+
+struct smartfs_cache_entry_s {
+	uint16_t logsector;			/* Cached logical sector, 0xFFFF if none */
+	bool dirty;					/* Data not yet written to the device */
+	uint32_t lastuse;			/* Cache tick of the last access */
+	uint32_t dirtyseq;			/* Cache tick when the slot became dirty */
+};
+
+/* This structure describes the per-mount sector cache.  Slot i occupies
+ * sectorsize bytes at data + i * sectorsize, laid out the way
+ * BIOC_READCHAIN returns sectors; its logical sector data starts after
+ * the SMART header, sectorsize - availbytes bytes in.
+ */
+
+struct smartfs_cache_s {
+	struct smartfs_cache_entry_s entry[CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES];
+	FAR uint8_t *data;			/* Slot buffer */
+	uint32_t tick;				/* Access counter for LRU and write order */
+	uint16_t ndirty;			/* Number of dirty slots */
+	uint16_t ranext;			/* Sector a sequential chain read visits next */
+	bool nochain;				/* Device lacks BIOC_READCHAIN */
+};
+#endif
+
+#ifdef CONFIG_SMARTFS_DCACHE
+/* This structure describes one entry of the directory lookup cache.  A
+ * negative entry records that the name does not exist in the directory.
+ */
+
+struct smartfs_dcache_entry_s {
+	uint32_t hash;				/* Hash of the name and parent sector */
+	uint16_t parent;			/* First sector of the parent directory */
+	bool valid;					/* The entry is in use */
+	bool negative;				/* The name is known not to exist */
+	uint16_t firstsector;		/* Sector number of the name */
+	uint16_t dsector;			/* Sector number of the directory entry */
+	uint16_t doffset;			/* Offset of the directory entry */
+	uint16_t flags;				/* Flags, including mode */
+	uint32_t utc;				/* Time stamp */
+	char name[CONFIG_SMARTFS_MAXNAMLEN];	/* Entry name, not terminated if full */
+};
+
+/* This structure describes the per-mount directory lookup cache, a
+ * direct-mapped table indexed by the hash of (parent sector, name).
+ */
+
+struct smartfs_dcache_s {
+	struct smartfs_dcache_entry_s entry[CONFIG_SMARTFS_DCACHE_ENTRIES];
+	uint32_t hits;				/* Lookups answered by a positive entry */
+	uint32_t neghits;			/* Lookups answered by a negative entry */
+	uint32_t misses;			/* Lookups that scanned the directory */
+	uint32_t invalidations;		/* Entries dropped by directory changes */
+};
+#endif
+
 /* This structure describes the state of one open file.  This structure
  * is protected by the volume semaphore.
  */
@@ -357,6 +432,14 @@ struct smartfs_ofile_s {
 								 * used field until the file is closed,
 								 * a seek, or more data is written that
 								 * causes the sector to change. */
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	uint16_t *sidx;				/* Logical sector of every sidxstride'th
+								 * sector in the file's chain, allocated
+								 * on the first seek that needs it. */
+	uint16_t sidxcount;			/* Number of valid entries in sidx */
+	uint16_t sidxstride;		/* Chain positions per sidx entry (a power
+								 * of 2, doubled when sidx fills up) */
+#endif
 };
 
 /* This structure represents the overall mountpoint state.  An instance of this
@@ -381,6 +464,12 @@ struct smartfs_mountpt_s {
 #endif
 #ifdef CONFIG_SMARTFS_JOURNALING
 	struct journal_transaction_manager_s *journal;
+#endif
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+	FAR struct smartfs_cache_s *fs_cache;	/* Sector cache, shared by all mounts of the device */
+#endif
+#ifdef CONFIG_SMARTFS_DCACHE
+	FAR struct smartfs_dcache_s *fs_dcache;	/* Directory lookup cache */
 #endif
 	uint8_t fs_rootsector;		/* Root directory sector num */
 };
@@ -515,6 +604,32 @@ int smartfs_countdirentries(struct smartfs_mountpt_s *fs, struct smartfs_entry_s
 
 int smartfs_truncatefile(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *entry, FAR struct smartfs_ofile_s *sf);
 
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+void smartfs_sidx_add(FAR struct smartfs_ofile_s *sf, uint16_t pos, uint16_t sector);
+
+uint16_t smartfs_sidx_lookup(FAR struct smartfs_ofile_s *sf, uint16_t target, FAR uint16_t *pos);
+
+void smartfs_sidx_invalidate(struct smartfs_mountpt_s *fs, uint16_t firstsector);
+#endif
+
+#ifdef CONFIG_SMARTFS_DCACHE
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_lookup(struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name);
+
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_insert(struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name);
+
+void smartfs_dcache_invalidate(struct smartfs_mountpt_s *fs, uint16_t parent);
+#endif
+
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+int smartfs_cache_init(struct smartfs_mountpt_s *fs);
+
+void smartfs_cache_release(struct smartfs_mountpt_s *fs);
+
+int smartfs_cache_flush(struct smartfs_mountpt_s *fs);
+
+int smartfs_cache_ioctl(struct smartfs_mountpt_s *fs, int cmd, unsigned long arg);
+#endif
+
 uint16_t smartfs_rdle16(FAR const void *val);
 
 void smartfs_wrle16(void *dest, uint16_t val);
@@ -0,0 +1,558 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/smart.h>
+
+#include "smartfs.h"
+
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SMARTFS_CACHE_NONE        0xFFFF
+
+/* Number of sectors fetched when a chain is read sequentially */
+
+#if CONFIG_SMARTFS_SECTOR_CACHE_READAHEAD > CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES
+#define SMARTFS_CACHE_READAHEAD   CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES
+#else
+#define SMARTFS_CACHE_READAHEAD   CONFIG_SMARTFS_SECTOR_CACHE_READAHEAD
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_cache_data
+ *
+ * Description: Return the logical sector data of a cache slot.
+ *
+ ****************************************************************************/
+
+static inline FAR uint8_t *smartfs_cache_data(struct smartfs_mountpt_s *fs, int slot)
+{
+	return &fs->fs_cache->data[slot * fs->fs_llformat.sectorsize + fs->fs_llformat.sectorsize - fs->fs_llformat.availbytes];
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_find
+ *
+ * Description: Return the slot caching a logical sector, or -1.
+ *
+ ****************************************************************************/
+
+static int smartfs_cache_find(FAR struct smartfs_cache_s *cache, uint16_t logsector)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES; i++) {
+		if (cache->entry[i].logsector == logsector) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_drop
+ *
+ * Description: Forget the content of a slot, dirty or not.
+ *
+ ****************************************************************************/
+
+static void smartfs_cache_drop(FAR struct smartfs_cache_s *cache, int slot)
+{
+	FAR struct smartfs_cache_entry_s *entry = &cache->entry[slot];
+
+	if (entry->dirty) {
+		cache->ndirty--;
+	}
+
+	entry->logsector = SMARTFS_CACHE_NONE;
+	entry->dirty = false;
+	entry->lastuse = 0;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_touch
+ *
+ * Description: Mark a slot as the most recently used one.
+ *
+ ****************************************************************************/
+
+static void smartfs_cache_touch(FAR struct smartfs_cache_s *cache, int slot, uint16_t logsector)
+{
+	cache->entry[slot].logsector = logsector;
+	cache->entry[slot].lastuse = ++cache->tick;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_victim
+ *
+ * Description: Free nslots adjacent slots and return the first one.  The
+ *   run whose most recent access is the oldest is chosen, so read-ahead
+ *   of a long chain does not push out directory sectors in use.  Dirty
+ *   slots are written back first, together with everything dirtied
+ *   before them.
+ *
+ ****************************************************************************/
+
+static int smartfs_cache_victim(struct smartfs_mountpt_s *fs, int nslots)
+{
+	FAR struct smartfs_cache_s *cache = fs->fs_cache;
+	uint32_t bestuse = UINT32_MAX;
+	uint32_t lastuse;
+	bool dirty = false;
+	int best = 0;
+	int ret;
+	int i;
+	int j;
+
+	for (i = 0; i + nslots <= CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES; i++) {
+		lastuse = 0;
+		for (j = i; j < i + nslots; j++) {
+			if (cache->entry[j].lastuse > lastuse) {
+				lastuse = cache->entry[j].lastuse;
+			}
+		}
+
+		if (lastuse < bestuse) {
+			bestuse = lastuse;
+			best = i;
+		}
+	}
+
+	for (j = best; j < best + nslots; j++) {
+		dirty |= cache->entry[j].dirty;
+	}
+
+	if (dirty) {
+		ret = smartfs_cache_flush(fs);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	for (j = best; j < best + nslots; j++) {
+		smartfs_cache_drop(cache, j);
+	}
+
+	return best;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_fill
+ *
+ * Description: Read a logical sector into the cache and return its slot.
+ *   If the sector is the one a sequential chain read visits next, the
+ *   following sectors of the chain are fetched with it in one
+ *   BIOC_READCHAIN request.
+ *
+ ****************************************************************************/
+
+static int smartfs_cache_fill(struct smartfs_mountpt_s *fs, uint16_t logsector)
+{
+	FAR struct smartfs_cache_s *cache = fs->fs_cache;
+	struct smart_read_write_s readwrite;
+#if SMARTFS_CACHE_READAHEAD > 1
+	struct smart_readchain_s readchain;
+	uint16_t sector;
+	int i;
+#endif
+	int slot;
+	int ret;
+
+#if SMARTFS_CACHE_READAHEAD > 1
+	if (logsector == cache->ranext && !cache->nochain) {
+		slot = smartfs_cache_victim(fs, SMARTFS_CACHE_READAHEAD);
+		if (slot < 0) {
+			return slot;
+		}
+
+		readchain.logsector = logsector;
+		readchain.nsectors = SMARTFS_CACHE_READAHEAD;
+		readchain.linkoffset = offsetof(struct smartfs_chain_header_s, nextsector);
+		readchain.buffer = &cache->data[slot * fs->fs_llformat.sectorsize];
+		ret = FS_RAWIOCTL(fs, BIOC_READCHAIN, (unsigned long)&readchain);
+		if (ret > 0) {
+			/* Slot i holds the sector linked from slot i - 1.  Stop at one
+			 * that is cached already; the cached copy may be newer.
+			 */
+
+			sector = logsector;
+			for (i = 0; i < ret; i++) {
+				if (i > 0) {
+					sector = smartfs_rdle16(&smartfs_cache_data(fs, slot + i - 1)[offsetof(struct smartfs_chain_header_s, nextsector)]);
+					if (smartfs_cache_find(cache, sector) >= 0) {
+						break;
+					}
+				}
+
+				smartfs_cache_touch(cache, slot + i, sector);
+			}
+
+			/* Leave the requested sector the most recently used. */
+
+			cache->entry[slot].lastuse = ++cache->tick;
+			return slot;
+		}
+
+		if (ret == -ENOTTY) {
+			cache->nochain = true;
+		}
+
+		fvdbg("Chain read of sector %d failed: %d\n", logsector, ret);
+	}
+#endif
+
+	slot = smartfs_cache_victim(fs, 1);
+	if (slot < 0) {
+		return slot;
+	}
+
+	readwrite.logsector = logsector;
+	readwrite.offset = 0;
+	readwrite.count = fs->fs_llformat.availbytes;
+	readwrite.buffer = smartfs_cache_data(fs, slot);
+	ret = FS_RAWIOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+	if (ret < 0) {
+		return ret;
+	}
+
+	smartfs_cache_touch(cache, slot, logsector);
+	return slot;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_read
+ ****************************************************************************/
+
+static int smartfs_cache_read(struct smartfs_mountpt_s *fs, FAR struct smart_read_write_s *req)
+{
+	FAR struct smartfs_cache_s *cache = fs->fs_cache;
+	FAR uint8_t *data;
+	int slot;
+
+	slot = smartfs_cache_find(cache, req->logsector);
+	if (slot < 0) {
+		slot = smartfs_cache_fill(fs, req->logsector);
+		if (slot < 0) {
+			return slot;
+		}
+	} else {
+		cache->entry[slot].lastuse = ++cache->tick;
+	}
+
+	data = smartfs_cache_data(fs, slot);
+	memcpy((FAR uint8_t *)req->buffer, &data[req->offset], req->count);
+
+	/* Remember where the chain goes from here for read-ahead. */
+
+	cache->ranext = smartfs_rdle16(&data[offsetof(struct smartfs_chain_header_s, nextsector)]);
+	return req->count;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_write
+ ****************************************************************************/
+
+static int smartfs_cache_write(struct smartfs_mountpt_s *fs, FAR struct smart_read_write_s *req)
+{
+	FAR struct smartfs_cache_s *cache = fs->fs_cache;
+	int slot;
+#ifndef CONFIG_SMARTFS_SECTOR_CACHE_WRITEBACK
+	int ret;
+#endif
+
+	slot = smartfs_cache_find(cache, req->logsector);
+
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE_WRITEBACK
+	/* Keep the write in the cache.  A partial write of an uncached sector
+	 * needs the rest of the sector first.
+	 */
+
+	if (slot < 0) {
+		if (req->offset == 0 && req->count == fs->fs_llformat.availbytes) {
+			slot = smartfs_cache_victim(fs, 1);
+		} else {
+			slot = smartfs_cache_fill(fs, req->logsector);
+		}
+
+		if (slot < 0) {
+			return slot;
+		}
+	}
+
+	memcpy(&smartfs_cache_data(fs, slot)[req->offset], req->buffer, req->count);
+	smartfs_cache_touch(cache, slot, req->logsector);
+	if (!cache->entry[slot].dirty) {
+		cache->entry[slot].dirty = true;
+		cache->entry[slot].dirtyseq = cache->tick;
+		cache->ndirty++;
+	}
+
+	return OK;
+#else
+	/* Write through, then update the cached copy if there is one. */
+
+	ret = FS_RAWIOCTL(fs, BIOC_WRITESECT, (unsigned long)req);
+	if (ret >= 0 && slot >= 0) {
+		memcpy(&smartfs_cache_data(fs, slot)[req->offset], req->buffer, req->count);
+		cache->entry[slot].lastuse = ++cache->tick;
+	}
+
+	return ret;
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_cache_init
+ *
+ * Description: Allocate the sector cache of a mount.
+ *
+ ****************************************************************************/
+
+int smartfs_cache_init(struct smartfs_mountpt_s *fs)
+{
+	FAR struct smartfs_cache_s *cache;
+	int i;
+
+	cache = (FAR struct smartfs_cache_s *)kmm_zalloc(sizeof(struct smartfs_cache_s));
+	if (cache == NULL) {
+		return -ENOMEM;
+	}
+
+	cache->data = (FAR uint8_t *)kmm_malloc(CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES * fs->fs_llformat.sectorsize);
+	if (cache->data == NULL) {
+		kmm_free(cache);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES; i++) {
+		cache->entry[i].logsector = SMARTFS_CACHE_NONE;
+	}
+
+	cache->ranext = SMARTFS_CACHE_NONE;
+	fs->fs_cache = cache;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_release
+ *
+ * Description: Write back and free the sector cache of a mount.
+ *
+ ****************************************************************************/
+
+void smartfs_cache_release(struct smartfs_mountpt_s *fs)
+{
+	if (fs->fs_cache == NULL) {
+		return;
+	}
+
+	if (smartfs_cache_flush(fs) < 0) {
+		fdbg("Lost %d unwritten sectors\n", fs->fs_cache->ndirty);
+	}
+
+	kmm_free(fs->fs_cache->data);
+	kmm_free(fs->fs_cache);
+	fs->fs_cache = NULL;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_flush
+ *
+ * Description: Write all dirty sectors to the device, in the order they
+ *   were first modified.
+ *
+ ****************************************************************************/
+
+int smartfs_cache_flush(struct smartfs_mountpt_s *fs)
+{
+	FAR struct smartfs_cache_s *cache = fs->fs_cache;
+	struct smart_read_write_s readwrite;
+	int oldest;
+	int ret;
+	int i;
+
+	if (cache == NULL) {
+		return OK;
+	}
+
+	while (cache->ndirty > 0) {
+		oldest = -1;
+		for (i = 0; i < CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES; i++) {
+			if (cache->entry[i].dirty && (oldest < 0 || cache->entry[i].dirtyseq < cache->entry[oldest].dirtyseq)) {
+				oldest = i;
+			}
+		}
+
+		readwrite.logsector = cache->entry[oldest].logsector;
+		readwrite.offset = 0;
+		readwrite.count = fs->fs_llformat.availbytes;
+		readwrite.buffer = smartfs_cache_data(fs, oldest);
+		ret = FS_RAWIOCTL(fs, BIOC_WRITESECT, (unsigned long)&readwrite);
+		if (ret < 0) {
+			fdbg("Error %d writing back sector %d\n", ret, readwrite.logsector);
+			return ret;
+		}
+
+		cache->entry[oldest].dirty = false;
+		cache->ndirty--;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: smartfs_cache_ioctl
+ *
+ * Description: Block driver ioctl of a cached mount.  Sector reads and
+ *   writes are served by the cache; sector allocation and release keep it
+ *   coherent; everything else goes to the device.
+ *
+ ****************************************************************************/
+
+int smartfs_cache_ioctl(struct smartfs_mountpt_s *fs, int cmd, unsigned long arg)
+{
+	FAR struct smartfs_cache_s *cache = fs->fs_cache;
+	FAR struct smart_read_write_s *req;
+	int slot;
+	int ret;
+	int i;
+
+	if (cache == NULL) {
+		return FS_RAWIOCTL(fs, cmd, arg);
+	}
+
+	switch (cmd) {
+	case BIOC_READSECT:
+	case BIOC_WRITESECT:
+		req = (FAR struct smart_read_write_s *)arg;
+		if (req->offset + req->count > fs->fs_llformat.availbytes) {
+			return -EINVAL;
+		}
+
+		if (cmd == BIOC_READSECT) {
+			return smartfs_cache_read(fs, req);
+		}
+
+		return smartfs_cache_write(fs, req);
+
+	case BIOC_FREESECT:
+		slot = smartfs_cache_find(cache, (uint16_t)arg);
+#if defined(CONFIG_SMARTFS_SECTOR_CACHE_WRITEBACK) && !defined(CONFIG_MTD_SMART_ENABLE_CRC)
+		/* The content of a released sector is never read again.  With CRC
+		 * the device cannot release a sector that was never written, so
+		 * the flush below writes it first.
+		 */
+
+		if (slot >= 0) {
+			smartfs_cache_drop(cache, slot);
+			slot = -1;
+		}
+#endif
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE_WRITEBACK
+		/* The sectors which referred to the released one, like directory
+		 * entries changed by unlink, rmdir or rename, must reach the device
+		 * before the sector can be reused.  Otherwise a power loss leaves
+		 * them pointing at a freed sector.
+		 */
+
+		ret = smartfs_cache_flush(fs);
+		if (ret < 0) {
+			return ret;
+		}
+#endif
+		if (slot >= 0) {
+			smartfs_cache_drop(cache, slot);
+		}
+
+		if (cache->ranext == (uint16_t)arg) {
+			cache->ranext = SMARTFS_CACHE_NONE;
+		}
+
+		return FS_RAWIOCTL(fs, cmd, arg);
+
+	case BIOC_ALLOCSECT:
+		ret = FS_RAWIOCTL(fs, cmd, arg);
+		if (ret < 0) {
+			return ret;
+		}
+
+		slot = smartfs_cache_find(cache, (uint16_t)ret);
+		if (slot >= 0) {
+			smartfs_cache_drop(cache, slot);
+		}
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE_WRITEBACK
+		/* A new sector reads back erased, so the first writes to it need no
+		 * read.  With CRC the device has not written it yet and cannot read
+		 * it back, so keep it dirty until it is written back.
+		 */
+
+		slot = smartfs_cache_victim(fs, 1);
+		if (slot >= 0) {
+			memset(smartfs_cache_data(fs, slot), CONFIG_SMARTFS_ERASEDSTATE, fs->fs_llformat.availbytes);
+			smartfs_cache_touch(cache, slot, (uint16_t)ret);
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+			cache->entry[slot].dirty = true;
+			cache->entry[slot].dirtyseq = cache->tick;
+			cache->ndirty++;
+#endif
+		}
+#endif
+		return ret;
+
+	case BIOC_LLFORMAT:
+		for (i = 0; i < CONFIG_SMARTFS_SECTOR_CACHE_ENTRIES; i++) {
+			smartfs_cache_drop(cache, i);
+		}
+
+		cache->ranext = SMARTFS_CACHE_NONE;
+		return FS_RAWIOCTL(fs, cmd, arg);
+
+	default:
+		return FS_RAWIOCTL(fs, cmd, arg);
+	}
+}
+
+#endif							/* CONFIG_SMARTFS_SECTOR_CACHE */
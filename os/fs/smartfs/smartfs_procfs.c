@@ -147,6 +147,9 @@ static int smartfs_stat(FAR const char *relpath, FAR struct stat *buf);
 
 static ssize_t smartfs_debug_write(FAR struct file *filep, FAR const char *buffer, size_t buflen);
 static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+#ifdef CONFIG_SMARTFS_DCACHE
+static size_t smartfs_dcache_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+#endif
 #ifdef CONFIG_MTD_SMART_ALLOC_DEBUG
 static size_t smartfs_mem_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
 #endif
@@ -162,6 +165,9 @@ static size_t smartfs_files_read(FAR struct file *filep, FAR char *buffer, size_
  ****************************************************************************/
 
 static const struct smartfs_procfs_entry_s g_direntry[] = {
+#ifdef CONFIG_SMARTFS_DCACHE
+	{"dcache", smartfs_dcache_read, NULL, DTYPE_FILE},
+#endif
 	{"debuglevel", NULL, smartfs_debug_write, DTYPE_FILE},
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	{"erasemap", smartfs_erasemap_read, NULL, DTYPE_FILE},
@@ -781,6 +787,40 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer, size
 	return len;
 }
 
+/****************************************************************************
+ * Name: smartfs_dcache_read
+ *
+ * Description: Performs the read operation for the "dcache" dir entry.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMARTFS_DCACHE
+static size_t smartfs_dcache_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct smartfs_file_s *priv;
+	FAR struct smartfs_dcache_s *dcache;
+	uint32_t lookups;
+	size_t len;
+
+	priv = (FAR struct smartfs_file_s *)filep->f_priv;
+
+	len = 0;
+	if (priv->offset == 0) {
+		dcache = priv->level1.mount->fs_dcache;
+		if (dcache != NULL) {
+			lookups = dcache->hits + dcache->neghits + dcache->misses;
+			len = snprintf(buffer, buflen, "Entries          %d\nHits             %u\n" "Negative Hits    %u\nMisses           %u\n" "Hit Rate         %u%%\nInvalidations    %u\n", CONFIG_SMARTFS_DCACHE_ENTRIES, dcache->hits, dcache->neghits, dcache->misses, lookups == 0 ? 0 : (uint32_t)(((uint64_t)(dcache->hits + dcache->neghits) * 100) / lookups), dcache->invalidations);
+		}
+
+		/* Indicate we have already provided all the data */
+
+		priv->offset = 0xFF;
+	}
+
+	return len;
+}
+#endif
+
 /****************************************************************************
  * Name: smartfs_mem_read
  *
@@ -117,6 +117,9 @@ static void smartfs_stat_common(FAR struct smartfs_mountpt_s *fs, FAR struct sma
 static int smartfs_stat(struct inode *mountpt, const char *relpath, struct stat *buf);
 
 static off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *sf, off_t offset, int whence);
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+static void smartfs_sidx_track(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *sf);
+#endif
 
 /****************************************************************************
  * Private Variables
@@ -225,6 +228,9 @@ static int smartfs_open(FAR struct file *filep, const char *relpath, int oflags,
 #endif							/* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
 
 	sf->entry.name = NULL;
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	sf->sidx = NULL;
+#endif
 	ret = smartfs_finddirentry(fs, &sf->entry, relpath, &parentdirsector, &filename);
 
 	/* Three possibilities: (1) a node exists for the relpath and
@@ -452,6 +458,11 @@ static int smartfs_close(FAR struct file *filep)
 		kmm_free(sf->buffer);
 	}
 #endif
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	if (sf->sidx) {
+		kmm_free(sf->sidx);
+	}
+#endif
 
 	kmm_free(sf);
 	filep->f_priv = NULL;
@@ -560,6 +571,9 @@ static ssize_t smartfs_read(FAR struct file *filep, char *buffer, size_t buflen)
 
 			sf->currsector = SMARTFS_NEXTSECTOR(header);
 			sf->curroffset = sizeof(struct smartfs_chain_header_s);
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+			smartfs_sidx_track(fs, sf);
+#endif
 
 			/* Test if at end of data */
 
@@ -852,6 +866,9 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 
 			sf->curroffset = sizeof(struct smartfs_chain_header_s);
 			sf->currsector = SMARTFS_NEXTSECTOR(header);
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+			smartfs_sidx_track(fs, sf);
+#endif
 		}
 	}
 
@@ -947,6 +964,9 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 			sf->bflags = SMARTFS_BFLAG_DIRTY;
 			sf->currsector = SMARTFS_NEXTSECTOR(header);
 			sf->curroffset = sizeof(struct smartfs_chain_header_s);
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+			smartfs_sidx_track(fs, sf);
+#endif
 			memset(sf->buffer, CONFIG_SMARTFS_ERASEDSTATE, fs->fs_llformat.availbytes);
 			header->type = SMARTFS_DIRENT_TYPE_FILE;
 		}
@@ -1014,6 +1034,9 @@ static ssize_t smartfs_write(FAR struct file *filep, const char *buffer, size_t
 
 				sf->currsector = SMARTFS_NEXTSECTOR(header);
 				sf->curroffset = sizeof(struct smartfs_chain_header_s);
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+				smartfs_sidx_track(fs, sf);
+#endif
 			}
 		}
 #endif							/* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
@@ -1043,6 +1066,11 @@ static off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_
 	int ret;
 	off_t newpos;
 	off_t sectorstartpos;
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	uint16_t datasize;
+	uint16_t sector;
+	uint16_t pos;
+#endif
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 	int sector_used = 0;
 #endif
@@ -1107,15 +1135,52 @@ static off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_
 	 * sector, otherwise we have to start from the beginning of the file.
 	 */
 
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	/* With the sector index, start from the closest known sector at or
+	 * before the target instead.  Every sector but the last in a chain is
+	 * full, so the target's chain position follows from newpos.  The
+	 * target is the sector whose data ends at or after newpos, matching
+	 * the walk below.
+	 */
+
+	datasize = fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s);
+	if (sf->sidx == NULL) {
+		sf->sidx = (uint16_t *)kmm_malloc(CONFIG_SMARTFS_SEEK_INDEX_ENTRIES * sizeof(uint16_t));
+		if (sf->sidx != NULL) {
+			sf->sidx[0] = sf->entry.firstsector;
+			sf->sidxcount = 1;
+			sf->sidxstride = 1;
+		}
+	}
+
+	sector = smartfs_sidx_lookup(sf, newpos > 0 ? (newpos - 1) / datasize : 0, &pos);
+	if (newpos > sf->filepos && (sectorstartpos % datasize) == 0 && sectorstartpos / datasize > pos) {
+		sf->filepos = sectorstartpos;
+	} else {
+		sf->currsector = sector;
+		sf->filepos = (off_t)pos * datasize;
+	}
+#else
 	if (newpos > sf->filepos) {
 		sf->filepos = sectorstartpos;
 	} else {
 		sf->currsector = sf->entry.firstsector;
 		sf->filepos = 0;
 	}
+#endif
+
+#ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
+	/* Count the full sectors before the starting point. */
+
+	sector_used = sf->filepos / (fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s));
+#endif
 
 	header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
 	while ((sf->currsector != SMARTFS_ERASEDSTATE_16BIT) && (sf->filepos + fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s) < newpos)) {
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+		smartfs_sidx_track(fs, sf);
+#endif
+
 		/* Read the sector's header */
 
 		readwrite.logsector = sf->currsector;
@@ -1140,6 +1205,10 @@ static off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_
 		sf->currsector = SMARTFS_NEXTSECTOR(header);
 	}
 
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	smartfs_sidx_track(fs, sf);
+#endif
+
 #ifdef CONFIG_SMARTFS_USE_SECTOR_BUFFER
 
 	/* When using sector buffering, we must read in the last buffer to our
@@ -1169,6 +1238,26 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smartfs_sidx_track
+ *
+ * Description: Records the current sector in the open file's sector index
+ *              when the file position is at the start of a sector.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+static void smartfs_sidx_track(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *sf)
+{
+	uint16_t datasize;
+
+	datasize = fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s);
+	if (sf->sidx != NULL && sf->currsector != SMARTFS_ERASEDSTATE_16BIT && (sf->filepos % datasize) == 0) {
+		smartfs_sidx_add(sf, sf->filepos / datasize, sf->currsector);
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: smartfs_seek
  ****************************************************************************/
@@ -1251,6 +1340,11 @@ static int smartfs_sync(FAR struct file *filep)
 	smartfs_semtake(fs);
 
 	ret = smartfs_sync_internal(fs, sf);
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+	if (ret == OK) {
+		ret = smartfs_cache_flush(fs);
+	}
+#endif
 
 	smartfs_semgive(fs);
 	return ret;
@@ -2123,6 +2217,12 @@ int smartfs_rename(struct inode *mountpt, const char *oldrelpath, const char *ne
 		tmp_pntr[0] = (uint8_t)(tmp_flag & 0x00FF);
 		tmp_pntr[1] = (uint8_t)((tmp_flag >> 8) & 0x00FF);
 
+#ifdef CONFIG_SMARTFS_DCACHE
+		/* The old name is going away, forget any lookup of it */
+
+		smartfs_dcache_invalidate(fs, oldentry.dfirst);
+#endif
+
 		/* Now write the updated flags back to the device */
 
 		readwrite.offset = oldentry.doffset;
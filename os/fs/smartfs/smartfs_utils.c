@@ -604,6 +604,32 @@ int smartfs_mount(struct smartfs_mountpt_s *fs, bool writeable)
 	fs->fs_workbuffer = (char *)kmm_malloc(256);
 	fs->fs_rootsector = SMARTFS_ROOT_DIR_SECTOR;
 
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+	/* Set up the sector cache, shared with other mounts of the device */
+
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	if (nextfs != NULL) {
+		fs->fs_cache = nextfs->fs_cache;
+	} else
+#endif
+	{
+		ret = smartfs_cache_init(fs);
+		if (ret != OK) {
+			fdbg("Error allocating sector cache: %d\n", ret);
+			goto errout;
+		}
+	}
+#endif
+
+#ifdef CONFIG_SMARTFS_DCACHE
+	/* The lookup cache is only an accelerator, carry on without it */
+
+	fs->fs_dcache = (FAR struct smartfs_dcache_s *)kmm_zalloc(sizeof(struct smartfs_dcache_s));
+	if (fs->fs_dcache == NULL) {
+		fdbg("Unable to allocate directory lookup cache\n");
+	}
+#endif
+
 	/* We did it! */
 
 	fs->fs_mounted = TRUE;
@@ -694,6 +720,12 @@ int smartfs_unmount(struct smartfs_mountpt_s *fs)
 	 */
 
 	if (count == 1) {
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+		/* Write back and free the sector cache while the device is open */
+
+		smartfs_cache_release(fs);
+#endif
+
 		/* Close the block driver */
 
 		if (fs->fs_blkdriver) {
@@ -730,6 +762,9 @@ int smartfs_unmount(struct smartfs_mountpt_s *fs)
 		prevfs->fs_next = fs->fs_next;
 	}
 #else
+#ifdef CONFIG_SMARTFS_SECTOR_CACHE
+	smartfs_cache_release(fs);
+#endif
 	if (fs->fs_blkdriver) {
 		inode = fs->fs_blkdriver;
 		if (inode) {
@@ -747,6 +782,13 @@ int smartfs_unmount(struct smartfs_mountpt_s *fs)
 	kmm_free(fs->fs_workbuffer);
 #endif
 
+#ifdef CONFIG_SMARTFS_DCACHE
+	if (fs->fs_dcache != NULL) {
+		kmm_free(fs->fs_dcache);
+		fs->fs_dcache = NULL;
+	}
+#endif
+
 	return ret;
 }
 
@@ -780,6 +822,15 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 	struct smartfs_chain_header_s *header;
 	struct smart_read_write_s readwrite;
 	struct smartfs_entry_header_s *entry;
+	bool found;
+	uint16_t efirstsector;
+	uint16_t eflags;
+	uint16_t edsector;
+	uint16_t edoffset;
+	uint32_t eutc;
+#ifdef CONFIG_SMARTFS_DCACHE
+	FAR struct smartfs_dcache_entry_s *dentry;
+#endif
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 	int used_value;
 #endif
@@ -853,218 +904,213 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 		} else {
 			/* Search for the entry in the current directory */
 
-			dirsector = dirstack[depth];
-
-			/* Read the directory */
+			found = false;
+#ifdef CONFIG_SMARTFS_DCACHE
+			dentry = smartfs_dcache_lookup(fs, dirstack[depth], fs->fs_workbuffer);
+			if (dentry != NULL) {
+				found = !dentry->negative;
+				efirstsector = dentry->firstsector;
+				eflags = dentry->flags;
+				eutc = dentry->utc;
+				edsector = dentry->dsector;
+				edoffset = dentry->doffset;
+			} else
+#endif
+			{
+				dirsector = dirstack[depth];
 
-			offset = 0xFFFF;
+				/* Read the directory */
 
 #if CONFIG_SMARTFS_ERASEDSTATE == 0xFF
-			while (dirsector != 0xFFFF)
+				while (!found && dirsector != 0xFFFF)
 #else
-			while (dirsector != 0)
+				while (!found && dirsector != 0)
 #endif
-			{
-				/* Read the next directory in the chain */
+				{
+					/* Read the next directory in the chain */
+
+					readwrite.logsector = dirsector;
+					readwrite.count = fs->fs_llformat.availbytes;
+					readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
+					readwrite.offset = 0;
+					ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+					if (ret < 0) {
+						goto errout;
+					}
 
-				readwrite.logsector = dirsector;
-				readwrite.count = fs->fs_llformat.availbytes;
-				readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
-				readwrite.offset = 0;
-				ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
-				if (ret < 0) {
-					goto errout;
-				}
+					/* Point to next sector in chain */
 
-				/* Point to next sector in chain */
+					header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
+					dirsector = SMARTFS_NEXTSECTOR(header);
 
-				header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
-				dirsector = SMARTFS_NEXTSECTOR(header);
+					/* Search for the entry */
 
-				/* Search for the entry */
+					offset = sizeof(struct smartfs_chain_header_s);
+					entry = (struct smartfs_entry_header_s *)&fs->fs_rwbuffer[offset];
+					while (offset < readwrite.count) {
+						/* Test if this entry is valid and active and the name
+						 * matches
+						 */
 
-				offset = sizeof(struct smartfs_chain_header_s);
-				entry = (struct smartfs_entry_header_s *)&fs->fs_rwbuffer[offset];
-				while (offset < readwrite.count) {
-					/* Test if this entry is valid and active */
+						if (ENTRY_VALID(entry) && strncmp(entry->name, fs->fs_workbuffer, fs->fs_llformat.namesize) == 0) {
+							/* We found it! */
 
-					if (!(ENTRY_VALID(entry))) {
-						/* This entry isn't valid, skip it */
+#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
+							efirstsector = smartfs_rdle16(&entry->firstsector);
+							eflags = smartfs_rdle16(&entry->flags);
+							eutc = smartfs_rdle32(&entry->utc);
+#else
+							efirstsector = entry->firstsector;
+							eflags = entry->flags;
+							eutc = entry->utc;
+#endif
+							edsector = readwrite.logsector;
+							edoffset = offset;
+							found = true;
+							break;
+						}
+
+						/* Not this entry.  Skip to the next one */
 
 						offset += entrysize;
 						entry = (struct smartfs_entry_header_s *)
 								&fs->fs_rwbuffer[offset];
-
-						continue;
 					}
+				}
 
-					/* Test if the name matches */
-
-					if (strncmp(entry->name, fs->fs_workbuffer, fs->fs_llformat.namesize) == 0) {
-						/* We found it!  If this is the last segment entry,
-						 * then report the entry.  If it isn't the last
-						 * entry, then validate it is a directory entry and
-						 * open it and continue searching.
-						 */
+#ifdef CONFIG_SMARTFS_DCACHE
+				/* Remember the result of the scan, found or not */
+
+				dentry = smartfs_dcache_insert(fs, dirstack[depth], fs->fs_workbuffer);
+				if (dentry != NULL && found) {
+					dentry->negative = false;
+					dentry->firstsector = efirstsector;
+					dentry->flags = eflags;
+					dentry->utc = eutc;
+					dentry->dsector = edsector;
+					dentry->doffset = edoffset;
+				}
+#endif
+			}
 
-						if (*ptr == '\0') {
-							/* We are at the last segment.  Report the entry */
+			if (!found) {
+				/* Entry not found!  Report the error.  Also, if this is the
+				 * last segment, then report the parent directory sector.
+				 */
 
-							/* Fill in the entry */
+				if (*ptr == '\0') {
+					*parentdirsector = dirstack[depth];
+					*filename = segment;
+				} else {
+					*parentdirsector = 0xFFFF;
+					*filename = NULL;
+				}
 
-#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
-							direntry->firstsector = smartfs_rdle16(&entry->firstsector);
-							direntry->flags = smartfs_rdle16(&entry->flags);
-							direntry->utc = smartfs_rdle32(&entry->utc);
-#else
-							direntry->firstsector = entry->firstsector;
-							direntry->flags = entry->flags;
-							direntry->utc = entry->utc;
-#endif
-							direntry->dsector = readwrite.logsector;
-							direntry->doffset = offset;
-							direntry->dfirst = dirstack[depth];
-							if (direntry->name == NULL) {
-								direntry->name = (char *)kmm_malloc(fs->fs_llformat.namesize + 1);
-								if (direntry->name == NULL) {
-									ret = ERROR;
-									goto errout;
-								}
-							}
+				ret = -ENOENT;
+				goto errout;
+			}
 
-							memset(direntry->name, 0, fs->fs_llformat.namesize + 1);
-							strncpy(direntry->name, entry->name, fs->fs_llformat.namesize);
-							direntry->datlen = 0;
+			/* We found it!  If this is the last segment entry, then report
+			 * the entry.  If it isn't the last entry, then validate it is a
+			 * directory entry and open it and continue searching.
+			 */
 
-							/* Scan the file's sectors to calculate the length and perform
-							 * a rudimentary check.
-							 */
+			if (*ptr == '\0') {
+				/* We are at the last segment.  Report the entry */
+
+				/* Fill in the entry */
+
+				direntry->firstsector = efirstsector;
+				direntry->flags = eflags;
+				direntry->utc = eutc;
+				direntry->dsector = edsector;
+				direntry->doffset = edoffset;
+				direntry->dfirst = dirstack[depth];
+				if (direntry->name == NULL) {
+					direntry->name = (char *)kmm_malloc(fs->fs_llformat.namesize + 1);
+					if (direntry->name == NULL) {
+						ret = ERROR;
+						goto errout;
+					}
+				}
 
-#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
-							if ((smartfs_rdle16(&entry->flags) & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_FILE) {
-								dirsector = smartfs_rdle16(&entry->firstsector);
-#else
-							if ((entry->flags & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_FILE) {
-								dirsector = entry->firstsector;
-#endif
-								readwrite.count = sizeof(struct smartfs_chain_header_s);
-								readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
-								readwrite.offset = 0;
-
-								while (dirsector != SMARTFS_ERASEDSTATE_16BIT) {
-									/* Read the next sector of the file */
-
-									readwrite.logsector = dirsector;
-									ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
-									if (ret < 0) {
-										fdbg("Error in sector chain at %d!\n", dirsector);
-										break;
-									}
-#ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
-									if (SMARTFS_NEXTSECTOR(header) == SMARTFS_ERASEDSTATE_16BIT) {
-
-										readwrite.count = fs->fs_llformat.availbytes;
-										readwrite.buffer = (uint8_t *)fs->fs_chunk_buffer;
-
-										ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
-										if (ret < 0) {
-											fdbg("Error %d reading sector %d header\n", ret, sf->currsector);
-											break;
-										}
-										used_value = get_leftover_used_byte_count((uint8_t *)readwrite.buffer, get_used_byte_count((uint8_t *)header->used));
-										direntry->datlen += used_value;
-									} else {
-										direntry->datlen += (fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s));
-									}
-									readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
-#else
-									/* Add used bytes to the total and point to next sector */
-									if (SMARTFS_USED(header) != SMARTFS_ERASEDSTATE_16BIT) {
-										direntry->datlen += SMARTFS_USED(header);
-									}
-#endif
-									dirsector = SMARTFS_NEXTSECTOR(header);
-								}
-							}
+				memset(direntry->name, 0, fs->fs_llformat.namesize + 1);
+				strncpy(direntry->name, fs->fs_workbuffer, fs->fs_llformat.namesize);
+				direntry->datlen = 0;
 
-							*parentdirsector = dirstack[depth];
-							*filename = segment;
-							ret = OK;
-							goto errout;
-						} else {
-							/* Validate it's a directory */
+				/* Scan the file's sectors to calculate the length and perform
+				 * a rudimentary check.
+				 */
 
-#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
-							if ((smartfs_rdle16(&entry->flags) & SMARTFS_DIRENT_TYPE) != SMARTFS_DIRENT_TYPE_DIR)
-#else
-							if ((entry->flags & SMARTFS_DIRENT_TYPE) != SMARTFS_DIRENT_TYPE_DIR)
-#endif
-							{
-								/* Not a directory!  Report the error */
+				if ((eflags & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_FILE) {
+					dirsector = efirstsector;
+					header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
+					readwrite.count = sizeof(struct smartfs_chain_header_s);
+					readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
+					readwrite.offset = 0;
 
-								ret = -ENOTDIR;
-								goto errout;
-							}
+					while (dirsector != SMARTFS_ERASEDSTATE_16BIT) {
+						/* Read the next sector of the file */
 
-							/* "Push" the directory and continue searching */
+						readwrite.logsector = dirsector;
+						ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+						if (ret < 0) {
+							fdbg("Error in sector chain at %d!\n", dirsector);
+							break;
+						}
+#ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
+						if (SMARTFS_NEXTSECTOR(header) == SMARTFS_ERASEDSTATE_16BIT) {
 
-							if (depth >= CONFIG_SMARTFS_DIRDEPTH - 1) {
-								/* Directory depth too big */
+							readwrite.count = fs->fs_llformat.availbytes;
+							readwrite.buffer = (uint8_t *)fs->fs_chunk_buffer;
 
-								ret = -ENAMETOOLONG;
-								goto errout;
+							ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+							if (ret < 0) {
+								fdbg("Error %d reading sector %d header\n", ret, sf->currsector);
+								break;
 							}
-#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
-							dirstack[++depth] = smartfs_rdle16(&entry->firstsector);
+							used_value = get_leftover_used_byte_count((uint8_t *)readwrite.buffer, get_used_byte_count((uint8_t *)header->used));
+							direntry->datlen += used_value;
+						} else {
+							direntry->datlen += (fs->fs_llformat.availbytes - sizeof(struct smartfs_chain_header_s));
+						}
+						readwrite.buffer = (uint8_t *)fs->fs_rwbuffer;
 #else
-							dirstack[++depth] = entry->firstsector;
-#endif
-							segment = ptr + 1;
-							break;
+						/* Add used bytes to the total and point to next sector */
+						if (SMARTFS_USED(header) != SMARTFS_ERASEDSTATE_16BIT) {
+							direntry->datlen += SMARTFS_USED(header);
 						}
+#endif
+						dirsector = SMARTFS_NEXTSECTOR(header);
 					}
-
-					/* Not this entry.  Skip to the next one */
-
-					offset += entrysize;
-					entry = (struct smartfs_entry_header_s *)
-							&fs->fs_rwbuffer[offset];
 				}
 
-				/* Test if a directory entry was found and break if it was */
-
-				if (offset < readwrite.count) {
-					break;
-				}
+				*parentdirsector = dirstack[depth];
+				*filename = segment;
+				ret = OK;
+				goto errout;
 			}
 
-			/* If we found a dir entry, then continue searching */
-
-			if (offset < readwrite.count) {
-				/* Update the segment pointer */
+			/* Validate it's a directory */
 
-				if (*ptr != '\0') {
-					ptr++;
-				}
+			if ((eflags & SMARTFS_DIRENT_TYPE) != SMARTFS_DIRENT_TYPE_DIR) {
+				/* Not a directory!  Report the error */
 
-				segment = ptr;
-				continue;
+				ret = -ENOTDIR;
+				goto errout;
 			}
 
-			/* Entry not found!  Report the error.  Also, if this is the last
-			 * segment, then report the parent directory sector.
-			 */
+			/* "Push" the directory and continue searching */
 
-			if (*ptr == '\0') {
-				*parentdirsector = dirstack[depth];
-				*filename = segment;
-			} else {
-				*parentdirsector = 0xFFFF;
-				*filename = NULL;
+			if (depth >= CONFIG_SMARTFS_DIRDEPTH - 1) {
+				/* Directory depth too big */
+
+				ret = -ENAMETOOLONG;
+				goto errout;
 			}
 
-			ret = -ENOENT;
-			goto errout;
+			dirstack[++depth] = efirstsector;
+			segment = ptr + 1;
 		}
 	}
 
@@ -1098,6 +1144,12 @@ int smartfs_createentry(struct smartfs_mountpt_s *fs, uint16_t parentdirsector,
 	struct smartfs_entry_header_s *entry;
 	struct smartfs_chain_header_s *chainheader;
 
+#ifdef CONFIG_SMARTFS_DCACHE
+	/* The parent directory is about to change, forget what we know of it */
+
+	smartfs_dcache_invalidate(fs, parentdirsector);
+#endif
+
 	/* Start at the 1st sector in the parent directory */
 
 	psector = parentdirsector;
@@ -1336,6 +1388,18 @@ int smartfs_deleteentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *en
 	struct smartfs_chain_header_s *header;
 	struct smart_read_write_s readwrite;
 
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	/* The sectors are about to be released, drop any cached chain. */
+
+	smartfs_sidx_invalidate(fs, entry->firstsector);
+#endif
+#ifdef CONFIG_SMARTFS_DCACHE
+	/* Drop lookups in the parent and, for a directory, in the entry itself */
+
+	smartfs_dcache_invalidate(fs, entry->dfirst);
+	smartfs_dcache_invalidate(fs, entry->firstsector);
+#endif
+
 	/* Okay, delete the file.  Loop through each sector and release them
 
 	 * TODO:  We really should walk the list backward to avoid lost
@@ -1594,6 +1658,12 @@ int smartfs_truncatefile(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *e
 	struct smartfs_chain_header_s *header;
 	struct smart_read_write_s readwrite;
 
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+	/* Only the first sector survives the truncate. */
+
+	smartfs_sidx_invalidate(fs, entry->firstsector);
+#endif
+
 	/* Walk through the directory's sectors and count entries */
 
 	nextsector = entry->firstsector;
@@ -1695,6 +1765,209 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smartfs_sidx_add
+ *
+ * Description: Records that 'sector' is at chain position 'pos' of an open
+ *              file.  Only positions that extend the index by one entry are
+ *              kept; once the index is full every other entry is dropped and
+ *              the stride doubled, so its size stays bounded while seeks
+ *              still walk at most stride - 1 sector headers.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+void smartfs_sidx_add(FAR struct smartfs_ofile_s *sf, uint16_t pos, uint16_t sector)
+{
+	uint16_t x;
+
+	if (sf->sidx == NULL || (pos & (sf->sidxstride - 1)) != 0 || pos / sf->sidxstride != sf->sidxcount) {
+		return;
+	}
+
+	if (sf->sidxcount == CONFIG_SMARTFS_SEEK_INDEX_ENTRIES) {
+		for (x = 0; x < sf->sidxcount >> 1; x++) {
+			sf->sidx[x] = sf->sidx[x << 1];
+		}
+
+		sf->sidxcount >>= 1;
+		sf->sidxstride <<= 1;
+		if ((pos & (sf->sidxstride - 1)) != 0) {
+			return;
+		}
+	}
+
+	sf->sidx[sf->sidxcount++] = sector;
+}
+#endif
+
+/****************************************************************************
+ * Name: smartfs_sidx_lookup
+ *
+ * Description: Returns the closest indexed sector at or before chain
+ *              position 'target' of an open file, with its position in
+ *              'pos'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+uint16_t smartfs_sidx_lookup(FAR struct smartfs_ofile_s *sf, uint16_t target, FAR uint16_t *pos)
+{
+	uint16_t x;
+
+	if (sf->sidx == NULL) {
+		*pos = 0;
+		return sf->entry.firstsector;
+	}
+
+	x = target / sf->sidxstride;
+	if (x >= sf->sidxcount) {
+		x = sf->sidxcount - 1;
+	}
+
+	*pos = x * sf->sidxstride;
+	return sf->sidx[x];
+}
+#endif
+
+/****************************************************************************
+ * Name: smartfs_sidx_invalidate
+ *
+ * Description: Drops the cached chain of every open instance of the file
+ *              starting at 'firstsector', keeping only the first sector.
+ *              Called whenever sectors of a file's chain are released.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMARTFS_SEEK_INDEX
+void smartfs_sidx_invalidate(struct smartfs_mountpt_s *fs, uint16_t firstsector)
+{
+	FAR struct smartfs_ofile_s *sf;
+
+	for (sf = fs->fs_head; sf != NULL; sf = sf->fnext) {
+		if (sf->sidx != NULL && sf->entry.firstsector == firstsector) {
+			sf->sidxcount = 1;
+			sf->sidxstride = 1;
+		}
+	}
+}
+#endif
+
+#ifdef CONFIG_SMARTFS_DCACHE
+/****************************************************************************
+ * Name: smartfs_dcache_hash
+ *
+ * Description: FNV-1a hash of at most 'namesize' characters of 'name',
+ *              seeded with the parent directory sector.
+ *
+ ****************************************************************************/
+
+static uint32_t smartfs_dcache_hash(struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name)
+{
+	uint32_t hash;
+	uint16_t x;
+
+	hash = 2166136261u ^ parent;
+	for (x = 0; x < fs->fs_llformat.namesize && name[x] != '\0'; x++) {
+		hash ^= (uint8_t)name[x];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_lookup
+ *
+ * Description: Looks up 'name' in the directory starting at sector 'parent'.
+ *              Returns the cached entry, which may be a negative one
+ *              recording that the name does not exist, or NULL on a miss.
+ *
+ ****************************************************************************/
+
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_lookup(struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name)
+{
+	FAR struct smartfs_dcache_s *dcache = fs->fs_dcache;
+	FAR struct smartfs_dcache_entry_s *dentry;
+	uint32_t hash;
+
+	if (dcache == NULL || fs->fs_llformat.namesize > CONFIG_SMARTFS_MAXNAMLEN) {
+		return NULL;
+	}
+
+	hash = smartfs_dcache_hash(fs, parent, name);
+	dentry = &dcache->entry[hash % CONFIG_SMARTFS_DCACHE_ENTRIES];
+	if (dentry->valid && dentry->hash == hash && dentry->parent == parent && strncmp(dentry->name, name, fs->fs_llformat.namesize) == 0) {
+		if (dentry->negative) {
+			dcache->neghits++;
+		} else {
+			dcache->hits++;
+		}
+
+		return dentry;
+	}
+
+	dcache->misses++;
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_insert
+ *
+ * Description: Claims the slot for 'name' in directory 'parent' and
+ *              initializes it as a negative entry.  The caller fills in the
+ *              directory entry details when the name was found.
+ *
+ ****************************************************************************/
+
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_insert(struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name)
+{
+	FAR struct smartfs_dcache_s *dcache = fs->fs_dcache;
+	FAR struct smartfs_dcache_entry_s *dentry;
+	uint32_t hash;
+
+	if (dcache == NULL || fs->fs_llformat.namesize > CONFIG_SMARTFS_MAXNAMLEN) {
+		return NULL;
+	}
+
+	hash = smartfs_dcache_hash(fs, parent, name);
+	dentry = &dcache->entry[hash % CONFIG_SMARTFS_DCACHE_ENTRIES];
+	memset(dentry, 0, sizeof(struct smartfs_dcache_entry_s));
+	dentry->hash = hash;
+	dentry->parent = parent;
+	dentry->valid = true;
+	dentry->negative = true;
+	strncpy(dentry->name, name, fs->fs_llformat.namesize);
+
+	return dentry;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_invalidate
+ *
+ * Description: Drops every cached lookup in the directory starting at
+ *              sector 'parent', or the whole cache if 'parent' is 0xFFFF.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_invalidate(struct smartfs_mountpt_s *fs, uint16_t parent)
+{
+	FAR struct smartfs_dcache_s *dcache = fs->fs_dcache;
+	int x;
+
+	if (dcache == NULL) {
+		return;
+	}
+
+	for (x = 0; x < CONFIG_SMARTFS_DCACHE_ENTRIES; x++) {
+		if (dcache->entry[x].valid && (parent == 0xFFFF || dcache->entry[x].parent == parent)) {
+			dcache->entry[x].valid = false;
+			dcache->invalidations++;
+		}
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: smartfs_get_first_mount
  *
@@ -2738,6 +3011,12 @@ static int process_transaction(struct smartfs_mountpt_s *fs)
 	j_mgr = fs->journal;
 	entry = (struct smartfs_logging_entry_s *)(j_mgr->buffer);
 
+#ifdef CONFIG_SMARTFS_DCACHE
+	/* A redo may rewrite any directory, so start over with an empty cache */
+
+	smartfs_dcache_invalidate(fs, 0xFFFF);
+#endif
+
 	/* Check whether the transaction qualifies for redo */
 	if (T_START_CHECK(entry->trans_info) && !T_FINISH_CHECK(entry->trans_info)) {
 		/* Choose redo routine based on transaction type */
@@ -242,6 +242,13 @@
 										 *      the block with specific debug
 										 *      command and data.
 										 * OUT: None.  */
+#define BIOC_READCHAIN  _BIOC(0x000C)	/* Read a chain of logical sectors from
+										 * the block device, following the link
+										 * stored in each sector.
+										 * IN:  Pointer to chain read data (the
+										 *      first logical sector, max count,
+										 *      link offset and read buffer)
+										 * OUT: Number of sectors read or error */
 
 /* TinyAra MTD driver ioctl definitions ***************************************/
 
@@ -177,6 +177,21 @@ enum mtd_partition_tag_s {
 	MTD_ROMFS = 4
 };
 
+/* Garbage collection statistics kept by MTD drivers that reclaim erase
+ * blocks in the background.  They are reported through procfs when
+ * registered with mtd_gcregister.
+ */
+
+struct mtd_gcstats_s {
+	FAR struct mtd_gcstats_s *pnext;	/* Next registered statistics entry */
+	FAR const char *name;		/* Name of the reporting device */
+	uint32_t slices;			/* Background collection time slices run */
+	uint32_t relocated;			/* Sectors relocated in the background */
+	uint32_t reclaimed;			/* Erase blocks reclaimed in the background */
+	uint32_t foreground;		/* Collections run inline on the writer's path */
+	uint32_t maxslice;			/* Longest background time slice in system ticks */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -363,6 +378,19 @@ FAR struct mtd_dev_s *progmem_initialize(void);
 
 #ifdef CONFIG_MTD_REGISTRATION
 int mtd_register(FAR struct mtd_dev_s *mtd, FAR const char *name);
+
+/****************************************************************************
+ * Name: mtd_gcregister
+ *
+ * Description:
+ *   Registers a set of garbage collection statistics with the procfs file
+ *   system.  The statistics are owned and updated by the caller and are
+ *   listed after the registered MTD devices.
+ *
+ * @since TizenRT v3.1
+ ****************************************************************************/
+
+int mtd_gcregister(FAR struct mtd_gcstats_s *stats, FAR const char *name);
 #endif
 
 #undef EXTERN
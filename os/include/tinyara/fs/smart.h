@@ -102,6 +102,20 @@ struct smart_read_write_s {
 	const uint8_t *buffer;		/* Pointer to the data to write */
 };
 
+/* The following defines the information for reading a chain of logical
+ * sectors with BIOC_READCHAIN.  Each sector is returned whole, SMART
+ * header included, in consecutive sectorsize slots of the buffer.  The
+ * next sector of the chain is the little-endian 16-bit value found at
+ * linkoffset within the data of the previous one.
+ */
+
+struct smart_readchain_s {
+	uint16_t logsector;			/* First logical sector of the chain */
+	uint16_t nsectors;			/* Max number of sectors to read */
+	uint16_t linkoffset;		/* Offset of the next sector link in data */
+	FAR uint8_t *buffer;		/* nsectors * sectorsize byte buffer */
+};
+
 /* The following defines the procfs data exchange interface between the
  * SMART MTD and FS layers.
  */
@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * include/tinyara/mm/kmm_pool.h
+ *
+ * Fixed-size kernel object pools built on the granule allocator.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_MM_KMM_POOL_H
+#define __INCLUDE_MM_KMM_POOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef CONFIG_MM_KMM_POOL
+
+#include <tinyara/mm/gran.h>
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+#define KMM_POOL_NAMELEN 12
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One pool of equally sized objects.  Every object occupies exactly one
+ * granule of the pool's private granule heap, so allocation and release
+ * never touch the kernel heap or its semaphore.  When the pool is
+ * exhausted, kmm_pool_alloc() falls back to kmm_malloc() and records the
+ * event in nfallback so the pool can be resized from the procfs report.
+ */
+
+struct kmm_pool_s {
+	FAR struct kmm_pool_s *flink;	/* Next pool in the global list */
+	char name[KMM_POOL_NAMELEN];	/* Name reported through procfs */
+	GRAN_HANDLE handle;				/* Granule heap holding the objects */
+	uintptr_t start;				/* First byte of the object region */
+	uintptr_t end;					/* One past the last byte of the region */
+	uint16_t objsize;				/* Requested size of one object */
+	uint16_t nobjs;					/* Number of objects in the pool */
+	uint16_t nused;					/* Objects currently allocated */
+	uint16_t peak;					/* Highest value nused has reached */
+	uint32_t nfallback;				/* Allocations satisfied by kmm_malloc */
+	uint8_t log2gran;				/* Log2 of the per-object granule size */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/* List of every pool created with kmm_pool_create(), newest first */
+
+EXTERN FAR struct kmm_pool_s *g_kmm_pools;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_pool_create
+ *
+ * Description:
+ *   Create a pool of nobjs objects of objsize bytes each.  The backing
+ *   region is taken from the kernel heap once, at creation time.  This
+ *   function must be called from task context.
+ *
+ * Input Parameters:
+ *   name    - Name reported through /proc/kmmpool (truncated if too long)
+ *   objsize - Size of one object in bytes
+ *   nobjs   - Number of objects to reserve
+ *
+ * Returned Value:
+ *   The new pool on success; NULL if nobjs is zero or memory is exhausted.
+ *
+ ****************************************************************************/
+
+FAR struct kmm_pool_s *kmm_pool_create(FAR const char *name, size_t objsize, unsigned int nobjs);
+
+/****************************************************************************
+ * Name: kmm_pool_alloc
+ *
+ * Description:
+ *   Allocate one object from the pool, falling back to kmm_malloc() if the
+ *   pool is exhausted or is NULL (i.e. its creation failed).  Because of
+ *   that fallback this function must not be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   pool    - The pool returned by kmm_pool_create()
+ *   objsize - Size of the object, at most the objsize of the pool.  This is
+ *             the size requested from kmm_malloc() on fallback.
+ *
+ * Returned Value:
+ *   A pointer to an uninitialized object, or NULL if no memory is left.
+ *
+ ****************************************************************************/
+
+FAR void *kmm_pool_alloc(FAR struct kmm_pool_s *pool, size_t objsize);
+
+/****************************************************************************
+ * Name: kmm_pool_free
+ *
+ * Description:
+ *   Return an object to the pool.  This may be called from interrupt
+ *   handlers.
+ *
+ * Input Parameters:
+ *   pool - The pool the object was allocated from
+ *   mem  - The object to release
+ *
+ * Returned Value:
+ *   true if mem belonged to the pool and has been released.  false if mem
+ *   came from the kmm_malloc() fallback or pool is NULL; the caller then
+ *   still owns it and must release it with kmm_free() or sched_kfree().
+ *
+ ****************************************************************************/
+
+bool kmm_pool_free(FAR struct kmm_pool_s *pool, FAR void *mem);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif							/* CONFIG_MM_KMM_POOL */
+#endif							/* __INCLUDE_MM_KMM_POOL_H */
@@ -191,6 +191,18 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* With the segregated-fit allocator, each of the MM_NNODES power-of-two
+ * classes is split into MM_SL_COUNT linear second-level lists.
+ */
+
+#ifdef CONFIG_MM_SEGREGATED_FIT
+#define MM_SL_SHIFT      CONFIG_MM_SEGREGATED_FIT_SL_SHIFT
+#else
+#define MM_SL_SHIFT      0
+#endif
+#define MM_SL_COUNT      (1 << MM_SL_SHIFT)
+#define MM_NLISTS        (MM_NNODES << MM_SL_SHIFT)
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -222,6 +234,8 @@
 #define HEAPINFO_ADD_INFO 1
 #define HEAPINFO_DEL_INFO 2
 
+#define HEAPINFO_NODE_TCACHED 1	/* mm_allocnode_s.reserved of a chunk in a per-task cache */
+
 #define HEAPINFO_HEAP_TYPE_KERNEL 1
 #ifdef CONFIG_BUILD_PROTECTED
 #define HEAPINFO_HEAP_TYPE_USER   2
@@ -396,12 +410,22 @@ struct mm_heap_s {
 	int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_SEGREGATED_FIT
+	/* Bit n of mm_fl_bitmap is set if any list of the n-th class is not
+	 * empty, and bit m of mm_sl_bitmap[n] is set if its m-th list is not
+	 * empty.
+	 */
+
+	uint32_t mm_fl_bitmap;
+	uint32_t mm_sl_bitmap[MM_NNODES];
+#endif
+
 	/* All free nodes are maintained in a doubly linked list.  This
 	 * array provides some hooks into the list at various points to
 	 * speed searches for free nodes.
 	 */
 
-	struct mm_freenode_s mm_nodelist[MM_NNODES + 1];
+	struct mm_freenode_s mm_nodelist[MM_NLISTS + 1];
 };
 
 /****************************************************************************
@@ -494,6 +518,13 @@ int umm_trysemaphore(void *address);
 void umm_givesemaphore(void *address);
 #endif
 
+/* Functions contained in umm_tcache.c *************************************/
+
+#ifdef CONFIG_MM_TCACHE
+struct tcb_s;					/* Forward reference */
+void umm_tcache_drain(FAR struct tcb_s *tcb);
+#endif
+
 /* Functions contained in kmm_sem.c ****************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -682,6 +713,16 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 int mm_size2ndx(size_t size);
 
+#ifdef CONFIG_MM_SEGREGATED_FIT
+/* Functions contained in mm_delfreechunk.c *********************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c ********************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size);
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 /* Functions contained in kmm_mallinfo.c . Used to display memory allocation details */
 void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid);
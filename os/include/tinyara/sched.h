@@ -626,6 +626,10 @@ struct tcb_s {
 
 	struct xcptcontext xcp;		/* Interrupt register save area        */
 
+#ifdef CONFIG_MM_TCACHE
+	FAR struct mm_tcache_s *tcache;	/* Small-object cache in front of the heap */
+#endif
+
 #ifdef CONFIG_APP_BINARY_SEPARATION
 	uint32_t ram_start;		/* Start address of RAM partition for this app */
 	uint32_t ram_size;		/* Size of RAM partition for this app */
@@ -56,6 +56,8 @@
 #define TTRACE_BUFFER              'b'
 #define TTRACE_DUMP                'd'
 #define TTRACE_PRINT               'p'
+#define TTRACE_USED_EVENTS         'n'
+#define TTRACE_READ_EVENTS         'r'
 
 #define TTRACE_CODE_VARIABLE        0
 #define TTRACE_CODE_UNIQUE         (1 << 7)
@@ -75,6 +77,18 @@
 #define TTRACE_TAG_LOCK            (1 << 2)
 #define TTRACE_TAG_TASK            (1 << 3)
 #define TTRACE_TAG_IPC             (1 << 4)
+#define TTRACE_TAG_IRQ             (1 << 5)
+
+/* Types of struct ttrace_event_s */
+#define TTRACE_EVENT_SCHED          1  /* pid: prev, aux: prev prio, arg: next pid << 16 | next prio << 8 | prev state */
+#define TTRACE_EVENT_SEM_WAIT       2  /* arg: semaphore address, the task blocks */
+#define TTRACE_EVENT_SEM_WAKE       3  /* arg: semaphore address, the task resumes */
+#define TTRACE_EVENT_SEM_POST       4  /* arg: semaphore address, a waiter is released */
+#define TTRACE_EVENT_IRQ_ENTER      5  /* pid: interrupted task, arg: irq number */
+#define TTRACE_EVENT_IRQ_LEAVE      6  /* pid: interrupted task, arg: irq number */
+#define TTRACE_EVENT_BEGIN          7  /* arg: address of the name string */
+#define TTRACE_EVENT_BEGIN_UID      8  /* arg: unique id */
+#define TTRACE_EVENT_END            9
 
 /****************************************************************************
  * Public Variables
@@ -103,6 +117,20 @@ struct trace_packet {        // total 44 byte(message), 12byte(uid)
 	union trace_message msg;   // 32B
 };
 
+struct ttrace_event_s {      // total 16B
+	uint32_t sec;              // 4B, seconds since boot
+	uint32_t usec;             // 4B
+	pid_t pid;                 // 2B
+	uint8_t type;              // 1B, TTRACE_EVENT_*
+	uint8_t aux;               // 1B, depends on type
+	uint32_t arg;              // 4B, depends on type
+};
+
+struct ttrace_evread_s {     // argument of TTRACE_READ_EVENTS
+	struct ttrace_event_s *events;
+	int nevents;
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -110,6 +138,8 @@ struct trace_packet {        // total 44 byte(message), 12byte(uid)
 extern "C" {
 #endif
 
+struct tcb_s;
+
 /**
  * @ingroup TTRACE_LIBC
  * @brief writes a trace log with string to indicate that a event has begun
@@ -162,12 +192,62 @@ int trace_end_uid(int tag);
  * @since TizenRT v1.1
  */
 int trace_sched(struct tcb_s *prev, struct tcb_s *next);
+
+#ifdef CONFIG_TTRACE_EVENTS
+/**
+ * @ingroup TTRACE_LIBC
+ * @brief records a binary event into the ring of the calling task
+ * @details @b #include <tinyara/ttrace.h>
+ *   Events from interrupt handlers go to a ring shared by all interrupts.
+ *   Nothing is recorded unless tracing runs and tag is selected.
+ * @param[in] tag number for tag
+ * @param[in] type one of TTRACE_EVENT_*
+ * @param[in] arg argument of the event
+ * @return none
+ * @since TizenRT v3.1
+ */
+void ttrace_event(int tag, uint8_t type, uint32_t arg);
+
+/**
+ * @ingroup TTRACE_LIBC
+ * @brief records a context switch as a binary event
+ * @details @b #include <tinyara/ttrace.h>
+ *   This is called by the architecture code before switching from prev
+ *   to next, while still running in the context of prev.
+ * @param[in] prev tcb of current task
+ * @param[in] next tcb of next task which will be switched
+ * @return none
+ * @since TizenRT v3.1
+ */
+void ttrace_event_sched(struct tcb_s *prev, struct tcb_s *next);
+
+#define ttrace_sem_wait(s)    ttrace_event(TTRACE_TAG_LOCK, TTRACE_EVENT_SEM_WAIT, (uint32_t)(uintptr_t)(s))
+#define ttrace_sem_wake(s)    ttrace_event(TTRACE_TAG_LOCK, TTRACE_EVENT_SEM_WAKE, (uint32_t)(uintptr_t)(s))
+#define ttrace_sem_post(s)    ttrace_event(TTRACE_TAG_LOCK, TTRACE_EVENT_SEM_POST, (uint32_t)(uintptr_t)(s))
+#define ttrace_irq_enter(irq) ttrace_event(TTRACE_TAG_IRQ, TTRACE_EVENT_IRQ_ENTER, (uint32_t)(irq))
+#define ttrace_irq_leave(irq) ttrace_event(TTRACE_TAG_IRQ, TTRACE_EVENT_IRQ_LEAVE, (uint32_t)(irq))
+#else
+#define ttrace_event(a, b, c)
+#define ttrace_event_sched(a, b)
+#define ttrace_sem_wait(a)
+#define ttrace_sem_wake(a)
+#define ttrace_sem_post(a)
+#define ttrace_irq_enter(a)
+#define ttrace_irq_leave(a)
+#endif
 #else
 #define trace_begin(a, b, ...)
 #define trace_begin_uid(a, b)
 #define trace_end(a)
 #define trace_end_uid(a)
 #define trace_sched(a, b)
+#define ttrace_event(a, b, c)
+#define ttrace_event_sched(a, b)
+#define ttrace_sem_wait(a)
+#define ttrace_sem_wake(a)
+#define ttrace_sem_post(a)
+#define ttrace_irq_enter(a)
+#define ttrace_irq_leave(a)
 
 #if defined(__cplusplus)
 }
@@ -80,6 +80,8 @@
  *   (which runs at the lowest of priority and may not be appropriate
  *   if memory reclamation is of high priority).  If CONFIG_SCHED_HPWORK
  *   is enabled, then the following options can also be used:
+ * CONFIG_SCHED_HPNTHREADS - The number of thread in the high-priority
+ *   queue's thread pool.  Default: 1
  * CONFIG_SCHED_HPWORKPRIORITY - The execution priority of the high-
  *   priority worker thread.  Default: 224
  * CONFIG_SCHED_HPWORKSTACKSIZE - The stack size allocated for the worker
@@ -153,6 +155,10 @@
 
 #ifdef CONFIG_SCHED_HPWORK
 
+#ifndef CONFIG_SCHED_HPNTHREADS
+#define CONFIG_SCHED_HPNTHREADS 1
+#endif
+
 #ifndef CONFIG_SCHED_HPWORKPRIORITY
 #define CONFIG_SCHED_HPWORKPRIORITY 224
 #endif
@@ -275,7 +281,9 @@ typedef void (*worker_t)(FAR void *arg);
 
 /* Defines one entry in the work queue.  The user only needs this structure
  * in order to declare instances of the work structure.  Handling of all
- * fields is performed by the work APIs
+ * fields is performed by the work APIs.  The flags of a structure which
+ * was never queued are not trusted, but zero it before its first use so
+ * that work_available() is meaningful.
  */
 
 struct work_s {
@@ -284,6 +292,7 @@ struct work_s {
 	FAR void *arg;				/* Callback argument */
 	clock_t qtime;			/* Time work queued */
 	clock_t delay;			/* Delay until work performed */
+	uint8_t flags;			/* Queueing state, managed by the work queue */
 };
 
 /****************************************************************************
@@ -58,11 +58,13 @@
 
 #include <debug.h>
 #include <errno.h>
+#include <stdint.h>
 #include <string.h>
 #include <queue.h>
 #include <semaphore.h>
 #include <tinyara/kmalloc.h>
 #include <tinyara/mm/mm.h>
+#include <tinyara/mm/kmm_pool.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -74,11 +76,20 @@
 #define MSG_RECV_EXIST   0
 #define MSG_RECV_NOEXIST 1
 
+/* Port nodes are hashed by name into a fixed table of buckets. */
+#define MSG_PORT_HASH_SIZE CONFIG_MESSAGING_PORT_HASH_SIZE
+#define MSG_PORT_HASH_MASK (MSG_PORT_HASH_SIZE - 1)
+
+#if (MSG_PORT_HASH_SIZE & MSG_PORT_HASH_MASK) != 0
+#error "CONFIG_MESSAGING_PORT_HASH_SIZE must be a power of two"
+#endif
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
 struct msg_port_node_s {
 	struct msg_port_node_s *flink;
+	uint32_t hash;
 	char port_name[MSG_MAX_PORT_NAME];
 	pid_t sender_pid;
 	int nreceiver;
@@ -103,17 +114,53 @@ static sem_t port_list_sem;
 /****************************************************************************
  * Private Variables
  ****************************************************************************/
-static sq_queue_t g_port_node_list;
+static sq_queue_t g_port_hash[MSG_PORT_HASH_SIZE];
 static int curr_recv_cnt;;
+#ifdef CONFIG_MM_KMM_POOL
+static FAR struct kmm_pool_s *g_recv_node_pool;
+#endif
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+static uint32_t messaging_hash_name(const char *port_name)
+{
+	uint32_t hash = 2166136261u;
+
+	/* FNV-1a */
+	while (*port_name != '\0') {
+		hash ^= (uint8_t)*port_name++;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static msg_port_node_t *messaging_find_port(const char *port_name, uint32_t hash)
+{
+	msg_port_node_t *port_node;
+
+	/* Only the nodes of one bucket are visited and the name is compared only when the hash matches. */
+	port_node = (msg_port_node_t *)sq_peek(&g_port_hash[hash & MSG_PORT_HASH_MASK]);
+	while (port_node != NULL) {
+		if (port_node->hash == hash && strncmp(port_node->port_name, port_name, MSG_MAX_PORT_NAME) == 0) {
+			return port_node;
+		}
+		port_node = (msg_port_node_t *)sq_next(port_node);
+	}
+
+	return NULL;
+}
+
 static int messaging_append_receiver(pid_t pid, int prio, sq_queue_t *queue)
 {
 	msg_recv_node_t *recv_node;
 	msg_recv_node_t *prev_node;
 	msg_recv_node_t *next_node;
+#ifdef CONFIG_MM_KMM_POOL
+	recv_node = (msg_recv_node_t *)kmm_pool_alloc(g_recv_node_pool, sizeof(msg_recv_node_t));
+#else
 	recv_node = (msg_recv_node_t *)kmm_malloc(sizeof(msg_recv_node_t));
+#endif
 	if (recv_node == NULL) {
 		msgdbg("[Messaging] fail to save receiver info : out of memory.\n");
 		return ERROR;
@@ -190,23 +237,22 @@ static int messaging_check_recv_exist(int recv_pid, sq_queue_t *queue)
 int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio)
 {
 	int ret;
+	uint32_t hash;
 	msg_port_node_t *port_node;
 
-	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
-	while (port_node != NULL) {
-		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
-			ret = messaging_check_recv_exist(recv_pid, &port_node->recv_node_list);
-			if (ret == MSG_RECV_EXIST) {
-				return OK;
-			}
-			port_node->nreceiver++;
-			/* There was already same port node in the list, append recv node to this list. */
-			sem_wait(&port_node->port_sem);
-			ret = messaging_append_receiver(recv_pid, recv_prio, &port_node->recv_node_list);
-			sem_post(&port_node->port_sem);
-			return ret;
+	hash = messaging_hash_name(port_name);
+	port_node = messaging_find_port(port_name, hash);
+	if (port_node != NULL) {
+		ret = messaging_check_recv_exist(recv_pid, &port_node->recv_node_list);
+		if (ret == MSG_RECV_EXIST) {
+			return OK;
 		}
-		port_node = (msg_port_node_t *)sq_next(port_node);
+		port_node->nreceiver++;
+		/* There was already same port node in the list, append recv node to this list. */
+		sem_wait(&port_node->port_sem);
+		ret = messaging_append_receiver(recv_pid, recv_prio, &port_node->recv_node_list);
+		sem_post(&port_node->port_sem);
+		return ret;
 	}
 
 	/* Create new port node which has this port name */
@@ -218,12 +264,13 @@ int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio)
 
 	/* Fill the port node information except sender_pid. */
 	strncpy(port_node->port_name, port_name, strlen(port_name) + 1);
+	port_node->hash = hash;
 	port_node->sender_pid = MSG_SENDER_UNDEFINED;
 	port_node->nreceiver = 1;
 	sem_init(&port_node->port_sem, 0, 1);
 	sq_init(&port_node->recv_node_list);
 	sem_wait(&port_list_sem);
-	sq_addlast((FAR sq_entry_t *)port_node, &g_port_node_list);
+	sq_addlast((FAR sq_entry_t *)port_node, &g_port_hash[hash & MSG_PORT_HASH_MASK]);
 	sem_post(&port_list_sem);
 
 	/* Append recv node to new created port node. */
@@ -257,42 +304,39 @@ int messaging_read_list(char *port_name, int *recv_arr, int *total_cnt)
 	msg_recv_node_t *recv_node;
 	int recv_cnt;
 
-	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
-	while (port_node != NULL) {
-		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
-			if (port_node->nreceiver > 0) {
-				*total_cnt = port_node->nreceiver;
-
-				recv_node = (msg_recv_node_t *)sq_peek(&port_node->recv_node_list);
-				if (recv_node == NULL) {
-					curr_recv_cnt = 0;
-					msgdbg("[Messaging] fail to read receivers list.\n");
-					return ERROR;
-				}
-
-				/* Ignore already read information. */
-				for (recv_idx = 0; recv_idx < curr_recv_cnt; recv_idx++) {
-					recv_node = (msg_recv_node_t *)sq_next(recv_node);
-				}
-
-				/* Read receivers' information. */
-				for (recv_idx = 0; recv_idx < CONFIG_MESSAGING_RECV_LIST_SIZE; recv_idx++) {
-					recv_arr[recv_idx] = recv_node->pid;
-					curr_recv_cnt++;
-					recv_node = (msg_recv_node_t *)sq_next(recv_node);
-					if (recv_node == NULL) {
-						recv_cnt = curr_recv_cnt;
-						curr_recv_cnt = 0;
-						return recv_cnt;
-					}
-				}
+	port_node = messaging_find_port(port_name, messaging_hash_name(port_name));
+	if (port_node == NULL) {
+		return ERROR;
+	}
+
+	if (port_node->nreceiver > 0) {
+		*total_cnt = port_node->nreceiver;
+
+		recv_node = (msg_recv_node_t *)sq_peek(&port_node->recv_node_list);
+		if (recv_node == NULL) {
+			curr_recv_cnt = 0;
+			msgdbg("[Messaging] fail to read receivers list.\n");
+			return ERROR;
+		}
+
+		/* Ignore already read information. */
+		for (recv_idx = 0; recv_idx < curr_recv_cnt; recv_idx++) {
+			recv_node = (msg_recv_node_t *)sq_next(recv_node);
+		}
+
+		/* Read receivers' information. */
+		for (recv_idx = 0; recv_idx < CONFIG_MESSAGING_RECV_LIST_SIZE; recv_idx++) {
+			recv_arr[recv_idx] = recv_node->pid;
+			curr_recv_cnt++;
+			recv_node = (msg_recv_node_t *)sq_next(recv_node);
+			if (recv_node == NULL) {
+				recv_cnt = curr_recv_cnt;
+				curr_recv_cnt = 0;
+				return recv_cnt;
 			}
-			return curr_recv_cnt;
 		}
-		port_node = (msg_port_node_t *)sq_next(port_node);
 	}
-
-	return ERROR;
+	return curr_recv_cnt;
 }
 
 /****************************************************************************
@@ -319,7 +363,13 @@ static int messaging_remove_recv_node(sq_queue_t *recv_node_list)
 	while (recv_node != NULL) {
 		if (recv_node->pid == my_pid) {
 			sq_rem((sq_entry_t *)recv_node, recv_node_list);
+#ifdef CONFIG_MM_KMM_POOL
+			if (!kmm_pool_free(g_recv_node_pool, recv_node)) {
+				kmm_free(recv_node);
+			}
+#else
 			kmm_free(recv_node);
+#endif
 			return OK;
 		}
 		recv_node = (msg_recv_node_t *)sq_next(recv_node);
@@ -344,38 +394,33 @@ static int messaging_remove_recv_node(sq_queue_t *recv_node_list)
  ****************************************************************************/
 int messaging_remove_list(char *port_name)
 {
-	int ret = ERROR;
+	int ret;
+	uint32_t hash;
 	msg_port_node_t *port_node;
 
-	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
-	while (port_node != NULL) {
-		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
-			/* Remove the whole recv node which attached to this port node. */
-			sem_wait(&port_node->port_sem);
-			ret = messaging_remove_recv_node(&port_node->recv_node_list);
-			if (ret == OK) {
-				port_node->nreceiver--;
-			}
-			sem_post(&port_node->port_sem);
+	hash = messaging_hash_name(port_name);
+	port_node = messaging_find_port(port_name, hash);
+	if (port_node == NULL) {
+		/* If port_node is NULL, there is no information for removing. */
+		return OK;
+	}
 
-			if (port_node->nreceiver == 0) {
-				sem_wait(&port_list_sem);
-				(void)sq_rem((FAR sq_entry_t *)port_node, &g_port_node_list);
-				sem_post(&port_list_sem);
-				kmm_free(port_node);
-			}
-			ret = OK;
-			break;
-		}
-		port_node = (msg_port_node_t *)sq_next(port_node);
+	/* Remove the whole recv node which attached to this port node. */
+	sem_wait(&port_node->port_sem);
+	ret = messaging_remove_recv_node(&port_node->recv_node_list);
+	if (ret == OK) {
+		port_node->nreceiver--;
 	}
+	sem_post(&port_node->port_sem);
 
-	if (port_node == NULL) {
-		/* If port_node is NULL, there is no information for removing. */
-		ret = OK;
+	if (port_node->nreceiver == 0) {
+		sem_wait(&port_list_sem);
+		(void)sq_rem((FAR sq_entry_t *)port_node, &g_port_hash[hash & MSG_PORT_HASH_MASK]);
+		sem_post(&port_list_sem);
+		kmm_free(port_node);
 	}
 
-	return ret;
+	return OK;
 }
 
 void messaging_initialize(void)
@@ -383,4 +428,10 @@ void messaging_initialize(void)
 	/* Initialize a sempahore for port list */
 
 	sem_init(&port_list_sem, 0, 1);
+
+#ifdef CONFIG_MM_KMM_POOL
+	/* Receiver nodes come from a fixed-size pool */
+
+	g_recv_node_pool = kmm_pool_create("msgrecv", sizeof(msg_recv_node_t), CONFIG_MM_KMM_POOL_NMSGRECV);
+#endif
 }
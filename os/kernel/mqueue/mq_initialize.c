@@ -101,6 +101,12 @@ sq_queue_t g_msgfreeirq;
 
 sq_queue_t g_desfree;
 
+#ifdef CONFIG_MM_KMM_POOL
+/* Pool serving messages once the pre-allocated ones are in use */
+
+FAR struct kmm_pool_s *g_msgpool;
+#endif
+
 /************************************************************************
  * Private Variables
  ************************************************************************/
@@ -197,6 +203,12 @@ void mq_initialize(void)
 
 	g_msgfreeirqalloc = mq_msgblockalloc(&g_msgfreeirq, NUM_INTERRUPT_MSGS, MQ_ALLOC_IRQ);
 
+#ifdef CONFIG_MM_KMM_POOL
+	/* Messages allocated beyond the pre-allocated blocks come from a pool */
+
+	g_msgpool = kmm_pool_create("mqmsg", sizeof(struct mqueue_msg_s), CONFIG_MM_KMM_POOL_NMQMSGS);
+#endif
+
 	/* Allocate a block of message queue descriptors */
 
 	mq_desblockalloc();
@@ -141,7 +141,13 @@ void mq_msgfree(FAR struct mqueue_msg_s *mqmsg)
 	 */
 
 	else if (mqmsg->type == MQ_ALLOC_DYN) {
+#ifdef CONFIG_MM_KMM_POOL
+		if (!kmm_pool_free(g_msgpool, mqmsg)) {
+			sched_kfree(mqmsg);
+		}
+#else
 		sched_kfree(mqmsg);
+#endif
 	} else {
 		PANIC();
 	}
@@ -211,7 +211,11 @@ FAR struct mqueue_msg_s *mq_msgalloc(void)
 		/* If we cannot a message from the free list, then we will have to allocate one. */
 
 		if (!mqmsg) {
+#ifdef CONFIG_MM_KMM_POOL
+			mqmsg = (FAR struct mqueue_msg_s *)kmm_pool_alloc(g_msgpool, sizeof(struct mqueue_msg_s));
+#else
 			mqmsg = (FAR struct mqueue_msg_s *)kmm_malloc((sizeof(struct mqueue_msg_s)));
+#endif
 
 			/* Check if we got an allocated message */
 
@@ -69,6 +69,7 @@
 #include <signal.h>
 
 #include <tinyara/mqueue.h>
+#include <tinyara/mm/kmm_pool.h>
 
 #if !defined(CONFIG_DISABLE_MQUEUE) && CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -146,6 +147,12 @@ EXTERN sq_queue_t g_msgfreeirq;
 
 EXTERN sq_queue_t g_desfree;
 
+#ifdef CONFIG_MM_KMM_POOL
+/* Pool serving messages once the pre-allocated ones are in use */
+
+EXTERN FAR struct kmm_pool_s *g_msgpool;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -62,6 +62,7 @@
 #include <sched.h>
 #include <tinyara/arch.h>
 #include <tinyara/sched.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -182,6 +183,7 @@ int sem_post(FAR sem_t *sem)
 #endif
 				/* Restart the waiting task. */
 
+				ttrace_sem_post(sem);
 				up_unblock_task(stcb);
 			}
 		}
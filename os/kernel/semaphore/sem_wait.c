@@ -62,6 +62,7 @@
 #include <assert.h>
 #include <tinyara/arch.h>
 #include <tinyara/cancelpt.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -213,7 +214,9 @@ int sem_wait(FAR sem_t *sem)
 			/* Add the TCB to the prioritized semaphore wait queue */
 
 			set_errno(0);
+			ttrace_sem_wait(sem);
 			up_block_task(rtcb, TSTATE_WAIT_SEM);
+			ttrace_sem_wake(sem);
 
 			/* When we resume at this point, either (1) the semaphore has been
 			 * assigned to this thread of execution, or (2) the semaphore wait
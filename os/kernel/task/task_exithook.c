@@ -653,4 +653,13 @@ void task_exithook(FAR struct tcb_s *tcb, int status, bool nonblocking)
 	 */
 
 	tcb->flags |= TCB_FLAG_EXIT_PROCESSING;
+
+#ifdef CONFIG_MM_TCACHE
+	/* Return the chunks held in the small-object cache of the task to the
+	 * heap.  The flag set above keeps the task from caching chunks again,
+	 * and the drain never blocks, so this is done for nonblocking exits too.
+	 */
+
+	umm_tcache_drain(tcb);
+#endif
 }
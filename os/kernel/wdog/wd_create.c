@@ -157,7 +157,11 @@ WDOG_ID wd_create(void)
 		/* We do not require that interrupts be disabled to do this. */
 
 		irqrestore(state);
+#ifdef CONFIG_MM_KMM_POOL
+		wdog = (FAR struct wdog_s *)kmm_pool_alloc(g_wdobjpool, sizeof(struct wdog_s));
+#else
 		wdog = (FAR struct wdog_s *)kmm_malloc(sizeof(struct wdog_s));
+#endif
 
 		/* Did we get one? */
 
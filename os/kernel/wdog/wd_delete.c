@@ -135,8 +135,9 @@ int wd_delete(WDOG_ID wdog)
 	 */
 
 	if (WDOG_ISALLOCED(wdog)) {
-		/* It was allocated from the heap.  Use sched_kfree() to release the
-		 * memory.  If the timer was released from an interrupt handler,
+		/* It was allocated dynamically.  Pool objects can be returned even
+		 * from an interrupt handler.  Otherwise use sched_kfree() to release
+		 * the memory.  If the timer was released from an interrupt handler,
 		 * sched_kfree() will defer the actual deallocation of the memory
 		 * until a more appropriate time.
 		 *
@@ -144,7 +145,13 @@ int wd_delete(WDOG_ID wdog)
 		 */
 
 		irqrestore(state);
+#ifdef CONFIG_MM_KMM_POOL
+		if (!kmm_pool_free(g_wdobjpool, wdog)) {
+			sched_kfree(wdog);
+		}
+#else
 		sched_kfree(wdog);
+#endif
 	}
 
 	/* This was a pre-allocated timer.  This function should not be called for
@@ -92,6 +92,12 @@ sq_queue_t g_wdactivelist;
 
 uint16_t g_wdnfree;
 
+#ifdef CONFIG_MM_KMM_POOL
+/* Pool serving watchdogs once the pre-allocated ones are in use */
+
+FAR struct kmm_pool_s *g_wdobjpool;
+#endif
+
 /************************************************************************
  * Private Data
  ************************************************************************/
@@ -150,4 +156,10 @@ void wd_initialize(void)
 	/* All watchdogs are free */
 
 	g_wdnfree = CONFIG_PREALLOC_WDOGS;
+
+#ifdef CONFIG_MM_KMM_POOL
+	/* Dynamically created watchdogs come from a fixed-size pool */
+
+	g_wdobjpool = kmm_pool_create("wdog", sizeof(struct wdog_s), CONFIG_MM_KMM_POOL_NWDOGS);
+#endif
 }
@@ -64,6 +64,7 @@
 
 #include <tinyara/compiler.h>
 #include <tinyara/wdog.h>
+#include <tinyara/mm/kmm_pool.h>
 
 /************************************************************************
  * Pre-processor Definitions
@@ -104,6 +105,12 @@ extern sq_queue_t g_wdactivelist;
 
 extern uint16_t g_wdnfree;
 
+#ifdef CONFIG_MM_KMM_POOL
+/* Pool serving watchdogs once the pre-allocated ones are in use */
+
+extern FAR struct kmm_pool_s *g_wdobjpool;
+#endif
+
 /************************************************************************
  * Public Function Prototypes
  ************************************************************************/
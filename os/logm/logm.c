@@ -19,6 +19,7 @@
 #include <tinyara/config.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 #include <unistd.h>
 #ifdef CONFIG_ARCH_LOWPUTC
 #include <sched.h>
@@ -56,11 +57,20 @@ static void logm_outstream(FAR struct lib_outstream_s *outstream)
 #ifdef CONFIG_ARCH_LOWPUTC
 static void logm_flush(struct lib_outstream_s *stream)
 {
+#ifdef CONFIG_LOGM_BINARY
+	int len;
+#endif
+
 	sched_lock();
 
 	while (g_logm_head != g_logm_tail) {
+#ifdef CONFIG_LOGM_BINARY
+		len = logm_binary_print(stream, g_logm_head);
+		g_logm_head = (g_logm_head + len) % logm_bufsize;
+#else
 		stream->put(stream, g_logm_rsvbuf[g_logm_head]);
 		g_logm_head = (g_logm_head + 1) % logm_bufsize;
+#endif
 	}
 
 	if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
@@ -80,13 +90,54 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 	irqstate_t flags;
 	int ret = 0;
 	struct lib_outstream_s strm;
-#ifdef CONFIG_LOGM_TIMESTAMP
+#if !defined(CONFIG_LOGM_BINARY) && defined(CONFIG_LOGM_TIMESTAMP)
 	struct timespec ts;
 #endif
 
 	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) \
 		&& flag == LOGM_NORMAL && !up_interrupt_context()) {
 
+#ifdef CONFIG_LOGM_BINARY
+		/* The record lives only in this branch, so the interrupt and
+		 * lowputc paths below don't pay for it on their stack.
+		 */
+		uint8_t rec[LOGM_BIN_RECSIZE];
+		int count;
+
+		/* Only copy the arguments, the logm task formats the message later.
+		 * The record is built before disabling interrupts, which then stay
+		 * disabled only for copying it into the buffer.
+		 */
+		ret = logm_binary_pack(rec, fmt, ap);
+
+		flags = irqsave();
+
+		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
+			g_logm_dropmsg_count++;
+			irqrestore(flags);
+			return 0;
+		}
+
+		if ((g_logm_head - g_logm_tail - 1 + logm_bufsize) % logm_bufsize < ret) {
+			LOGM_STATUS_SET(LOGM_BUFFER_OVERFLOW);
+			g_logm_dropmsg_count = 1;
+			g_logm_overflow_offset = g_logm_tail;
+			irqrestore(flags);
+			return 0;
+		}
+
+		count = logm_bufsize - g_logm_tail;
+		if (count > ret) {
+			count = ret;
+		}
+
+		memcpy(&g_logm_rsvbuf[g_logm_tail], rec, count);
+		memcpy(g_logm_rsvbuf, &rec[count], ret - count);
+		g_logm_tail = (g_logm_tail + ret) % logm_bufsize;
+
+		irqrestore(flags);
+		return ret;
+#else
 		flags = irqsave();
 
 		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
@@ -114,11 +165,22 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 			g_logm_overflow_offset = g_logm_tail;
 		}
 		irqrestore(flags);
+#endif
 	} else {
 		/* Low Output: Sytem is not yet completely ready or this is called from interrupt handler */
 #ifdef CONFIG_ARCH_LOWPUTC
 		lib_lowoutstream(&strm);
+#ifdef CONFIG_LOGM_BINARY
+		/* Formatting the binary backlog needs a large stack and lib_sprintf,
+		 * so an interrupt handler only prints its own message and leaves
+		 * the buffered records to the logm task.
+		 */
+		if (!up_interrupt_context()) {
+			logm_flush(&strm);
+		}
+#else
 		logm_flush(&strm);
+#endif
 		ret = lib_vsprintf(&strm, fmt, ap);
 #endif
 	}
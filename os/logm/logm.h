@@ -20,6 +20,10 @@
 
 #include <tinyara/config.h>
 #include <stdint.h>
+#include <stdarg.h>
+#ifdef CONFIG_LOGM_BINARY
+#include <tinyara/streams.h>
+#endif
 
 /****************************************************************************
  * Preprocessor Definitions
@@ -47,6 +51,14 @@
 #define LOGM_BUFFER_RESIZE_REQ BIT(1)
 #define LOGM_BUFFER_OVERFLOW BIT(2)
 
+#ifdef CONFIG_LOGM_BINARY_RECSIZE
+#define LOGM_BIN_RECSIZE CONFIG_LOGM_BINARY_RECSIZE
+#else
+#define LOGM_BIN_RECSIZE (128)
+#endif
+
+#define LOGM_BIN_MAGIC (0xA5)
+
 #define LOGM_STATUS(a) (logm_status & (a))
 #define LOGM_STATUS_SET(a) (logm_status |= (a))
 #define LOGM_STATUS_CLEAR(a) (logm_status &= ~(a))
@@ -57,6 +69,23 @@
 
 /* Structure for a single debug message */
 
+#ifdef CONFIG_LOGM_BINARY
+/* Header of a binary log record.  It is followed by the raw arguments of
+ * the message in the order the format string consumes them: integers and
+ * floating point values as stored in memory, strings as a length byte
+ * followed by the characters.  tools/logm/logm_decoder.py relies on this
+ * layout.
+ */
+
+struct logm_binhdr_s {
+	uint8_t magic;				/* LOGM_BIN_MAGIC, to resynchronize on raw dumps */
+	uint8_t nconv;				/* Number of conversions with stored arguments */
+	uint16_t len;				/* Length of the record including this header */
+	uintptr_t fmt;				/* Address of the format string */
+	uint32_t ticks;				/* System timer when the message was logged */
+};
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
@@ -80,6 +109,11 @@ EXTERN volatile int logm_print_interval;
  ************************************************************************************/
 int logm_task(int argc, char *argv[]);
 void logm_register_tashcmds(void);
+#ifdef CONFIG_LOGM_BINARY
+int logm_binary_pack(FAR uint8_t *rec, FAR const char *fmt, va_list ap);
+void logm_binary_ringread(FAR uint8_t *dest, int offset, int len);
+int logm_binary_print(FAR struct lib_outstream_s *stream, int head);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -0,0 +1,429 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <tinyara/clock.h>
+#include <tinyara/streams.h>
+#include "logm.h"
+
+/* Types of the argument consumed by a conversion specification */
+
+enum logm_argtype_e {
+	LOGM_ARG_NONE,				/* "%%" or unknown conversion, no argument */
+	LOGM_ARG_INT,
+	LOGM_ARG_LONG,
+	LOGM_ARG_LLONG,
+	LOGM_ARG_SIZE,
+	LOGM_ARG_INTMAX,
+	LOGM_ARG_PTRDIFF,
+	LOGM_ARG_DOUBLE,
+	LOGM_ARG_LDOUBLE,
+	LOGM_ARG_PTR,
+	LOGM_ARG_STRING,
+	LOGM_ARG_COUNT				/* "%n", the pointer is stored but not used */
+};
+
+#define LOGM_SPEC_MAX 24
+
+/* Parse the conversion specification following a '%'.  Returns a pointer
+ * past the conversion character, the number of '*' width and precision
+ * arguments and the type of the argument converted.
+ */
+static FAR const char *logm_parsespec(FAR const char *p, FAR int *nstars, FAR int *type)
+{
+	int lenmod = 0;
+
+	*nstars = 0;
+
+	/* Flags */
+	while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+		p++;
+	}
+
+	/* Field width */
+	if (*p == '*') {
+		(*nstars)++;
+		p++;
+	} else {
+		while (*p >= '0' && *p <= '9') {
+			p++;
+		}
+	}
+
+	/* Precision */
+	if (*p == '.') {
+		p++;
+		if (*p == '*') {
+			(*nstars)++;
+			p++;
+		} else {
+			while (*p >= '0' && *p <= '9') {
+				p++;
+			}
+		}
+	}
+
+	/* Length modifier */
+	switch (*p) {
+	case 'h':
+		p++;
+		if (*p == 'h') {
+			p++;
+		}
+		break;
+	case 'l':
+		p++;
+		lenmod = 'l';
+		if (*p == 'l') {
+			p++;
+			lenmod = 'q';
+		}
+		break;
+	case 'z':
+	case 'j':
+	case 't':
+	case 'L':
+		lenmod = *p++;
+		break;
+	default:
+		break;
+	}
+
+	/* Conversion */
+	switch (*p) {
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'x':
+	case 'X':
+	case 'o':
+	case 'c':
+		*type = lenmod == 'l' ? LOGM_ARG_LONG :
+				lenmod == 'q' ? LOGM_ARG_LLONG :
+				lenmod == 'z' ? LOGM_ARG_SIZE :
+				lenmod == 'j' ? LOGM_ARG_INTMAX :
+				lenmod == 't' ? LOGM_ARG_PTRDIFF : LOGM_ARG_INT;
+		break;
+	case 'e':
+	case 'E':
+	case 'f':
+	case 'F':
+	case 'g':
+	case 'G':
+	case 'a':
+	case 'A':
+		*type = lenmod == 'L' ? LOGM_ARG_LDOUBLE : LOGM_ARG_DOUBLE;
+		break;
+	case 'p':
+		*type = LOGM_ARG_PTR;
+		break;
+	case 's':
+		*type = LOGM_ARG_STRING;
+		break;
+	case 'n':
+		*type = LOGM_ARG_COUNT;
+		break;
+	case '\0':
+		*type = LOGM_ARG_NONE;
+		return p;
+	default:
+		*type = LOGM_ARG_NONE;
+		break;
+	}
+
+	return p + 1;
+}
+
+/* Size of a stored argument, strings excepted */
+static int logm_argsize(int type)
+{
+	switch (type) {
+	case LOGM_ARG_INT:
+		return sizeof(int);
+	case LOGM_ARG_LONG:
+		return sizeof(long);
+	case LOGM_ARG_LLONG:
+		return sizeof(long long);
+	case LOGM_ARG_SIZE:
+		return sizeof(size_t);
+	case LOGM_ARG_INTMAX:
+		return sizeof(intmax_t);
+	case LOGM_ARG_PTRDIFF:
+		return sizeof(ptrdiff_t);
+	case LOGM_ARG_DOUBLE:
+		return sizeof(double);
+	case LOGM_ARG_LDOUBLE:
+		return sizeof(long double);
+	case LOGM_ARG_PTR:
+	case LOGM_ARG_COUNT:
+		return sizeof(FAR void *);
+	default:
+		return 0;
+	}
+}
+
+/* Pack one argument of 'type' from 'ap' at 'dest' */
+#define LOGM_PACK(dest, ap, ctype) \
+	do { \
+		ctype v = va_arg(ap, ctype); \
+		memcpy(dest, &v, sizeof(ctype)); \
+	} while (0)
+
+/* Offset in the logm buffer of byte 'offset' of the record at 'head' */
+#define LOGM_RINGPOS(head, offset) (((head) + (offset)) % logm_bufsize)
+
+/* Print one argument of 'type' stored at 'pos' of the logm buffer with
+ * conversion 'spec'
+ */
+#define LOGM_PRINT(stream, spec, pos, ctype) \
+	do { \
+		ctype v; \
+		logm_binary_ringread((FAR uint8_t *)&v, pos, sizeof(ctype)); \
+		(void)lib_sprintf(stream, spec, v); \
+	} while (0)
+
+/* logm_binary_pack: build the binary record of a message in 'rec', which
+ * holds LOGM_BIN_RECSIZE bytes.  Only the arguments are copied, the text is
+ * formatted later by logm_binary_print().  Strings are copied as they may
+ * not live until then.  Arguments which do not fit are dropped.  Returns
+ * the length of the record.
+ */
+int logm_binary_pack(FAR uint8_t *rec, FAR const char *fmt, va_list ap)
+{
+	struct logm_binhdr_s hdr;
+	FAR const char *p = fmt;
+	FAR const char *str;
+	int len = sizeof(struct logm_binhdr_s);
+	int nconv = 0;
+	int nstars;
+	int type;
+	int size;
+	int i;
+
+	while (*p != '\0') {
+		if (*p++ != '%') {
+			continue;
+		}
+
+		p = logm_parsespec(p, &nstars, &type);
+		if (type == LOGM_ARG_NONE) {
+			continue;
+		}
+
+		size = nstars * sizeof(int) + (type == LOGM_ARG_STRING ? 1 : logm_argsize(type));
+		if (len + size > LOGM_BIN_RECSIZE || nconv == UINT8_MAX) {
+			break;
+		}
+
+		for (i = 0; i < nstars; i++) {
+			LOGM_PACK(&rec[len], ap, int);
+			len += sizeof(int);
+		}
+
+		switch (type) {
+		case LOGM_ARG_INT:
+			LOGM_PACK(&rec[len], ap, int);
+			break;
+		case LOGM_ARG_LONG:
+			LOGM_PACK(&rec[len], ap, long);
+			break;
+		case LOGM_ARG_LLONG:
+			LOGM_PACK(&rec[len], ap, long long);
+			break;
+		case LOGM_ARG_SIZE:
+			LOGM_PACK(&rec[len], ap, size_t);
+			break;
+		case LOGM_ARG_INTMAX:
+			LOGM_PACK(&rec[len], ap, intmax_t);
+			break;
+		case LOGM_ARG_PTRDIFF:
+			LOGM_PACK(&rec[len], ap, ptrdiff_t);
+			break;
+		case LOGM_ARG_DOUBLE:
+			LOGM_PACK(&rec[len], ap, double);
+			break;
+		case LOGM_ARG_LDOUBLE:
+			LOGM_PACK(&rec[len], ap, long double);
+			break;
+		case LOGM_ARG_PTR:
+		case LOGM_ARG_COUNT:
+			LOGM_PACK(&rec[len], ap, FAR void *);
+			break;
+		case LOGM_ARG_STRING:
+			str = va_arg(ap, FAR const char *);
+			if (str == NULL) {
+				str = "(null)";
+			}
+
+			size = strnlen(str, UINT8_MAX);
+			if (len + 1 + size > LOGM_BIN_RECSIZE) {
+				size = LOGM_BIN_RECSIZE - len - 1;
+			}
+
+			rec[len] = (uint8_t)size;
+			memcpy(&rec[len + 1], str, size);
+			break;
+		}
+
+		len += type == LOGM_ARG_STRING ? 1 + rec[len] : logm_argsize(type);
+		nconv++;
+	}
+
+	hdr.magic = LOGM_BIN_MAGIC;
+	hdr.nconv = nconv;
+	hdr.len = len;
+	hdr.fmt = (uintptr_t)fmt;
+	hdr.ticks = (uint32_t)clock_systimer();
+	memcpy(rec, &hdr, sizeof(struct logm_binhdr_s));
+
+	return len;
+}
+
+/* logm_binary_ringread: copy 'len' bytes at 'offset' of the logm buffer */
+void logm_binary_ringread(FAR uint8_t *dest, int offset, int len)
+{
+	int count = logm_bufsize - offset;
+
+	if (count > len) {
+		count = len;
+	}
+
+	memcpy(dest, &g_logm_rsvbuf[offset], count);
+	memcpy(&dest[count], g_logm_rsvbuf, len - count);
+}
+
+/* logm_binary_print: format the binary record at offset 'head' of the logm
+ * buffer to 'stream'.  The arguments are read in place, a record which wraps
+ * around the end of the buffer is not copied out first.  Returns the length
+ * of the record.
+ */
+int logm_binary_print(FAR struct lib_outstream_s *stream, int head)
+{
+	struct logm_binhdr_s hdr;
+	FAR const char *p;
+	FAR const char *start;
+	char spec[LOGM_SPEC_MAX];
+	char str[LOGM_BIN_RECSIZE];
+	int offset = sizeof(struct logm_binhdr_s);
+	int nconv;
+	int nstars;
+	int star;
+	int type;
+	int size;
+	int n;
+
+	logm_binary_ringread((FAR uint8_t *)&hdr, head, sizeof(struct logm_binhdr_s));
+
+#ifdef CONFIG_LOGM_TIMESTAMP
+	(void)lib_sprintf(stream, "[%4d.%4d] ", (int)(hdr.ticks / TICK_PER_SEC), (int)((hdr.ticks % TICK_PER_SEC) * 10000 / TICK_PER_SEC));
+#endif
+
+	p = (FAR const char *)hdr.fmt;
+	for (nconv = 0; *p != '\0';) {
+		if (*p != '%') {
+			stream->put(stream, *p++);
+			continue;
+		}
+
+		start = p++;
+		p = logm_parsespec(p, &nstars, &type);
+		if (type == LOGM_ARG_NONE) {
+			/* "%%" prints a '%', an unknown conversion prints itself */
+			if (p - start == 2 && start[1] == '%') {
+				stream->put(stream, '%');
+			} else {
+				while (start < p) {
+					stream->put(stream, *start++);
+				}
+			}
+			continue;
+		}
+
+		if (nconv++ == hdr.nconv) {
+			/* The record was truncated here */
+			(void)lib_sprintf(stream, "...\n");
+			return hdr.len;
+		}
+
+		/* Rebuild the specification with '*' replaced by the stored value */
+		for (n = 0; start < p && n < LOGM_SPEC_MAX - 12; start++) {
+			if (*start != '*') {
+				spec[n++] = *start;
+				continue;
+			}
+
+			logm_binary_ringread((FAR uint8_t *)&star, LOGM_RINGPOS(head, offset), sizeof(int));
+			offset += sizeof(int);
+			n += snprintf(&spec[n], 12, "%d", star);
+		}
+
+		spec[n] = '\0';
+		if (start < p) {
+			/* Too long to rebuild, skip it */
+			offset += type == LOGM_ARG_STRING ? 1 + (uint8_t)g_logm_rsvbuf[LOGM_RINGPOS(head, offset)] : logm_argsize(type);
+			continue;
+		}
+
+		switch (type) {
+		case LOGM_ARG_INT:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), int);
+			break;
+		case LOGM_ARG_LONG:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), long);
+			break;
+		case LOGM_ARG_LLONG:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), long long);
+			break;
+		case LOGM_ARG_SIZE:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), size_t);
+			break;
+		case LOGM_ARG_INTMAX:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), intmax_t);
+			break;
+		case LOGM_ARG_PTRDIFF:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), ptrdiff_t);
+			break;
+		case LOGM_ARG_DOUBLE:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), double);
+			break;
+		case LOGM_ARG_LDOUBLE:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), long double);
+			break;
+		case LOGM_ARG_PTR:
+			LOGM_PRINT(stream, spec, LOGM_RINGPOS(head, offset), FAR void *);
+			break;
+		case LOGM_ARG_STRING:
+			size = (uint8_t)g_logm_rsvbuf[LOGM_RINGPOS(head, offset)];
+			logm_binary_ringread((FAR uint8_t *)str, LOGM_RINGPOS(head, offset + 1), size);
+			str[size] = '\0';
+			(void)lib_sprintf(stream, spec, str);
+			break;
+		default:
+			break;
+		}
+
+		offset += type == LOGM_ARG_STRING ? 1 + size : logm_argsize(type);
+	}
+
+	return hdr.len;
+}
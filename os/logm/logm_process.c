@@ -65,6 +65,12 @@ static int logm_change_bufsize(int buflen)
 int logm_task(int argc, char *argv[])
 {
 	irqstate_t flags;
+#ifdef CONFIG_LOGM_BINARY
+	struct lib_stdoutstream_s strm;
+	int len;
+
+	lib_stdoutstream(&strm, stdout);
+#endif
 
 	g_logm_rsvbuf = (char *)malloc(logm_bufsize);
 	memset(g_logm_rsvbuf, 0, logm_bufsize);
@@ -78,8 +84,14 @@ int logm_task(int argc, char *argv[])
 
 	while (1) {
 		while (g_logm_head != g_logm_tail) {
+#ifdef CONFIG_LOGM_BINARY
+			/* Format one message, records are added whole to the buffer */
+			len = logm_binary_print(&strm.public, g_logm_head);
+			g_logm_head = (g_logm_head + len) % logm_bufsize;
+#else
 			fputc(g_logm_rsvbuf[g_logm_head], stdout);
 			g_logm_head = (g_logm_head + 1) % logm_bufsize;
+#endif
 			if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
 				LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
 			}
@@ -136,7 +136,7 @@ static inline FAR void *gran_common_alloc(FAR struct gran_s *priv, size_t size)
 
 			/* Get the next entry from the GAT to support a 64 bit shift */
 
-			if (granidx < priv->ngranules) {
+			if (granidx + 32 < priv->ngranules) {
 				next = priv->gat[gatidx + 1];
 			}
 
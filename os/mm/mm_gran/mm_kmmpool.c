@@ -0,0 +1,196 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_gran/mm_kmmpool.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <arch/irq.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/mm/gran.h>
+#include <tinyara/mm/kmm_pool.h>
+
+#ifdef CONFIG_MM_KMM_POOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Objects are at least 8 bytes and aligned to 8 bytes so that any kernel
+ * structure can be placed in a pool.
+ */
+
+#define KMM_POOL_LOG2ALIGN 3
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+FAR struct kmm_pool_s *g_kmm_pools;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_pool_create
+ *
+ * Description:
+ *   Create a pool of nobjs objects of objsize bytes each.
+ *
+ ****************************************************************************/
+
+FAR struct kmm_pool_s *kmm_pool_create(FAR const char *name, size_t objsize, unsigned int nobjs)
+{
+	FAR struct kmm_pool_s *pool;
+	FAR void *region;
+	size_t regionsize;
+	irqstate_t flags;
+	uint8_t log2gran;
+
+	DEBUGASSERT(name != NULL && objsize > 0 && objsize <= UINT16_MAX);
+
+	if (nobjs == 0 || nobjs > UINT16_MAX) {
+		return NULL;
+	}
+
+	/* Each object gets one granule, the smallest power of two holding it */
+
+	log2gran = KMM_POOL_LOG2ALIGN;
+	while (((size_t)1 << log2gran) < objsize) {
+		log2gran++;
+	}
+
+	/* Leave room to align the start of the region to KMM_POOL_LOG2ALIGN */
+
+	regionsize = ((size_t)nobjs << log2gran) + (1 << KMM_POOL_LOG2ALIGN) - 1;
+
+	pool = (FAR struct kmm_pool_s *)kmm_zalloc(sizeof(struct kmm_pool_s));
+	if (pool == NULL) {
+		return NULL;
+	}
+
+	region = kmm_malloc(regionsize);
+	if (region == NULL) {
+		goto errout_with_pool;
+	}
+
+	pool->handle = gran_initialize(region, regionsize, log2gran, KMM_POOL_LOG2ALIGN);
+	if (pool->handle == NULL) {
+		goto errout_with_region;
+	}
+
+	strncpy(pool->name, name, KMM_POOL_NAMELEN - 1);
+	pool->start    = (uintptr_t)region;
+	pool->end      = (uintptr_t)region + regionsize;
+	pool->objsize  = objsize;
+	pool->nobjs    = nobjs;
+	pool->log2gran = log2gran;
+
+	flags = irqsave();
+	pool->flink = g_kmm_pools;
+	g_kmm_pools = pool;
+	irqrestore(flags);
+
+	mvdbg("pool %s: %u objects of %u bytes\n", pool->name, nobjs, 1 << log2gran);
+	return pool;
+
+errout_with_region:
+	kmm_free(region);
+errout_with_pool:
+	kmm_free(pool);
+	mdbg("pool %s: cannot reserve %u bytes\n", name, (unsigned int)regionsize);
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: kmm_pool_alloc
+ *
+ * Description:
+ *   Allocate one object from the pool, falling back to kmm_malloc() if the
+ *   pool is exhausted or could not be created.
+ *
+ ****************************************************************************/
+
+FAR void *kmm_pool_alloc(FAR struct kmm_pool_s *pool, size_t objsize)
+{
+	FAR void *mem;
+	irqstate_t flags;
+
+	if (pool == NULL) {
+		return kmm_malloc(objsize);
+	}
+
+	DEBUGASSERT(objsize <= pool->objsize);
+
+	mem = gran_alloc(pool->handle, pool->objsize);
+	if (mem != NULL) {
+		flags = irqsave();
+		if (++pool->nused > pool->peak) {
+			pool->peak = pool->nused;
+		}
+		irqrestore(flags);
+		return mem;
+	}
+
+	flags = irqsave();
+	pool->nfallback++;
+	irqrestore(flags);
+
+	return kmm_malloc(objsize);
+}
+
+/****************************************************************************
+ * Name: kmm_pool_free
+ *
+ * Description:
+ *   Return an object to the pool.  Returns false if the object came from the
+ *   kmm_malloc() fallback, or pool is NULL, and must be released by the
+ *   caller.
+ *
+ ****************************************************************************/
+
+bool kmm_pool_free(FAR struct kmm_pool_s *pool, FAR void *mem)
+{
+	irqstate_t flags;
+
+	if (pool == NULL || (uintptr_t)mem < pool->start || (uintptr_t)mem >= pool->end) {
+		return false;
+	}
+
+	gran_free(pool->handle, mem, pool->objsize);
+
+	flags = irqsave();
+	DEBUGASSERT(pool->nused > 0);
+	pool->nused--;
+	irqrestore(flags);
+
+	return true;
+}
+
+#endif							/* CONFIG_MM_KMM_POOL */
@@ -88,9 +88,22 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 	int ndx = mm_size2ndx(node->size);
 
+#ifdef CONFIG_MM_SEGREGATED_FIT
+	/* Every node in a segregated-fit list is big enough for any request
+	 * mapped to it, so just push the new node at the head of the list and
+	 * mark the list as non-empty.
+	 */
+
+	prev = &heap->mm_nodelist[ndx];
+	next = prev->flink;
+
+	heap->mm_sl_bitmap[ndx >> MM_SL_SHIFT] |= (1 << (ndx & (MM_SL_COUNT - 1)));
+	heap->mm_fl_bitmap |= (1 << (ndx >> MM_SL_SHIFT));
+#else
 	/* Now put the new free node in a descending order */
 
 	for (prev = &heap->mm_nodelist[ndx], next = prev->flink; next && next->size > node->size; prev = next, next = next->flink) ;
+#endif
 
 	/* Does it go in mid next or at the end? */
 
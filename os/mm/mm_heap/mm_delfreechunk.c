@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_heap/mm_delfreechunk.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <assert.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_node.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its segregated-fit list and clear the list
+ *   bitmaps if the list becomes empty.  The size of the node must not have
+ *   been changed since it was added with mm_addfreechunk().  It is assumed
+ *   that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+	int ndx;
+	int fl;
+
+	DEBUGASSERT(node->blink);
+
+	node->blink->flink = node->flink;
+	if (node->flink) {
+		node->flink->blink = node->blink;
+	}
+
+	ndx = mm_size2ndx(node->size);
+	if (heap->mm_nodelist[ndx].flink == NULL) {
+		fl = ndx >> MM_SL_SHIFT;
+		heap->mm_sl_bitmap[fl] &= ~(1 << (ndx & (MM_SL_COUNT - 1)));
+		if (heap->mm_sl_bitmap[fl] == 0) {
+			heap->mm_fl_bitmap &= ~(1 << fl);
+		}
+	}
+}
@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_heap/mm_findfreechunk.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <tinyara/mm/mm.h>
+
+#include "mm_node.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes in the segregated-fit lists.
+ *   The node is not removed from its list.  It is assumed that the caller
+ *   holds the mm semaphore.
+ *
+ *   The request is rounded up to the start of the next second-level list
+ *   so that every node of the selected list fits it.  The first non-empty
+ *   list at or above that one is then found with two bitmap scans, which
+ *   keeps the search time independent of the number of free chunks.  Only
+ *   the last list, which holds every chunk of MM_MAX_CHUNK bytes or more,
+ *   has to be searched for a big enough node.
+ *
+ *   If no list above the rounded request has a node, the list of the
+ *   request itself may still hold a node that fits.  It is searched as a
+ *   last resort so that the allocation does not fail while such a chunk
+ *   exists (e.g. a request for almost all the free memory).
+ *
+ * Return Value:
+ *   The free node, or NULL if there is no chunk big enough.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size)
+{
+	FAR struct mm_freenode_s *node;
+	uint32_t map;
+	int ndx;
+	int fl;
+	int sl;
+
+	if (size < MM_MIN_CHUNK) {
+		ndx = 0;
+	} else if (size < MM_MAX_CHUNK) {
+		ndx = mm_size2ndx(size + (1 << (mm_fls((uint32_t)size) - MM_SL_SHIFT)) - 1);
+	} else {
+		ndx = MM_NLISTS - 1;
+	}
+
+	fl = ndx >> MM_SL_SHIFT;
+	sl = ndx & (MM_SL_COUNT - 1);
+
+	/* Look for a non-empty list in the same class first, then for the
+	 * smallest non-empty class above it.
+	 */
+
+	map = heap->mm_sl_bitmap[fl] & (~0U << sl);
+	if (map == 0) {
+		if (fl + 1 < MM_NNODES) {
+			map = heap->mm_fl_bitmap & (~0U << (fl + 1));
+		}
+
+		if (map == 0) {
+			ndx = mm_size2ndx(size);
+			for (node = heap->mm_nodelist[ndx].flink; node && node->size < size; node = node->flink) ;
+			return node;
+		}
+
+		fl = mm_ffs(map);
+		map = heap->mm_sl_bitmap[fl];
+	}
+
+	ndx = (fl << MM_SL_SHIFT) | mm_ffs(map);
+	node = heap->mm_nodelist[ndx].flink;
+
+	/* The last list is not bounded above, so its nodes may be smaller than
+	 * a request which was mapped to it.
+	 */
+
+	if (ndx == MM_NLISTS - 1) {
+		while (node && node->size < size) {
+			node = node->flink;
+		}
+	}
+
+	return node;
+}
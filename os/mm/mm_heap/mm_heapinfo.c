@@ -159,7 +159,7 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 			if ((pid == HEAPINFO_PID_ALL || node->pid == pid) && (node->preceding & MM_ALLOC_BIT) != 0) {
 				if (mode == HEAPINFO_DETAIL_ALL || mode == HEAPINFO_DETAIL_PID || mode == HEAPINFO_DETAIL_SPECIFIC_HEAP) {
 					if (node->pid >= 0) {
-						printf("0x%x | %8u |   %c    | 0x%8x | %3d   |\n", node, node->size, 'A', node->alloc_call_addr, node->pid);
+						printf("0x%x | %8u |   %c    | 0x%8x | %3d   |\n", node, node->size, node->reserved == HEAPINFO_NODE_TCACHED ? 'C' : 'A', node->alloc_call_addr, node->pid);
 					} else {
 						printf("0x%x | %8u |   %c    | 0x%8x | %3d(S)|\n", node, node->size, 'A', node->alloc_call_addr, -(node->pid));
 					}
@@ -195,7 +195,11 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 		}
 
 		if (mode != HEAPINFO_SIMPLE) {
-			printf("** PID(S) in Pid colum means that mem is used for stack of PID\n\n");
+			printf("** PID(S) in Pid colum means that mem is used for stack of PID\n");
+#ifdef CONFIG_MM_TCACHE
+			printf("** Status C means that mem is kept in the small-object cache of PID\n");
+#endif
+			printf("\n");
 		}
 		mm_givesemaphore(heap);
 	}
@@ -250,17 +254,25 @@ void heapinfo_parse(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 
 	mm_takesemaphore(heap);
 
-	for (ndx = 0; ndx < MM_NNODES; ++ndx) {
+	/* With the segregated-fit allocator, the second-level lists of each
+	 * class are summed up into the class.
+	 */
+
+	for (ndx = 0; ndx < MM_NLISTS; ++ndx) {
 		for (fnode = heap->mm_nodelist[ndx].flink; fnode && fnode->size; fnode = fnode->flink) {
-			++nodelist_cnt[ndx];
-			nodelist_size[ndx] += fnode->size;
+			++nodelist_cnt[ndx >> MM_SL_SHIFT];
+			nodelist_size[ndx >> MM_SL_SHIFT] += fnode->size;
 		}
 	}
 
 	mm_givesemaphore(heap);
 
 	for (ndx = 0; ndx < MM_NNODES; ++ndx) {
+#ifdef CONFIG_MM_SEGREGATED_FIT
+		printf("Nodelist[%d] ranging [%u, %u] : num %d, size %u [Bytes]\n", ndx, 1 << (ndx + MM_MIN_SHIFT), (1 << (ndx + MM_MIN_SHIFT + 1)) - 1, nodelist_cnt[ndx], nodelist_size[ndx]);
+#else
 		printf("Nodelist[%d] ranging [%u, %u] : num %d, size %u [Bytes]\n", ndx, ((ndx > 0 ? (1 << (ndx + MM_MIN_SHIFT)) : 0) + 1), 1 << (ndx + MM_MIN_SHIFT + 1), nodelist_cnt[ndx], nodelist_size[ndx]);
+#endif
 	}
 #endif
 
@@ -111,7 +111,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 {
 	FAR struct mm_freenode_s *node;
 	void *ret = NULL;
+#ifndef CONFIG_MM_SEGREGATED_FIT
 	int ndx;
+#endif
 
 	/* Handle bad sizes */
 
@@ -136,6 +138,17 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 	mm_takesemaphore(heap);
 
+#ifdef CONFIG_MM_SEGREGATED_FIT
+	/* Find a free node through the segregated-fit bitmaps.  If there is
+	 * none, use the empty node at the end of the node list so that the
+	 * allocation fails below.
+	 */
+
+	node = mm_findfreechunk(heap, size);
+	if (!node) {
+		node = &heap->mm_nodelist[MM_NLISTS];
+	}
+#else
 	/* Get the location in the node list to start the search
 	 * by converting the request size into a nodelist index.
 	 */
@@ -159,6 +172,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 	if (!(node && node->size == size)) {
 		node = prev;
 	}
+#endif
 
 	/* If we found a node with non-zero size, then this is one to use. Since
 	 * the list is ordered, we know that is must be best fitting chunk
@@ -174,7 +188,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 		 * a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(node);
+		REMOVE_NODE_FROM_LIST(heap, node);
 
 		/* Check if we have to split the free node into one of the allocated
 		 * size and another smaller freenode.  In some cases, the remaining
@@ -23,13 +23,23 @@
  * Included Files
  ****************************************************************************/
 
+#include <tinyara/config.h>
+
+#include <stdint.h>
 #include <assert.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define REMOVE_NODE_FROM_LIST(node)				\
+/* With the segregated-fit allocator, the list bitmaps have to be updated
+ * whenever a list becomes empty, so the removal needs to know the heap.
+ */
+
+#ifdef CONFIG_MM_SEGREGATED_FIT
+#define REMOVE_NODE_FROM_LIST(heap, node) mm_delfreechunk(heap, node)
+#else
+#define REMOVE_NODE_FROM_LIST(heap, node)			\
 	do {							\
 		DEBUGASSERT((node)->blink);			\
 		(node)->blink->flink = (node)->flink;		\
@@ -37,6 +47,46 @@
 			(node)->flink->blink = (node)->blink;	\
 		}						\
 	} while (0)
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_SEGREGATED_FIT
+/* Index of the least significant set bit of a non-zero value */
+
+static inline int mm_ffs(uint32_t value)
+{
+#ifdef __GNUC__
+	return __builtin_ctz(value);
+#else
+	int bit = 0;
+
+	while ((value & 1) == 0) {
+		value >>= 1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+/* Index of the most significant set bit of a non-zero value */
+
+static inline int mm_fls(uint32_t value)
+{
+#ifdef __GNUC__
+	return 31 - __builtin_clz(value);
+#else
+	int bit = 0;
+
+	while (value >>= 1) {
+		bit++;
+	}
+	return bit;
+#endif
+}
+#endif
 
 /****************************************************************************
  * Public Functions
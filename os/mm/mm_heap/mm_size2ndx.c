@@ -58,6 +58,8 @@
 
 #include <tinyara/mm/mm.h>
 
+#include "mm_node.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -72,8 +74,36 @@
  * Description:
  *    Convert the size to a nodelist index.
  *
+ *    With the segregated-fit allocator, the index selects the first-level
+ *    class from the position of the most significant bit of the size and
+ *    the second-level list from the MM_SL_SHIFT bits that follow it.
+ *    Every node in that list has a size in the range
+ *    [class start + n * step, class start + (n + 1) * step[.
+ *
  ****************************************************************************/
 
+#ifdef CONFIG_MM_SEGREGATED_FIT
+int mm_size2ndx(size_t size)
+{
+	int log2;
+	int sl;
+
+	/* All chunks bigger than the largest class share the last list */
+
+	if (size >= MM_MAX_CHUNK) {
+		return MM_NLISTS - 1;
+	}
+
+	if (size < MM_MIN_CHUNK) {
+		return 0;
+	}
+
+	log2 = mm_fls((uint32_t)size);
+	sl = (size >> (log2 - MM_SL_SHIFT)) & (MM_SL_COUNT - 1);
+
+	return ((log2 - MM_MIN_SHIFT) << MM_SL_SHIFT) | sl;
+}
+#else
 int mm_size2ndx(size_t size)
 {
 	int ndx = 0;
@@ -104,3 +134,4 @@ int mm_size2ndx(size_t size)
 		return ndx;
 	}
 }
+#endif
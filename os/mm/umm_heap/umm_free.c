@@ -85,6 +85,13 @@ void free(FAR void *mem)
 	struct mm_heap_s *heap;
 	heap = mm_get_heap(mem);
 	if (heap) {
+#ifdef CONFIG_MM_TCACHE
+		/* Keep small chunks in the cache of the calling task */
+
+		if (umm_tcache_free(heap, mem)) {
+			return;
+		}
+#endif
 		mm_free(heap, mem);
 		return;
 	}
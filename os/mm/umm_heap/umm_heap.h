@@ -97,8 +97,35 @@ extern uint32_t _stext;
 #define USR_HEAP (g_mmheap)
 #endif
 
+#ifdef CONFIG_MM_TCACHE
+/* The per-task cache keeps one list per chunk size, from MM_MIN_CHUNK up to
+ * the chunk size of a MM_TCACHE_MAXSIZE request.  The cached chunks are
+ * linked through their first payload word.  CONFIG_MM_TCACHE_MAXSIZE is
+ * rounded up to the heap granule.
+ */
+
+#define MM_TCACHE_MAXSIZE  MM_ALIGN_UP(CONFIG_MM_TCACHE_MAXSIZE)
+#define MM_TCACHE_NCLASSES (MM_ALIGN_UP(MM_TCACHE_MAXSIZE + SIZEOF_MM_ALLOCNODE) >> MM_MIN_SHIFT)
+
+struct mm_tcache_s {
+	FAR void *head[MM_TCACHE_NCLASSES];
+	uint8_t count[MM_TCACHE_NCLASSES];
+};
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_MM_TCACHE
+/* Functions contained in umm_tcache.c *************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *umm_tcache_alloc(size_t size, mmaddress_t caller_retaddr);
+#else
+FAR void *umm_tcache_alloc(size_t size);
+#endif
+bool umm_tcache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+#endif
+
 #endif /* __MM_UMM_HEAP_UMM_HEAP_H */
@@ -207,6 +207,19 @@ FAR void *malloc(size_t size)
 	size_t retaddr = 0;
 #endif
 
+#ifdef CONFIG_MM_TCACHE
+	/* Try the small-object cache of the calling task first */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	ret = umm_tcache_alloc(size, retaddr);
+#else
+	ret = umm_tcache_alloc(size);
+#endif
+	if (ret != NULL) {
+		return ret;
+	}
+#endif
+
 #ifdef CONFIG_RAM_MALLOC_PRIOR_INDEX
 	heap_idx = CONFIG_RAM_MALLOC_PRIOR_INDEX;
 #endif
@@ -0,0 +1,307 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/umm_heap/umm_tcache.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <unistd.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/mm/mm.h>
+
+#include "umm_heap.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCACHE_NEXT(mem) (*(FAR void **)(mem))
+
+/* Only chunks of the heap which malloc() tries first are cached, so that a
+ * chunk served from a cache comes from the same heap as one served by
+ * malloc() itself.
+ */
+
+#ifdef CONFIG_RAM_MALLOC_PRIOR_INDEX
+#define TCACHE_HEAP (&USR_HEAP[CONFIG_RAM_MALLOC_PRIOR_INDEX])
+#else
+#define TCACHE_HEAP (&USR_HEAP[0])
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcache_self
+ *
+ * Description:
+ *   Return the TCB of the calling task, or NULL if the cache must not be
+ *   used in this context.  The IDLE task and the kernel threads free the
+ *   memory of other tasks, and a task which has completed its exit
+ *   processing has had its cache drained, so none of them use a cache.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *tcache_self(void)
+{
+	FAR struct tcb_s *rtcb;
+
+	if (up_interrupt_context()) {
+		return NULL;
+	}
+
+	rtcb = sched_self();
+	if (rtcb == NULL || rtcb->pid == 0) {
+		return NULL;
+	}
+
+	if ((rtcb->flags & TCB_FLAG_TTYPE_MASK) == TCB_FLAG_TTYPE_KERNEL || (rtcb->flags & TCB_FLAG_EXIT_PROCESSING) != 0) {
+		return NULL;
+	}
+
+	return rtcb;
+}
+
+/****************************************************************************
+ * Name: tcache_release
+ *
+ * Description:
+ *   Return a drained chunk to its heap.  The drain may run on a task which
+ *   must not block, so if the heap is busy the chunk is handed to the
+ *   garbage collector like sched_ufree() does.
+ *
+ ****************************************************************************/
+
+static void tcache_release(FAR void *mem)
+{
+	FAR struct mm_heap_s *heap;
+
+	heap = mm_get_heap(mem);
+	if (heap == NULL) {
+		return;
+	}
+
+	if (!up_interrupt_context() && mm_trysemaphore(heap) == 0) {
+		mm_free(heap, mem);
+		mm_givesemaphore(heap);
+		return;
+	}
+
+	sched_ufree(mem);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_tcache_alloc
+ *
+ * Description:
+ *   Take a chunk for a request of 'size' bytes from the cache of the
+ *   calling task.  The cache is only touched with interrupts disabled, so
+ *   the drain from another task never sees a half-updated list.
+ *
+ * Return Value:
+ *   The address of the memory, or NULL if the cache can't serve the request.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *umm_tcache_alloc(size_t size, mmaddress_t caller_retaddr)
+#else
+FAR void *umm_tcache_alloc(size_t size)
+#endif
+{
+	FAR struct tcb_s *rtcb;
+	FAR struct mm_tcache_s *tcache;
+	FAR void *mem;
+	irqstate_t flags;
+	int ndx;
+
+	if (size < 1 || size > MM_TCACHE_MAXSIZE) {
+		return NULL;
+	}
+
+	ndx = (MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE) >> MM_MIN_SHIFT) - 1;
+	DEBUGASSERT(ndx < MM_TCACHE_NCLASSES);
+	if (ndx >= MM_TCACHE_NCLASSES) {
+		return NULL;
+	}
+
+	rtcb = tcache_self();
+	if (rtcb == NULL) {
+		return NULL;
+	}
+
+	flags = irqsave();
+	tcache = rtcb->tcache;
+	if (tcache == NULL || tcache->head[ndx] == NULL) {
+		irqrestore(flags);
+		return NULL;
+	}
+
+	mem = tcache->head[ndx];
+	tcache->head[ndx] = TCACHE_NEXT(mem);
+	tcache->count[ndx]--;
+	irqrestore(flags);
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* The chunk is already accounted to this task.  Just record the new
+	 * caller and clear the cached mark.
+	 */
+
+	heapinfo_update_node((FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE), caller_retaddr);
+#endif
+
+	return mem;
+}
+
+/****************************************************************************
+ * Name: umm_tcache_free
+ *
+ * Description:
+ *   Put a chunk of 'heap' into the cache of the calling task.  The cache
+ *   is created on the first free of a small chunk.  Chunks of the other
+ *   heaps are not cached.
+ *
+ * Return Value:
+ *   true if the chunk was cached; false if it has to be returned to the
+ *   heap.
+ *
+ ****************************************************************************/
+
+bool umm_tcache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+	FAR struct tcb_s *rtcb;
+	FAR struct mm_tcache_s *tcache;
+	FAR struct mm_allocnode_s *node;
+	irqstate_t flags;
+	int ndx;
+
+	if (mem == NULL || heap != TCACHE_HEAP) {
+		return false;
+	}
+
+	node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+	ndx = (node->size >> MM_MIN_SHIFT) - 1;
+	if (ndx < 0 || ndx >= MM_TCACHE_NCLASSES) {
+		return false;
+	}
+
+	rtcb = tcache_self();
+	if (rtcb == NULL) {
+		return false;
+	}
+
+	if (rtcb->tcache == NULL) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ARCH_GET_RET_ADDRESS
+		rtcb->tcache = (FAR struct mm_tcache_s *)mm_zalloc(heap, sizeof(struct mm_tcache_s), retaddr);
+#else
+		rtcb->tcache = (FAR struct mm_tcache_s *)mm_zalloc(heap, sizeof(struct mm_tcache_s));
+#endif
+		if (rtcb->tcache == NULL) {
+			return false;
+		}
+	}
+
+	if (rtcb->tcache->count[ndx] >= CONFIG_MM_TCACHE_DEPTH) {
+		return false;
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* Move the chunk from its owner to the caching task, which now holds it,
+	 * and mark it as cached for heapinfo.
+	 */
+
+	mm_takesemaphore(heap);
+	if (node->pid != rtcb->pid) {
+		heapinfo_subtract_size(heap, node->pid, node->size);
+		node->pid = rtcb->pid;
+		heapinfo_add_size(heap, node->pid, node->size);
+	}
+	node->reserved = HEAPINFO_NODE_TCACHED;
+	mm_givesemaphore(heap);
+#endif
+
+	flags = irqsave();
+	tcache = rtcb->tcache;
+	if (tcache == NULL || tcache->count[ndx] >= CONFIG_MM_TCACHE_DEPTH) {
+		irqrestore(flags);
+		return false;
+	}
+
+	TCACHE_NEXT(mem) = tcache->head[ndx];
+	tcache->head[ndx] = mem;
+	tcache->count[ndx]++;
+	irqrestore(flags);
+
+	return true;
+}
+
+/****************************************************************************
+ * Name: umm_tcache_drain
+ *
+ * Description:
+ *   Return all the chunks cached by a task, and the cache itself, to their
+ *   heap.  This is called at the end of the task exit logic, either on the
+ *   exiting task or on the task which deletes it, after the task has been
+ *   marked with TCB_FLAG_EXIT_PROCESSING so that it can't cache chunks
+ *   again.  It never blocks: chunks whose heap is busy are freed later by
+ *   the garbage collector.
+ *
+ ****************************************************************************/
+
+void umm_tcache_drain(FAR struct tcb_s *tcb)
+{
+	FAR struct mm_tcache_s *tcache;
+	FAR void *mem;
+	irqstate_t flags;
+	int ndx;
+
+	flags = irqsave();
+	tcache = tcb->tcache;
+	tcb->tcache = NULL;
+	irqrestore(flags);
+
+	if (tcache == NULL) {
+		return;
+	}
+
+	for (ndx = 0; ndx < MM_TCACHE_NCLASSES; ndx++) {
+		while ((mem = tcache->head[ndx]) != NULL) {
+			tcache->head[ndx] = TCACHE_NEXT(mem);
+			tcache_release(mem);
+		}
+	}
+
+	tcache_release(tcache);
+}
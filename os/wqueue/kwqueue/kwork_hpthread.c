@@ -56,6 +56,8 @@
 
 #include <tinyara/config.h>
 
+#include <unistd.h>
+#include <sched.h>
 #include <errno.h>
 #include <queue.h>
 #include <debug.h>
@@ -95,8 +97,8 @@ struct hp_wqueue_s g_hpwork;
  * Name: work_hpthread
  *
  * Description:
- *   This is the worker thread that performs the actions placed on the high
- *   priority work queue.
+ *   These are the worker thread(s) that performs the actions placed on the
+ *   high priority work queue.
  *
  *   This, along with the lower priority worker thread(s) are the kernel
  *   mode work queues (also build in the flat build).  One of these threads
@@ -119,6 +121,25 @@ struct hp_wqueue_s g_hpwork;
 
 static int work_hpthread(int argc, char *argv[])
 {
+	int wndx;
+#if CONFIG_SCHED_HPNTHREADS > 1
+	pid_t me = getpid();
+	int i;
+
+	/* Find out thread index by search the workers in g_hpwork */
+
+	for (wndx = 0, i = 0; i < CONFIG_SCHED_HPNTHREADS; i++) {
+		if (g_hpwork.worker[i].pid == me) {
+			wndx = i;
+			break;
+		}
+	}
+
+	DEBUGASSERT(i < CONFIG_SCHED_HPNTHREADS);
+#else
+	wndx = 0;
+#endif
+
 	/* Loop forever */
 
 	for (;;) {
@@ -134,7 +155,9 @@ static int work_hpthread(int argc, char *argv[])
 		 * thread instead.
 		 */
 
-		sched_garbagecollection();
+		if (wndx == 0) {
+			sched_garbagecollection();
+		}
 #endif
 
 		/* Then process queued work.  work_process will not return until: (1)
@@ -142,7 +165,7 @@ static int work_hpthread(int argc, char *argv[])
 		 * period provided by g_hpwork.delay expires.
 		 */
 
-		work_process((FAR struct wqueue_s *)&g_hpwork, 0);
+		work_process((FAR struct wqueue_s *)&g_hpwork, wndx);
 	}
 
 	return OK;					/* To keep some compilers happy */
@@ -156,7 +179,7 @@ static int work_hpthread(int argc, char *argv[])
  * Name: work_hpstart
  *
  * Description:
- *   Start the high-priority, kernel-mode work queue.
+ *   Start the high-priority, kernel-mode worker thread(s)
  *
  * Input parameters:
  *   None
@@ -170,27 +193,39 @@ static int work_hpthread(int argc, char *argv[])
 int work_hpstart(void)
 {
 	int pid;
+	int wndx;
 
 	/* Initialize work queue data structures */
 
 	dq_init(&g_hpwork.q);
 
-	/* Start the high-priority, kernel mode worker thread */
+	/* Don't permit any of the threads to run until we have fully initialized
+	 * g_hpwork.
+	 */
+
+	sched_lock();
+
+	/* Start the high-priority, kernel mode worker thread(s) */
+
+	svdbg("Starting high-priority kernel worker thread(s)\n");
 
-	svdbg("Starting high-priority kernel worker thread\n");
+	for (wndx = 0; wndx < CONFIG_SCHED_HPNTHREADS; wndx++) {
+		pid = kernel_thread(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY, CONFIG_SCHED_HPWORKSTACKSIZE, (main_t)work_hpthread, (FAR char *const *)NULL);
 
-	pid = kernel_thread(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY, CONFIG_SCHED_HPWORKSTACKSIZE, (main_t)work_hpthread, (FAR char *const *)NULL);
+		DEBUGASSERT(pid > 0);
+		if (pid < 0) {
+			int errcode = errno;
+			DEBUGASSERT(errcode > 0);
 
-	DEBUGASSERT(pid > 0);
-	if (pid < 0) {
-		int errcode = errno;
-		DEBUGASSERT(errcode > 0);
+			slldbg("kernel_thread %d failed: %d\n", wndx, errcode);
+			sched_unlock();
+			return -errcode;
+		}
 
-		slldbg("kernel_thread failed: %d\n", errcode);
-		return -errcode;
+		g_hpwork.worker[wndx].pid = (pid_t)pid;
+		g_hpwork.worker[wndx].busy = true;
 	}
 
-	g_hpwork.worker[0].pid = pid;
-	g_hpwork.worker[0].busy = true;
-	return pid;
+	sched_unlock();
+	return g_hpwork.worker[0].pid;
 }
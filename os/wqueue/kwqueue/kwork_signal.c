@@ -54,7 +54,27 @@ int work_signal(int qid)
 	/* Get the process ID of the worker thread */
 #ifdef CONFIG_SCHED_HPWORK
 	if (qid == HPWORK) {
-		pid = g_hpwork.worker[0].pid;
+		int wndx;
+		int i;
+
+		/* Find an IDLE worker thread */
+
+		for (wndx = 0, i = 0; i < CONFIG_SCHED_HPNTHREADS; i++) {
+			/* Is this worker thread busy? */
+
+			if (!g_hpwork.worker[i].busy) {
+				/* No.. select this thread */
+
+				wndx = i;
+				break;
+			}
+		}
+
+		/* Use the process ID of the IDLE worker thread (or the ID of worker
+		 * thread 0 if all of the worker threads are busy).
+		 */
+
+		pid = g_hpwork.worker[wndx].pid;
 	} else
 #endif
 #ifdef CONFIG_SCHED_LPWORK
@@ -112,7 +112,6 @@
 
 int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
 {
-	struct work_s *cur_work;
 	int ret = -ENOENT;
 
 	DEBUGASSERT(work != NULL);
@@ -128,34 +127,20 @@ int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
 	irqstate_t flags;
 	flags = irqsave();
 #endif
-	if (work->worker != NULL) {
-		/* A little test of the integrity of the work queue */
-
-		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == wqueue->q.tail);
-		DEBUGASSERT(work->dq.blink || (FAR dq_entry_t *)work == wqueue->q.head);
-
-		/* check whether requested work is in queue list or not */
-		cur_work = (struct work_s *)wqueue->q.head;
-		do {
-			if (cur_work == NULL) {
-#if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
-#else
-				irqrestore(flags);
-#endif
-				return -ENOENT;
-			} else if (cur_work == work) {
-				break;
-			}
-
-			cur_work = (struct work_s *)cur_work->dq.flink;
-		} while (1);
-
-		/* Remove the entry from the work queue and make sure that it is
-		 * mark as available (i.e., the worker field is nullified).
+	if (work_isqueued(wqueue, work)) {
+		/* Remove the entry from the ready queue or from its timer wheel
+		 * slot and make sure that it is mark as available (i.e., the
+		 * worker field is nullified).
 		 */
 
-		dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+		if ((work->flags & WORK_FLAG_DELAYED) != 0) {
+			dq_rem((FAR dq_entry_t *)work, WORK_SLOT(wqueue, work));
+			wqueue->wheel.ndelayed--;
+		} else {
+			dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+		}
+
+		work->flags = 0;
 		work->worker = NULL;
 		ret = OK;
 	}
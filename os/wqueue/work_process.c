@@ -89,6 +89,116 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_expire
+ *
+ * Description:
+ *   Move delayed work whose delay has elapsed from the timer wheel to the
+ *   end of the ready queue.  Only the slots of the ticks since the last
+ *   call are visited, in order, so ready work keeps the order of expiry.
+ *
+ ****************************************************************************/
+
+static void work_expire(FAR struct wqueue_s *wqueue, clock_t ctick)
+{
+	FAR struct wqueue_wheel_s *wheel = &wqueue->wheel;
+	FAR struct work_s *work;
+	FAR struct work_s *next;
+	FAR dq_queue_t *slot;
+	clock_t nticks;
+	clock_t i;
+
+	nticks = ctick - wheel->tick + 1;
+	if (nticks > CONFIG_SCHED_WORKQUEUE_SLOTS) {
+		nticks = CONFIG_SCHED_WORKQUEUE_SLOTS;
+	}
+
+	for (i = 0; i < nticks && wheel->ndelayed > 0; i++) {
+		slot = &wheel->slot[(wheel->tick + i) & WORK_SLOT_MASK];
+
+		for (work = (FAR struct work_s *)slot->head; work != NULL; work = next) {
+			next = (FAR struct work_s *)work->dq.flink;
+
+			/* Work of a later turn of the wheel stays in the slot */
+
+			if (ctick - work->qtime >= work->delay) {
+				dq_rem((FAR dq_entry_t *)work, slot);
+				dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+				work->flags &= ~WORK_FLAG_DELAYED;
+				wheel->ndelayed--;
+			}
+		}
+	}
+
+	wheel->tick = ctick + 1;
+}
+
+/****************************************************************************
+ * Name: work_stats
+ *
+ * Description:
+ *   Account the latency of a work which is about to be started, the ticks
+ *   from the moment it became ready until now.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+static void work_stats(FAR struct wqueue_s *wqueue, volatile FAR struct work_s *work)
+{
+	FAR struct wqueue_stats_s *stats = &wqueue->stats;
+	clock_t latency;
+	int bucket;
+
+	latency = clock() - work->qtime - work->delay;
+
+	for (bucket = 0; latency >> bucket != 0 && bucket < WORK_STATS_NBUCKETS - 1; bucket++) {
+	}
+
+	stats->hist[bucket]++;
+	stats->count++;
+	if (latency > stats->max) {
+		stats->max = latency;
+	}
+}
+#else
+#define work_stats(wqueue, work)
+#endif
+
+/****************************************************************************
+ * Name: work_nextdelay
+ *
+ * Description:
+ *   Return the number of ticks until the next delayed work expires.  At
+ *   most one turn of the wheel is looked ahead, work further away is
+ *   found again on a later call.
+ *
+ ****************************************************************************/
+
+static clock_t work_nextdelay(FAR struct wqueue_s *wqueue, clock_t ctick)
+{
+	FAR struct wqueue_wheel_s *wheel = &wqueue->wheel;
+	FAR struct work_s *work;
+	FAR dq_queue_t *slot;
+	clock_t remaining;
+	clock_t next;
+	clock_t i;
+
+	next = CONFIG_SCHED_WORKQUEUE_SLOTS;
+
+	for (i = 1; i < next; i++) {
+		slot = &wheel->slot[(ctick + i) & WORK_SLOT_MASK];
+
+		for (work = (FAR struct work_s *)slot->head; work != NULL; work = (FAR struct work_s *)work->dq.flink) {
+			remaining = work->delay - (ctick - work->qtime);
+			if (remaining < next) {
+				next = remaining;
+			}
+		}
+	}
+
+	return next;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -114,7 +224,6 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	volatile FAR struct work_s *work;
 	worker_t worker;
 	FAR void *arg;
-	clock_t elapsed;
 	clock_t ctick;
 	clock_t next;
 
@@ -137,82 +246,77 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	 * so ourselves, and (2) there will be no changes to the work queue
 	 */
 
+	work_expire(wqueue, clock());
 	work = (FAR struct work_s *)wqueue->q.head;
-	
+
 	while (work) {
-		
-		/* Is this work ready?  It is ready if there is no delay or if
-		 * the delay has elapsed. qtime is the time that the work was added
-		 * to the work queue.  It will always be greater than or equal to
-		 * zero.  Therefore a delay of zero will always execute immediately.
+		/* All work in the ready queue is ready.  Its delay has elapsed
+		 * when it was moved there from the timer wheel, or it was queued
+		 * without delay.  Remove the ready-to-execute work from the list.
 		 */
 
-		ctick = clock();
-		elapsed = ctick - work->qtime;
-
-		if (elapsed >= work->delay) {
-			/* Remove the ready-to-execute work from the list */
+		(void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+		work->flags = 0;
 
-			(void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+		/* Extract the work description from the entry (in case the work
+		 * instance by the re-used after it has been de-queued).
+		 */
 
-			/* Extract the work description from the entry (in case the work
-			 * instance by the re-used after it has been de-queued).
-			 */
+		worker = work->worker;
 
-			worker = work->worker;
+		/* Check for a race condition where the work may be nullified
+		 * before it is removed from the queue.
+		 */
 
-			/* Check for a race condition where the work may be nullified
-			 * before it is removed from the queue.
-			 */
+		if (worker != NULL) {
+			/* Extract the work argument (before re-enabling interrupts) */
 
-			if (worker != NULL) {
-				/* Extract the work argument (before re-enabling interrupts) */
+			arg = work->arg;
+			work_stats(wqueue, work);
 
-				arg = work->arg;
+			/* Mark the work as no longer being queued */
 
-				/* Mark the work as no longer being queued */
+			work->worker = NULL;
 
-				work->worker = NULL;
+			/* Do the work.  Re-enable interrupts while the work is being
+			 * performed... we don't have any idea how long this will take!
+			 */
 
-				/* Do the work.  Re-enable interrupts while the work is being
-				 * performed... we don't have any idea how long this will take!
-				 */
-				
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
+			work_unlock();
 #else
-				irqrestore(flags);
+			irqrestore(flags);
 #endif
-				worker(arg);
+			worker(arg);
 
-				/* Now, unfortunately, since we re-enabled interrupts we don't
-				 * know the state of the work list and we will have to start
-				 * back at the head of the list.
-				 */
+			/* Now, unfortunately, since we re-enabled interrupts we don't
+			 * know the state of the work list and we will have to start
+			 * back at the head of the list.  Time has passed as well, so
+			 * collect the work which expired meanwhile.
+			 */
 
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				while (work_lock() < 0);
+			while (work_lock() < 0);
 #else
-				flags = irqsave();
+			flags = irqsave();
 #endif
-				work = (FAR struct work_s *)wqueue->q.head;
-			} else {
-				/* Cancelled.. Just move to the next work in the list with
-				 * interrupts still disabled.
-				 */
+			work_expire(wqueue, clock());
+		}
 
-				work = (FAR struct work_s *)work->dq.flink;
-			}
-		} else {				/* elapsed < work->delay */
+		work = (FAR struct work_s *)wqueue->q.head;
+	}
 
-			next = work->delay - elapsed;
+	/* The ready queue is empty now, wait for the next delayed work */
 
-			/* Then break at while loop due to sorted list */
-			break;
+	if (wqueue->wheel.ndelayed > 0) {
+		ctick = clock();
+		work_expire(wqueue, ctick);
+		if (wqueue->q.head == NULL) {
+			next = work_nextdelay(wqueue, ctick);
 		}
 	}
 
-	if (wqueue->q.head == NULL) {
+	if (wqueue->q.head == NULL && wqueue->wheel.ndelayed == 0) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 		work_unlock();
 #endif
@@ -120,11 +120,7 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 {
 	DEBUGASSERT(work != NULL);
 
-	struct work_s *next_work = NULL;
-	struct work_s *cur_work;
-	clock_t elapsed;
 	clock_t ctick;
-	ctick = clock();
 
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	while (work_lock() < 0);
@@ -133,26 +129,20 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 	flags = irqsave();
 #endif
 
+	/* Read the time with the queue locked, so that the work can not expire
+	 * at a tick which the worker has already passed in the timer wheel.
+	 */
+
+	ctick = clock();
+
 	/* check whether requested work is in queue list or not */
-	cur_work = (struct work_s *)wqueue->q.head;
-	while (cur_work != NULL) {
-		if (cur_work == work) {
+	if (work_isqueued(wqueue, work)) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-			work_unlock();
+		work_unlock();
 #else
-			irqrestore(flags);
+		irqrestore(flags);
 #endif
-			return -EALREADY;
-		}
-
-		if (next_work == NULL) {
-			elapsed = ctick - cur_work->qtime;
-			if (cur_work->delay > elapsed && cur_work->delay - elapsed > delay) {
-				next_work = cur_work;
-			}
-		}
-
-		cur_work = (struct work_s *)cur_work->dq.flink;
+		return -EALREADY;
 	}
 
 	work->worker = worker;		/* Work callback */
@@ -160,10 +150,17 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 	work->delay = delay;		/* Delay until work performed */
 	work->qtime = ctick;		/* Time work queued */
 
-	if (next_work) {
-		dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->q);
-	} else {
+	/* Work without delay is ready now, delayed work waits in the slot of
+	 * the tick it expires at.
+	 */
+
+	if (delay == 0) {
+		work->flags = WORK_FLAG_QUEUED;
 		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+	} else {
+		work->flags = WORK_FLAG_QUEUED | WORK_FLAG_DELAYED;
+		dq_addlast((FAR dq_entry_t *)work, WORK_SLOT(wqueue, work));
+		wqueue->wheel.ndelayed++;
 	}
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	work_unlock();
@@ -60,6 +60,7 @@
 #include <tinyara/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <queue.h>
 #include <semaphore.h>
@@ -75,10 +76,59 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+#ifndef CONFIG_SCHED_WORKQUEUE_SLOTS
+#define CONFIG_SCHED_WORKQUEUE_SLOTS 32
+#endif
+
+#if (CONFIG_SCHED_WORKQUEUE_SLOTS & (CONFIG_SCHED_WORKQUEUE_SLOTS - 1)) != 0
+#error "CONFIG_SCHED_WORKQUEUE_SLOTS must be a power of two"
+#endif
+
+#define WORK_SLOT_MASK    (CONFIG_SCHED_WORKQUEUE_SLOTS - 1)
+
+/* Values of work_s flags */
+
+#define WORK_FLAG_QUEUED  (1 << 0)	/* The work is in a work queue */
+#define WORK_FLAG_DELAYED (1 << 1)	/* The work is in a timer wheel slot */
+
+/* The timer wheel slot holding delayed work, by the tick it expires at */
+
+#define WORK_SLOT(wqueue, work) \
+	(&(wqueue)->wheel.slot[((work)->qtime + (work)->delay) & WORK_SLOT_MASK])
+
+/* Number of buckets of the latency histograms.  Bucket 0 counts work
+ * started in the tick it became ready, bucket n counts latencies of
+ * [2^(n-1), 2^n) ticks and the last bucket all longer latencies.
+ */
+
+#define WORK_STATS_NBUCKETS 8
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
+/* Delayed work waits in a timer wheel.  Work expiring at tick t is kept in
+ * slot t % CONFIG_SCHED_WORKQUEUE_SLOTS, so queueing and cancelling work
+ * are O(1).  Each slot is unsorted and may hold work of later turns of the
+ * wheel, which stays there until its delay has really elapsed.
+ */
+
+struct wqueue_wheel_s {
+	clock_t tick;				/* Slots before this tick have been expired */
+	uint16_t ndelayed;			/* Number of work in the slots */
+	struct dq_queue_s slot[CONFIG_SCHED_WORKQUEUE_SLOTS];
+};
+
+/* Latency statistics of one work queue */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+struct wqueue_stats_s {
+	uint32_t count;				/* Number of work started */
+	clock_t max;				/* Longest latency seen, in ticks */
+	uint32_t hist[WORK_STATS_NBUCKETS];	/* Latency histogram */
+};
+#endif
+
 /* This represents one worker */
 
 struct worker_s {
@@ -89,7 +139,11 @@ struct worker_s {
 /* This structure defines the state of work queue */
 
 struct wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to be performed */
+	struct wqueue_wheel_s wheel;	/* Delayed work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct wqueue_stats_s stats;	/* Latency statistics */
+#endif
 	struct worker_s worker[1];	/* Describes a worker thread */
 };
 
@@ -99,8 +153,14 @@ struct wqueue_s {
 
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
-	struct worker_s worker[1];	/* Describes the single high priority worker */
+	struct dq_queue_s q;		/* The queue of work ready to be performed */
+	struct wqueue_wheel_s wheel;	/* Delayed work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct wqueue_stats_s stats;	/* Latency statistics */
+#endif
+
+	/* Describes each thread in the high priority queue's thread pool */
+	struct worker_s worker[CONFIG_SCHED_HPNTHREADS];
 };
 #endif
 
@@ -110,7 +170,11 @@ struct hp_wqueue_s {
 
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to be performed */
+	struct wqueue_wheel_s wheel;	/* Delayed work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct wqueue_stats_s stats;	/* Latency statistics */
+#endif
 
 	/* Describes each thread in the low priority queue's thread pool */
 	struct worker_s worker[CONFIG_SCHED_LPNTHREADS];
@@ -145,6 +209,43 @@ extern sem_t g_usrsem;
 extern pthread_mutex_t g_usrmutex;
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_isqueued
+ *
+ * Description:
+ *   Check whether the work is in the ready queue or in the timer wheel of
+ *   wqueue.  The flags only tell which list to search: a work_s which was
+ *   never queued may hold garbage, so its links are not followed and the
+ *   list is searched for it instead.  This walks one timer wheel slot or
+ *   the ready queue, and only when the flags claim the work is queued.
+ *
+ *   The caller must hold the work queue locked.
+ *
+ ****************************************************************************/
+
+static inline bool work_isqueued(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
+{
+	FAR dq_entry_t *curr;
+	FAR dq_queue_t *list;
+
+	if ((work->flags & WORK_FLAG_QUEUED) == 0) {
+		return false;
+	}
+
+	list = (work->flags & WORK_FLAG_DELAYED) != 0 ? WORK_SLOT(wqueue, work) : &wqueue->q;
+	for (curr = list->head; curr != NULL; curr = curr->flink) {
+		if (curr == (FAR dq_entry_t *)work) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -0,0 +1,265 @@
+#!/usr/bin/env python
+###########################################################################
+#
+# Copyright 2020 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# Decodes a dump of the logm buffer written in binary mode
+# (CONFIG_LOGM_BINARY) back into text.  Format strings are read from the
+# ELF image the dump was taken from.  The record layout is described by
+# struct logm_binhdr_s in os/logm/logm.h.
+
+from __future__ import print_function
+
+import argparse
+import struct
+import sys
+
+RECORD_MAGIC = 0xA5
+
+# Record header: magic, nconv, len, fmt, ticks (32-bit little endian target)
+HEADER = struct.Struct('<BBHII')
+
+# Sizes of the stored arguments on the target
+SIZES = {
+    'int': 4,
+    'long': 4,
+    'llong': 8,
+    'size': 4,
+    'intmax': 8,
+    'ptrdiff': 4,
+    'double': 8,
+    'ldouble': 8,
+    'ptr': 4,
+    'count': 4,
+}
+
+INT_TYPES = {'l': 'long', 'q': 'llong', 'z': 'size', 'j': 'intmax', 't': 'ptrdiff'}
+
+
+class Elf(object):
+    """Reads strings from the allocated sections of an ELF image."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+        is64 = self.data[4] == 2 or self.data[4:5] == b'\x02'
+        endian = '<' if self.data[5:6] == b'\x01' else '>'
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 0x3A)
+            shdr = struct.Struct(endian + 'IIQQQQIIQQ')
+        else:
+            shoff, = struct.unpack_from(endian + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 0x2E)
+            shdr = struct.Struct(endian + 'IIIIIIIIII')
+        self.sections = []
+        for i in range(shnum):
+            fields = shdr.unpack_from(self.data, shoff + i * shentsize)
+            sh_type, sh_flags, sh_addr, sh_offset, sh_size = fields[1:6]
+            # SHF_ALLOC, and not SHT_NOBITS
+            if sh_flags & 0x2 and sh_type != 8 and sh_addr != 0:
+                self.sections.append((sh_addr, sh_size, sh_offset))
+
+    def string_at(self, addr):
+        for sh_addr, sh_size, sh_offset in self.sections:
+            if sh_addr <= addr < sh_addr + sh_size:
+                start = sh_offset + addr - sh_addr
+                end = self.data.find(b'\0', start, sh_offset + sh_size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode('latin-1')
+        return None
+
+
+def parse_spec(fmt, i):
+    """Parses the conversion specification following the '%' at fmt[i - 1].
+
+    Mirrors logm_parsespec() in os/logm/logm_binary.c.  Returns the index past
+    the specification, the flags, width and precision text, the number of
+    '*' arguments, the conversion character and the argument type.
+    """
+    start = i
+    while i < len(fmt) and fmt[i] in '-+ #0':
+        i += 1
+    flags = fmt[start:i]
+    nstars = 0
+
+    start = i
+    if i < len(fmt) and fmt[i] == '*':
+        nstars += 1
+        i += 1
+    else:
+        while i < len(fmt) and fmt[i].isdigit():
+            i += 1
+    width = fmt[start:i]
+
+    prec = ''
+    if i < len(fmt) and fmt[i] == '.':
+        start = i
+        i += 1
+        if i < len(fmt) and fmt[i] == '*':
+            nstars += 1
+            i += 1
+        else:
+            while i < len(fmt) and fmt[i].isdigit():
+                i += 1
+        prec = fmt[start:i]
+
+    lenmod = ''
+    if i < len(fmt):
+        if fmt[i] == 'h':
+            i += 1
+            if i < len(fmt) and fmt[i] == 'h':
+                i += 1
+        elif fmt[i] == 'l':
+            i += 1
+            lenmod = 'l'
+            if i < len(fmt) and fmt[i] == 'l':
+                i += 1
+                lenmod = 'q'
+        elif fmt[i] in 'zjtL':
+            lenmod = fmt[i]
+            i += 1
+
+    if i >= len(fmt):
+        return i, flags, width, prec, nstars, '', None
+
+    conv = fmt[i]
+    if conv in 'diuxXoc':
+        argtype = INT_TYPES.get(lenmod, 'int')
+    elif conv in 'eEfFgGaA':
+        argtype = 'ldouble' if lenmod == 'L' else 'double'
+    elif conv == 'p':
+        argtype = 'ptr'
+    elif conv == 's':
+        argtype = 'string'
+    elif conv == 'n':
+        argtype = 'count'
+    else:
+        argtype = None
+    return i + 1, flags, width, prec, nstars, conv, argtype
+
+
+def format_arg(flags, width, prec, conv, value):
+    if conv in 'aA':
+        text = float.hex(value)
+        return ('%' + flags.replace('0', '') + width + 's') % (text.upper() if conv == 'A' else text)
+    if conv == 'p':
+        return ('%' + flags + width + '#x') % value
+    pyconv = {'i': 'd', 'u': 'd'}.get(conv, conv)
+    return ('%' + flags + width + prec + pyconv) % value
+
+
+def decode_record(elf, data, off, tick_per_sec, timestamp):
+    """Decodes the record at data[off].  Returns (text, length) or None."""
+    if off + HEADER.size > len(data):
+        return None
+    magic, nconv, length, fmtaddr, ticks = HEADER.unpack_from(data, off)
+    if magic != RECORD_MAGIC or length < HEADER.size or off + length > len(data):
+        return None
+    fmt = elf.string_at(fmtaddr)
+    if fmt is None:
+        return None
+
+    rec = bytearray(data[off:off + length])
+    pos = HEADER.size
+    out = []
+    if timestamp:
+        out.append('[%4d.%4d] ' % (ticks // tick_per_sec, (ticks % tick_per_sec) * 10000 // tick_per_sec))
+
+    i = 0
+    count = 0
+    while i < len(fmt):
+        if fmt[i] != '%':
+            out.append(fmt[i])
+            i += 1
+            continue
+        start = i
+        i, flags, width, prec, nstars, conv, argtype = parse_spec(fmt, i + 1)
+        if argtype is None:
+            out.append('%' if fmt[start:i] == '%%' else fmt[start:i])
+            continue
+        if count == nconv:
+            out.append('...\n')
+            return ''.join(out), length
+        count += 1
+
+        stars = []
+        for _ in range(nstars):
+            stars.append(struct.unpack_from('<i', rec, pos)[0])
+            pos += 4
+        if width == '*':
+            width = str(stars.pop(0))
+        if prec == '.*':
+            prec = '.' + str(stars.pop(0))
+
+        if argtype == 'string':
+            size = rec[pos]
+            value = bytes(rec[pos + 1:pos + 1 + size]).decode('latin-1')
+            pos += 1 + size
+        else:
+            size = SIZES[argtype]
+            raw = bytes(rec[pos:pos + size])
+            pos += size
+            if argtype in ('double', 'ldouble'):
+                value = struct.unpack('<d', raw)[0]
+            else:
+                code = {4: 'i', 8: 'q'}[size]
+                if conv not in 'di':
+                    code = code.upper()
+                value = struct.unpack('<' + code, raw)[0]
+        if argtype == 'count':
+            continue
+        try:
+            out.append(format_arg(flags, width, prec, conv, value))
+        except (TypeError, ValueError, OverflowError):
+            out.append(fmt[start:i])
+    return ''.join(out), length
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary logm buffer dump into text')
+    parser.add_argument('-e', '--elf', required=True, help='ELF image of the firmware, e.g. build/output/bin/tinyara')
+    parser.add_argument('dump', help='raw dump of the logm buffer (g_logm_rsvbuf)')
+    parser.add_argument('--head', type=int, default=0,
+                        help='offset of the oldest record in the dump (g_logm_head), to undo the ring wrap')
+    parser.add_argument('--tick-per-sec', type=int, default=100,
+                        help='system timer ticks per second (1000000 / CONFIG_USEC_PER_TICK)')
+    parser.add_argument('--no-timestamp', action='store_true', help='do not print the timestamps')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    with open(args.dump, 'rb') as f:
+        data = f.read()
+    data = data[args.head:] + data[:args.head]
+
+    # Records are found by their magic byte, anything else is skipped
+    off = 0
+    while off < len(data):
+        result = decode_record(elf, data, off, args.tick_per_sec, not args.no_timestamp)
+        if result is None:
+            off += 1
+            continue
+        text, length = result
+        sys.stdout.write(text)
+        off += length
+
+
+if __name__ == '__main__':
+    main()
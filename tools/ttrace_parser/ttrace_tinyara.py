@@ -24,6 +24,8 @@ import os
 import sys
 import time
 import glob
+import json
+import re
 import optparse
 
 cycleIdDict = dict()
@@ -35,6 +37,16 @@ temporalId = 1000
 parserDirPath = "scripts"
 
 ftraceLogs = []
+tinyaraLogs = []
+
+# Letters which ftrace understands, the rest are only used for JSON
+ftracePairTypes = ('B', 'E', 'S')
+
+# Pseudo process holding the CPU and interrupt tracks in JSON
+jsonTaskPid = 0
+jsonCpuPid = 1
+jsonCpuTid = 0
+jsonIrqTid = 1
 
 
 class TraceItem:
@@ -112,6 +124,11 @@ def translateTinyaraLogs(options):
             pid = item.extractPid(lineList[1])
             pair_type = item.extractPairType(lineList[2])
             msg = item.extractMsg(lineList[2])
+            sec, usec = time.split('.')
+            tinyaraLogs.append((int(sec) * 1000000 + int(usec), int(pid),
+                    pair_type, msg))
+            if pair_type not in ftracePairTypes:
+                continue
             translatedLine = item.composeLine()
             if (options.verbose == True):
                 print(translatedLine)
@@ -119,6 +136,84 @@ def translateTinyaraLogs(options):
     return True
 
 
+def parseSchedMsg(msg):
+    fields = dict(re.findall(r'(\w+)=(\S+)', msg))
+    return fields
+
+
+def makeChromeJson(options):
+    # Rings of each task are merged on target, legacy packets and events
+    # are merged here by time.  sort() is stable so equal times keep order.
+    logs = sorted(tinyaraLogs, key=itemgetter(0))
+    events = []
+    names = dict()
+    running = None
+
+    def meta(name, pid, tid, value):
+        events.append({"name": name, "ph": "M", "pid": pid, "tid": tid,
+                "args": {"name": value}})
+
+    slices = []
+
+    for (ts, pid, pair_type, msg) in logs:
+        if pair_type == 'B':
+            events.append({"name": msg, "ph": "B", "pid": jsonTaskPid,
+                    "tid": pid, "ts": ts})
+        elif pair_type == 'E':
+            events.append({"ph": "E", "pid": jsonTaskPid, "tid": pid,
+                    "ts": ts})
+        elif pair_type == 'S':
+            fields = parseSchedMsg(msg)
+            nextPid = int(fields.get('next_pid', 0))
+            for key in ('prev', 'next'):
+                comm = fields.get(key + '_comm')
+                commPid = int(fields.get(key + '_pid', 0))
+                if comm is not None and comm != str(commPid):
+                    names[commPid] = comm
+            if running is not None:
+                slices.append((running[0], running[1], ts - running[1],
+                        fields.get('prev_state')))
+            running = (nextPid, ts)
+        elif pair_type == 'W':
+            events.append({"name": "sem_wait", "ph": "B", "pid": jsonTaskPid,
+                    "tid": pid, "ts": ts, "args": {"sem": msg}})
+        elif pair_type == 'R':
+            events.append({"ph": "E", "pid": jsonTaskPid, "tid": pid,
+                    "ts": ts})
+        elif pair_type == 'P':
+            events.append({"name": "sem_post", "ph": "i", "s": "t",
+                    "pid": jsonTaskPid, "tid": pid, "ts": ts,
+                    "args": {"sem": msg}})
+        elif pair_type == 'I':
+            events.append({"name": "irq %s" % msg, "ph": "B",
+                    "pid": jsonCpuPid, "tid": jsonIrqTid, "ts": ts,
+                    "args": {"pid": pid}})
+        elif pair_type == 'X':
+            events.append({"ph": "E", "pid": jsonCpuPid, "tid": jsonIrqTid,
+                    "ts": ts})
+
+    # Names may only show up in later switches, so the CPU track is added
+    # after all logs have been seen
+    for (pid, ts, dur, state) in slices:
+        events.append({"name": "%s-%d" % (names.get(pid, "task"), pid),
+                "ph": "X", "pid": jsonCpuPid, "tid": jsonCpuTid, "ts": ts,
+                "dur": dur, "args": {"prev_state": state}})
+
+    meta("process_name", jsonTaskPid, 0, "Tasks")
+    meta("process_name", jsonCpuPid, 0, "CPU")
+    meta("thread_name", jsonCpuPid, jsonCpuTid, "sched")
+    meta("thread_name", jsonCpuPid, jsonIrqTid, "irq")
+    for pid in sorted(names):
+        meta("thread_name", jsonTaskPid, pid, "%s-%d" % (names[pid], pid))
+
+    jsonfile = options.outputFile.replace(options.outputExt, '.json')
+    with open(jsonfile, "w") as output:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, output,
+                indent=1)
+    print("JSON trace saved at %s" % (jsonfile))
+    return True
+
+
 def get_os_cmd(cmdARGS):
         fd_popen = subprocess.Popen(cmdARGS.split(),
                 stdout=subprocess.PIPE, stderr=subprocess.PIPE)
@@ -171,6 +266,11 @@ def main():
                 metavar='FILENAME',
                 help="Output file that html report saved, "
                 "[default:%default]")
+        parser.add_option('-j', '--json', dest='json',
+                action="store_true",
+                default=False,
+                help="Generate Chrome/Perfetto JSON instead of html report, "
+                "[default:%default]")
         parser.add_option('-v', '--verbose', dest='verbose',
                 action="store_true",
                 default=False,
@@ -229,6 +329,9 @@ def main():
         print("output file will be saved at %s" % (options.outputFile))
 
         translateTinyaraLogs(options)
+        if (options.json == True):
+            makeChromeJson(options)
+            return
         writeFtraceLogs(options)
         makeHtml(options)
 